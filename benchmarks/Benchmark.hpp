@@ -0,0 +1,124 @@
+
+#ifndef THREEPP_BENCHMARK_HPP
+#define THREEPP_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace threepp::bench {
+
+    // Handed to a benchmark function. Work done before the first keepRunning() call is setup
+    // and not timed, every call that returns true is one timed iteration:
+    //
+    //     while (state.keepRunning()) { ... }
+    class State {
+
+    public:
+        // values reported alongside the timings, e.g. the triangle count of the benchmarked mesh
+        std::map<std::string, double> counters;
+
+        State(int64_t param, size_t iterations);
+
+        // the parameter the benchmark was registered with (scene size, triangle count, ...)
+        [[nodiscard]] int64_t param() const {
+
+            return param_;
+        }
+
+        [[nodiscard]] size_t iterations() const {
+
+            return iterations_;
+        }
+
+        bool keepRunning() {
+
+            if (!started_) {
+
+                started_ = true;
+                resumeTiming();
+            }
+
+            if (remaining_ == 0) {
+
+                pauseTiming();
+                return false;
+            }
+
+            --remaining_;
+            return true;
+        }
+
+        // excludes per-iteration setup from the measurement
+        void pauseTiming();
+
+        void resumeTiming();
+
+        // items handled by a single iteration, reported as items per second
+        void setItemsPerIteration(double items) {
+
+            itemsPerIteration_ = items;
+        }
+
+        [[nodiscard]] double itemsPerIteration() const {
+
+            return itemsPerIteration_;
+        }
+
+        [[nodiscard]] double elapsedSeconds() const {
+
+            return elapsed_.count();
+        }
+
+    private:
+        int64_t param_;
+        size_t iterations_;
+        size_t remaining_;
+        bool started_ = false;
+        bool running_ = false;
+        double itemsPerIteration_ = 0;
+
+        std::chrono::steady_clock::time_point start_;
+        std::chrono::duration<double> elapsed_{0};
+    };
+
+    using Function = std::function<void(State&)>;
+
+    struct Benchmark {
+
+        std::string name;
+        Function function;
+        std::vector<int64_t> params;
+    };
+
+    std::vector<Benchmark>& registry();
+
+    struct Registrar {
+
+        Registrar(std::string name, Function function, std::vector<int64_t> params = {0}) {
+
+            registry().push_back({std::move(name), std::move(function), std::move(params)});
+        }
+    };
+
+    // keeps the compiler from discarding a computed value
+    template<class T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile(""
+                     :
+                     : "m"(value)
+                     : "memory");
+#else
+        static volatile const void* sink;
+        sink = &value;
+#endif
+    }
+
+}// namespace threepp::bench
+
+#endif//THREEPP_BENCHMARK_HPP
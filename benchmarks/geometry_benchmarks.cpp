@@ -0,0 +1,99 @@
+
+#include "Benchmark.hpp"
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/EdgesGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/utils/BufferGeometryUtils.hpp"
+#include "threepp/utils/MeshSimplifier.hpp"
+
+using namespace threepp;
+
+namespace {
+
+    void edgesGeometry(bench::State& state) {
+
+        const auto segments = static_cast<unsigned int>(state.param());
+        auto geometry = SphereGeometry::create(1, segments, segments);
+
+        const auto triangles = geometry->getIndex()->count() / 3;
+        state.counters["triangles"] = static_cast<double>(triangles);
+        state.setItemsPerIteration(static_cast<double>(triangles));
+
+        while (state.keepRunning()) {
+
+            auto edges = EdgesGeometry::create(*geometry, 1);
+            bench::doNotOptimize(edges);
+        }
+    }
+
+    void mergeBufferGeometries(bench::State& state) {
+
+        const auto count = static_cast<size_t>(state.param());
+
+        std::vector<std::shared_ptr<BufferGeometry>> geometries;
+        for (size_t i = 0; i < count; i++) {
+
+            auto box = BoxGeometry::create(1, 1, 1, 2, 2, 2);
+            box->translate(static_cast<float>(i), 0, 0);
+            geometries.emplace_back(box);
+        }
+
+        state.setItemsPerIteration(static_cast<double>(count));
+        while (state.keepRunning()) {
+
+            auto merged = threepp::mergeBufferGeometries(geometries);
+            bench::doNotOptimize(merged);
+        }
+    }
+
+    void optimizeGeometry(bench::State& state) {
+
+        const auto segments = static_cast<unsigned int>(state.param());
+        auto soup = SphereGeometry::create(1, segments, segments)->toNonIndexed();
+
+        const auto triangles = soup->getAttribute("position")->count() / 3;
+        state.counters["triangles"] = static_cast<double>(triangles);
+        state.setItemsPerIteration(static_cast<double>(triangles));
+
+        std::shared_ptr<BufferGeometry> optimized;
+        while (state.keepRunning()) {
+
+            optimized = threepp::optimizeGeometry(*soup);
+            bench::doNotOptimize(optimized);
+        }
+
+        state.counters["vertices"] = static_cast<double>(optimized->getAttribute("position")->count());
+        state.counters["acmr"] = computeACMR(*optimized);
+    }
+
+    void simplifyGeometry(bench::State& state) {
+
+        const auto segments = static_cast<unsigned int>(state.param());
+        auto sphere = SphereGeometry::create(1, segments, segments);
+
+        const auto triangles = sphere->getIndex()->count() / 3;
+        state.counters["triangles"] = static_cast<double>(triangles);
+        state.setItemsPerIteration(static_cast<double>(triangles));
+
+        SimplifyOptions options;
+        options.targetRatio = 0.1f;
+
+        std::shared_ptr<BufferGeometry> simplified;
+        float error = 0;
+        while (state.keepRunning()) {
+
+            simplified = threepp::simplifyGeometry(*sphere, options, &error);
+            bench::doNotOptimize(simplified);
+        }
+
+        state.counters["simplifiedTriangles"] = static_cast<double>(simplified->getIndex()->count() / 3);
+        state.counters["error"] = error;
+    }
+
+    bench::Registrar edges("EdgesGeometry", edgesGeometry, {16, 64, 256});
+    bench::Registrar merge("mergeBufferGeometries", mergeBufferGeometries, {10, 100, 1000});
+    bench::Registrar optimize("optimizeGeometry", optimizeGeometry, {64, 256, 512});
+    bench::Registrar simplify("simplifyGeometry", simplifyGeometry, {64, 256, 1024});
+
+}// namespace
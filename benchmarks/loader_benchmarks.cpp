@@ -0,0 +1,79 @@
+
+#include "Benchmark.hpp"
+
+#include "threepp/loaders/OBJLoader.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace threepp;
+
+namespace {
+
+    // writes (once) a textured, lit height-field OBJ of roughly sizeKB kilobytes
+    std::filesystem::path objFile(int64_t sizeKB) {
+
+        static std::map<int64_t, std::filesystem::path> files;
+
+        auto it = files.find(sizeKB);
+        if (it != files.end()) return it->second;
+
+        const auto dir = std::filesystem::temp_directory_path() / "threepp_benchmarks";
+        std::filesystem::create_directories(dir);
+        const auto path = dir / ("grid_" + std::to_string(sizeKB) + "kb.obj");
+
+        // roughly 105 bytes per grid vertex, counting the v/vt/vn lines and its share of faces
+        const auto n = static_cast<int>(std::sqrt(static_cast<double>(sizeKB) * 1024 / 105)) + 2;
+
+        std::ofstream out(path);
+        out << "o grid\n";
+        for (int y = 0; y < n; y++) {
+            for (int x = 0; x < n; x++) {
+
+                const auto h = std::sin(x * 0.1f) * std::cos(y * 0.1f);
+                out << "v " << x * 0.1f << " " << h << " " << y * 0.1f << "\n";
+                out << "vt " << static_cast<float>(x) / (n - 1) << " " << static_cast<float>(y) / (n - 1) << "\n";
+                out << "vn 0 1 0\n";
+            }
+        }
+        for (int y = 0; y < n - 1; y++) {
+            for (int x = 0; x < n - 1; x++) {
+
+                const auto a = y * n + x + 1;
+                const auto b = a + 1;
+                const auto c = a + n + 1;
+                const auto d = a + n;
+                out << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " "
+                    << c << "/" << c << "/" << c << " " << d << "/" << d << "/" << d << "\n";
+            }
+        }
+
+        files[sizeKB] = path;
+
+        return path;
+    }
+
+    void objLoad(bench::State& state, bool fastMode) {
+
+        const auto path = objFile(state.param());
+        const auto bytes = static_cast<double>(std::filesystem::file_size(path));
+
+        OBJLoader loader;
+        loader.useCache = false;
+        loader.fastMode = fastMode;
+
+        state.counters["bytes"] = bytes;
+        state.setItemsPerIteration(bytes);
+        while (state.keepRunning()) {
+
+            auto group = loader.load(path, false);
+            bench::doNotOptimize(group);
+        }
+    }
+
+    bench::Registrar slow("OBJLoader::load", [](bench::State& state) { objLoad(state, false); }, {256, 4096, 32768});
+    bench::Registrar fast("OBJLoader::load(fastMode)", [](bench::State& state) { objLoad(state, true); }, {256, 4096, 32768});
+
+}// namespace
@@ -0,0 +1,311 @@
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+
+using namespace threepp::bench;
+
+namespace {
+
+    struct Options {
+
+        std::string filter;
+        std::string out;
+        double minTime = 0.2;
+        unsigned int repetitions = 5;
+        bool list = false;
+    };
+
+    struct Result {
+
+        std::string name;
+        int64_t param;
+        size_t iterations;
+        std::vector<double> nsPerIteration;
+        double itemsPerIteration;
+        std::map<std::string, double> counters;
+
+        [[nodiscard]] double min() const {
+
+            return *std::min_element(nsPerIteration.begin(), nsPerIteration.end());
+        }
+
+        [[nodiscard]] double max() const {
+
+            return *std::max_element(nsPerIteration.begin(), nsPerIteration.end());
+        }
+
+        [[nodiscard]] double mean() const {
+
+            return std::accumulate(nsPerIteration.begin(), nsPerIteration.end(), 0.0) / static_cast<double>(nsPerIteration.size());
+        }
+
+        [[nodiscard]] double median() const {
+
+            auto sorted = nsPerIteration;
+            std::sort(sorted.begin(), sorted.end());
+            const auto mid = sorted.size() / 2;
+
+            return sorted.size() % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2;
+        }
+
+        [[nodiscard]] double stddev() const {
+
+            if (nsPerIteration.size() < 2) return 0;
+
+            const auto m = mean();
+            double sum = 0;
+            for (auto v : nsPerIteration) sum += (v - m) * (v - m);
+
+            return std::sqrt(sum / static_cast<double>(nsPerIteration.size() - 1));
+        }
+    };
+
+    std::string fullName(const Benchmark& benchmark, int64_t param) {
+
+        if (benchmark.params.size() == 1 && benchmark.params.front() == 0) return benchmark.name;
+
+        return benchmark.name + "/" + std::to_string(param);
+    }
+
+    // grows the iteration count until one run takes at least minTime, then measures repetitions runs of that size
+    Result run(const Benchmark& benchmark, int64_t param, const Options& options) {
+
+        size_t iterations = 1;
+        while (true) {
+
+            State state(param, iterations);
+            benchmark.function(state);
+
+            const auto elapsed = state.elapsedSeconds();
+            if (elapsed >= options.minTime || iterations >= 1000000000) break;
+
+            const auto multiplier = elapsed > 0 ? std::min(10.0, 1.4 * options.minTime / elapsed) : 10.0;
+            iterations = std::max(iterations + 1, static_cast<size_t>(static_cast<double>(iterations) * multiplier));
+        }
+
+        Result result{fullName(benchmark, param), param, iterations, {}, 0, {}};
+        for (unsigned int i = 0; i < std::max(options.repetitions, 1u); i++) {
+
+            State state(param, iterations);
+            benchmark.function(state);
+
+            result.nsPerIteration.emplace_back(state.elapsedSeconds() * 1e9 / static_cast<double>(iterations));
+            result.itemsPerIteration = state.itemsPerIteration();
+            result.counters = state.counters;
+        }
+
+        return result;
+    }
+
+    std::string escape(const std::string& str) {
+
+        std::string result;
+        for (auto c : str) {
+
+            if (c == '"' || c == '\\') result += '\\';
+            result += c;
+        }
+
+        return result;
+    }
+
+    std::string timestamp() {
+
+        const auto now = std::time(nullptr);
+        std::tm tm{};
+#ifdef _WIN32
+        gmtime_s(&tm, &now);
+#else
+        gmtime_r(&now, &tm);
+#endif
+        std::ostringstream ss;
+        ss << std::put_time(&tm, "%Y-%m-%dT%H:%M:%SZ");
+
+        return ss.str();
+    }
+
+    std::string compiler() {
+#if defined(__clang__)
+        return "clang " __clang_version__;
+#elif defined(__GNUC__)
+        return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+        return "msvc " + std::to_string(_MSC_VER);
+#else
+        return "unknown";
+#endif
+    }
+
+    void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+
+        out << std::setprecision(10);
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"date\": \"" << timestamp() << "\",\n";
+        out << "    \"version\": \"" << THREEPP_VERSION << "\",\n";
+        out << "    \"build_type\": \"" << THREEPP_BUILD_TYPE << "\",\n";
+        out << "    \"compiler\": \"" << escape(compiler()) << "\",\n";
+        out << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+        out << "    \"min_time\": " << options.minTime << ",\n";
+        out << "    \"repetitions\": " << options.repetitions << "\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [";
+
+        for (size_t i = 0; i < results.size(); i++) {
+
+            const auto& r = results[i];
+            out << (i ? ",\n" : "\n");
+            out << "    {\n";
+            out << "      \"name\": \"" << escape(r.name) << "\",\n";
+            out << "      \"param\": " << r.param << ",\n";
+            out << "      \"iterations\": " << r.iterations << ",\n";
+            out << "      \"ns_per_iteration\": {\"min\": " << r.min() << ", \"median\": " << r.median() << ", \"mean\": " << r.mean()
+                << ", \"max\": " << r.max() << ", \"stddev\": " << r.stddev() << "},\n";
+            out << "      \"items_per_second\": " << (r.itemsPerIteration > 0 ? r.itemsPerIteration * 1e9 / r.median() : 0) << ",\n";
+            out << "      \"counters\": {";
+            bool first = true;
+            for (const auto& [key, value] : r.counters) {
+
+                out << (first ? "" : ", ") << "\"" << escape(key) << "\": " << value;
+                first = false;
+            }
+            out << "}\n";
+            out << "    }";
+        }
+
+        out << "\n  ]\n";
+        out << "}\n";
+    }
+
+    std::string formatTime(double ns) {
+
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(ns < 10 ? 2 : 1);
+        if (ns < 1e3) ss << ns << " ns";
+        else if (ns < 1e6) ss << ns / 1e3 << " us";
+        else if (ns < 1e9) ss << ns / 1e6 << " ms";
+        else ss << ns / 1e9 << " s";
+
+        return ss.str();
+    }
+
+    void printUsage() {
+
+        std::cout << "Usage: threepp_benchmarks [--filter=<substring>] [--min-time=<seconds>] [--repetitions=<n>] [--out=<file.json>] [--list]" << std::endl;
+    }
+
+    bool parseArgs(int argc, char** argv, Options& options) {
+
+        for (int i = 1; i < argc; i++) {
+
+            const std::string arg = argv[i];
+            const auto eq = arg.find('=');
+            const auto key = arg.substr(0, eq);
+            const auto value = eq == std::string::npos ? "" : arg.substr(eq + 1);
+
+            if (key == "--filter") options.filter = value;
+            else if (key == "--out") options.out = value;
+            else if (key == "--min-time") options.minTime = std::stod(value);
+            else if (key == "--repetitions") options.repetitions = static_cast<unsigned int>(std::stoul(value));
+            else if (key == "--list") options.list = true;
+            else return false;
+        }
+
+        return true;
+    }
+
+}// namespace
+
+State::State(int64_t param, size_t iterations)
+    : param_(param), iterations_(iterations), remaining_(iterations) {}
+
+void State::pauseTiming() {
+
+    if (!running_) return;
+
+    elapsed_ += std::chrono::steady_clock::now() - start_;
+    running_ = false;
+}
+
+void State::resumeTiming() {
+
+    if (running_) return;
+
+    running_ = true;
+    start_ = std::chrono::steady_clock::now();
+}
+
+std::vector<Benchmark>& threepp::bench::registry() {
+
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+int main(int argc, char** argv) {
+
+    Options options;
+    try {
+
+        if (!parseArgs(argc, argv, options)) {
+
+            printUsage();
+            return 1;
+        }
+    } catch (const std::exception&) {
+
+        printUsage();
+        return 1;
+    }
+
+    auto benchmarks = registry();
+    std::sort(benchmarks.begin(), benchmarks.end(), [](const Benchmark& a, const Benchmark& b) {
+        return a.name < b.name;
+    });
+
+    std::vector<Result> results;
+    for (const auto& benchmark : benchmarks) {
+
+        for (auto param : benchmark.params) {
+
+            const auto name = fullName(benchmark, param);
+            if (name.find(options.filter) == std::string::npos) continue;
+
+            if (options.list) {
+
+                std::cout << name << std::endl;
+                continue;
+            }
+
+            auto result = run(benchmark, param, options);
+            std::cout << std::left << std::setw(48) << name
+                      << std::right << std::setw(12) << formatTime(result.median())
+                      << std::setw(14) << result.iterations << " it"
+                      << "  +/- " << std::fixed << std::setprecision(1) << (result.median() > 0 ? 100 * result.stddev() / result.median() : 0) << "%"
+                      << std::defaultfloat << std::endl;
+
+            results.emplace_back(std::move(result));
+        }
+    }
+
+    if (!options.out.empty()) {
+
+        std::ofstream out(options.out);
+        if (!out) {
+
+            std::cerr << "Unable to write " << options.out << std::endl;
+            return 1;
+        }
+        writeJson(out, results, options);
+    }
+
+    return 0;
+}
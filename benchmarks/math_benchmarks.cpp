@@ -0,0 +1,116 @@
+
+#include "Benchmark.hpp"
+
+#include "threepp/math/Matrix4.hpp"
+#include "threepp/math/Quaternion.hpp"
+#include "threepp/math/SimdKernels.hpp"
+#include "threepp/math/Vector3.hpp"
+
+#include <random>
+
+using namespace threepp;
+
+namespace {
+
+    std::vector<Matrix4> randomMatrices(size_t count) {
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1, 1);
+
+        std::vector<Matrix4> matrices(count);
+        for (auto& m : matrices) {
+
+            Quaternion q(dist(rng), dist(rng), dist(rng), dist(rng));
+            q.normalize();
+            m.compose({dist(rng), dist(rng), dist(rng)}, q, {1 + dist(rng) * 0.5f, 1 + dist(rng) * 0.5f, 1 + dist(rng) * 0.5f});
+        }
+
+        return matrices;
+    }
+
+    void matrix4MultiplyMatrices(bench::State& state) {
+
+        const auto matrices = randomMatrices(64);
+        Matrix4 result;
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+
+            result.multiplyMatrices(matrices[i & 63], matrices[(i + 1) & 63]);
+            bench::doNotOptimize(result);
+            ++i;
+        }
+    }
+
+    void matrix4Invert(bench::State& state) {
+
+        auto matrices = randomMatrices(64);
+
+        size_t i = 0;
+        while (state.keepRunning()) {
+
+            matrices[i & 63].invert();
+            bench::doNotOptimize(matrices[i & 63]);
+            ++i;
+        }
+    }
+
+    void vector3ApplyMatrix4(bench::State& state) {
+
+        const auto count = static_cast<size_t>(state.param());
+        const auto matrix = randomMatrices(1).front();
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-10, 10);
+        std::vector<Vector3> points(count);
+        for (auto& p : points) p.set(dist(rng), dist(rng), dist(rng));
+
+        state.setItemsPerIteration(static_cast<double>(count));
+        while (state.keepRunning()) {
+
+            for (auto& p : points) p.applyMatrix4(matrix);
+            bench::doNotOptimize(points.front());
+        }
+    }
+
+    // best = the instruction set detected at runtime
+    void arrayKernels(bench::State& state, bool best, bool bounds) {
+
+        const auto count = static_cast<size_t>(state.param());
+        const auto matrix = randomMatrices(1).front();
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-10, 10);
+        std::vector<float> array(count * 3);
+        for (auto& value : array) value = dist(rng);
+
+        simd::setInstructionSet(best ? simd::detectInstructionSet() : simd::InstructionSet::Scalar);
+
+        float min[3], max[3];
+        state.setItemsPerIteration(static_cast<double>(count));
+        while (state.keepRunning()) {
+
+            if (bounds) {
+
+                simd::computeBounds(array.data(), count, 3, min, max);
+                bench::doNotOptimize(min);
+
+            } else {
+
+                simd::applyMatrix4(array.data(), count, 3, matrix.elements.data());
+                bench::doNotOptimize(array.front());
+            }
+        }
+
+        simd::setInstructionSet(simd::detectInstructionSet());
+    }
+
+    bench::Registrar multiplyMatrices("Matrix4::multiplyMatrices", matrix4MultiplyMatrices);
+    bench::Registrar invert("Matrix4::invert", matrix4Invert);
+    bench::Registrar applyMatrix4("Vector3::applyMatrix4", vector3ApplyMatrix4, {1024, 65536});
+    bench::Registrar arrayApplyMatrix4Scalar("simd::applyMatrix4(Scalar)", [](bench::State& state) { arrayKernels(state, false, false); }, {1024, 65536});
+    bench::Registrar arrayApplyMatrix4("simd::applyMatrix4", [](bench::State& state) { arrayKernels(state, true, false); }, {1024, 65536});
+    bench::Registrar arrayBoundsScalar("simd::computeBounds(Scalar)", [](bench::State& state) { arrayKernels(state, false, true); }, {1024, 65536});
+    bench::Registrar arrayBounds("simd::computeBounds", [](bench::State& state) { arrayKernels(state, true, true); }, {1024, 65536});
+
+}// namespace
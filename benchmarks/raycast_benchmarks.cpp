@@ -0,0 +1,107 @@
+
+#include "Benchmark.hpp"
+
+#include "threepp/core/BatchRaycaster.hpp"
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+#include <random>
+
+using namespace threepp;
+
+namespace {
+
+    // rays from a shell around the unit sphere towards random points inside it
+    std::vector<Ray> createRays(size_t count) {
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1, 1);
+
+        std::vector<Ray> rays;
+        for (size_t i = 0; i < count; i++) {
+
+            Vector3 origin(dist(rng), dist(rng), dist(rng));
+            origin.normalize().multiplyScalar(3);
+            Vector3 target(dist(rng) * 0.5f, dist(rng) * 0.5f, dist(rng) * 0.5f);
+
+            rays.emplace_back(origin, (target - origin).normalize());
+        }
+
+        return rays;
+    }
+
+    void meshRaycast(bench::State& state, bool boundsTree, bool firstHitOnly) {
+
+        const auto segments = static_cast<unsigned int>(state.param());
+        auto geometry = SphereGeometry::create(1, segments, segments);
+        if (boundsTree) geometry->computeBoundsTree();
+
+        auto mesh = Mesh::create(geometry, MeshBasicMaterial::create());
+        mesh->updateMatrixWorld();
+
+        const auto rays = createRays(256);
+        Raycaster raycaster;
+        raycaster.firstHitOnly = firstHitOnly;
+
+        std::vector<Intersection> intersects;
+        size_t i = 0;
+        while (state.keepRunning()) {
+
+            raycaster.ray = rays[i++ & 255];
+            intersects.clear();
+            mesh->raycast(raycaster, intersects);
+            bench::doNotOptimize(intersects);
+        }
+
+        state.counters["triangles"] = static_cast<double>(geometry->getIndex()->count() / 3);
+    }
+
+    // a lidar scan of the sphere, one column of rings after the other so that neighbouring rays are coherent
+    void batchRaycast(bench::State& state, BatchRaycaster::Mode mode) {
+
+        auto geometry = SphereGeometry::create(1, 256, 256);
+        geometry->computeBoundsTree();
+
+        auto mesh = Mesh::create(geometry, MeshBasicMaterial::create());
+        mesh->updateMatrixWorld();
+
+        const auto count = static_cast<size_t>(state.param());
+        const size_t rings = 64;
+
+        const Vector3 origin(0, 0, 3);
+        std::vector<Vector3> origins(count, origin);
+        std::vector<Vector3> directions;
+        for (size_t i = 0; i < count; i++) {
+
+            const auto azimuth = static_cast<float>(i / rings) / static_cast<float>(count / rings) * 0.6f - 0.3f;
+            const auto elevation = static_cast<float>(i % rings) / rings * 0.6f - 0.3f;
+
+            directions.emplace_back(Vector3(azimuth, elevation, -1).normalize());
+        }
+
+        std::vector<float> distance(count);
+        RayBatchHits hits;
+        hits.distance = distance.data();
+
+        BatchRaycaster raycaster;
+        raycaster.mode = mode;
+
+        while (state.keepRunning()) {
+
+            raycaster.intersectObject(*mesh, origins.data(), directions.data(), count, hits);
+            bench::doNotOptimize(distance);
+        }
+
+        state.setItemsPerIteration(static_cast<double>(count));
+    }
+
+    bench::Registrar bruteForce("Mesh::raycast", [](bench::State& state) { meshRaycast(state, false, false); }, {16, 64, 256});
+    bench::Registrar bvh("Mesh::raycast(boundsTree)", [](bench::State& state) { meshRaycast(state, true, false); }, {16, 64, 256});
+    bench::Registrar bvhFirstHit("Mesh::raycast(boundsTree,firstHitOnly)", [](bench::State& state) { meshRaycast(state, true, true); }, {16, 64, 256});
+
+    bench::Registrar batchClosest("BatchRaycaster(ClosestHit)", [](bench::State& state) { batchRaycast(state, BatchRaycaster::Mode::ClosestHit); }, {100000, 1000000});
+    bench::Registrar batchAny("BatchRaycaster(AnyHit)", [](bench::State& state) { batchRaycast(state, BatchRaycaster::Mode::AnyHit); }, {100000, 1000000});
+
+}// namespace
@@ -0,0 +1,62 @@
+#include "Benchmark.hpp"
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/gl/GLRenderLists.hpp"
+
+#include <random>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // a frame of `count` draws spread over a handful of materials and geometries
+    void renderListSort(bench::State& state) {
+
+        const auto count = static_cast<size_t>(state.param());
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1, 1);
+
+        GLProperties properties;
+        GLRenderList list(properties);
+
+        std::vector<std::shared_ptr<MeshBasicMaterial>> materials(64);
+        for (size_t i = 0; i < materials.size(); i++) {
+
+            materials[i] = MeshBasicMaterial::create();
+            materials[i]->transparent = i % 4 == 0;
+        }
+
+        std::vector<std::shared_ptr<BufferGeometry>> geometries(32);
+        for (auto& geometry : geometries) geometry = BufferGeometry::create();
+
+        std::vector<std::shared_ptr<Mesh>> meshes(count);
+        std::vector<float> depths(count);
+        for (size_t i = 0; i < count; i++) {
+
+            meshes[i] = Mesh::create(geometries[i % geometries.size()], materials[(i * 7) % materials.size()]);
+            depths[i] = dist(rng);
+        }
+
+        state.setItemsPerIteration(static_cast<double>(count));
+        while (state.keepRunning()) {
+
+            list.init();
+            for (size_t i = 0; i < count; i++) {
+
+                auto& mesh = meshes[i];
+                list.push(mesh.get(), mesh->geometry(), mesh->material(), 0, depths[i], std::nullopt);
+            }
+            list.sort();
+            list.finish();
+
+            bench::doNotOptimize(list.opaque.front());
+        }
+    }
+
+    bench::Registrar renderListSortBench("GLRenderList::sort", renderListSort, {1000, 10000, 100000});
+
+}// namespace
@@ -0,0 +1,197 @@
+
+#include "Benchmark.hpp"
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/core/TransformSystem.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/Frustum.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/scenes/Scene.hpp"
+
+#include <random>
+
+using namespace threepp;
+
+namespace {
+
+    // scene of `count` meshes spread over a tree with the given branching factor
+    std::shared_ptr<Scene> createScene(size_t count, size_t branching, std::vector<Object3D*>& nodes) {
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> dist(-1, 1);
+
+        auto geometry = BoxGeometry::create();
+        auto material = MeshBasicMaterial::create();
+
+        auto scene = Scene::create();
+        nodes.clear();
+        nodes.reserve(count);
+
+        for (size_t i = 0; i < count; i++) {
+
+            auto mesh = Mesh::create(geometry, material);
+            mesh->position.set(dist(rng) * 10, dist(rng) * 10, dist(rng) * 10);
+            mesh->rotation.set(dist(rng), dist(rng), dist(rng));
+
+            Object3D* parent = i == 0 ? static_cast<Object3D*>(scene.get()) : nodes[(i - 1) / branching];
+            parent->add(mesh);
+            nodes.emplace_back(mesh.get());
+        }
+
+        return scene;
+    }
+
+    void updateMatrixWorld(bench::State& state) {
+
+        std::vector<Object3D*> nodes;
+        auto scene = createScene(static_cast<size_t>(state.param()), 8, nodes);
+
+        state.setItemsPerIteration(static_cast<double>(nodes.size()));
+        while (state.keepRunning()) {
+
+            scene->updateMatrixWorld(true);
+        }
+    }
+
+    // one percent of the nodes move per frame
+    void updateMatrixWorldIncremental(bench::State& state) {
+
+        std::vector<Object3D*> nodes;
+        auto scene = createScene(static_cast<size_t>(state.param()), 8, nodes);
+        scene->updateMatrixWorldIncremental(true);
+
+        const auto stride = size_t(100);
+        size_t frame = 0;
+
+        state.setItemsPerIteration(static_cast<double>(nodes.size()));
+        while (state.keepRunning()) {
+
+            for (auto i = frame % stride; i < nodes.size(); i += stride) {
+
+                nodes[i]->position.x += 0.01f;
+            }
+            scene->updateMatrixWorldIncremental();
+            ++frame;
+        }
+    }
+
+    void transformSystemUpdate(bench::State& state) {
+
+        std::vector<Object3D*> nodes;
+        auto scene = createScene(static_cast<size_t>(state.param()), 8, nodes);
+        TransformSystem transforms(*scene);
+
+        state.setItemsPerIteration(static_cast<double>(nodes.size()));
+        while (state.keepRunning()) {
+
+            transforms.update(true);
+        }
+    }
+
+    // one percent of the nodes move per frame, as in updateMatrixWorldIncremental
+    void transformSystemUpdateIncremental(bench::State& state) {
+
+        std::vector<Object3D*> nodes;
+        auto scene = createScene(static_cast<size_t>(state.param()), 8, nodes);
+        TransformSystem transforms(*scene);
+        transforms.update();
+
+        const auto stride = size_t(100);
+        size_t frame = 0;
+
+        state.setItemsPerIteration(static_cast<double>(nodes.size()));
+        while (state.keepRunning()) {
+
+            for (auto i = frame % stride; i < nodes.size(); i += stride) {
+
+                nodes[i]->position.x += 0.01f;
+            }
+            transforms.update();
+            ++frame;
+        }
+
+        state.counters["updated"] = static_cast<double>(transforms.updatedCount());
+    }
+
+    void createObjects(bench::State& state) {
+
+        const auto count = static_cast<size_t>(state.param());
+
+        std::vector<std::shared_ptr<Object3D>> objects;
+        objects.reserve(count);
+
+        state.setItemsPerIteration(static_cast<double>(count));
+        while (state.keepRunning()) {
+
+            for (size_t i = 0; i < count; i++) {
+
+                objects.emplace_back(Object3D::create());
+            }
+            bench::doNotOptimize(objects.data());
+
+            state.pauseTiming();
+            objects.clear();
+            state.resumeTiming();
+        }
+
+        state.counters["bytesPerObject"] = static_cast<double>(sizeof(Object3D));
+    }
+
+    // rotation written through Euler angles, then read through the quaternion when the matrix is composed
+    void rotateObjects(bench::State& state) {
+
+        std::vector<Object3D*> nodes;
+        auto scene = createScene(static_cast<size_t>(state.param()), 8, nodes);
+
+        state.setItemsPerIteration(static_cast<double>(nodes.size()));
+        while (state.keepRunning()) {
+
+            for (auto node : nodes) {
+
+                node->rotation.x += 0.01f;
+                node->rotation.y += 0.01f;
+                node->updateMatrix();
+            }
+        }
+    }
+
+    void frustumIntersectsObject(bench::State& state) {
+
+        std::vector<Object3D*> nodes;
+        auto scene = createScene(static_cast<size_t>(state.param()), 8, nodes);
+        scene->updateMatrixWorld(true);
+
+        auto camera = PerspectiveCamera::create(60, 1.5f, 0.1f, 50);
+        camera->position.set(0, 0, 20);
+        camera->updateMatrixWorld();
+
+        Matrix4 projScreenMatrix;
+        projScreenMatrix.multiplyMatrices(camera->projectionMatrix, camera->matrixWorldInverse);
+        Frustum frustum;
+        frustum.setFromProjectionMatrix(projScreenMatrix);
+
+        size_t visible = 0;
+        state.setItemsPerIteration(static_cast<double>(nodes.size()));
+        while (state.keepRunning()) {
+
+            visible = 0;
+            for (auto node : nodes) {
+
+                if (frustum.intersectsObject(*node)) ++visible;
+            }
+            bench::doNotOptimize(visible);
+        }
+
+        state.counters["visible"] = static_cast<double>(visible);
+    }
+
+    bench::Registrar updateMatrixWorldBench("Object3D::updateMatrixWorld", updateMatrixWorld, {1000, 10000, 100000});
+    bench::Registrar updateMatrixWorldIncrementalBench("Object3D::updateMatrixWorldIncremental", updateMatrixWorldIncremental, {1000, 10000, 100000});
+    bench::Registrar transformSystemUpdateBench("TransformSystem::update", transformSystemUpdate, {1000, 10000, 100000});
+    bench::Registrar transformSystemUpdateIncrementalBench("TransformSystem::updateIncremental", transformSystemUpdateIncremental, {1000, 10000, 100000});
+    bench::Registrar createObjectsBench("Object3D::create", createObjects, {10000, 100000, 1000000});
+    bench::Registrar rotateObjectsBench("Object3D::rotation", rotateObjects, {1000, 10000, 100000});
+    bench::Registrar intersectsObjectBench("Frustum::intersectsObject", frustumIntersectsObject, {1000, 10000, 100000});
+
+}// namespace
@@ -0,0 +1,71 @@
+
+#include "threepp/threepp.hpp"
+
+#include "threepp/HeadlessCanvas.hpp"
+#include "threepp/renderers/GLReadback.hpp"
+
+#include <fstream>
+
+using namespace threepp;
+
+namespace {
+
+    // writes a binary PPM, GL rows arrive bottom first
+    void writePPM(const std::string& path, const Image& image) {
+
+        std::ofstream out(path, std::ios::binary);
+        out << "P6\n"
+            << image.width << " " << image.height << "\n255\n";
+
+        const auto data = image.getData();
+        for (unsigned int row = 0; row < image.height; row++) {
+
+            const auto y = image.flipped() ? image.height - 1 - row : row;
+            for (unsigned int x = 0; x < image.width; x++) {
+
+                out.write(reinterpret_cast<const char*>(data + (y * image.width + x) * 4), 3);
+            }
+        }
+    }
+
+}// namespace
+
+int main() {
+
+    HeadlessCanvas canvas(Canvas::Parameters().size(640, 480));
+    GLRenderer renderer;
+    renderer.setSize(canvas.getSize());
+    renderer.setClearColor(Color::aliceblue);
+
+    auto scene = Scene::create();
+    auto camera = PerspectiveCamera::create(75, canvas.getAspect(), 0.1f, 100);
+    camera->position.z = 3;
+
+    auto box = Mesh::create(BoxGeometry::create(), MeshNormalMaterial::create());
+    scene->add(box);
+
+    GLReadback readback(renderer);
+
+    size_t frame = 0;
+    readback.onFrame = [&](Image& image) {
+        if (frame++ % 30 == 0) {
+            writePPM("frame" + std::to_string(frame - 1) + ".ppm", image);
+        }
+    };
+
+    canvas.animate([&](float dt) {
+        box->rotation.y += 0.02f;
+        box->rotation.x += 0.01f;
+
+        renderer.render(scene, camera);
+        readback.read();
+
+        if (canvas.frameCount() == 120) {
+            canvas.stop();
+        }
+    });
+
+    readback.flush();
+
+    std::cout << "Streamed " << frame << " frames" << std::endl;
+}
@@ -177,7 +177,7 @@ int main() {
             Vector3 n = i.face->normal;
 
             mouseHelper.setPosition(i.point);
-            n.transformDirection(*mesh->matrixWorld);
+            n.transformDirection(mesh->matrixWorld);
             n.multiplyScalar(10);
             n.add(i.point);
             mouseHelper.lookAt(position.setFromMatrixPosition(mouseHelper), n, Vector3::Z());
@@ -152,7 +152,7 @@ int main() {
             if (ui.posMode) {
 
                 auto target = Matrix4().setPosition(ui.pos);
-                target.premultiply(Matrix4().copy(*youbot->matrixWorld).invert());
+                target.premultiply(Matrix4().copy(youbot->matrixWorld).invert());
                 targetHelper->position.setFromMatrixPosition(target);
                 targetHelper->quaternion.setFromRotationMatrix(target);
                 ui.values = ikSolver.solveIK(kine, targetHelper->position, youbot->getJointValues());
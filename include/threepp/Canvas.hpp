@@ -343,7 +343,7 @@ namespace threepp {
                 }
             }
 
-            ~Impl() {
+            virtual ~Impl() {
                 backend_window_destroy();
             }
 
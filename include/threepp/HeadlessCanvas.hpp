@@ -0,0 +1,31 @@
+
+#ifndef THREEPP_HEADLESSCANVAS_HPP
+#define THREEPP_HEADLESSCANVAS_HPP
+
+#include "threepp/Canvas.hpp"
+
+namespace threepp {
+
+    // Canvas without a window, backed by an offscreen EGL pbuffer or OSMesa buffer.
+    // Available when built with THREEPP_USE_CUSTOM_BACKEND and THREEPP_HEADLESS_BACKEND set.
+    class HeadlessCanvas: public Canvas {
+
+    public:
+        explicit HeadlessCanvas(const Parameters& params = Parameters());
+
+        // makes animate() return after the current frame
+        void stop();
+
+        // number of frames completed by animate()
+        [[nodiscard]] size_t frameCount() const;
+
+    private:
+        struct HeadlessImpl;
+        HeadlessImpl* impl_;
+
+        HeadlessCanvas(const Parameters& params, HeadlessImpl* impl);
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_HEADLESSCANVAS_HPP
@@ -33,26 +33,25 @@ namespace threepp {
 
             this->updateWorldMatrix(true, false);
 
-            const auto& e = this->matrixWorld->elements;
+            const auto& e = this->matrixWorld.elements;
 
             target.set(-e[8], -e[9], -e[10]).normalize();
         }
 
-        void updateMatrixWorld(bool force = false) override {
-
-            Object3D::updateMatrixWorld(force);
-
-            this->matrixWorldInverse.copy(*this->matrixWorld).invert();
-        }
-
         void updateWorldMatrix(std::optional<bool> updateParents, std::optional<bool> updateChildren) override {
 
             Object3D::updateWorldMatrix(updateParents, updateChildren);
 
-            this->matrixWorldInverse.copy(*this->matrixWorld).invert();
+            this->matrixWorldInverse.copy(this->matrixWorld).invert();
         }
 
         virtual void updateProjectionMatrix(){};
+
+    protected:
+        void afterUpdateMatrixWorld() override {
+
+            this->matrixWorldInverse.copy(this->matrixWorld).invert();
+        }
     };
 
 }// namespace threepp
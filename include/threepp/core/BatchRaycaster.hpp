@@ -0,0 +1,69 @@
+
+#ifndef THREEPP_BATCHRAYCASTER_HPP
+#define THREEPP_BATCHRAYCASTER_HPP
+
+#include "threepp/core/Layers.hpp"
+#include "threepp/math/Vector3.hpp"
+
+#include <cstddef>
+#include <limits>
+
+namespace threepp {
+
+    class Object3D;
+
+    // Caller owned buffers receiving one entry per ray, each component in its own array.
+    // Only distance is required, any other buffer may be left null when not needed.
+    struct RayBatchHits {
+
+        float* distance = nullptr;// Infinity for rays that hit nothing
+
+        float* pointX = nullptr;
+        float* pointY = nullptr;
+        float* pointZ = nullptr;
+
+        // geometric normal of the hit triangle in world space, following its winding
+        float* normalX = nullptr;
+        float* normalY = nullptr;
+        float* normalZ = nullptr;
+
+        unsigned int* objectId = nullptr;  // Object3D::id of the mesh hit
+        unsigned int* faceIndex = nullptr; // triangle number in (non-)indexed buffer semantics
+        unsigned int* instanceId = nullptr;// instance hit for an InstancedMesh
+    };
+
+    // Casts large numbers of rays against the meshes of a scene at once, e.g. to simulate lidar or depth sensors.
+    // Consecutive rays are intersected in packets traversing a hierarchy over the world bounds of the meshes
+    // and instances, then the boundsTree of each geometry reached, and packets are spread over the worker
+    // threads of the ThreadPool.
+    class BatchRaycaster {
+
+    public:
+        enum class Mode {
+            ClosestHit,// the closest hit of every ray
+            AnyHit     // whichever hit is found first, for visibility queries
+        };
+
+        // written to objectId, faceIndex and instanceId when there is no hit
+        static constexpr unsigned int noHit = std::numeric_limits<unsigned int>::max();
+
+        float near;
+        float far;
+
+        Layers layers;
+        Mode mode = Mode::ClosestHit;
+
+        explicit BatchRaycaster(float near = 0, float far = std::numeric_limits<float>::infinity())
+            : near(near), far(far) {}
+
+        // Intersects count rays given by origins and (normalized) directions with object and, if recursive, its descendants.
+        // Only meshes are tested, each with the side of its first material and ignoring groups and drawRange.
+        // World matrices are used as they are, and geometries without a boundsTree get one.
+        // Returns the number of rays that hit.
+        size_t intersectObject(Object3D& object, const Vector3* origins, const Vector3* directions, size_t count,
+                               const RayBatchHits& hits, bool recursive = true) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_BATCHRAYCASTER_HPP
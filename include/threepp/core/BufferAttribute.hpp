@@ -5,6 +5,10 @@
 
 #include "threepp/math/Box3.hpp"
 #include "threepp/math/Color.hpp"
+#include "threepp/math/Float16.hpp"
+#include "threepp/math/Matrix3.hpp"
+#include "threepp/math/Matrix4.hpp"
+#include "threepp/math/SimdKernels.hpp"
 #include "threepp/math/Vector2.hpp"
 #include "threepp/math/Vector3.hpp"
 #include "threepp/math/Vector4.hpp"
@@ -12,7 +16,12 @@
 #include "threepp/constants.hpp"
 #include "threepp/core/misc.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 namespace threepp {
@@ -20,15 +29,69 @@ namespace threepp {
     template<class T>
     class TypedBufferAttribute;
 
+    enum class ComponentType {
+        Float,
+        HalfFloat,
+        Byte,
+        UnsignedByte,
+        Short,
+        UnsignedShort,
+        Int,
+        UnsignedInt
+    };
+
+    template<class T>
+    constexpr ComponentType componentTypeOf() {
+
+        if constexpr (std::is_same_v<T, float>) return ComponentType::Float;
+        else if constexpr (std::is_same_v<T, Float16>) return ComponentType::HalfFloat;
+        else if constexpr (std::is_same_v<T, int8_t>) return ComponentType::Byte;
+        else if constexpr (std::is_same_v<T, uint8_t>) return ComponentType::UnsignedByte;
+        else if constexpr (std::is_same_v<T, int16_t>) return ComponentType::Short;
+        else if constexpr (std::is_same_v<T, uint16_t>) return ComponentType::UnsignedShort;
+        else if constexpr (std::is_same_v<T, int32_t>) return ComponentType::Int;
+        else {
+            static_assert(std::is_same_v<T, uint32_t>, "Unsupported buffer attribute component type");
+            return ComponentType::UnsignedInt;
+        }
+    }
+
     class BufferAttribute {
 
     public:
         UpdateRange updateRange{0, -1};
 
+        // element ranges to upload on the next update, the whole array is uploaded when empty
+        std::vector<UpdateRange> updateRanges;
+
         unsigned int version = 0;
 
         [[nodiscard]] virtual int count() const = 0;
 
+        [[nodiscard]] virtual ComponentType componentType() const = 0;
+
+        // raw component storage, as uploaded to the GPU
+        [[nodiscard]] virtual const void* rawData() const = 0;
+
+        [[nodiscard]] virtual size_t byteLength() const = 0;
+
+        [[nodiscard]] virtual int bytesPerComponent() const = 0;
+
+        // component access as float, normalized integer data is mapped to [0,1] or [-1,1]
+        [[nodiscard]] virtual float getComponent(size_t index, int component) const = 0;
+
+        virtual void setComponent(size_t index, int component, float value) = 0;
+
+        virtual void setFromBufferAttribute(Vector2& target, size_t index) const = 0;
+
+        virtual void setFromBufferAttribute(Vector3& target, size_t index) const = 0;
+
+        virtual void setFromBufferAttribute(Vector4& target, size_t index) const = 0;
+
+        virtual void setFromBufferAttribute(Box3& target) const = 0;
+
+        [[nodiscard]] virtual std::unique_ptr<BufferAttribute> cloneAttribute() const = 0;
+
         [[nodiscard]] int itemSize() const {
 
             return itemSize_;
@@ -49,6 +112,16 @@ namespace threepp {
             ++version;
         }
 
+        void addUpdateRange(int start, int count) {
+
+            updateRanges.push_back({start, count});
+        }
+
+        void clearUpdateRanges() {
+
+            updateRanges.clear();
+        }
+
         void setUsage(int value) {
 
             this->usage_ = value;
@@ -81,9 +154,6 @@ namespace threepp {
 
             this->usage_ = source.usage_;
         }
-
-        inline static Vector3 _vector{};
-        inline static Vector2 _vector2{};
     };
 
     template<class T>
@@ -95,6 +165,36 @@ namespace threepp {
             return count_;
         }
 
+        [[nodiscard]] ComponentType componentType() const final {
+
+            return componentTypeOf<T>();
+        }
+
+        [[nodiscard]] const void* rawData() const override {
+
+            return array_.data();
+        }
+
+        [[nodiscard]] size_t byteLength() const override {
+
+            return array_.size() * sizeof(T);
+        }
+
+        [[nodiscard]] int bytesPerComponent() const final {
+
+            return sizeof(T);
+        }
+
+        [[nodiscard]] float getComponent(size_t index, int component) const final {
+
+            return toFloat(array_[index * this->itemSize_ + component]);
+        }
+
+        void setComponent(size_t index, int component, float value) final {
+
+            array_[index * this->itemSize_ + component] = fromFloat(value);
+        }
+
         virtual std::vector<T>& array() {
 
             return array_;
@@ -178,24 +278,39 @@ namespace threepp {
 
         TypedBufferAttribute<T>& applyMatrix3(const Matrix3& m) {
 
+            if constexpr (std::is_same_v<T, float>) {
+
+                if (this->itemSize_ == 3) {
+
+                    simd::applyMatrix3(array_.data(), this->count_, this->itemSize_, m.elements.data());
+
+                    return *this;
+                }
+            }
+
             if (this->itemSize_ == 2) {
 
+                Vector2 vector;
+
                 for (size_t i = 0, l = this->count_; i < l; i++) {
 
-                    setFromBufferAttribute(_vector2, i);
-                    _vector2.applyMatrix3(m);
+                    setFromBufferAttribute(vector, i);
+                    vector.applyMatrix3(m);
 
-                    this->setXY(i, _vector2.x, _vector2.y);
+                    setComponent(i, 0, vector.x);
+                    setComponent(i, 1, vector.y);
                 }
 
             } else if (this->itemSize_ == 3) {
 
+                Vector3 vector;
+
                 for (size_t i = 0, l = this->count_; i < l; i++) {
 
-                    setFromBufferAttribute(_vector, i);
-                    _vector.applyMatrix3(m);
+                    setFromBufferAttribute(vector, i);
+                    vector.applyMatrix3(m);
 
-                    this->setXYZ(i, _vector.x, _vector.y, _vector.z);
+                    setFromVector(i, vector);
                 }
             }
 
@@ -204,15 +319,25 @@ namespace threepp {
 
         TypedBufferAttribute<T>& applyMatrix4(const Matrix4& m) {
 
+            if constexpr (std::is_same_v<T, float>) {
+
+                if (this->itemSize_ >= 3) {
+
+                    simd::applyMatrix4(array_.data(), this->count_, this->itemSize_, m.elements.data());
+
+                    return *this;
+                }
+            }
+
+            Vector3 vector;
+
             for (int i = 0, l = this->count_; i < l; i++) {
 
-                _vector.x = this->getX(i);
-                _vector.y = this->getY(i);
-                _vector.z = this->getZ(i);
+                setFromBufferAttribute(vector, i);
 
-                _vector.applyMatrix4(m);
+                vector.applyMatrix4(m);
 
-                this->setXYZ(i, _vector.x, _vector.y, _vector.z);
+                setFromVector(i, vector);
             }
 
             return *this;
@@ -220,15 +345,25 @@ namespace threepp {
 
         TypedBufferAttribute<T>& applyNormalMatrix(const Matrix3& m) {
 
+            if constexpr (std::is_same_v<T, float>) {
+
+                if (this->itemSize_ >= 3) {
+
+                    simd::applyNormalMatrix(array_.data(), this->count_, this->itemSize_, m.elements.data());
+
+                    return *this;
+                }
+            }
+
+            Vector3 vector;
+
             for (int i = 0, l = this->count_; i < l; i++) {
 
-                _vector.x = this->getX(i);
-                _vector.y = this->getY(i);
-                _vector.z = this->getZ(i);
+                setFromBufferAttribute(vector, i);
 
-                _vector.applyNormalMatrix(m);
+                vector.applyNormalMatrix(m);
 
-                this->setXYZ(i, _vector.x, _vector.y, _vector.z);
+                setFromVector(i, vector);
             }
 
             return *this;
@@ -236,15 +371,25 @@ namespace threepp {
 
         TypedBufferAttribute<T>& transformDirection(const Matrix4& m) {
 
+            if constexpr (std::is_same_v<T, float>) {
+
+                if (this->itemSize_ >= 3) {
+
+                    simd::transformDirection(array_.data(), this->count_, this->itemSize_, m.elements.data());
+
+                    return *this;
+                }
+            }
+
+            Vector3 vector;
+
             for (int i = 0, l = this->count_; i < l; i++) {
 
-                _vector.x = this->getX(i);
-                _vector.y = this->getY(i);
-                _vector.z = this->getZ(i);
+                setFromBufferAttribute(vector, i);
 
-                _vector.transformDirection(m);
+                vector.transformDirection(m);
 
-                this->setXYZ(i, _vector.x, _vector.y, _vector.z);
+                setFromVector(i, vector);
             }
 
             return *this;
@@ -331,28 +476,46 @@ namespace threepp {
             return *this;
         }
 
-        void setFromBufferAttribute(Vector2& target, size_t index) const {
+        void setFromBufferAttribute(Vector2& target, size_t index) const final {
+
+            index *= this->itemSize_;
 
-            target.x = getX(index);
-            target.y = getY(index);
+            target.x = toFloat(array_[index]);
+            target.y = toFloat(array_[index + 1]);
         }
 
-        void setFromBufferAttribute(Vector3& target, size_t index) const {
+        void setFromBufferAttribute(Vector3& target, size_t index) const final {
 
-            target.x = getX(index);
-            target.y = getY(index);
-            target.z = getZ(index);
+            index *= this->itemSize_;
+
+            target.x = toFloat(array_[index]);
+            target.y = toFloat(array_[index + 1]);
+            target.z = toFloat(array_[index + 2]);
         }
 
-        void setFromBufferAttribute(Vector4& target, size_t index) const {
+        void setFromBufferAttribute(Vector4& target, size_t index) const final {
+
+            index *= this->itemSize_;
 
-            target.x = getX(index);
-            target.y = getY(index);
-            target.z = getZ(index);
-            target.w = getW(index);
+            target.x = toFloat(array_[index]);
+            target.y = toFloat(array_[index + 1]);
+            target.z = toFloat(array_[index + 2]);
+            target.w = toFloat(array_[index + 3]);
         }
 
-        void setFromBufferAttribute(Box3& target) const {
+        void setFromBufferAttribute(Box3& target) const final {
+
+            if constexpr (std::is_same_v<T, float>) {
+
+                if (this->itemSize_ >= 3) {
+
+                    float min[3], max[3];
+                    simd::computeBounds(array_.data(), this->count_, this->itemSize_, min, max);
+                    target.set(min[0], min[1], min[2], max[0], max[1], max[2]);
+
+                    return;
+                }
+            }
 
             auto minX = +Infinity<float>;
             auto minY = +Infinity<float>;
@@ -364,9 +527,9 @@ namespace threepp {
 
             for (int i = 0, l = count(); i < l; i++) {
 
-                const auto x = getX(i);
-                const auto y = getY(i);
-                const auto z = getZ(i);
+                const auto x = toFloat(getX(i));
+                const auto y = toFloat(getY(i));
+                const auto z = toFloat(getZ(i));
 
                 if (x < minX) minX = x;
                 if (y < minY) minY = y;
@@ -380,11 +543,20 @@ namespace threepp {
             target.set(minX, minY, minZ, maxX, maxY, maxZ);
         }
 
+        void setFromVector(size_t index, const Vector3& v) {
+
+            index *= this->itemSize_;
+
+            this->array_[index + 0] = fromFloat(v.x);
+            this->array_[index + 1] = fromFloat(v.y);
+            this->array_[index + 2] = fromFloat(v.z);
+        }
+
         void copy(const TypedBufferAttribute<T>& source) {
             BufferAttribute::copy(source);
 
             this->count_ = source.count_;
-            this->array_ = array_;
+            this->array_ = source.array_;
         }
 
         [[nodiscard]] std::unique_ptr<TypedBufferAttribute<T>> clone() const {
@@ -394,12 +566,23 @@ namespace threepp {
             return clone;
         }
 
+        [[nodiscard]] std::unique_ptr<BufferAttribute> cloneAttribute() const override {
+
+            return clone();
+        }
+
         template<class ArrayLike>
         static std::unique_ptr<TypedBufferAttribute<T>> create(const ArrayLike& array, int itemSize, bool normalized = false) {
 
             return create(array.begin(), array.end(), itemSize, normalized);
         }
 
+        // takes ownership of the data without copying
+        static std::unique_ptr<TypedBufferAttribute<T>> create(std::vector<T>&& array, int itemSize, bool normalized = false) {
+
+            return std::unique_ptr<TypedBufferAttribute<T>>(new TypedBufferAttribute<T>(std::move(array), itemSize, normalized));
+        }
+
         template<class It>
         static std::unique_ptr<TypedBufferAttribute<T>> create(It begin, It end, int itemSize, bool normalized = false) {
 
@@ -414,13 +597,59 @@ namespace threepp {
         TypedBufferAttribute(const std::vector<T>& array, int itemSize, bool normalized)
             : BufferAttribute(itemSize, normalized), array_(array), count_(array_.size() / itemSize) {}
 
+        TypedBufferAttribute(std::vector<T>&& array, int itemSize, bool normalized)
+            : BufferAttribute(itemSize, normalized), array_(std::move(array)), count_(array_.size() / itemSize) {}
+
     private:
         std::vector<T> array_;
         int count_{};
+
+        [[nodiscard]] float toFloat(T value) const {
+
+            if constexpr (std::is_integral_v<T>) {
+
+                if (this->normalized_) {
+
+                    constexpr auto max = static_cast<float>(std::numeric_limits<T>::max());
+
+                    if constexpr (std::is_signed_v<T>) {
+
+                        return std::max(static_cast<float>(value) / max, -1.f);
+
+                    } else {
+
+                        return static_cast<float>(value) / max;
+                    }
+                }
+            }
+
+            return static_cast<float>(value);
+        }
+
+        [[nodiscard]] T fromFloat(float value) const {
+
+            if constexpr (std::is_integral_v<T>) {
+
+                if (this->normalized_) {
+
+                    constexpr auto max = static_cast<float>(std::numeric_limits<T>::max());
+                    constexpr auto min = std::is_signed_v<T> ? -1.f : 0.f;
+
+                    return static_cast<T>(std::round(std::clamp(value, min, 1.f) * max));
+                }
+            }
+
+            return static_cast<T>(value);
+        }
     };
 
     typedef TypedBufferAttribute<unsigned int> IntBufferAttribute;
     typedef TypedBufferAttribute<float> FloatBufferAttribute;
+    typedef TypedBufferAttribute<Float16> HalfFloatBufferAttribute;
+    typedef TypedBufferAttribute<int8_t> Int8BufferAttribute;
+    typedef TypedBufferAttribute<uint8_t> Uint8BufferAttribute;
+    typedef TypedBufferAttribute<int16_t> Int16BufferAttribute;
+    typedef TypedBufferAttribute<uint16_t> Uint16BufferAttribute;
 
 
 }// namespace threepp
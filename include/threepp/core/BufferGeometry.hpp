@@ -9,6 +9,8 @@
 #include "threepp/core/EventDispatcher.hpp"
 
 #include "threepp/core/BufferAttribute.hpp"
+#include "threepp/core/MeshBVH.hpp"
+#include "threepp/core/ResourceSlot.hpp"
 
 #include <optional>
 #include <unordered_map>
@@ -22,6 +24,8 @@ namespace threepp {
 
         const std::string uuid;
 
+        const ResourceSlot slot{ResourceKind::Geometry};
+
         std::string name;
 
         std::vector<GeometryGroup> groups;
@@ -29,6 +33,8 @@ namespace threepp {
         std::optional<Box3> boundingBox;
         std::optional<Sphere> boundingSphere;
 
+        std::unique_ptr<MeshBVH> boundsTree;
+
         DrawRange drawRange{0, std::numeric_limits<int>::max() / 2};
 
         BufferGeometry();
@@ -48,10 +54,34 @@ namespace threepp {
         BufferGeometry& setIndex(const ArrayLike& index) {
 
             this->index_ = IntBufferAttribute::create(index, 1);
+            ++layoutVersion_;
 
             return *this;
         }
 
+        BufferGeometry& setIndex(std::vector<unsigned int>&& index) {
+
+            this->index_ = IntBufferAttribute::create(std::move(index), 1);
+            ++layoutVersion_;
+
+            return *this;
+        }
+
+        // untyped access, read through the float accessors when the component type does not matter
+        BufferAttribute* getAttribute(const std::string& name) {
+
+            if (!hasAttribute(name)) return nullptr;
+
+            return attributes_.at(name).get();
+        }
+
+        [[nodiscard]] const BufferAttribute* getAttribute(const std::string& name) const {
+
+            if (!hasAttribute(name)) return nullptr;
+
+            return attributes_.at(name).get();
+        }
+
         template<class T>
         TypedBufferAttribute<T>* getAttribute(const std::string& name) {
 
@@ -72,8 +102,13 @@ namespace threepp {
 
         void setAttribute(const std::string& name, std::unique_ptr<BufferAttribute> attribute);
 
+        void deleteAttribute(const std::string& name);
+
         [[nodiscard]] bool hasAttribute(const std::string& name) const;
 
+        // incremented whenever an attribute or the index is added, removed or replaced
+        [[nodiscard]] unsigned int layoutVersion() const;
+
         void addGroup(int start, int count, unsigned int materialIndex = 0);
 
         void clearGroups();
@@ -104,6 +139,10 @@ namespace threepp {
 
         void computeBoundingSphere();
 
+        MeshBVH& computeBoundsTree(const MeshBVH::Options& options = {});
+
+        void disposeBoundsTree();
+
         void normalizeNormals();
 
         [[nodiscard]] std::shared_ptr<BufferGeometry> toNonIndexed() const;
@@ -131,6 +170,7 @@ namespace threepp {
 
     private:
         bool disposed_ = false;
+        unsigned int layoutVersion_ = 0;
         std::unique_ptr<IntBufferAttribute> index_;
         std::unordered_map<std::string, std::unique_ptr<BufferAttribute>> attributes_;
 
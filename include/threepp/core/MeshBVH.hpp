@@ -0,0 +1,135 @@
+
+#ifndef THREEPP_MESHBVH_HPP
+#define THREEPP_MESHBVH_HPP
+
+#include "threepp/math/Box3.hpp"
+#include "threepp/math/Ray.hpp"
+
+#include "threepp/constants.hpp"
+
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace threepp {
+
+    class BufferGeometry;
+
+    struct BVHHit {
+
+        float distance;
+        Vector3 point;
+        unsigned int faceIndex;// triangle number in (non-)indexed buffer semantics
+    };
+
+    // A group of rays intersected together, one traversal of the tree serving all of them.
+    // Rays are stored per component, in the space of the geometry, and need not be normalized:
+    // distances are in units of the direction of each ray.
+    struct BVHRayPacket {
+
+        static constexpr unsigned int maxSize = 16;
+
+        unsigned int size = 0;
+
+        float origin[3][maxSize];
+        float direction[3][maxSize];
+        float near[maxSize];
+        float far[maxSize];// shrinks to the distance of the closest hit found
+
+        bool hit[maxSize];
+        unsigned int faceIndex[maxSize];
+    };
+
+    struct BVHOptions {
+
+        unsigned int maxLeafTriangles = 8;
+        unsigned int binCount = 16;
+    };
+
+    // Bounding volume hierarchy over the triangles of a BufferGeometry.
+    // Built with a binned SAH, stored as a flat node array and refitted in place
+    // when the position attribute changes.
+    class MeshBVH {
+
+    public:
+        using Options = BVHOptions;
+
+        explicit MeshBVH(const BufferGeometry& geometry, const Options& options = {});
+
+        MeshBVH(const BufferGeometry& geometry, unsigned int maxLeafTriangles)
+            : MeshBVH(geometry, Options{maxLeafTriangles}) {}
+
+        [[nodiscard]] const Box3& boundingBox() const;
+
+        [[nodiscard]] size_t nodeCount() const;
+
+        [[nodiscard]] size_t triangleCount() const;
+
+        // true if the topology or positions changed since the last build or refit.
+        // Mesh::raycast does not use a stale tree, as queries must not write.
+        [[nodiscard]] bool stale() const;
+
+        // rebuilds if the topology changed, refits if only positions changed.
+        // Returns true if anything was done.
+        bool update();
+
+        void build();
+
+        void refit();
+
+        // closest intersection along the ray within [near, far] (in ray units).
+        [[nodiscard]] std::optional<BVHHit> closestHit(const Ray& ray, int side = FrontSide, float near = 0, float far = std::numeric_limits<float>::infinity()) const;
+
+        // true if any triangle is hit within [near, far] (in ray units). Stops at the first hit found.
+        [[nodiscard]] bool anyHit(const Ray& ray, int side = FrontSide, float near = 0, float far = std::numeric_limits<float>::infinity()) const;
+
+        // intersects the rays of the packet within [near, far], setting hit, far and faceIndex of the rays that hit.
+        // A node is visited once for all rays passing through it. With anyHit, a ray stops at the first hit found.
+        void intersectPacket(BVHRayPacket& packet, int side = FrontSide, bool anyHit = false) const;
+
+        // invokes callback with the faceIndex of every triangle in a leaf whose bounds the ray passes through.
+        void intersectRay(const Ray& ray, const std::function<void(unsigned int)>& callback) const;
+
+        // invokes callback with the faceIndex of every triangle in a leaf whose bounds intersect the box.
+        void intersectBox(const Box3& box, const std::function<void(unsigned int)>& callback) const;
+
+    private:
+        struct Node {
+
+            float min[3];
+            float max[3];
+            // leaf: first entry in triangles_, inner: index of the first child (the second child follows it)
+            unsigned int offset;
+            unsigned int count;// 0 for inner nodes
+            unsigned int axis;
+        };
+
+        const BufferGeometry& geometry_;
+        Options options_;
+
+        std::vector<Node> nodes_;
+        std::vector<unsigned int> triangles_;
+
+        Box3 boundingBox_;
+
+        const void* positionRef_ = nullptr;
+        const void* indexRef_ = nullptr;
+        unsigned int positionVersion_ = 0;
+        unsigned int indexVersion_ = 0;
+        int positionCount_ = 0;
+        int indexCount_ = 0;
+
+        void snapshotVersions();
+
+        [[nodiscard]] bool topologyChanged() const;
+
+        void getTriangle(unsigned int tri, unsigned int& a, unsigned int& b, unsigned int& c) const;
+
+        template<class Callback>
+        void traverse(const Ray& ray, float near, float& far, bool ordered, Callback&& callback) const;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_MESHBVH_HPP
@@ -14,6 +14,8 @@
 
 #include "misc.hpp"
 
+#include <array>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -37,8 +39,6 @@ namespace threepp {
 
         unsigned int id{_object3Did++};
 
-        const std::string uuid;
-
         std::string name;
 
         Object3D* parent = nullptr;
@@ -54,8 +54,8 @@ namespace threepp {
         Matrix4 modelViewMatrix;
         Matrix3 normalMatrix;
 
-        std::shared_ptr<Matrix4> matrix;
-        std::shared_ptr<Matrix4> matrixWorld;
+        Matrix4 matrix;
+        Matrix4 matrixWorld;
 
         bool matrixAutoUpdate = defaultMatrixAutoUpdate;
         bool matrixWorldNeedsUpdate = false;
@@ -74,11 +74,17 @@ namespace threepp {
 
         Object3D();
 
+        Object3D(const Object3D&) = delete;
+        Object3D& operator=(const Object3D&) = delete;
+
         [[nodiscard]] virtual std::string type() const {
 
             return "Object3D";
         }
 
+        // generated on first use
+        [[nodiscard]] const std::string& uuid() const;
+
         void applyMatrix4(const Matrix4& matrix);
 
         Object3D& applyQuaternion(const Quaternion& q);
@@ -160,6 +166,11 @@ namespace threepp {
 
         virtual void updateMatrixWorld(bool force = false);
 
+        // Same result as updateMatrixWorld, but local matrices are only recomposed when position,
+        // quaternion or scale changed since they were last composed, world matrices only when the local
+        // or parent world matrix changed, and large subtrees are updated in parallel on utils::ThreadPool::instance().
+        void updateMatrixWorldIncremental(bool force = false);
+
         virtual void updateWorldMatrix(std::optional<bool> updateParents = std::nullopt, std::optional<bool> updateChildren = std::nullopt);
 
         static std::shared_ptr<Object3D> create() {
@@ -205,8 +216,58 @@ namespace threepp {
 
         ~Object3D() override;
 
+    protected:
+        // Called around the update of the world matrix by updateMatrixWorld and TransformSystem,
+        // so objects can adjust their local transform first or derive state from the result.
+        virtual void beforeUpdateMatrixWorld() {}
+
+        virtual void afterUpdateMatrixWorld() {}
+
+        // Object whose world matrix beforeUpdateMatrixWorld copies into the local matrix of this one, if any.
+        // TransformSystem and updateMatrixWorldIncremental update this object once the world matrices of the others
+        // are computed, so the copy is not one update behind and is never read while another thread writes it.
+        [[nodiscard]] virtual const Object3D* matrixWorldSource() const {
+
+            return nullptr;
+        }
+
     private:
+        // Keeps rotation and quaternion in sync. Writing one marks the other stale,
+        // which is then recomputed from it when next read.
+        class RotationSync: public float_view::observer {
+
+        public:
+            RotationSync(Object3D& object, bool rotation)
+                : object_(object), rotation_(rotation) {}
+
+        protected:
+            void update() override;
+
+            void changed() override;
+
+        private:
+            Object3D& object_;
+            // whether this observes rotation, rather than quaternion
+            bool rotation_;
+        };
+
+        RotationSync rotationSync_{*this, true};
+        RotationSync quaternionSync_{*this, false};
+
+        mutable std::atomic<const std::string*> uuid_{nullptr};
+
+        // position, quaternion and scale as of the last updateMatrix()
+        std::array<float, 10> composedTransform_{};
+        // number of nodes in this subtree, as seen by the last incremental update
+        unsigned int subtreeSize_{1};
+
+        bool transformChanged() const;
+
+        void updateChildrenMatrixWorld(bool force);
+
         inline static unsigned int _object3Did{0};
+
+        friend class TransformSystem;
     };
 
 }// namespace threepp
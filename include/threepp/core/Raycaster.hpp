@@ -32,6 +32,8 @@ namespace threepp {
         std::optional<float> distanceToRay;
     };
 
+    // Raycasting only reads the scene once geometry bounds are computed, so separate Raycasters may query
+    // the same scene from several threads. Bounds trees are used while up to date, see MeshBVH::update.
     class Raycaster {
 
     public:
@@ -48,6 +50,10 @@ namespace threepp {
         };
         Params params;
 
+        // when set, meshes report only their closest intersection.
+        // Meshes whose geometry has a boundsTree can then stop at the first hit instead of collecting all.
+        bool firstHitOnly = false;
+
         explicit Raycaster(const Vector3& origin = Vector3(), const Vector3& direction = Vector3(), float near = 0, float far = std::numeric_limits<float>::infinity())
             : near(near), far(far), ray(origin, direction), camera(nullptr) {}
 
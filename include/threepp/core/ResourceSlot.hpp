@@ -0,0 +1,73 @@
+
+#ifndef THREEPP_RESOURCESLOT_HPP
+#define THREEPP_RESOURCESLOT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace threepp {
+
+    enum class ResourceKind {
+        Texture,
+        Material,
+        RenderTarget,
+        Geometry
+    };
+
+    struct ResourceHandle {
+
+        uint32_t index = 0;
+        uint32_t generation = 0;// 0 is never handed out
+
+        bool operator==(const ResourceHandle& other) const {
+
+            return index == other.index && generation == other.generation;
+        }
+
+        bool operator!=(const ResourceHandle& other) const {
+
+            return !(*this == other);
+        }
+    };
+
+    // Dense integer identity of a renderer resource, used by the renderer to index its state arrays.
+    // Slots of destroyed owners are recycled with a new generation, so stale state is never picked up.
+    // A copy acquires a slot of its own, copied objects never share renderer state.
+    class ResourceSlot {
+
+    public:
+        explicit ResourceSlot(ResourceKind kind);
+
+        ResourceSlot(const ResourceSlot& other);
+
+        // an assigned slot would either keep its identity or share another one, neither is a copy
+        ResourceSlot& operator=(const ResourceSlot&) = delete;
+
+        [[nodiscard]] ResourceKind kind() const {
+
+            return kind_;
+        }
+
+        [[nodiscard]] const ResourceHandle& handle() const {
+
+            return handle_;
+        }
+
+        [[nodiscard]] uint32_t index() const {
+
+            return handle_.index;
+        }
+
+        // number of slots in use for the given kind
+        static size_t count(ResourceKind kind);
+
+        ~ResourceSlot();
+
+    private:
+        ResourceKind kind_;
+        ResourceHandle handle_;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_RESOURCESLOT_HPP
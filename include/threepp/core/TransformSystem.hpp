@@ -0,0 +1,134 @@
+
+#ifndef THREEPP_TRANSFORMSYSTEM_HPP
+#define THREEPP_TRANSFORMSYSTEM_HPP
+
+#include "threepp/math/Matrix4.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace threepp {
+
+    class Object3D;
+
+    // Keeps the transforms of a scene graph in contiguous arrays sorted by depth, so parents come before
+    // their children: the position, quaternion and scale of every object, one array per component,
+    // its local and world matrix, the handle of its parent and which of its matrices changed.
+    //
+    // update() replaces root.updateMatrixWorld(). It gathers the local transforms of all objects,
+    // computes the world matrices in a sweep over the arrays, one depth level after the other with each
+    // level split into parallel ranges, and writes the changed matrices back to the objects. Like
+    // updateMatrixWorldIncremental, only world matrices depending on a changed transform are recomputed.
+    //
+    // Objects remain the source of truth for local transforms and the hierarchy. Changes to the hierarchy
+    // are detected by update(), which then rebuilds the arrays and hands out new handles. Overrides of
+    // updateMatrixWorld are not called, the hooks around it are, all on the calling thread. Objects following
+    // the world matrix of another one, see Object3D::matrixWorldSource, take it once it has been computed.
+    class TransformSystem {
+
+    public:
+        // index of an object in the arrays, valid until the arrays are rebuilt
+        using Handle = unsigned int;
+
+        static constexpr Handle invalidHandle = std::numeric_limits<Handle>::max();
+
+        explicit TransformSystem(Object3D& root);
+
+        void update(bool force = false);
+
+        // re-reads the hierarchy below root, done by update() when it has changed
+        void rebuild();
+
+        [[nodiscard]] Object3D& root() const {
+
+            return root_;
+        }
+
+        [[nodiscard]] size_t size() const {
+
+            return objects_.size();
+        }
+
+        [[nodiscard]] Handle handle(const Object3D& object) const;
+
+        [[nodiscard]] Object3D& object(Handle handle) const {
+
+            return *objects_[handle];
+        }
+
+        // invalidHandle for the root
+        [[nodiscard]] Handle parent(Handle handle) const {
+
+            return parents_[handle];
+        }
+
+        [[nodiscard]] const Matrix4& matrixWorld(Handle handle) const {
+
+            return matrixWorlds_[handle];
+        }
+
+        // world matrices of all objects, indexed by handle
+        [[nodiscard]] const std::vector<Matrix4>& matrixWorlds() const {
+
+            return matrixWorlds_;
+        }
+
+        // handles of depth level i are levelOffsets()[i] up to levelOffsets()[i + 1]
+        [[nodiscard]] const std::vector<Handle>& levelOffsets() const {
+
+            return levelOffsets_;
+        }
+
+        // number of world matrices recomputed by the last update
+        [[nodiscard]] size_t updatedCount() const {
+
+            return updatedCount_;
+        }
+
+    private:
+        Object3D& root_;
+
+        std::vector<Object3D*> objects_;
+        // keeps objects removed from the graph alive until the arrays are rebuilt
+        std::vector<std::shared_ptr<Object3D>> retained_;
+        std::unordered_map<const Object3D*, Handle> handles_;
+
+        std::vector<Handle> parents_;
+        std::vector<unsigned int> childCounts_;
+        std::vector<Handle> levelOffsets_;
+        // objects following the world matrix of a source in the arrays, and the handle of that source
+        std::vector<std::pair<Handle, Handle>> followers_;
+
+        std::vector<float> positionX_, positionY_, positionZ_;
+        std::vector<float> quaternionX_, quaternionY_, quaternionZ_, quaternionW_;
+        std::vector<float> scaleX_, scaleY_, scaleZ_;
+
+        std::vector<Matrix4> matrices_;
+        std::vector<Matrix4> matrixWorlds_;
+        std::vector<std::uint8_t> dirty_;
+
+        Matrix4 rootParentMatrixWorld_;
+        size_t updatedCount_ = 0;
+        bool rebuilt_ = false;
+
+        // calls the hooks before the update, false if the hierarchy changed since the last rebuild
+        bool prepare();
+
+        // reads the local transforms of all objects, marking those that changed
+        void gather(bool force);
+
+        void sweep();
+
+        // sets the local matrix of followers to the world matrix of their source, then sweeps their subtrees again
+        void follow();
+
+        void scatter();
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_TRANSFORMSYSTEM_HPP
@@ -129,7 +129,7 @@ namespace threepp {
         BulletWrapper& addRigidbody(const std::shared_ptr<RbWrapper>& rb, Object3D& obj) {
 
             obj.updateMatrixWorld();
-            auto t = convert(*obj.matrixWorld);
+            auto t = convert(obj.matrixWorld);
             rb->state->setWorldTransform(t);
             rb->body->setWorldTransform(t);
 
@@ -10,11 +10,11 @@ namespace threepp {
     class Box3Helper: public LineSegments {
 
     public:
-        void updateMatrixWorld(bool force) override;
-
         static std::shared_ptr<Box3Helper> create(const Box3& box, const Color& color = 0xffff00);
 
     protected:
+        void beforeUpdateMatrixWorld() override;
+
         Box3Helper(const Box3& box, const Color& color);
 
     private:
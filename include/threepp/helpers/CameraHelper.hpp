@@ -19,6 +19,10 @@ namespace threepp {
         void update();
 
     protected:
+        void beforeUpdateMatrixWorld() override;
+
+        [[nodiscard]] const Object3D* matrixWorldSource() const override;
+
         Camera _camera;
         std::shared_ptr<Camera> camera;
         std::unordered_map<std::string, std::vector<size_t>> pointMap;
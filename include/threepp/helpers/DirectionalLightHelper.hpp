@@ -20,6 +20,10 @@ namespace threepp {
                 std::optional<Color> color = std::nullopt);
 
     protected:
+        void beforeUpdateMatrixWorld() override;
+
+        [[nodiscard]] const Object3D* matrixWorldSource() const override;
+
         float size;
         std::optional<Color> color;
 
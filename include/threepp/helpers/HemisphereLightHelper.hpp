@@ -29,6 +29,11 @@ namespace threepp {
 
         ~HemisphereLightHelper() override;
 
+    protected:
+        void beforeUpdateMatrixWorld() override;
+
+        [[nodiscard]] const Object3D* matrixWorldSource() const override;
+
     private:
         struct Impl;
         std::unique_ptr<Impl> pimpl_;
@@ -15,11 +15,11 @@ namespace threepp {
         Plane plane;
         float size;
 
-        void updateMatrixWorld(bool force) override;
-
         static std::shared_ptr<PlaneHelper> create(const Plane& plane, float size = 1, const Color& color = 0xffff00);
 
     protected:
+        void beforeUpdateMatrixWorld() override;
+
         PlaneHelper(const Plane& plane, float size, const Color& color);
 
     private:
@@ -17,6 +17,10 @@ namespace threepp {
         static std::shared_ptr<PointLightHelper> create(const std::shared_ptr<PointLight>& light, float sphereSize, std::optional<Color> color = std::nullopt);
 
     protected:
+        void beforeUpdateMatrixWorld() override;
+
+        [[nodiscard]] const Object3D* matrixWorldSource() const override;
+
         std::optional<Color> color;
         std::shared_ptr<PointLight> light;
 
@@ -21,6 +21,10 @@ namespace threepp {
         static std::shared_ptr<SpotLightHelper> create(const std::shared_ptr<SpotLight>& light, std::optional<Color> color = std::nullopt);
 
     protected:
+        void beforeUpdateMatrixWorld() override;
+
+        [[nodiscard]] const Object3D* matrixWorldSource() const override;
+
         std::shared_ptr<SpotLight> light;
         std::optional<Color> color;
 
@@ -34,6 +34,10 @@ namespace threepp {
         bool autoUpdate = true;
         bool needsUpdate = false;
 
+        // keep the depth of static casters in a cached layer that is only re-rendered when one of
+        // them or the light changes, casters that move are drawn on top of it every frame
+        bool cacheStaticCasters = false;
+
         [[nodiscard]] size_t getViewportCount() const {
 
             return this->_viewports.size();
@@ -50,12 +54,12 @@ namespace threepp {
             auto& shadowMatrix = this->matrix;
 
             Vector3 _lightPositionWorld{};
-            _lightPositionWorld.setFromMatrixPosition(*light->matrixWorld);
+            _lightPositionWorld.setFromMatrixPosition(light->matrixWorld);
             shadowCamera->position.copy(_lightPositionWorld);
 
             Vector3 _lookTarget{};
             auto lightWithTarget = dynamic_cast<LightWithTarget*>(light);
-            _lookTarget.setFromMatrixPosition(*lightWithTarget->target->matrixWorld);
+            _lookTarget.setFromMatrixPosition(lightWithTarget->target->matrixWorld);
             shadowCamera->lookAt(_lookTarget);
             shadowCamera->updateMatrixWorld();
 
@@ -3,6 +3,7 @@
 #define THREEPP_OBJLOADER_HPP
 
 #include <filesystem>
+#include <functional>
 #include <memory>
 
 #include "threepp/objects/Group.hpp"
@@ -16,6 +17,13 @@ namespace threepp {
     public:
         bool useCache = true;
 
+        // memory maps the file and parses it in parallel chunks
+        bool fastMode = false;
+
+        // load progress in [0, 1] when fastMode is set.
+        // May be invoked from worker threads, calls are serialized.
+        std::function<void(float)> onProgress;
+
         OBJLoader();
 
         std::shared_ptr<Group> load(const std::filesystem::path& path, bool tryLoadMtl = true);
@@ -8,9 +8,13 @@
 
 namespace threepp {
 
+    // Loads binary and ASCII STL files, the format is detected from the file content.
     class STLLoader {
 
     public:
+        // merge vertices with identical position and normal into an indexed geometry
+        bool weldVertices = false;
+
         [[nodiscard]] std::shared_ptr<BufferGeometry> load(const std::filesystem::path& path) const;
     };
 
@@ -5,6 +5,7 @@
 
 #include "threepp/constants.hpp"
 #include "threepp/core/EventDispatcher.hpp"
+#include "threepp/core/ResourceSlot.hpp"
 #include "threepp/core/Uniform.hpp"
 #include "threepp/math/Plane.hpp"
 
@@ -20,6 +21,8 @@ namespace threepp {
     public:
         const unsigned int id = materialId++;
 
+        const ResourceSlot slot{ResourceKind::Material};
+
         std::string name;
 
         bool fog = true;
@@ -5,6 +5,9 @@
 
 #include "float_view.hpp"
 
+#include <memory>
+#include <optional>
+
 namespace threepp {
 
     class Vector3;
@@ -32,6 +35,11 @@ namespace threepp {
 
         explicit Euler(float x = 0, float y = 0, float z = 0, RotationOrders order = default_order);
 
+        // copies the angles and order, the copy is not observed
+        Euler(const Euler& e);
+
+        Euler& operator=(const Euler& e);
+
         [[nodiscard]] RotationOrders getOrder() const {
 
             return order_;
@@ -39,8 +47,9 @@ namespace threepp {
 
         void setOrder(RotationOrders value) {
 
+            this->sync();
             this->order_ = value;
-            onChangeCallback_();
+            this->changed();
         }
 
         Euler& set(float x, float y, float z, const std::optional<RotationOrders>& order = std::nullopt);
@@ -62,7 +71,7 @@ namespace threepp {
             this->y.value_ = array[offset + 1];
             this->z.value_ = array[offset + 2];
 
-            this->onChangeCallback_();
+            this->changed();
 
             return *this;
         }
@@ -79,7 +88,20 @@ namespace threepp {
     private:
         RotationOrders order_ = default_order;
 
-        std::function<void()> onChangeCallback_ = [] {};
+        std::unique_ptr<float_view::observer> callback_;
+
+        // attaches observer to x, y and z
+        void observe(float_view::observer* observer);
+
+        void sync() const {
+
+            x.sync();
+        }
+
+        void changed() {
+
+            x.notify();
+        }
 
         friend class Object3D;
         friend class Quaternion;
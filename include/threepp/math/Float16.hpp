@@ -0,0 +1,99 @@
+
+#ifndef THREEPP_FLOAT16_HPP
+#define THREEPP_FLOAT16_HPP
+
+#include <cstdint>
+#include <cstring>
+
+namespace threepp {
+
+    // IEEE 754 binary16 storage type, used for half float vertex attributes
+    struct Float16 {
+
+        uint16_t bits{};
+
+        Float16() = default;
+
+        Float16(float value): bits(toBits(value)) {}
+
+        operator float() const {
+
+            return toFloat(bits);
+        }
+
+        static Float16 fromBits(uint16_t bits) {
+
+            Float16 h;
+            h.bits = bits;
+            return h;
+        }
+
+        // round to nearest even, overflow saturates to infinity
+        static uint16_t toBits(float value) {
+
+            constexpr uint32_t f32infty = 255u << 23;
+            constexpr uint32_t f16max = (127u + 16u) << 23;
+            constexpr uint32_t denormMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+            uint32_t f;
+            std::memcpy(&f, &value, sizeof(f));
+
+            const uint32_t sign = f & 0x80000000u;
+            f ^= sign;
+
+            uint16_t o;
+            if (f >= f16max) {
+
+                o = f > f32infty ? 0x7e00 : 0x7c00;
+
+            } else if (f < (113u << 23)) {
+
+                float v, magic;
+                std::memcpy(&v, &f, sizeof(v));
+                std::memcpy(&magic, &denormMagic, sizeof(magic));
+                v += magic;
+                std::memcpy(&f, &v, sizeof(f));
+                o = static_cast<uint16_t>(f - denormMagic);
+
+            } else {
+
+                const uint32_t mantOdd = (f >> 13) & 1u;
+                f += ((15u - 127u) << 23) + 0xfffu;
+                f += mantOdd;
+                o = static_cast<uint16_t>(f >> 13);
+            }
+
+            return static_cast<uint16_t>(o | (sign >> 16));
+        }
+
+        static float toFloat(uint16_t h) {
+
+            const uint32_t sign = static_cast<uint32_t>(h & 0x8000u) << 16;
+            const uint32_t exponent = (h >> 10) & 0x1fu;
+            const uint32_t mantissa = h & 0x3ffu;
+
+            uint32_t f;
+            if (exponent == 0) {
+
+                float v = static_cast<float>(mantissa) * (1.f / 16777216.f);
+                std::memcpy(&f, &v, sizeof(f));
+                f |= sign;
+
+            } else if (exponent == 31) {
+
+                f = sign | 0x7f800000u | (mantissa << 13);
+
+            } else {
+
+                f = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+            }
+
+            float result;
+            std::memcpy(&result, &f, sizeof(result));
+            return result;
+        }
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_FLOAT16_HPP
@@ -6,6 +6,7 @@
 #include "threepp/math/float_view.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace threepp {
 
@@ -23,6 +24,11 @@ namespace threepp {
 
         explicit Quaternion(float x = 0, float y = 0, float z = 0, float w = 1);
 
+        // copies the components, the copy is not observed
+        Quaternion(const Quaternion& q);
+
+        Quaternion& operator=(const Quaternion& q);
+
         float operator[](unsigned int index) const;
 
         Quaternion& set(float x, float y, float z, float w);
@@ -81,7 +87,7 @@ namespace threepp {
             this->z.value_ = array[offset + 2];
             this->w.value_ = array[offset + 3];
 
-            this->onChangeCallback_();
+            this->changed();
 
             return *this;
         }
@@ -101,7 +107,22 @@ namespace threepp {
         }
 
     private:
-        std::function<void()> onChangeCallback_ = [] {};
+        std::unique_ptr<float_view::observer> callback_;
+
+        // attaches observer to x, y, z and w
+        void observe(float_view::observer* observer);
+
+        void sync() const {
+
+            x.sync();
+        }
+
+        void changed() {
+
+            x.notify();
+        }
+
+        friend class Object3D;
     };
 
 }// namespace threepp
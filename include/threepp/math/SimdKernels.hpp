@@ -0,0 +1,66 @@
+
+#ifndef THREEPP_SIMDKERNELS_HPP
+#define THREEPP_SIMDKERNELS_HPP
+
+#include <cstddef>
+
+// Math kernels over raw float arrays, implemented for several instruction sets.
+// The best set supported by both the build and the CPU is selected at runtime.
+// Results match the scalar Matrix4/Vector3 code up to rounding.
+namespace threepp::simd {
+
+    enum class InstructionSet {
+        Scalar,
+        SSE,
+        AVX2,
+        NEON
+    };
+
+    // the best instruction set the kernels are built for and the CPU supports
+    InstructionSet detectInstructionSet();
+
+    // the instruction set the kernels currently use, detectInstructionSet() unless overridden
+    InstructionSet instructionSet();
+
+    // selects the kernels of set, or of the best supported set below it. Meant for testing and benchmarking.
+    void setInstructionSet(InstructionSet set);
+
+    const char* name(InstructionSet set);
+
+    // out = a * b for column major 4x4 matrices as stored in Matrix4::elements. out may alias a or b.
+    void multiplyMatrices(const float* a, const float* b, float* out);
+
+    // out = inverse of m, or all zeros if m is singular. out may alias m.
+    void invert(const float* m, float* out);
+
+    // The array kernels work in place on count vectors stride floats apart (stride >= 3),
+    // e.g. the array of a BufferAttribute with stride = itemSize. Only x, y and z of each vector are touched.
+
+    // as Vector3::applyMatrix4, m is a column major 4x4 matrix
+    void applyMatrix4(float* array, size_t count, size_t stride, const float* m);
+
+    // as Vector3::applyMatrix3, m is a column major 3x3 matrix
+    void applyMatrix3(float* array, size_t count, size_t stride, const float* m);
+
+    // as Vector3::applyNormalMatrix, m is a column major 3x3 matrix
+    void applyNormalMatrix(float* array, size_t count, size_t stride, const float* m);
+
+    // as Vector3::transformDirection, m is a column major 4x4 matrix
+    void transformDirection(float* array, size_t count, size_t stride, const float* m);
+
+    // as Vector3::normalize
+    void normalize(float* array, size_t count, size_t stride);
+
+    // component wise min and max of the vectors, skipping NaN components as Box3::setFromBufferAttribute does.
+    // min and max are left at +/-Infinity when there are no vectors.
+    void computeBounds(const float* array, size_t count, size_t stride, float* min, float* max);
+
+    // Spheres are count runs of 4 floats, center x, y, z and radius. Replaces the radius of each by the smallest
+    // signed distance of its center to the planes, given as normal x, y, z and constant, plus the radius.
+    // The result is >= 0 when the sphere intersects the space in front of every plane, as in Frustum::intersectsSphere.
+    // Planes at a NaN distance are skipped.
+    void planeDistances(float* spheres, size_t count, const float* planes, size_t planeCount);
+
+}// namespace threepp::simd
+
+#endif//THREEPP_SIMDKERNELS_HPP
@@ -2,8 +2,8 @@
 #ifndef THREEPP_FLOAT_VIEW_HPP
 #define THREEPP_FLOAT_VIEW_HPP
 
+#include <algorithm>
 #include <functional>
-#include <optional>
 #include <ostream>
 #include <utility>
 
@@ -12,145 +12,182 @@ namespace threepp {
     class float_view {
 
     public:
+        // Told about the float_views of an Euler or Quaternion it is attached to.
+        // Lets values be computed lazily: while stale, the views call update() before they are read or written.
+        class observer {
+
+        public:
+            virtual ~observer() = default;
+
+        protected:
+            bool stale_ = false;
+
+            // brings the values of the views up to date, clearing stale_
+            virtual void update() {}
+
+            // called after the values of the views were written
+            virtual void changed() = 0;
+
+            friend class float_view;
+        };
+
+        // observer calling a function on every change, see Euler::_onChange and Quaternion::_onChange
+        class callback_observer: public observer {
+
+        public:
+            explicit callback_observer(std::function<void()> f)
+                : f_(std::move(f)) {}
+
+        protected:
+            void changed() override {
+
+                f_();
+            }
+
+        private:
+            std::function<void()> f_;
+        };
+
         float_view(float value = 0)
             : value_(value) {}
 
+        // copies the value only, the copy is not observed
+        float_view(const float_view& other)
+            : value_(other()) {}
+
+        inline float_view& operator=(const float_view& other) {
+
+            return *this = other();
+        }
+
         inline float operator()() const {
 
+            sync();
+
             return value_;
         }
 
         inline float_view& operator=(float v) {
 
+            sync();
             this->value_ = v;
-            if (f_) f_.value()();
+            notify();
 
             return *this;
         }
 
         inline float operator*(float f) const {
 
-            return value_ * f;
+            return (*this)() * f;
         }
 
         inline float operator*(const float_view& f) const {
 
-            return value_ * f.value_;
+            return (*this)() * f();
         }
 
         inline float_view& operator*=(float f) {
 
-            value_ *= f;
-            if (f_) f_.value()();
-
-            return *this;
+            return *this = (*this)() * f;
         }
 
         inline float operator/(float f) const {
 
-            return value_ / f;
+            return (*this)() / f;
         }
 
         inline float_view& operator/=(float f) {
 
-            value_ /= f;
-            if (f_) f_.value()();
-
-            return *this;
+            return *this = (*this)() / f;
         }
 
         inline float operator+(float f) const {
 
-            return value_ + f;
+            return (*this)() + f;
         }
 
         inline float operator+(const float_view& f) const {
 
-            return value_ + f.value_;
+            return (*this)() + f();
         }
 
         inline float_view& operator+=(float f) {
 
-            value_ += f;
-            if (f_) f_.value()();
-
-            return *this;
+            return *this = (*this)() + f;
         }
 
         inline float operator-(float f) const {
 
-            return value_ - f;
+            return (*this)() - f;
         }
 
         inline float operator-(const float_view& f) const {
 
-            return value_ - f.value_;
+            return (*this)() - f();
         }
 
         inline float_view& operator-=(float f) {
 
-            value_ -= f;
-            if (f_) f_.value()();
-
-            return *this;
+            return *this = (*this)() - f;
         }
 
         inline float_view& operator++() {
 
-            value_++;
-            if (f_) f_.value()();
-
-            return *this;
+            return *this = (*this)() + 1;
         }
 
         inline float_view& operator--() {
 
-            value_--;
-            if (f_) f_.value()();
-
-            return *this;
+            return *this = (*this)() - 1;
         }
 
         inline bool operator==(float other) const {
 
-            return value_ == other;
+            return (*this)() == other;
         }
 
         inline bool operator!=(float other) const {
 
-            return value_ != other;
+            return (*this)() != other;
         }
 
         inline bool operator==(const float_view& other) const {
 
-            return value_ == other.value_;
+            return (*this)() == other();
         }
 
         inline bool operator!=(const float_view& other) const {
 
-            return value_ != other.value_;
-        }
-
-        inline constexpr float_view& clamp(float min, float max) {
-
-            value_ = std::max(min, std::min(max, value_));
-
-            return *this;
+            return (*this)() != other();
         }
 
-        void setCallback(std::function<void()> f) {
+        inline float_view& clamp(float min, float max) {
 
-            f_ = std::move(f);
+            return *this = std::max(min, std::min(max, (*this)()));
         }
 
         friend std::ostream& operator<<(std::ostream& os, const float_view& f) {
-            os << f.value_;
+            os << f();
             return os;
         }
 
     private:
         float value_;
-        std::optional<std::function<void()>> f_;
+        observer* observer_ = nullptr;
+
+        inline void sync() const {
+
+            if (observer_ && observer_->stale_) observer_->update();
+        }
+
+        inline void notify() const {
+
+            if (observer_) {
+
+                observer_->stale_ = false;
+                observer_->changed();
+            }
+        }
 
         friend class Euler;
         friend class Quaternion;
@@ -11,15 +11,28 @@ namespace threepp {
 
     class Raycaster;
 
+    struct InstanceLevel {
+
+        float distance;
+        std::shared_ptr<BufferGeometry> geometry;
+    };
+
     class InstancedMesh: public Mesh {
 
     public:
-        const int count;
+        // number of instances drawn, at most capacity()
+        int count;
         std::unique_ptr<FloatBufferAttribute> instanceMatrix;
         std::unique_ptr<FloatBufferAttribute> instanceColor = nullptr;
 
+        // when rendered, draws only the instances whose bounds intersect the camera frustum
+        bool perInstanceFrustumCulled = false;
+
         [[nodiscard]] std::string type() const override;
 
+        // number of instances the instance buffers were created for
+        [[nodiscard]] int capacity() const;
+
         void getColorAt(size_t index, Color& color) const;
 
         void getMatrixAt(size_t index, Matrix4& matrix) const;
@@ -28,6 +41,12 @@ namespace threepp {
 
         void setMatrixAt(size_t index, const Matrix4& matrix) const;
 
+        // instances at least distance away from the camera are drawn with geometry instead, see LOD::addLevel.
+        // The geometry of the mesh is used below the closest level. At most 254 levels can be added.
+        InstancedMesh& addLevel(std::shared_ptr<BufferGeometry> geometry, float distance);
+
+        [[nodiscard]] const std::vector<InstanceLevel>& levels() const;
+
         void dispose();
 
         void raycast(Raycaster& raycaster, std::vector<Intersection>& intersects) override;
@@ -40,6 +59,9 @@ namespace threepp {
 
     protected:
         InstancedMesh(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material, unsigned int count);
+
+    private:
+        std::vector<InstanceLevel> levels_;
     };
 
 }// namespace threepp
@@ -0,0 +1,57 @@
+
+#ifndef THREEPP_GLREADBACK_HPP
+#define THREEPP_GLREADBACK_HPP
+
+#include "threepp/textures/Image.hpp"
+
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace threepp {
+
+    class GLRenderer;
+    class GLRenderTarget;
+
+    // Streams frames back from the GPU through a ring of pixel buffer objects.
+    // read() only queues the copy, the pixels are mapped once the copy's fence has signalled,
+    // so frame N+1 is rendered while frame N is still in flight.
+    // Must be destroyed while the GL context it was used with is still current.
+    class GLReadback {
+
+    public:
+        // receives completed frames as RGBA images with the bottom row first.
+        // When unset, frames are queued and retrieved with nextFrame()
+        std::function<void(Image&)> onFrame;
+
+        explicit GLReadback(GLRenderer& renderer, unsigned int ringSize = 3);
+
+        GLReadback(const GLReadback&) = delete;
+        GLReadback& operator=(const GLReadback&) = delete;
+
+        // queues a copy of the render target, or of the default framebuffer when null.
+        // Blocks on the oldest copy only when every buffer in the ring is still in flight
+        void read(const std::shared_ptr<GLRenderTarget>& renderTarget = nullptr);
+
+        // delivers the copies that have completed without blocking, returns how many were delivered
+        size_t poll();
+
+        // blocks until every queued copy has been delivered
+        void flush();
+
+        // pops the oldest delivered frame, only used when onFrame is unset
+        std::optional<Image> nextFrame();
+
+        // number of copies still in flight
+        [[nodiscard]] size_t pending() const;
+
+        ~GLReadback();
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> pimpl_;
+    };
+
+}// namespace threepp
+
+#endif//THREEPP_GLREADBACK_HPP
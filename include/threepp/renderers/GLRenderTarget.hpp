@@ -4,6 +4,7 @@
 #define THREEPPGLRENDERTARGETHPP
 
 #include "threepp/core/EventDispatcher.hpp"
+#include "threepp/core/ResourceSlot.hpp"
 
 #include "threepp/textures/DepthTexture.hpp"
 #include "threepp/textures/Texture.hpp"
@@ -37,6 +38,8 @@ namespace threepp {
 
         const std::string uuid;
 
+        const ResourceSlot slot{ResourceKind::RenderTarget};
+
         unsigned int width;
         unsigned int height;
         unsigned int depth = 1;
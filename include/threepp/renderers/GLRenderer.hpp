@@ -20,6 +20,7 @@
 
 #include "TextHandle.hpp"
 
+#include <filesystem>
 #include <memory>
 #include <vector>
 
@@ -52,6 +53,12 @@ namespace threepp {
 
         bool sortObjects = true;
 
+        // merges opaque draws of meshes sharing geometry, material and group into instanced draws
+        bool autoInstancing = false;
+
+        // fewest draws merged into one instanced draw
+        unsigned int autoInstancingThreshold = 2;
+
         // user-defined clipping
 
         std::vector<Plane> clippingPlanes;
@@ -73,6 +80,9 @@ namespace threepp {
 
         bool checkShaderErrors = false;
 
+        // linked program binaries are stored here and reused on later runs, empty disables the cache
+        std::filesystem::path programCacheDirectory;
+
         //Microstrain edit to remove dependency on canvas
         explicit GLRenderer(const Parameters& parameters = {});
 
@@ -146,6 +156,10 @@ namespace threepp {
 
         void setRenderTarget(const std::shared_ptr<GLRenderTarget>& renderTarget, int activeCubeFace = 0, int activeMipmapLevel = 0);
 
+        // copies RGBA/UnsignedByte pixels into buffer with the bottom row first, a null renderTarget reads the default framebuffer.
+        // With a GL_PIXEL_PACK_BUFFER bound, buffer is an offset into that buffer.
+        bool readRenderTargetPixels(const std::shared_ptr<GLRenderTarget>& renderTarget, int x, int y, int width, int height, unsigned char* buffer);
+
         void enableTextRendering();
 
         TextHandle& textHandle(const std::string& str = "");
@@ -27,9 +27,24 @@ namespace threepp::gl {
         size_t triangles{0};
         size_t points{0};
         size_t lines{0};
+        size_t uniformUploads{0};
+        size_t uniformUploadsSkipped{0};// values equal to the last upload to the same program
 
         friend std::ostream& operator<<(std::ostream& os, const RenderInfo& m) {
-            os << "RenderInfo: frame=" << m.frame << ", calls=" << m.calls << ", triangles=" << m.triangles << ", points=" << m.points << ", lines=" << m.lines;
+            os << "RenderInfo: frame=" << m.frame << ", calls=" << m.calls << ", triangles=" << m.triangles << ", points=" << m.points << ", lines=" << m.lines
+               << ", uniformUploads=" << m.uniformUploads << ", uniformUploadsSkipped=" << m.uniformUploadsSkipped;
+            return os;
+        }
+    };
+
+    struct ProgramInfo {
+
+        size_t binaryCacheHits{0};
+        size_t binaryCacheMisses{0};
+        size_t binaryCacheRejected{0};// stored binaries the driver refused to load
+
+        friend std::ostream& operator<<(std::ostream& os, const ProgramInfo& m) {
+            os << "ProgramInfo: binaryCacheHits=" << m.binaryCacheHits << ", binaryCacheMisses=" << m.binaryCacheMisses << ", binaryCacheRejected=" << m.binaryCacheRejected;
             return os;
         }
     };
@@ -38,6 +53,7 @@ namespace threepp::gl {
 
         MemoryInfo memory{};
         RenderInfo render{};
+        ProgramInfo programs{};
 
         bool autoReset = true;
 
@@ -46,7 +62,7 @@ namespace threepp::gl {
         void reset();
 
         friend std::ostream& operator<<(std::ostream& os, const GLInfo& m) {
-            os << m.memory << "\n" << m.render;
+            os << m.memory << "\n" << m.render << "\n" << m.programs;
             return os;
         }
     };
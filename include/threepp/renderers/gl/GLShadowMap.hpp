@@ -16,6 +16,7 @@ namespace threepp {
     namespace gl {
 
         class GLObjects;
+        struct GLProperties;
 
         struct GLShadowMap {
 
@@ -26,7 +27,7 @@ namespace threepp {
 
             int type = PCFShadowMap;
 
-            explicit GLShadowMap(GLObjects& objects);
+            GLShadowMap(GLObjects& objects, GLProperties& properties);
 
             void render(GLRenderer& renderer, const std::vector<Light*>& lights, Scene* scene, Camera* camera);
 
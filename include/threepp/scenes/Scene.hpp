@@ -14,6 +14,7 @@
 namespace threepp {
 
     class Texture;
+    class TransformSystem;
     typedef std::variant<Fog, FogExp2> FogVariant;
 
     class Scene: public Object3D {
@@ -27,6 +28,12 @@ namespace threepp {
 
         bool autoUpdate = true;
 
+        // when set, the renderer updates the scene graph with updateMatrixWorldIncremental()
+        bool incrementalUpdate = false;
+
+        // when set, the renderer updates the scene graph through it instead, see TransformSystem
+        std::shared_ptr<TransformSystem> transforms;
+
         static std::shared_ptr<Scene> create();
     };
 
@@ -6,6 +6,7 @@
 #include "threepp/constants.hpp"
 
 #include "threepp/core/EventDispatcher.hpp"
+#include "threepp/core/ResourceSlot.hpp"
 
 #include "threepp/math/Matrix3.hpp"
 #include "threepp/math/Vector2.hpp"
@@ -28,6 +29,8 @@ namespace threepp {
 
         std::string uuid;
 
+        ResourceSlot slot{ResourceKind::Texture};
+
         std::string name;
 
         std::optional<Image> image;
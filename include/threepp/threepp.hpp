@@ -31,6 +31,7 @@
 #include "threepp/cameras/PerspectiveCamera.hpp"
 #include "threepp/cameras/OrthographicCamera.hpp"
 
+#include "threepp/renderers/GLReadback.hpp"
 #include "threepp/renderers/GLRenderer.hpp"
 
 #include "threepp/loaders/loaders.hpp"
@@ -13,6 +13,38 @@ namespace threepp {
 
     std::shared_ptr<BufferGeometry> mergeBufferGeometries(const std::vector<std::shared_ptr<BufferGeometry>>& geometries, bool useGroups = false);
 
+    // Welds vertices whose attributes all match within tolerance and returns an indexed geometry.
+    // Triangle soups from loaders are welded through a spatial hash, in parallel for large meshes.
+    std::shared_ptr<BufferGeometry> mergeVertices(const BufferGeometry& geometry, float tolerance = 1e-4f);
+
+    // Reorders the triangles of every group for post-transform vertex cache locality (Forsyth).
+    // Overlapping groups are cut at every group start and end, so triangles never move to another group.
+    void optimizeVertexCache(BufferGeometry& geometry, unsigned int cacheSize = 32);
+
+    // Splits vertex cache optimized triangles into clusters and draws outward facing clusters first,
+    // the vertex cache miss ratio of a cluster may degrade by at most threshold. Groups are handled as in optimizeVertexCache.
+    void optimizeOverdraw(BufferGeometry& geometry, float threshold = 1.05f);
+
+    // Renumbers vertices in the order the index first references them and drops unreferenced vertices.
+    void optimizeVertexFetch(BufferGeometry& geometry);
+
+    // Average number of vertices transformed per triangle with a FIFO post-transform cache (ACMR).
+    float computeACMR(const BufferGeometry& geometry, unsigned int cacheSize = 16);
+
+    struct OptimizeGeometryOptions {
+
+        // welding tolerance, negative to skip welding
+        float tolerance = 1e-4f;
+
+        unsigned int cacheSize = 32;
+
+        // allowed vertex cache degradation for overdraw, values below 1 skip the overdraw pass
+        float overdrawThreshold = 1.05f;
+    };
+
+    // Runs mergeVertices, optimizeVertexCache, optimizeOverdraw and optimizeVertexFetch in that order.
+    std::shared_ptr<BufferGeometry> optimizeGeometry(const BufferGeometry& geometry, const OptimizeGeometryOptions& options = {});
+
 
 }// namespace threepp
 
@@ -0,0 +1,43 @@
+// Edge collapse simplification with quadric error metrics,
+// Garland & Heckbert, "Surface Simplification Using Quadric Error Metrics"
+
+#ifndef THREEPP_MESHSIMPLIFIER_HPP
+#define THREEPP_MESHSIMPLIFIER_HPP
+
+#include "threepp/core/BufferGeometry.hpp"
+
+#include <vector>
+
+namespace threepp {
+
+    class LOD;
+    class Mesh;
+
+    struct SimplifyOptions {
+
+        // fraction of the triangles to keep
+        float targetRatio = 0.5f;
+
+        // largest allowed deviation from the input surface, relative to the mesh extent
+        float targetError = 1e-2f;
+
+        // keeps vertices on open boundaries in place
+        bool lockBorder = false;
+
+        // importance of attribute (normal, uv, color..) differences when ordering collapses, zero ignores attributes
+        float attributeWeight = 0.1f;
+    };
+
+    // Collapses edges onto existing vertices until the target ratio or error is reached.
+    // Attribute seams survive as seams and triangles stay within their geometry group.
+    // Triangle soups are welded first. resultError receives the deviation reached, relative to the mesh extent.
+    std::shared_ptr<BufferGeometry> simplifyGeometry(const BufferGeometry& geometry, const SimplifyOptions& options = {}, float* resultError = nullptr);
+
+    // LOD with a copy of mesh at distance 0 and one simplified level per distance,
+    // each keeping options.targetRatio of the triangles of the level before it.
+    // The LOD takes over the transform of mesh, levels share its materials.
+    std::shared_ptr<LOD> generateLOD(Mesh& mesh, const std::vector<float>& distances, const SimplifyOptions& options = {});
+
+}// namespace threepp
+
+#endif//THREEPP_MESHSIMPLIFIER_HPP
@@ -2,11 +2,24 @@
 #ifndef THREEPP_THREADPOOL_HPP
 #define THREEPP_THREADPOOL_HPP
 
-#include <memory>
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
 #include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
 
 namespace threepp::utils {
 
+    class TaskGroup;
+
+    // Work-stealing thread pool. Every worker owns a task deque, tasks submitted from
+    // a worker are pushed to its own deque and idle workers steal from the others.
+    // Threads waiting on a TaskGroup (or wait()) execute pending tasks instead of blocking,
+    // so tasks may themselves submit and wait on nested work.
     class ThreadPool {
 
     public:
@@ -16,17 +29,138 @@ namespace threepp::utils {
         ThreadPool(const ThreadPool&&) = delete;
         ThreadPool operator=(const ThreadPool&) = delete;
 
-        void submit(const std::function<void()>& f);
+        [[nodiscard]] unsigned int threadCount() const;
+
+        // fire-and-forget
+        void post(std::function<void()> f);
+
+        template<class F>
+        auto submit(F&& f) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+
+            using R = std::invoke_result_t<std::decay_t<F>>;
 
+            auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+            auto future = task->get_future();
+            post([task] { (*task)(); });
+
+            return future;
+        }
+
+        // blocks until every task submitted to the pool has completed.
+        // Called from a task of this pool, waits for the tasks posted by that task only.
         void wait();
 
+        // shared pool sized to the hardware concurrency
+        static ThreadPool& instance();
+
         ~ThreadPool();
 
     private:
         struct Impl;
         std::unique_ptr<Impl> pimpl_;
+
+        // runs a single pending task on the calling thread, returns false if none was found
+        bool runPendingTask();
+
+        friend class TaskGroup;
+    };
+
+    // Counts outstanding tasks, acts as a latch for a batch of work.
+    // The first exception thrown by a task is rethrown from wait().
+    class TaskGroup {
+
+    public:
+        explicit TaskGroup(ThreadPool& pool = ThreadPool::instance());
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void run(std::function<void()> f);
+
+        void wait();
+
+        ~TaskGroup();
+
+    private:
+        ThreadPool& pool_;
+
+        std::mutex m_;
+        std::condition_variable cv_;
+        unsigned int pending_{0};
+        std::exception_ptr error_;
+
+        void join();
     };
 
+    // Invokes f(begin, end) over sub-ranges of [first, last) of at most grainSize indices.
+    template<class Index, class F>
+    void parallel_for(ThreadPool& pool, Index first, Index last, Index grainSize, F&& f) {
+
+        if (last <= first) return;
+
+        grainSize = std::max(grainSize, Index(1));
+
+        if (last - first <= grainSize) {
+
+            f(first, last);
+            return;
+        }
+
+        TaskGroup group(pool);
+        for (Index begin = first; begin < last; begin += std::min(grainSize, last - begin)) {
+
+            const Index end = begin + std::min(grainSize, last - begin);
+            group.run([&f, begin, end] { f(begin, end); });
+        }
+        group.wait();
+    }
+
+    template<class Index, class F>
+    void parallel_for(Index first, Index last, Index grainSize, F&& f) {
+
+        parallel_for(ThreadPool::instance(), first, last, grainSize, std::forward<F>(f));
+    }
+
+    // Maps every sub-range with map(begin, end) -> T and folds the partial results
+    // left to right with reduce(T, T), so the result does not depend on scheduling.
+    template<class T, class Index, class Map, class Reduce>
+    T parallel_reduce(ThreadPool& pool, Index first, Index last, Index grainSize, T identity, Map&& map, Reduce&& reduce) {
+
+        if (last <= first) return identity;
+
+        grainSize = std::max(grainSize, Index(1));
+
+        // wrapped so that std::vector<bool> does not pack concurrently written results into shared words
+        struct Partial {
+            T value;
+        };
+
+        const auto chunks = static_cast<size_t>((last - first + grainSize - 1) / grainSize);
+        std::vector<Partial> partials(chunks, Partial{identity});
+
+        parallel_for(pool, size_t(0), chunks, size_t(1), [&](size_t chunkBegin, size_t chunkEnd) {
+            for (auto chunk = chunkBegin; chunk < chunkEnd; chunk++) {
+
+                const Index begin = first + static_cast<Index>(chunk) * grainSize;
+                const Index end = begin + std::min(grainSize, last - begin);
+                partials[chunk].value = map(begin, end);
+            }
+        });
+
+        T result = identity;
+        for (auto& partial : partials) {
+
+            result = reduce(result, partial.value);
+        }
+
+        return result;
+    }
+
+    template<class T, class Index, class Map, class Reduce>
+    T parallel_reduce(Index first, Index last, Index grainSize, T identity, Map&& map, Reduce&& reduce) {
+
+        return parallel_reduce(ThreadPool::instance(), first, last, grainSize, std::move(identity), std::forward<Map>(map), std::forward<Reduce>(reduce));
+    }
 
 }// namespace threepp::utils
 
@@ -0,0 +1,253 @@
+
+#include "threepp/HeadlessCanvas.hpp"
+
+#include <glad/glad.h>
+
+#ifdef THREEPP_HEADLESS_OSMESA
+#include <GL/osmesa.h>
+#else
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+using namespace threepp;
+
+struct HeadlessCanvas::HeadlessImpl: Canvas::Impl {
+
+    bool stop_ = false;
+    size_t frameCount_ = 0;
+    std::chrono::steady_clock::time_point start_ = std::chrono::steady_clock::now();
+
+    explicit HeadlessImpl(const Canvas::Parameters& params): Canvas::Impl(params) {
+
+        // virtual calls from the base constructor resolve to the base, so the context is created here
+        if (!createContext()) {
+
+            destroyContext();
+            throw std::runtime_error("[HeadlessCanvas] Unable to create an offscreen OpenGL 3.3 context");
+        }
+
+        if (!gladLoadGLLoader(loadProc())) {
+
+            destroyContext();
+            throw std::runtime_error("[HeadlessCanvas] Unable to load OpenGL functions");
+        }
+
+        glEnable(GL_PROGRAM_POINT_SIZE);
+    }
+
+    bool backend_should_window_close() override {
+
+        return stop_;
+    }
+
+    void backend_window_size(WindowSize size) override {
+
+        if (resizeSurface(size)) {
+
+            window_resize(size.width, size.height);
+        }
+    }
+
+    double backend_get_time() override {
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+    }
+
+    void backend_draw_complete() override {
+
+        ++frameCount_;
+    }
+
+    ~HeadlessImpl() override {
+
+        destroyContext();
+    }
+
+#ifdef THREEPP_HEADLESS_OSMESA
+
+    OSMesaContext context_ = nullptr;
+    std::vector<unsigned char> buffer_;
+
+    static GLADloadproc loadProc() {
+
+        return reinterpret_cast<GLADloadproc>(OSMesaGetProcAddress);
+    }
+
+    bool createContext() {
+
+        const int attributes[] = {
+                OSMESA_FORMAT, OSMESA_RGBA,
+                OSMESA_DEPTH_BITS, 24,
+                OSMESA_STENCIL_BITS, 8,
+                OSMESA_PROFILE, OSMESA_CORE_PROFILE,
+                OSMESA_CONTEXT_MAJOR_VERSION, 3,
+                OSMESA_CONTEXT_MINOR_VERSION, 3,
+                0};
+
+        context_ = OSMesaCreateContextAttribs(attributes, nullptr);
+        if (!context_) return false;
+
+        window = context_;
+
+        return resizeSurface(size_);
+    }
+
+    bool resizeSurface(WindowSize size) {
+
+        buffer_.resize(static_cast<size_t>(size.width) * size.height * 4);
+
+        return OSMesaMakeCurrent(context_, buffer_.data(), GL_UNSIGNED_BYTE, size.width, size.height);
+    }
+
+    void destroyContext() {
+
+        if (context_) {
+
+            OSMesaDestroyContext(context_);
+            context_ = nullptr;
+        }
+    }
+
+#else
+
+    EGLDisplay display_ = EGL_NO_DISPLAY;
+    EGLConfig config_ = nullptr;
+    EGLSurface surface_ = EGL_NO_SURFACE;
+    EGLContext context_ = EGL_NO_CONTEXT;
+
+    static GLADloadproc loadProc() {
+
+        return reinterpret_cast<GLADloadproc>(eglGetProcAddress);
+    }
+
+    static EGLDisplay getDisplay() {
+
+        // prefer a display that needs neither a window system nor a DRM device
+        const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+        if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+
+            auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+            if (getPlatformDisplay) {
+
+                EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+                if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+
+                    return display;
+                }
+            }
+        }
+
+        EGLDisplay display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display != EGL_NO_DISPLAY && eglInitialize(display, nullptr, nullptr)) {
+
+            return display;
+        }
+
+        return EGL_NO_DISPLAY;
+    }
+
+    bool createContext() {
+
+        display_ = getDisplay();
+        if (display_ == EGL_NO_DISPLAY) return false;
+
+        if (!eglBindAPI(EGL_OPENGL_API)) return false;
+
+        const EGLint configAttributes[] = {
+                EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_RED_SIZE, 8,
+                EGL_GREEN_SIZE, 8,
+                EGL_BLUE_SIZE, 8,
+                EGL_ALPHA_SIZE, 8,
+                EGL_DEPTH_SIZE, 24,
+                EGL_STENCIL_SIZE, 8,
+                EGL_NONE};
+
+        EGLint numConfigs = 0;
+        if (!eglChooseConfig(display_, configAttributes, &config_, 1, &numConfigs) || numConfigs == 0) return false;
+
+        const EGLint contextAttributes[] = {
+                EGL_CONTEXT_MAJOR_VERSION, 3,
+                EGL_CONTEXT_MINOR_VERSION, 3,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE};
+
+        context_ = eglCreateContext(display_, config_, EGL_NO_CONTEXT, contextAttributes);
+        if (context_ == EGL_NO_CONTEXT) return false;
+
+        window = context_;
+
+        return resizeSurface(size_);
+    }
+
+    bool resizeSurface(WindowSize size) {
+
+        const EGLint surfaceAttributes[] = {
+                EGL_WIDTH, size.width,
+                EGL_HEIGHT, size.height,
+                EGL_NONE};
+
+        EGLSurface surface = eglCreatePbufferSurface(display_, config_, surfaceAttributes);
+        if (surface == EGL_NO_SURFACE) return false;
+
+        if (!eglMakeCurrent(display_, surface, surface, context_)) {
+
+            eglDestroySurface(display_, surface);
+            return false;
+        }
+
+        if (surface_ != EGL_NO_SURFACE) {
+
+            eglDestroySurface(display_, surface_);
+        }
+        surface_ = surface;
+
+        return true;
+    }
+
+    void destroyContext() {
+
+        if (display_ == EGL_NO_DISPLAY) return;
+
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+        if (surface_ != EGL_NO_SURFACE) {
+
+            eglDestroySurface(display_, surface_);
+            surface_ = EGL_NO_SURFACE;
+        }
+        if (context_ != EGL_NO_CONTEXT) {
+
+            eglDestroyContext(display_, context_);
+            context_ = EGL_NO_CONTEXT;
+        }
+
+        eglTerminate(display_);
+        display_ = EGL_NO_DISPLAY;
+    }
+
+#endif
+};
+
+HeadlessCanvas::HeadlessCanvas(const Canvas::Parameters& params)
+    : HeadlessCanvas(params, new HeadlessImpl(params)) {}
+
+HeadlessCanvas::HeadlessCanvas(const Canvas::Parameters& params, HeadlessImpl* impl)
+    : Canvas(params, impl), impl_(impl) {}
+
+void HeadlessCanvas::stop() {
+
+    impl_->stop_ = true;
+}
+
+size_t HeadlessCanvas::frameCount() const {
+
+    return impl_->frameCount_;
+}
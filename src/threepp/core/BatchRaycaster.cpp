@@ -0,0 +1,377 @@
+
+#include "threepp/core/BatchRaycaster.hpp"
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/materials/Material.hpp"
+#include "threepp/math/Matrix3.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+using namespace threepp;
+
+namespace {
+
+    // packets handed to a task at a time
+    constexpr size_t packetGrain = 16;
+
+    // targets per leaf of the hierarchy over the targets
+    constexpr size_t maxLeafTargets = 4;
+
+    // a mesh, or an instance of an InstancedMesh, with its transform prepared for the rays
+    struct Target {
+
+        const Object3D* object;
+        const BufferGeometry* geometry;
+        const MeshBVH* bvh;
+        int side;
+        unsigned int instanceId;
+
+        Matrix4 inverse;
+        Matrix3 normalMatrix;
+
+        // world space bounds, tested before transforming a packet into the space of the geometry
+        float min[3];
+        float max[3];
+    };
+
+    void addTarget(std::vector<Target>& targets, const Object3D& object, const BufferGeometry& geometry, const Matrix4& matrixWorld, int side, unsigned int instanceId) {
+
+        if (matrixWorld.determinant() == 0) return;
+
+        auto& target = targets.emplace_back();
+        target.object = &object;
+        target.geometry = &geometry;
+        target.bvh = geometry.boundsTree.get();
+        target.side = side;
+        target.instanceId = instanceId;
+        target.inverse.copy(matrixWorld).invert();
+        target.normalMatrix.getNormalMatrix(matrixWorld);
+
+        Box3 box = target.bvh->boundingBox();
+        box.applyMatrix4(matrixWorld);
+
+        target.min[0] = box.min().x, target.min[1] = box.min().y, target.min[2] = box.min().z;
+        target.max[0] = box.max().x, target.max[1] = box.max().y, target.max[2] = box.max().z;
+    }
+
+    void collectTargets(Object3D& object, const Layers& layers, bool recursive, std::vector<Target>& targets) {
+
+        auto mesh = object.as<Mesh>();
+        if (mesh && object.layers.test(layers) && mesh->material()) {
+
+            auto geometry = mesh->geometry();
+
+            if (geometry && geometry->hasAttribute("position")) {
+
+                if (!geometry->boundsTree) geometry->computeBoundsTree();
+                geometry->boundsTree->update();
+
+                const int side = mesh->material()->side;
+
+                if (auto instanced = object.as<InstancedMesh>()) {
+
+                    Matrix4 instanceMatrix;
+                    Matrix4 matrixWorld;
+
+                    const auto instances = std::clamp(instanced->count, 0, instanced->capacity());
+                    for (int i = 0; i < instances; i++) {
+
+                        instanced->getMatrixAt(i, instanceMatrix);
+                        matrixWorld.multiplyMatrices(object.matrixWorld, instanceMatrix);
+
+                        addTarget(targets, object, *geometry, matrixWorld, side, static_cast<unsigned int>(i));
+                    }
+
+                } else {
+
+                    addTarget(targets, object, *geometry, object.matrixWorld, side, BatchRaycaster::noHit);
+                }
+            }
+        }
+
+        if (recursive) {
+
+            for (auto& child : object.children) {
+
+                collectTargets(*child, layers, true, targets);
+            }
+        }
+    }
+
+    // Node of the bounding volume hierarchy over the world space bounds of the targets, stored depth first.
+    // The first child of an inner node follows it, the second is at offset. Leaves hold count targets from offset.
+    struct TargetNode {
+
+        float min[3];
+        float max[3];
+        uint32_t offset;
+        uint32_t count;
+        uint32_t axis;
+    };
+
+    // Splits targets at the median of their centers along the longest axis of the centers, reordering them in place.
+    // Returns the index of the node built for [begin, end).
+    uint32_t buildTargetNodes(std::vector<Target>& targets, size_t begin, size_t end, std::vector<TargetNode>& nodes) {
+
+        const auto index = static_cast<uint32_t>(nodes.size());
+        auto& node = nodes.emplace_back();
+
+        float centerMin[3], centerMax[3];
+        for (int i = 0; i < 3; i++) {
+
+            node.min[i] = centerMin[i] = Infinity<float>;
+            node.max[i] = centerMax[i] = -Infinity<float>;
+        }
+
+        for (auto t = begin; t < end; t++) {
+
+            for (int i = 0; i < 3; i++) {
+
+                const float center = (targets[t].min[i] + targets[t].max[i]) * 0.5f;
+                node.min[i] = std::min(node.min[i], targets[t].min[i]);
+                node.max[i] = std::max(node.max[i], targets[t].max[i]);
+                centerMin[i] = std::min(centerMin[i], center);
+                centerMax[i] = std::max(centerMax[i], center);
+            }
+        }
+
+        if (end - begin <= maxLeafTargets) {
+
+            node.offset = static_cast<uint32_t>(begin);
+            node.count = static_cast<uint32_t>(end - begin);
+
+            return index;
+        }
+
+        uint32_t axis = 0;
+        for (uint32_t i = 1; i < 3; i++) {
+
+            if (centerMax[i] - centerMin[i] > centerMax[axis] - centerMin[axis]) axis = i;
+        }
+
+        const auto middle = begin + (end - begin) / 2;
+        std::nth_element(targets.begin() + static_cast<std::ptrdiff_t>(begin), targets.begin() + static_cast<std::ptrdiff_t>(middle), targets.begin() + static_cast<std::ptrdiff_t>(end),
+                         [axis](const Target& a, const Target& b) { return a.min[axis] + a.max[axis] < b.min[axis] + b.max[axis]; });
+
+        // node may dangle once the children are added
+        nodes[index].axis = axis;
+        nodes[index].count = 0;
+        buildTargetNodes(targets, begin, middle, nodes);
+        nodes[index].offset = buildTargetNodes(targets, middle, end, nodes);
+
+        return index;
+    }
+
+    // rays of the packet in mask passing through [min, max] before their current far
+    uint32_t raysThrough(const float* min, const float* max, const BVHRayPacket& rays, uint32_t mask) {
+
+        uint32_t result = 0;
+        for (unsigned r = 0; r < rays.size; r++) {
+
+            if (!(mask >> r & 1u)) continue;
+
+            float tmin = rays.near[r];
+            float tmax = rays.far[r];
+
+            for (int i = 0; i < 3; i++) {
+
+                const float d = rays.direction[i][r] == 0 ? 1e-30f : rays.direction[i][r];
+                float t1 = (min[i] - rays.origin[i][r]) / d;
+                float t2 = (max[i] - rays.origin[i][r]) / d;
+                if (t1 > t2) std::swap(t1, t2);
+
+                tmin = std::max(tmin, t1);
+                tmax = std::min(tmax, t2);
+            }
+
+            if (tmin <= tmax) result |= 1u << r;
+        }
+
+        return result;
+    }
+
+    Vector3 faceNormal(const Target& target, unsigned int faceIndex) {
+
+        const auto index = target.geometry->getIndex();
+        const auto position = target.geometry->getAttribute("position");
+
+        unsigned int a = faceIndex * 3, b = faceIndex * 3 + 1, c = faceIndex * 3 + 2;
+        if (index) {
+
+            a = index->getX(a);
+            b = index->getX(b);
+            c = index->getX(c);
+        }
+
+        Vector3 va, vb, vc;
+        position->setFromBufferAttribute(va, a);
+        position->setFromBufferAttribute(vb, b);
+        position->setFromBufferAttribute(vc, c);
+
+        Vector3 normal;
+        normal.subVectors(vc, vb).cross(va.sub(vb));
+
+        return normal.applyMatrix3(target.normalMatrix).normalize();
+    }
+
+}// namespace
+
+size_t BatchRaycaster::intersectObject(Object3D& object, const Vector3* origins, const Vector3* directions, size_t count,
+                                       const RayBatchHits& hits, bool recursive) const {
+
+    std::vector<Target> targets;
+    collectTargets(object, layers, recursive, targets);
+
+    // packets descend the hierarchy nearer child first, so in ClosestHit mode boxes behind the hits found are skipped
+    std::vector<TargetNode> nodes;
+    if (!targets.empty()) buildTargetNodes(targets, 0, targets.size(), nodes);
+
+    const bool anyHit = mode == Mode::AnyHit;
+    const size_t packets = (count + BVHRayPacket::maxSize - 1) / BVHRayPacket::maxSize;
+
+    const auto castPackets = [&](size_t packetBegin, size_t packetEnd) {
+        size_t hitCount = 0;
+
+        // rays of the packet in world space, and transformed into the space of the current target
+        BVHRayPacket world;
+        BVHRayPacket local;
+
+        float distance[BVHRayPacket::maxSize];
+        const Target* hitTarget[BVHRayPacket::maxSize];
+        unsigned int hitFace[BVHRayPacket::maxSize];
+
+        for (auto packet = packetBegin; packet < packetEnd; packet++) {
+
+            const auto first = packet * BVHRayPacket::maxSize;
+            const auto size = static_cast<unsigned int>(std::min<size_t>(BVHRayPacket::maxSize, count - first));
+
+            world.size = size;
+            local.size = size;
+
+            for (unsigned r = 0; r < size; r++) {
+
+                const auto& origin = origins[first + r];
+                const auto& direction = directions[first + r];
+
+                world.origin[0][r] = origin.x, world.origin[1][r] = origin.y, world.origin[2][r] = origin.z;
+                world.direction[0][r] = direction.x, world.direction[1][r] = direction.y, world.direction[2][r] = direction.z;
+                world.near[r] = near;
+                world.far[r] = far;
+
+                distance[r] = Infinity<float>;
+                hitTarget[r] = nullptr;
+            }
+
+            const uint32_t all = size == 32 ? ~0u : (1u << size) - 1;
+            uint32_t active = all;
+
+            uint32_t stack[64];
+            unsigned int stackSize = 0;
+            if (!nodes.empty()) stack[stackSize++] = 0;
+
+            while (stackSize > 0 && active) {
+
+                // far may have shrunk since the node was pushed
+                const auto& node = nodes[stack[--stackSize]];
+                const auto nodeMask = raysThrough(node.min, node.max, world, active);
+                if (!nodeMask) continue;
+
+                if (node.count == 0) {
+
+                    // the side the first ray enters from decides which child is nearer
+                    unsigned int ray = 0;
+                    while (!(nodeMask >> ray & 1u)) ray++;
+
+                    auto nearChild = static_cast<uint32_t>(&node - nodes.data()) + 1;
+                    auto farChild = node.offset;
+                    if (world.direction[node.axis][ray] < 0) std::swap(nearChild, farChild);
+
+                    stack[stackSize++] = farChild;
+                    stack[stackSize++] = nearChild;
+                    continue;
+                }
+
+                for (auto t = node.offset; t < node.offset + node.count && active; t++) {
+
+                    const auto& target = targets[t];
+
+                    const auto mask = raysThrough(target.min, target.max, world, active);
+                    if (!mask) continue;
+
+                    // the transform is affine, so distances along the untransformed directions are kept
+                    const auto& e = target.inverse.elements;
+                    for (unsigned r = 0; r < size; r++) {
+
+                        const float ox = world.origin[0][r], oy = world.origin[1][r], oz = world.origin[2][r];
+                        const float dx = world.direction[0][r], dy = world.direction[1][r], dz = world.direction[2][r];
+
+                        local.origin[0][r] = e[0] * ox + e[4] * oy + e[8] * oz + e[12];
+                        local.origin[1][r] = e[1] * ox + e[5] * oy + e[9] * oz + e[13];
+                        local.origin[2][r] = e[2] * ox + e[6] * oy + e[10] * oz + e[14];
+
+                        local.direction[0][r] = e[0] * dx + e[4] * dy + e[8] * dz;
+                        local.direction[1][r] = e[1] * dx + e[5] * dy + e[9] * dz;
+                        local.direction[2][r] = e[2] * dx + e[6] * dy + e[10] * dz;
+
+                        local.near[r] = world.near[r];
+                        // rays outside the mask get an empty interval
+                        local.far[r] = (mask >> r & 1u) ? world.far[r] : -Infinity<float>;
+                    }
+
+                    target.bvh->intersectPacket(local, target.side, anyHit);
+
+                    for (unsigned r = 0; r < size; r++) {
+
+                        if (!local.hit[r]) continue;
+
+                        distance[r] = local.far[r];
+                        hitTarget[r] = &target;
+                        hitFace[r] = local.faceIndex[r];
+
+                        // later targets only need to beat this hit
+                        world.far[r] = local.far[r];
+                        if (anyHit) active &= ~(1u << r);
+                    }
+                }
+            }
+
+            for (unsigned r = 0; r < size; r++) {
+
+                const auto i = first + r;
+                const auto target = hitTarget[r];
+
+                hits.distance[i] = distance[r];
+
+                if (target) hitCount++;
+
+                if (hits.pointX) {
+
+                    hits.pointX[i] = target ? world.origin[0][r] + world.direction[0][r] * distance[r] : NAN;
+                    hits.pointY[i] = target ? world.origin[1][r] + world.direction[1][r] * distance[r] : NAN;
+                    hits.pointZ[i] = target ? world.origin[2][r] + world.direction[2][r] * distance[r] : NAN;
+                }
+
+                if (hits.normalX) {
+
+                    const auto normal = target ? faceNormal(*target, hitFace[r]) : Vector3(NAN, NAN, NAN);
+                    hits.normalX[i] = normal.x;
+                    hits.normalY[i] = normal.y;
+                    hits.normalZ[i] = normal.z;
+                }
+
+                if (hits.objectId) hits.objectId[i] = target ? target->object->id : noHit;
+                if (hits.faceIndex) hits.faceIndex[i] = target ? hitFace[r] : noHit;
+                if (hits.instanceId) hits.instanceId[i] = target ? target->instanceId : noHit;
+            }
+        }
+
+        return hitCount;
+    };
+
+    return utils::parallel_reduce(size_t(0), packets, packetGrain, size_t(0), castPackets, std::plus<>());
+}
@@ -13,36 +13,52 @@ using namespace threepp;
 
 namespace {
 
-    std::unique_ptr<BufferAttribute> convertBufferAttribute(BufferAttribute& _attribute, const std::vector<unsigned int>& indices) {
+    template<class T>
+    std::unique_ptr<BufferAttribute> convertBufferAttribute(TypedBufferAttribute<T>& attribute, const std::vector<unsigned int>& indices) {
 
-        if (_attribute.typed<float>()) {
+        const auto& array = attribute.array();
+        const auto itemSize = attribute.itemSize();
+        const auto normalized = attribute.normalized();
 
-            auto attribute = _attribute.typed<float>();
+        auto array2 = std::vector<T>(indices.size() * itemSize);
 
-            const auto& array = attribute->array();
-            const auto itemSize = attribute->itemSize();
-            const auto normalized = attribute->normalized();
+        unsigned index = 0, index2 = 0;
 
-            auto array2 = std::vector<float>(indices.size() * itemSize);
+        for (unsigned i = 0, l = indices.size(); i < l; i++) {
 
-            unsigned index = 0, index2 = 0;
+            index = indices[i] * itemSize;
 
-            for (unsigned i = 0, l = indices.size(); i < l; i++) {
+            for (unsigned j = 0; j < itemSize; j++) {
 
-                index = indices[i] * itemSize;
-
-                for (unsigned j = 0; j < itemSize; j++) {
-
-                    array2[index2++] = array[index++];
-                }
+                array2[index2++] = array[index++];
             }
+        }
 
-            return FloatBufferAttribute::create(array2, itemSize, normalized);
-
-        } else {
+        return TypedBufferAttribute<T>::create(std::move(array2), itemSize, normalized);
+    }
 
-            throw std::runtime_error("Unsupported operation");
+    std::unique_ptr<BufferAttribute> convertBufferAttribute(BufferAttribute& attribute, const std::vector<unsigned int>& indices) {
+
+        switch (attribute.componentType()) {
+            case ComponentType::Float:
+                return convertBufferAttribute(*attribute.typed<float>(), indices);
+            case ComponentType::HalfFloat:
+                return convertBufferAttribute(*attribute.typed<Float16>(), indices);
+            case ComponentType::Byte:
+                return convertBufferAttribute(*attribute.typed<int8_t>(), indices);
+            case ComponentType::UnsignedByte:
+                return convertBufferAttribute(*attribute.typed<uint8_t>(), indices);
+            case ComponentType::Short:
+                return convertBufferAttribute(*attribute.typed<int16_t>(), indices);
+            case ComponentType::UnsignedShort:
+                return convertBufferAttribute(*attribute.typed<uint16_t>(), indices);
+            case ComponentType::Int:
+                return convertBufferAttribute(*attribute.typed<int32_t>(), indices);
+            case ComponentType::UnsignedInt:
+                return convertBufferAttribute(*attribute.typed<uint32_t>(), indices);
         }
+
+        throw std::runtime_error("Unsupported operation");
     }
 
 }// namespace
@@ -77,6 +93,12 @@ const std::unordered_map<std::string, std::unique_ptr<BufferAttribute>>& BufferG
 void BufferGeometry::setAttribute(const std::string& name, std::unique_ptr<BufferAttribute> attribute) {
 
     attributes_[name] = std::move(attribute);
+    ++layoutVersion_;
+}
+
+void BufferGeometry::deleteAttribute(const std::string& name) {
+
+    if (attributes_.erase(name)) ++layoutVersion_;
 }
 
 bool BufferGeometry::hasAttribute(const std::string& name) const {
@@ -84,6 +106,11 @@ bool BufferGeometry::hasAttribute(const std::string& name) const {
     return attributes_.count(name);
 }
 
+unsigned int BufferGeometry::layoutVersion() const {
+
+    return layoutVersion_;
+}
+
 void BufferGeometry::addGroup(int start, int count, unsigned int materialIndex) {
 
     groups.emplace_back(GeometryGroup{start, count, materialIndex});
@@ -274,7 +301,7 @@ void BufferGeometry::computeBoundingBox() {
 
     if (this->attributes_.count("position")) {
 
-        const auto position = this->attributes_.at("position")->typed<float>();
+        const auto& position = this->attributes_.at("position");
 
         position->setFromBufferAttribute(*this->boundingBox);
 
@@ -298,7 +325,7 @@ void BufferGeometry::computeBoundingSphere() {
 
     if (this->attributes_.count("position")) {
 
-        const auto& position = this->attributes_.at("position")->typed<float>();
+        const auto& position = this->attributes_.at("position");
 
         // first, find the center of the bounding sphere
 
@@ -331,6 +358,18 @@ void BufferGeometry::computeBoundingSphere() {
     }
 }
 
+MeshBVH& BufferGeometry::computeBoundsTree(const MeshBVH::Options& options) {
+
+    this->boundsTree = std::make_unique<MeshBVH>(*this, options);
+
+    return *this->boundsTree;
+}
+
+void BufferGeometry::disposeBoundsTree() {
+
+    this->boundsTree = nullptr;
+}
+
 void BufferGeometry::normalizeNormals() {
 
     auto normals = getAttribute<float>("normal");
@@ -351,9 +390,11 @@ void BufferGeometry::copy(const BufferGeometry& source) {
 
     this->index_ = nullptr;
     this->attributes_.clear();
+    ++layoutVersion_;
     this->groups.clear();
     this->boundingBox = std::nullopt;
     this->boundingSphere = std::nullopt;
+    this->boundsTree = nullptr;
 
     // name
 
@@ -374,13 +415,7 @@ void BufferGeometry::copy(const BufferGeometry& source) {
 
     for (const auto& [name, attribute] : attributes) {
 
-        if (attribute->typed<unsigned int>()) {
-            this->setAttribute(name, attribute->typed<unsigned int>()->clone());
-        } else if (attribute->typed<float>()) {
-            this->setAttribute(name, attribute->typed<float>()->clone());
-        } else {
-            throw std::runtime_error("TODO");
-        }
+        this->setAttribute(name, attribute->cloneAttribute());
     }
 
 
@@ -0,0 +1,764 @@
+
+#include "threepp/core/MeshBVH.hpp"
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+
+using namespace threepp;
+
+namespace {
+
+    // beyond this depth, nodes are split at the median which bounds the depth of the tree
+    constexpr unsigned int maxSAHDepth = 64;
+    constexpr unsigned int maxStackSize = 128;
+
+    struct TriangleRef {
+
+        float min[3];
+        float max[3];
+        float centroid[3];
+    };
+
+    struct Bin {
+
+        float min[3]{Infinity<float>, Infinity<float>, Infinity<float>};
+        float max[3]{-Infinity<float>, -Infinity<float>, -Infinity<float>};
+        unsigned int count = 0;
+
+        void grow(const float* bmin, const float* bmax) {
+
+            for (int i = 0; i < 3; i++) {
+                min[i] = std::min(min[i], bmin[i]);
+                max[i] = std::max(max[i], bmax[i]);
+            }
+        }
+
+        void grow(const Bin& other) {
+
+            grow(other.min, other.max);
+            count += other.count;
+        }
+
+        [[nodiscard]] float area() const {
+
+            if (count == 0) return 0;
+
+            const float dx = max[0] - min[0];
+            const float dy = max[1] - min[1];
+            const float dz = max[2] - min[2];
+
+            return dx * dy + dy * dz + dz * dx;
+        }
+    };
+
+    struct RayData {
+
+        float origin[3];
+        float direction[3];
+        float invDir[3];
+
+        RayData() = default;
+
+        explicit RayData(const Ray& ray)
+            : RayData(ray.origin.x, ray.origin.y, ray.origin.z, ray.direction.x, ray.direction.y, ray.direction.z) {}
+
+        RayData(float ox, float oy, float oz, float dx, float dy, float dz)
+            : origin{ox, oy, oz}, direction{dx, dy, dz} {
+
+            for (int i = 0; i < 3; i++) {
+                const float d = direction[i] == 0 ? 1e-30f : direction[i];
+                invDir[i] = 1.f / d;
+            }
+        }
+    };
+
+    // returns the entry distance of the ray into the box, or NaN if it misses within [near, far]
+    inline float slabTest(const RayData& ray, const float* min, const float* max, float near, float far) {
+
+        float tmin = near;
+        float tmax = far;
+
+        for (int i = 0; i < 3; i++) {
+
+            float t1 = (min[i] - ray.origin[i]) * ray.invDir[i];
+            float t2 = (max[i] - ray.origin[i]) * ray.invDir[i];
+            if (t1 > t2) std::swap(t1, t2);
+
+            tmin = std::max(tmin, t1);
+            tmax = std::min(tmax, t2);
+        }
+
+        return tmin <= tmax ? tmin : NAN;
+    }
+
+    // same algorithm as Ray::intersectTriangle, without temporaries
+    inline bool intersectTriangle(const RayData& ray, const Vector3& a, const Vector3& b, const Vector3& c, bool backfaceCulling, float& t) {
+
+        const float e1x = b.x - a.x, e1y = b.y - a.y, e1z = b.z - a.z;
+        const float e2x = c.x - a.x, e2y = c.y - a.y, e2z = c.z - a.z;
+
+        const float nx = e1y * e2z - e1z * e2y;
+        const float ny = e1z * e2x - e1x * e2z;
+        const float nz = e1x * e2y - e1y * e2x;
+
+        const float* d = ray.direction;
+
+        float DdN = d[0] * nx + d[1] * ny + d[2] * nz;
+        float sign;
+
+        if (DdN > 0) {
+
+            if (backfaceCulling) return false;
+            sign = 1.f;
+
+        } else if (DdN < 0) {
+
+            sign = -1.f;
+            DdN = -DdN;
+
+        } else {
+
+            return false;
+        }
+
+        const float qx = ray.origin[0] - a.x, qy = ray.origin[1] - a.y, qz = ray.origin[2] - a.z;
+
+        // Dot(D, Cross(Q, E2))
+        const float DdQxE2 = sign * (d[0] * (qy * e2z - qz * e2y) + d[1] * (qz * e2x - qx * e2z) + d[2] * (qx * e2y - qy * e2x));
+        if (DdQxE2 < 0) return false;
+
+        // Dot(D, Cross(E1, Q))
+        const float DdE1xQ = sign * (d[0] * (e1y * qz - e1z * qy) + d[1] * (e1z * qx - e1x * qz) + d[2] * (e1x * qy - e1y * qx));
+        if (DdE1xQ < 0) return false;
+
+        if (DdQxE2 + DdE1xQ > DdN) return false;
+
+        const float QdN = -sign * (qx * nx + qy * ny + qz * nz);
+        if (QdN < 0) return false;
+
+        t = QdN / DdN;
+
+        return true;
+    }
+
+    inline bool intersectTriangle(const RayData& ray, const Vector3& a, const Vector3& b, const Vector3& c, int side, float& t) {
+
+        if (side == BackSide) {
+
+            return intersectTriangle(ray, c, b, a, true, t);
+        }
+
+        return intersectTriangle(ray, a, b, c, side != DoubleSide, t);
+    }
+
+    inline bool boxesOverlap(const float* min, const float* max, const Box3& box) {
+
+        return !(max[0] < box.min().x || min[0] > box.max().x ||
+                 max[1] < box.min().y || min[1] > box.max().y ||
+                 max[2] < box.min().z || min[2] > box.max().z);
+    }
+
+}// namespace
+
+
+MeshBVH::MeshBVH(const BufferGeometry& geometry, const Options& options)
+    : geometry_(geometry), options_(options) {
+
+    options_.maxLeafTriangles = std::max(1u, options_.maxLeafTriangles);
+    options_.binCount = std::max(2u, options_.binCount);
+
+    build();
+}
+
+const Box3& MeshBVH::boundingBox() const {
+
+    return boundingBox_;
+}
+
+size_t MeshBVH::nodeCount() const {
+
+    return nodes_.size();
+}
+
+size_t MeshBVH::triangleCount() const {
+
+    return triangles_.size();
+}
+
+void MeshBVH::snapshotVersions() {
+
+    const auto position = geometry_.getAttribute("position");
+    const auto index = geometry_.getIndex();
+
+    positionRef_ = position;
+    positionVersion_ = position ? position->version : 0;
+    positionCount_ = position ? position->count() : 0;
+
+    indexRef_ = index;
+    indexVersion_ = index ? index->version : 0;
+    indexCount_ = index ? index->count() : 0;
+}
+
+bool MeshBVH::topologyChanged() const {
+
+    const auto position = geometry_.getAttribute("position");
+    const auto index = geometry_.getIndex();
+
+    return position != positionRef_ || index != indexRef_ ||
+           (position && position->count() != positionCount_) ||
+           (index && (index->count() != indexCount_ || index->version != indexVersion_));
+}
+
+bool MeshBVH::stale() const {
+
+    if (topologyChanged()) return true;
+
+    const auto position = geometry_.getAttribute("position");
+
+    return position && position->version != positionVersion_;
+}
+
+bool MeshBVH::update() {
+
+    const auto position = geometry_.getAttribute("position");
+
+    if (topologyChanged()) {
+
+        build();
+        return true;
+    }
+
+    if (position && position->version != positionVersion_) {
+
+        refit();
+        return true;
+    }
+
+    return false;
+}
+
+void MeshBVH::getTriangle(unsigned int tri, unsigned int& a, unsigned int& b, unsigned int& c) const {
+
+    const auto index = geometry_.getIndex();
+
+    if (index) {
+
+        a = index->getX(tri * 3);
+        b = index->getX(tri * 3 + 1);
+        c = index->getX(tri * 3 + 2);
+
+    } else {
+
+        a = tri * 3;
+        b = tri * 3 + 1;
+        c = tri * 3 + 2;
+    }
+}
+
+void MeshBVH::build() {
+
+    snapshotVersions();
+
+    nodes_.clear();
+    triangles_.clear();
+    boundingBox_.makeEmpty();
+
+    const auto position = geometry_.getAttribute("position");
+    if (!position) return;
+
+    const auto index = geometry_.getIndex();
+    const unsigned int triangleCount = (index ? index->count() : position->count()) / 3;
+    if (triangleCount == 0) return;
+
+    std::vector<TriangleRef> refs(triangleCount);
+
+    utils::parallel_for(0u, triangleCount, 16384u, [&](unsigned int begin, unsigned int end) {
+        Vector3 a, b, c;
+        for (unsigned i = begin; i < end; i++) {
+
+            unsigned int ia, ib, ic;
+            getTriangle(i, ia, ib, ic);
+
+            position->setFromBufferAttribute(a, ia);
+            position->setFromBufferAttribute(b, ib);
+            position->setFromBufferAttribute(c, ic);
+
+            auto& ref = refs[i];
+            ref.min[0] = std::min({a.x, b.x, c.x});
+            ref.min[1] = std::min({a.y, b.y, c.y});
+            ref.min[2] = std::min({a.z, b.z, c.z});
+            ref.max[0] = std::max({a.x, b.x, c.x});
+            ref.max[1] = std::max({a.y, b.y, c.y});
+            ref.max[2] = std::max({a.z, b.z, c.z});
+
+            for (int k = 0; k < 3; k++) {
+                ref.centroid[k] = (ref.min[k] + ref.max[k]) * 0.5f;
+            }
+        }
+    });
+
+    triangles_.resize(triangleCount);
+    std::iota(triangles_.begin(), triangles_.end(), 0);
+
+    nodes_.reserve(2 * triangleCount / options_.maxLeafTriangles + 1);
+    nodes_.emplace_back();
+
+    struct Task {
+        unsigned int node;
+        unsigned int begin;
+        unsigned int end;
+        unsigned int depth;
+    };
+
+    std::vector<Task> tasks{{0, 0, triangleCount, 0}};
+    std::vector<Bin> bins(options_.binCount);
+    std::vector<Bin> rightAccum(options_.binCount);
+
+    while (!tasks.empty()) {
+
+        const auto task = tasks.back();
+        tasks.pop_back();
+
+        const unsigned int count = task.end - task.begin;
+
+        Bin bounds;
+        float cmin[3]{Infinity<float>, Infinity<float>, Infinity<float>};
+        float cmax[3]{-Infinity<float>, -Infinity<float>, -Infinity<float>};
+
+        for (unsigned i = task.begin; i < task.end; i++) {
+
+            const auto& ref = refs[triangles_[i]];
+            bounds.grow(ref.min, ref.max);
+
+            for (int k = 0; k < 3; k++) {
+                cmin[k] = std::min(cmin[k], ref.centroid[k]);
+                cmax[k] = std::max(cmax[k], ref.centroid[k]);
+            }
+        }
+        bounds.count = count;
+
+        auto& node = nodes_[task.node];
+        std::copy(bounds.min, bounds.min + 3, node.min);
+        std::copy(bounds.max, bounds.max + 3, node.max);
+        node.axis = 0;
+
+        const auto makeLeaf = [&] {
+            node.offset = task.begin;
+            node.count = count;
+        };
+
+        if (count <= options_.maxLeafTriangles) {
+
+            makeLeaf();
+            continue;
+        }
+
+        unsigned int axis = 0;
+        for (unsigned k = 1; k < 3; k++) {
+            if (cmax[k] - cmin[k] > cmax[axis] - cmin[axis]) axis = k;
+        }
+
+        unsigned int mid = task.begin;
+
+        if (cmax[axis] - cmin[axis] > 0 && task.depth < maxSAHDepth) {
+
+            // binned SAH over all three axes
+
+            const unsigned int binCount = options_.binCount;
+
+            float bestCost = Infinity<float>;
+            unsigned int bestAxis = 0;
+            unsigned int bestSplit = 0;
+
+            for (unsigned k = 0; k < 3; k++) {
+
+                const float extent = cmax[k] - cmin[k];
+                if (extent <= 0) continue;
+
+                const float scale = static_cast<float>(binCount) / extent;
+
+                std::fill(bins.begin(), bins.end(), Bin{});
+                for (unsigned i = task.begin; i < task.end; i++) {
+
+                    const auto& ref = refs[triangles_[i]];
+                    const auto bin = std::min(binCount - 1, static_cast<unsigned int>((ref.centroid[k] - cmin[k]) * scale));
+                    bins[bin].grow(ref.min, ref.max);
+                    bins[bin].count++;
+                }
+
+                Bin right;
+                for (unsigned i = binCount - 1; i > 0; i--) {
+                    right.grow(bins[i]);
+                    rightAccum[i] = right;
+                }
+
+                Bin left;
+                for (unsigned i = 0; i < binCount - 1; i++) {
+
+                    left.grow(bins[i]);
+                    const auto& r = rightAccum[i + 1];
+
+                    const float cost = left.area() * static_cast<float>(left.count) + r.area() * static_cast<float>(r.count);
+                    if (left.count > 0 && r.count > 0 && cost < bestCost) {
+                        bestCost = cost;
+                        bestAxis = k;
+                        bestSplit = i;
+                    }
+                }
+            }
+
+            const float leafCost = bounds.area() * static_cast<float>(count);
+
+            if (bestCost < Infinity<float>) {
+
+                if (bestCost >= leafCost && count <= 4 * options_.maxLeafTriangles) {
+
+                    makeLeaf();
+                    continue;
+                }
+
+                axis = bestAxis;
+                const float scale = static_cast<float>(binCount) / (cmax[axis] - cmin[axis]);
+                const auto it = std::partition(triangles_.begin() + task.begin, triangles_.begin() + task.end, [&](unsigned int tri) {
+                    const auto bin = std::min(binCount - 1, static_cast<unsigned int>((refs[tri].centroid[axis] - cmin[axis]) * scale));
+                    return bin <= bestSplit;
+                });
+                mid = static_cast<unsigned int>(it - triangles_.begin());
+            }
+        }
+
+        if (mid <= task.begin || mid >= task.end) {
+
+            // no usable SAH split, fall back to a median split along the widest axis
+            mid = task.begin + count / 2;
+            std::nth_element(triangles_.begin() + task.begin, triangles_.begin() + mid, triangles_.begin() + task.end, [&](unsigned int l, unsigned int r) {
+                return refs[l].centroid[axis] < refs[r].centroid[axis];
+            });
+        }
+
+        const auto left = static_cast<unsigned int>(nodes_.size());
+        node.offset = left;
+        node.count = 0;
+        node.axis = axis;
+
+        nodes_.emplace_back();
+        nodes_.emplace_back();
+
+        tasks.push_back({left + 1, mid, task.end, task.depth + 1});
+        tasks.push_back({left, task.begin, mid, task.depth + 1});
+    }
+
+    const auto& root = nodes_.front();
+    boundingBox_.set(root.min[0], root.min[1], root.min[2], root.max[0], root.max[1], root.max[2]);
+}
+
+void MeshBVH::refit() {
+
+    snapshotVersions();
+
+    const auto position = geometry_.getAttribute("position");
+    if (!position || nodes_.empty()) return;
+
+    // children are always stored after their parent
+    Vector3 v;
+    for (auto i = static_cast<int>(nodes_.size()) - 1; i >= 0; i--) {
+
+        auto& node = nodes_[i];
+
+        if (node.count > 0) {
+
+            Bin bounds;
+            for (unsigned j = node.offset; j < node.offset + node.count; j++) {
+
+                unsigned int abc[3];
+                getTriangle(triangles_[j], abc[0], abc[1], abc[2]);
+
+                for (auto vertex : abc) {
+                    position->setFromBufferAttribute(v, vertex);
+                    const float p[3]{v.x, v.y, v.z};
+                    bounds.grow(p, p);
+                }
+            }
+            std::copy(bounds.min, bounds.min + 3, node.min);
+            std::copy(bounds.max, bounds.max + 3, node.max);
+
+        } else {
+
+            const auto& l = nodes_[node.offset];
+            const auto& r = nodes_[node.offset + 1];
+            for (int k = 0; k < 3; k++) {
+                node.min[k] = std::min(l.min[k], r.min[k]);
+                node.max[k] = std::max(l.max[k], r.max[k]);
+            }
+        }
+    }
+
+    const auto& root = nodes_.front();
+    boundingBox_.set(root.min[0], root.min[1], root.min[2], root.max[0], root.max[1], root.max[2]);
+}
+
+template<class Callback>
+void MeshBVH::traverse(const Ray& ray, float near, float& far, bool ordered, Callback&& callback) const {
+
+    if (nodes_.empty()) return;
+
+    const RayData data(ray);
+
+    struct Entry {
+        unsigned int node;
+        float tEnter;
+    };
+
+    Entry stack[maxStackSize];
+    unsigned int size = 0;
+
+    const float tRoot = slabTest(data, nodes_[0].min, nodes_[0].max, near, far);
+    if (std::isnan(tRoot)) return;
+    stack[size++] = {0, tRoot};
+
+    while (size > 0) {
+
+        const auto entry = stack[--size];
+        if (entry.tEnter > far) continue;// far may have shrunk since the entry was pushed
+
+        const auto& node = nodes_[entry.node];
+
+        if (node.count > 0) {
+
+            if (callback(node)) return;
+            continue;
+        }
+
+        auto first = node.offset;
+        auto second = node.offset + 1;
+        if (ordered && data.direction[node.axis] < 0) std::swap(first, second);
+
+        const float t1 = slabTest(data, nodes_[first].min, nodes_[first].max, near, far);
+        const float t2 = slabTest(data, nodes_[second].min, nodes_[second].max, near, far);
+
+        // push the farther child first so that the nearer one is visited first
+        if (!std::isnan(t2)) stack[size++] = {second, t2};
+        if (!std::isnan(t1)) stack[size++] = {first, t1};
+    }
+}
+
+std::optional<BVHHit> MeshBVH::closestHit(const Ray& ray, int side, float near, float far) const {
+
+    const auto position = geometry_.getAttribute("position");
+    if (!position) return std::nullopt;
+
+    const RayData data(ray);
+
+    std::optional<BVHHit> hit;
+    Vector3 a, b, c;
+
+    traverse(ray, near, far, true, [&](const Node& leaf) {
+        for (unsigned i = leaf.offset; i < leaf.offset + leaf.count; i++) {
+
+            const auto tri = triangles_[i];
+
+            unsigned int ia, ib, ic;
+            getTriangle(tri, ia, ib, ic);
+
+            position->setFromBufferAttribute(a, ia);
+            position->setFromBufferAttribute(b, ib);
+            position->setFromBufferAttribute(c, ic);
+
+            float t;
+            if (intersectTriangle(data, a, b, c, side, t) && t >= near && t <= far) {
+
+                far = t;
+                hit = BVHHit{t, {}, tri};
+            }
+        }
+        return false;
+    });
+
+    if (hit) {
+
+        ray.at(hit->distance, hit->point);
+    }
+
+    return hit;
+}
+
+bool MeshBVH::anyHit(const Ray& ray, int side, float near, float far) const {
+
+    const auto position = geometry_.getAttribute("position");
+    if (!position) return false;
+
+    const RayData data(ray);
+
+    bool found = false;
+    Vector3 a, b, c;
+
+    traverse(ray, near, far, false, [&](const Node& leaf) {
+        for (unsigned i = leaf.offset; i < leaf.offset + leaf.count; i++) {
+
+            unsigned int ia, ib, ic;
+            getTriangle(triangles_[i], ia, ib, ic);
+
+            position->setFromBufferAttribute(a, ia);
+            position->setFromBufferAttribute(b, ib);
+            position->setFromBufferAttribute(c, ic);
+
+            float t;
+            if (intersectTriangle(data, a, b, c, side, t) && t >= near && t <= far) {
+
+                found = true;
+                return true;
+            }
+        }
+        return false;
+    });
+
+    return found;
+}
+
+void MeshBVH::intersectPacket(BVHRayPacket& packet, int side, bool anyHit) const {
+
+    static_assert(BVHRayPacket::maxSize <= 32, "ray masks are 32 bit");
+
+    const auto size = std::min(packet.size, BVHRayPacket::maxSize);
+    std::fill(packet.hit, packet.hit + size, false);
+
+    const auto position = geometry_.getAttribute("position");
+    if (!position || nodes_.empty() || size == 0) return;
+
+    RayData rays[BVHRayPacket::maxSize];
+    for (unsigned r = 0; r < size; r++) {
+
+        rays[r] = RayData(packet.origin[0][r], packet.origin[1][r], packet.origin[2][r],
+                          packet.direction[0][r], packet.direction[1][r], packet.direction[2][r]);
+    }
+
+    // rays of the packet passing through a node
+    const auto raysThrough = [&](const Node& node, uint32_t mask) {
+        uint32_t result = 0;
+        for (unsigned r = 0; r < size; r++) {
+
+            if ((mask >> r & 1u) && !std::isnan(slabTest(rays[r], node.min, node.max, packet.near[r], packet.far[r]))) {
+
+                result |= 1u << r;
+            }
+        }
+        return result;
+    };
+
+    struct Entry {
+        unsigned int node;
+        uint32_t mask;
+    };
+
+    Entry stack[maxStackSize];
+    unsigned int stackSize = 0;
+
+    // rays that have stopped after their first hit
+    uint32_t done = 0;
+
+    const uint32_t all = size == 32 ? ~0u : (1u << size) - 1;
+    const auto rootMask = raysThrough(nodes_[0], all);
+    if (rootMask) stack[stackSize++] = {0, rootMask};
+
+    Vector3 a, b, c;
+
+    while (stackSize > 0) {
+
+        const auto entry = stack[--stackSize];
+        const auto& node = nodes_[entry.node];
+
+        // far may have shrunk for some rays since the entry was pushed
+        const auto mask = raysThrough(node, entry.mask & ~done);
+        if (!mask) continue;
+
+        if (node.count > 0) {
+
+            for (unsigned i = node.offset; i < node.offset + node.count; i++) {
+
+                const auto tri = triangles_[i];
+
+                unsigned int ia, ib, ic;
+                getTriangle(tri, ia, ib, ic);
+
+                position->setFromBufferAttribute(a, ia);
+                position->setFromBufferAttribute(b, ib);
+                position->setFromBufferAttribute(c, ic);
+
+                for (unsigned r = 0; r < size; r++) {
+
+                    if (!(mask >> r & 1u) || (done >> r & 1u)) continue;
+
+                    float t;
+                    if (intersectTriangle(rays[r], a, b, c, side, t) && t >= packet.near[r] && t <= packet.far[r]) {
+
+                        packet.far[r] = t;
+                        packet.hit[r] = true;
+                        packet.faceIndex[r] = tri;
+
+                        if (anyHit) done |= 1u << r;
+                    }
+                }
+            }
+
+            if (done == all) return;
+            continue;
+        }
+
+        // children are ordered by the direction of the first ray, rays of a packet are expected to be coherent
+        auto first = node.offset;
+        auto second = node.offset + 1;
+        unsigned lead = 0;
+        while (!(mask >> lead & 1u)) lead++;
+        if (rays[lead].direction[node.axis] < 0) std::swap(first, second);
+
+        stack[stackSize++] = {second, mask};
+        stack[stackSize++] = {first, mask};
+    }
+}
+
+void MeshBVH::intersectRay(const Ray& ray, const std::function<void(unsigned int)>& callback) const {
+
+    float far = Infinity<float>;
+
+    traverse(ray, 0, far, false, [&](const Node& leaf) {
+        for (unsigned i = leaf.offset; i < leaf.offset + leaf.count; i++) {
+
+            callback(triangles_[i]);
+        }
+        return false;
+    });
+}
+
+void MeshBVH::intersectBox(const Box3& box, const std::function<void(unsigned int)>& callback) const {
+
+    if (nodes_.empty()) return;
+
+    unsigned int stack[maxStackSize];
+    unsigned int size = 0;
+    stack[size++] = 0;
+
+    while (size > 0) {
+
+        const auto& node = nodes_[stack[--size]];
+
+        if (!boxesOverlap(node.min, node.max, box)) continue;
+
+        if (node.count > 0) {
+
+            for (unsigned i = node.offset; i < node.offset + node.count; i++) {
+
+                callback(triangles_[i]);
+            }
+
+        } else {
+
+            stack[size++] = node.offset + 1;
+            stack[size++] = node.offset;
+        }
+    }
+}
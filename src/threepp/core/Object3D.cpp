@@ -10,28 +10,97 @@
 
 #include "threepp/lights/Light.hpp"
 
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <mutex>
+
 using namespace threepp;
 
-Object3D::Object3D()
-    : uuid(math::generateUUID()),
-      matrix(std::make_shared<Matrix4>()),
-      matrixWorld(std::make_shared<Matrix4>()) {
+namespace {
 
-    rotation._onChange([this] {
-        quaternion.setFromEuler(rotation, false);
-    });
-    quaternion._onChange([this] {
-        rotation.setFromQuaternion(quaternion, std::nullopt, false);
-    });
+    // subtrees smaller than this are not worth a task of their own
+    constexpr unsigned int parallelUpdateGrainSize = 1024;
+
+    // set while an incremental update runs on the current thread
+    thread_local bool incrementalUpdate = false;
+
+    // objects with a matrixWorldSource met by the traversal, updated once it is done
+    struct Followers {
+
+        std::mutex mutex;
+        std::vector<Object3D*> objects;
+    };
+
+    // followers of the incremental update running on the current thread, null while they are updated
+    thread_local Followers* followers = nullptr;
+
+    struct IncrementalUpdateScope {
+
+        bool previous;
+        Followers* previousFollowers;
+
+        explicit IncrementalUpdateScope(Followers* current): previous(incrementalUpdate), previousFollowers(followers) {
+            incrementalUpdate = true;
+            followers = current;
+        }
+
+        ~IncrementalUpdateScope() {
+            incrementalUpdate = previous;
+            followers = previousFollowers;
+        }
+    };
+
+}// namespace
+
+Object3D::Object3D() {
+
+    rotation.observe(&rotationSync_);
+    quaternion.observe(&quaternionSync_);
+}
+
+const std::string& Object3D::uuid() const {
+
+    auto uuid = uuid_.load(std::memory_order_acquire);
+
+    if (!uuid) {
+
+        auto generated = std::make_unique<const std::string>(math::generateUUID());
+        if (uuid_.compare_exchange_strong(uuid, generated.get(), std::memory_order_acq_rel)) {
+
+            uuid = generated.release();
+        }
+    }
+
+    return *uuid;
+}
+
+void Object3D::RotationSync::update() {
+
+    stale_ = false;
+
+    if (rotation_) {
+
+        object_.rotation.setFromQuaternion(object_.quaternion, std::nullopt, false);
+
+    } else {
+
+        object_.quaternion.setFromEuler(object_.rotation, false);
+    }
+}
+
+void Object3D::RotationSync::changed() {
+
+    auto& other = rotation_ ? object_.quaternionSync_ : object_.rotationSync_;
+    other.stale_ = true;
 }
 
 void Object3D::applyMatrix4(const Matrix4& m) {
 
     if (this->matrixAutoUpdate) this->updateMatrix();
 
-    this->matrix->premultiply(m);
+    this->matrix.premultiply(m);
 
-    this->matrix->decompose(this->position, this->quaternion, this->scale);
+    this->matrix.decompose(this->position, this->quaternion, this->scale);
 }
 
 Object3D& Object3D::applyQuaternion(const Quaternion& q) {
@@ -142,14 +211,14 @@ Object3D& Object3D::translateZ(float distance) {
 
 void Object3D::localToWorld(Vector3& vector) const {
 
-    vector.applyMatrix4(*this->matrixWorld);
+    vector.applyMatrix4(this->matrixWorld);
 }
 
 void Object3D::worldToLocal(Vector3& vector) const {
 
     Matrix4 _m1{};
 
-    vector.applyMatrix4(_m1.copy(*this->matrixWorld).invert());
+    vector.applyMatrix4(_m1.copy(this->matrixWorld).invert());
 }
 
 void Object3D::lookAt(const Vector3& vector) {
@@ -170,7 +239,7 @@ void Object3D::lookAt(float x, float y, float z) {
 
     this->updateWorldMatrix(true, false);
 
-    _position.setFromMatrixPosition(*this->matrixWorld);
+    _position.setFromMatrixPosition(this->matrixWorld);
 
     if (this->is<Camera>() || this->is<Light>()) {
 
@@ -185,7 +254,7 @@ void Object3D::lookAt(float x, float y, float z) {
 
     if (parent) {
 
-        _m1.extractRotation(*parent->matrixWorld);
+        _m1.extractRotation(parent->matrixWorld);
         _q1.setFromRotationMatrix(_m1);
         this->quaternion.premultiply(_q1.invert());
     }
@@ -199,6 +268,7 @@ Object3D& Object3D::add(const std::shared_ptr<Object3D>& object) {
     }
 
     object->parent = this;
+    object->matrixWorldNeedsUpdate = true;
     this->children.emplace_back(object);
 
     object->dispatchEvent("added");
@@ -271,7 +341,7 @@ Vector3& Object3D::getWorldPosition(Vector3& target) {
 
     this->updateWorldMatrix(true, false);
 
-    return target.setFromMatrixPosition(*this->matrixWorld);
+    return target.setFromMatrixPosition(this->matrixWorld);
 }
 
 Quaternion& Object3D::getWorldQuaternion(Quaternion& target) {
@@ -281,7 +351,7 @@ Quaternion& Object3D::getWorldQuaternion(Quaternion& target) {
 
     this->updateWorldMatrix(true, false);
 
-    this->matrixWorld->decompose(_position, target, _scale);
+    this->matrixWorld.decompose(_position, target, _scale);
 
     return target;
 }
@@ -293,7 +363,7 @@ Vector3& Object3D::getWorldScale(Vector3& target) {
 
     this->updateWorldMatrix(true, false);
 
-    this->matrixWorld->decompose(_position, _quaternion, target);
+    this->matrixWorld.decompose(_position, _quaternion, target);
 
     return target;
 }
@@ -302,7 +372,7 @@ void Object3D::getWorldDirection(Vector3& target) {
 
     this->updateWorldMatrix(true, false);
 
-    const auto& e = this->matrixWorld->elements;
+    const auto& e = this->matrixWorld.elements;
 
     target.set(e[8], e[9], e[10]).normalize();
 }
@@ -341,24 +411,47 @@ void Object3D::traverseAncestors(const std::function<void(Object3D&)>& callback)
 
 void Object3D::updateMatrix() {
 
-    this->matrix->compose(this->position, this->quaternion, this->scale);
+    this->matrix.compose(this->position, this->quaternion, this->scale);
+
+    this->composedTransform_ = {position.x, position.y, position.z,
+                                quaternion.x(), quaternion.y(), quaternion.z(), quaternion.w(),
+                                scale.x, scale.y, scale.z};
 
     this->matrixWorldNeedsUpdate = true;
 }
 
+bool Object3D::transformChanged() const {
+
+    const auto& t = composedTransform_;
+
+    return t[0] != position.x || t[1] != position.y || t[2] != position.z ||
+           t[3] != quaternion.x() || t[4] != quaternion.y() || t[5] != quaternion.z() || t[6] != quaternion.w() ||
+           t[7] != scale.x || t[8] != scale.y || t[9] != scale.z;
+}
+
 void Object3D::updateMatrixWorld(bool force) {
 
-    if (this->matrixAutoUpdate) this->updateMatrix();
+    if (followers && this->matrixWorldSource()) {
+
+        // the source may not be updated yet, or be updated on another thread
+        std::lock_guard lock(followers->mutex);
+        followers->objects.emplace_back(this);
+        return;
+    }
+
+    this->beforeUpdateMatrixWorld();
+
+    if (this->matrixAutoUpdate && (!incrementalUpdate || transformChanged())) this->updateMatrix();
 
     if (this->matrixWorldNeedsUpdate || force) {
 
         if (!this->parent) {
 
-            this->matrixWorld->copy(*this->matrix);
+            this->matrixWorld.copy(this->matrix);
 
         } else {
 
-            this->matrixWorld->multiplyMatrices(*this->parent->matrixWorld, *this->matrix);
+            this->matrixWorld.multiplyMatrices(this->parent->matrixWorld, this->matrix);
         }
 
         this->matrixWorldNeedsUpdate = false;
@@ -366,12 +459,87 @@ void Object3D::updateMatrixWorld(bool force) {
         force = true;
     }
 
+    this->afterUpdateMatrixWorld();
+
     // update children
 
-    for (auto& child : this->children) {
+    if (incrementalUpdate) {
+
+        updateChildrenMatrixWorld(force);
+
+    } else {
+
+        for (auto& child : this->children) {
+
+            child->updateMatrixWorld(force);
+        }
+    }
+}
+
+void Object3D::updateMatrixWorldIncremental(bool force) {
+
+    Followers deferred;
+
+    {
+        IncrementalUpdateScope scope(&deferred);
+
+        this->updateMatrixWorld(force);
+    }
+
+    // the world matrices of the sources are final now, the followers copy them in beforeUpdateMatrixWorld
+    IncrementalUpdateScope scope(nullptr);
+
+    for (auto object : deferred.objects) {
+
+        object->updateMatrixWorld(force);
+    }
+}
+
+void Object3D::updateChildrenMatrixWorld(bool force) {
+
+    if (children.size() > 1 && subtreeSize_ >= 2 * parallelUpdateGrainSize) {
+
+        // batch consecutive children into tasks of roughly parallelUpdateGrainSize nodes,
+        // using the subtree sizes recorded by the previous update
+
+        utils::TaskGroup group;
+
+        size_t begin = 0;
+        unsigned int batchSize = 0;
+        for (size_t i = 0; i < children.size(); i++) {
+
+            batchSize += children[i]->subtreeSize_;
+
+            if (batchSize >= parallelUpdateGrainSize || i + 1 == children.size()) {
+
+                group.run([this, begin, end = i + 1, force, current = followers] {
+                    IncrementalUpdateScope scope(current);
+                    for (auto j = begin; j < end; j++) {
+                        children[j]->updateMatrixWorld(force);
+                    }
+                });
+
+                begin = i + 1;
+                batchSize = 0;
+            }
+        }
+
+        group.wait();
+
+    } else {
+
+        for (auto& child : this->children) {
 
-        child->updateMatrixWorld(force);
+            child->updateMatrixWorld(force);
+        }
     }
+
+    unsigned int size = 1;
+    for (const auto& child : this->children) {
+
+        size += child->subtreeSize_;
+    }
+    this->subtreeSize_ = size;
 }
 
 void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optional<bool> updateChildren) {
@@ -385,11 +553,11 @@ void Object3D::updateWorldMatrix(std::optional<bool> updateParents, std::optiona
 
     if (!this->parent) {
 
-        this->matrixWorld->copy(*this->matrix);
+        this->matrixWorld.copy(this->matrix);
 
     } else {
 
-        this->matrixWorld->multiplyMatrices(*this->parent->matrixWorld, *this->matrix);
+        this->matrixWorld.multiplyMatrices(this->parent->matrixWorld, this->matrix);
     }
 
     // update children
@@ -414,8 +582,8 @@ void Object3D::copy(const Object3D& source, bool recursive) {
     this->quaternion.copy(source.quaternion);
     this->scale.copy(source.scale);
 
-    this->matrix->copy(*source.matrix);
-    this->matrixWorld->copy(*source.matrixWorld);
+    this->matrix.copy(source.matrix);
+    this->matrixWorld.copy(source.matrixWorld);
 
     this->matrixAutoUpdate = source.matrixAutoUpdate;
     this->matrixWorldNeedsUpdate = source.matrixWorldNeedsUpdate;
@@ -447,4 +615,7 @@ std::shared_ptr<Object3D> Object3D::clone(bool recursive) {
     return clone;
 }
 
-Object3D::~Object3D() = default;
+Object3D::~Object3D() {
+
+    delete uuid_.load();
+}
@@ -73,14 +73,14 @@ void Raycaster::setFromCamera(const Vector2& coords, Camera* camera) {
 
     if (camera->is<PerspectiveCamera>()) {
 
-        this->ray.origin.setFromMatrixPosition(*camera->matrixWorld);
+        this->ray.origin.setFromMatrixPosition(camera->matrixWorld);
         this->ray.direction.set(coords.x, coords.y, 0.5f).unproject(*camera).sub(this->ray.origin).normalize();
         this->camera = camera;
 
     } else if (camera->is<OrthographicCamera>()) {
 
         this->ray.origin.set(coords.x, coords.y, (camera->near + camera->far) / (camera->near - camera->far)).unproject(*camera);// set origin in plane of camera
-        this->ray.direction.set(0, 0, -1).transformDirection(*camera->matrixWorld);
+        this->ray.direction.set(0, 0, -1).transformDirection(camera->matrixWorld);
         this->camera = camera;
 
     } else {
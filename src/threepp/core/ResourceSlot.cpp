@@ -0,0 +1,84 @@
+
+#include "threepp/core/ResourceSlot.hpp"
+
+#include <mutex>
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    // free list of slot indices with a generation counter per slot
+    class SlotAllocator {
+
+    public:
+        ResourceHandle acquire() {
+
+            std::lock_guard<std::mutex> lock(m_);
+
+            ++used_;
+
+            if (!free_.empty()) {
+
+                const auto index = free_.back();
+                free_.pop_back();
+
+                return {index, generations_[index]};
+            }
+
+            generations_.emplace_back(1);
+
+            return {static_cast<uint32_t>(generations_.size() - 1), 1};
+        }
+
+        void release(const ResourceHandle& handle) {
+
+            std::lock_guard<std::mutex> lock(m_);
+
+            --used_;
+
+            auto& generation = generations_[handle.index];
+            if (++generation == 0) generation = 1;
+
+            free_.emplace_back(handle.index);
+        }
+
+        size_t count() {
+
+            std::lock_guard<std::mutex> lock(m_);
+
+            return used_;
+        }
+
+    private:
+        std::mutex m_;
+        size_t used_ = 0;
+        std::vector<uint32_t> generations_;
+        std::vector<uint32_t> free_;
+    };
+
+    SlotAllocator& allocator(ResourceKind kind) {
+
+        // intentionally leaked, resources held by static objects may outlive any static allocator
+        static auto allocators = new SlotAllocator[4];
+
+        return allocators[static_cast<int>(kind)];
+    }
+
+}// namespace
+
+ResourceSlot::ResourceSlot(ResourceKind kind)
+    : kind_(kind), handle_(allocator(kind).acquire()) {}
+
+ResourceSlot::ResourceSlot(const ResourceSlot& other)
+    : ResourceSlot(other.kind_) {}
+
+size_t ResourceSlot::count(ResourceKind kind) {
+
+    return allocator(kind).count();
+}
+
+ResourceSlot::~ResourceSlot() {
+
+    allocator(kind_).release(handle_);
+}
@@ -0,0 +1,298 @@
+
+#include "threepp/core/TransformSystem.hpp"
+
+#include "threepp/core/Object3D.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <functional>
+
+using namespace threepp;
+
+namespace {
+
+    // objects handled per task
+    constexpr TransformSystem::Handle grainSize = 1024;
+
+    // flags kept per object by an update
+    constexpr std::uint8_t matrixChanged = 1;// local matrix recomposed, to be written back
+    constexpr std::uint8_t worldChanged = 2; // world matrix to be recomputed and written back
+    constexpr std::uint8_t followed = 4;     // world matrix depends on the source of a follower
+
+}// namespace
+
+TransformSystem::TransformSystem(Object3D& root)
+    : root_(root) {
+
+    rebuild();
+}
+
+void TransformSystem::rebuild() {
+
+    objects_.clear();
+    retained_.clear();
+    handles_.clear();
+    parents_.clear();
+    childCounts_.clear();
+    levelOffsets_.clear();
+
+    objects_.emplace_back(&root_);
+    parents_.emplace_back(invalidHandle);
+    levelOffsets_.emplace_back(0);
+
+    // breadth first, so every depth level is a contiguous range following the one of its parents
+    for (Handle levelBegin = 0; levelBegin < objects_.size();) {
+
+        const auto levelEnd = static_cast<Handle>(objects_.size());
+
+        for (auto i = levelBegin; i < levelEnd; i++) {
+
+            const auto& children = objects_[i]->children;
+            childCounts_.emplace_back(static_cast<unsigned int>(children.size()));
+
+            for (const auto& child : children) {
+
+                objects_.emplace_back(child.get());
+                retained_.emplace_back(child);
+                parents_.emplace_back(i);
+            }
+        }
+
+        levelOffsets_.emplace_back(levelEnd);
+        levelBegin = levelEnd;
+    }
+
+    const auto count = objects_.size();
+
+    handles_.reserve(count);
+    for (Handle i = 0; i < count; i++) {
+
+        handles_[objects_[i]] = i;
+    }
+
+    followers_.clear();
+    for (Handle i = 0; i < count; i++) {
+
+        // sources outside the arrays are up to date when the hooks copy them
+        const auto source = objects_[i]->matrixWorldSource();
+        const auto sourceHandle = source ? handle(*source) : invalidHandle;
+        if (sourceHandle != invalidHandle) followers_.emplace_back(i, sourceHandle);
+    }
+
+    for (auto array : {&positionX_, &positionY_, &positionZ_,
+                       &quaternionX_, &quaternionY_, &quaternionZ_, &quaternionW_,
+                       &scaleX_, &scaleY_, &scaleZ_}) {
+
+        array->assign(count, 0.f);
+    }
+
+    matrices_.assign(count, Matrix4());
+    matrixWorlds_.assign(count, Matrix4());
+    dirty_.assign(count, 0);
+
+    rebuilt_ = true;
+}
+
+TransformSystem::Handle TransformSystem::handle(const Object3D& object) const {
+
+    const auto it = handles_.find(&object);
+
+    return it == handles_.end() ? invalidHandle : it->second;
+}
+
+void TransformSystem::update(bool force) {
+
+    while (!prepare()) {
+
+        rebuild();
+    }
+
+    gather(force || rebuilt_);
+    sweep();
+    follow();
+    scatter();
+
+    rebuilt_ = false;
+}
+
+bool TransformSystem::prepare() {
+
+    for (Handle i = 0; i < objects_.size(); i++) {
+
+        auto& object = *objects_[i];
+
+        const auto parent = parents_[i];
+        if ((parent != invalidHandle && object.parent != objects_[parent]) || object.children.size() != childCounts_[i]) {
+
+            return false;
+        }
+
+        object.beforeUpdateMatrixWorld();
+    }
+
+    return true;
+}
+
+void TransformSystem::gather(bool force) {
+
+    utils::parallel_for(Handle(0), static_cast<Handle>(objects_.size()), grainSize, [&](Handle begin, Handle end) {
+        for (auto i = begin; i < end; i++) {
+
+            auto& object = *objects_[i];
+
+            std::uint8_t dirty = force || object.matrixWorldNeedsUpdate ? worldChanged : 0;
+
+            if (object.matrixAutoUpdate) {
+
+                const auto& p = object.position;
+                const auto& q = object.quaternion;
+                const auto& s = object.scale;
+
+                const float qx = q.x(), qy = q.y(), qz = q.z(), qw = q.w();
+
+                if (p.x != positionX_[i] || p.y != positionY_[i] || p.z != positionZ_[i] ||
+                    qx != quaternionX_[i] || qy != quaternionY_[i] || qz != quaternionZ_[i] || qw != quaternionW_[i] ||
+                    s.x != scaleX_[i] || s.y != scaleY_[i] || s.z != scaleZ_[i]) {
+
+                    positionX_[i] = p.x, positionY_[i] = p.y, positionZ_[i] = p.z;
+                    quaternionX_[i] = qx, quaternionY_[i] = qy, quaternionZ_[i] = qz, quaternionW_[i] = qw;
+                    scaleX_[i] = s.x, scaleY_[i] = s.y, scaleZ_[i] = s.z;
+
+                    dirty = worldChanged;
+                }
+
+                if (dirty) {
+
+                    matrices_[i].compose(p, q, s);
+                    dirty |= matrixChanged;
+                }
+
+            } else if (!object.matrix.equals(matrices_[i])) {
+
+                matrices_[i].copy(object.matrix);
+                dirty = worldChanged;
+            }
+
+            dirty_[i] = dirty;
+        }
+    });
+}
+
+void TransformSystem::sweep() {
+
+    // the root, relative to the world matrix of its parent if it has one
+
+    const auto& rootParentMatrixWorld = root_.parent ? root_.parent->matrixWorld : Matrix4();
+    if (!rootParentMatrixWorld.equals(rootParentMatrixWorld_)) {
+
+        rootParentMatrixWorld_.copy(rootParentMatrixWorld);
+        dirty_[0] |= worldChanged;
+    }
+
+    if (dirty_[0]) {
+
+        if (root_.parent) {
+
+            matrixWorlds_[0].multiplyMatrices(rootParentMatrixWorld_, matrices_[0]);
+
+        } else {
+
+            matrixWorlds_[0].copy(matrices_[0]);
+        }
+    }
+
+    // the parents of every level were computed by the one before it
+
+    for (size_t level = 1; level + 1 < levelOffsets_.size(); level++) {
+
+        utils::parallel_for(levelOffsets_[level], levelOffsets_[level + 1], grainSize, [&](Handle begin, Handle end) {
+            for (auto i = begin; i < end; i++) {
+
+                const auto parent = parents_[i];
+
+                if (dirty_[i] || dirty_[parent]) {
+
+                    matrixWorlds_[i].multiplyMatrices(matrixWorlds_[parent], matrices_[i]);
+                    dirty_[i] |= worldChanged;
+                }
+            }
+        });
+    }
+}
+
+void TransformSystem::follow() {
+
+    if (followers_.empty()) return;
+
+    for (const auto& [i, source] : followers_) {
+
+        matrices_[i].copy(matrixWorlds_[source]);
+        dirty_[i] |= followed;
+    }
+
+    if (dirty_[0] & followed) {
+
+        if (root_.parent) {
+
+            matrixWorlds_[0].multiplyMatrices(rootParentMatrixWorld_, matrices_[0]);
+
+        } else {
+
+            matrixWorlds_[0].copy(matrices_[0]);
+        }
+    }
+
+    // followers are sorted by handle, so levels above the first one are unaffected.
+    // A source depending on a follower is not swept again and stays one update behind.
+
+    const auto firstLevel = static_cast<size_t>(std::upper_bound(levelOffsets_.begin(), levelOffsets_.end(), followers_.front().first) - levelOffsets_.begin() - 1);
+
+    for (auto level = std::max<size_t>(firstLevel, 1); level + 1 < levelOffsets_.size(); level++) {
+
+        utils::parallel_for(levelOffsets_[level], levelOffsets_[level + 1], grainSize, [&](Handle begin, Handle end) {
+            for (auto i = begin; i < end; i++) {
+
+                const auto parent = parents_[i];
+
+                if ((dirty_[i] | dirty_[parent]) & followed) {
+
+                    matrixWorlds_[i].multiplyMatrices(matrixWorlds_[parent], matrices_[i]);
+                    dirty_[i] |= worldChanged | followed;
+                }
+            }
+        });
+    }
+
+    for (const auto& [i, source] : followers_) {
+
+        dirty_[i] |= matrixChanged | worldChanged;
+    }
+}
+
+void TransformSystem::scatter() {
+
+    updatedCount_ = utils::parallel_reduce(
+            Handle(0), static_cast<Handle>(objects_.size()), grainSize, size_t(0),
+            [&](Handle begin, Handle end) {
+                size_t updated = 0;
+                for (auto i = begin; i < end; i++) {
+
+                    if (!dirty_[i]) continue;
+
+                    auto& object = *objects_[i];
+
+                    if (dirty_[i] & matrixChanged) object.matrix.copy(matrices_[i]);
+                    object.matrixWorld.copy(matrixWorlds_[i]);
+                    object.matrixWorldNeedsUpdate = false;
+
+                    ++updated;
+                }
+                return updated;
+            },
+            std::plus<>());
+
+    for (Handle i = 0; i < objects_.size(); i++) {
+
+        if (dirty_[i]) objects_[i]->afterUpdateMatrixWorld();
+    }
+}
@@ -29,7 +29,8 @@ std::shared_ptr<Box3Helper> Box3Helper::create(const Box3& box, const Color& col
     return std::shared_ptr<Box3Helper>(new Box3Helper(box, color));
 }
 
-void Box3Helper::updateMatrixWorld(bool force) {
+void Box3Helper::beforeUpdateMatrixWorld() {
+
     if (box.isEmpty()) return;
 
     box.getCenter(this->position);
@@ -37,6 +38,4 @@ void Box3Helper::updateMatrixWorld(bool force) {
     box.getSize(this->scale);
 
     this->scale.multiplyScalar(0.5);
-
-    LineSegments::updateMatrixWorld(force);
 }
@@ -91,7 +91,7 @@ CameraHelper::CameraHelper(const std::shared_ptr<Camera>& camera)
 
     camera->updateProjectionMatrix();
 
-    this->matrix = camera->matrixWorld;
+    this->matrix.copy(this->camera->matrixWorld);
     this->matrixAutoUpdate = false;
 
     update();
@@ -102,6 +102,18 @@ std::shared_ptr<CameraHelper> CameraHelper::create(const std::shared_ptr<Camera>
     return std::shared_ptr<CameraHelper>(new CameraHelper(camera));
 }
 
+void CameraHelper::beforeUpdateMatrixWorld() {
+
+    // the world matrix of the camera is the local matrix of the helper
+    this->matrix.copy(this->camera->matrixWorld);
+    this->matrixWorldNeedsUpdate = true;
+}
+
+const Object3D* CameraHelper::matrixWorldSource() const {
+
+    return this->camera.get();
+}
+
 void CameraHelper::update() {
 
     float w = 1, h = 1;
@@ -12,7 +12,7 @@ DirectionalLightHelper::DirectionalLightHelper(std::shared_ptr<DirectionalLight>
 
     this->light->updateMatrixWorld();
 
-    this->matrix = this->light->matrixWorld;
+    this->matrix.copy(this->light->matrixWorld);
     this->matrixAutoUpdate = false;
 
     auto geometry = BufferGeometry::create();
@@ -41,14 +41,26 @@ DirectionalLightHelper::DirectionalLightHelper(std::shared_ptr<DirectionalLight>
     this->update();
 }
 
+void DirectionalLightHelper::beforeUpdateMatrixWorld() {
+
+    // the world matrix of the light is the local matrix of the helper
+    this->matrix.copy(this->light->matrixWorld);
+    this->matrixWorldNeedsUpdate = true;
+}
+
+const Object3D* DirectionalLightHelper::matrixWorldSource() const {
+
+    return this->light.get();
+}
+
 void DirectionalLightHelper::update() {
 
     static Vector3 _v1;
     static Vector3 _v2;
     static Vector3 _v3;
 
-    _v1.setFromMatrixPosition(*this->light->matrixWorld);
-    _v2.setFromMatrixPosition(*this->light->target->matrixWorld);
+    _v1.setFromMatrixPosition(this->light->matrixWorld);
+    _v2.setFromMatrixPosition(this->light->target->matrixWorld);
     _v3.subVectors(_v2, _v1);
 
     this->lightPlane->lookAt(_v2);
@@ -28,7 +28,7 @@ struct HemisphereLightHelper::Impl {
         : scope(scope), light(light) {
 
         this->light.updateMatrixWorld();
-        this->scope.matrix = light.matrixWorld;
+        this->scope.matrix.copy(light.matrixWorld);
         this->scope.matrixAutoUpdate = false;
 
         auto geometry = OctahedronGeometry::create(size);
@@ -76,7 +76,7 @@ struct HemisphereLightHelper::Impl {
             colors->needsUpdate();
         }
 
-        mesh->lookAt(_vector.setFromMatrixPosition(*this->light.matrixWorld).negate());
+        mesh->lookAt(_vector.setFromMatrixPosition(this->light.matrixWorld).negate());
     }
 
     void dispose() {
@@ -100,6 +100,18 @@ void threepp::HemisphereLightHelper::update() {
     pimpl_->update();
 }
 
+void threepp::HemisphereLightHelper::beforeUpdateMatrixWorld() {
+
+    // the world matrix of the light is the local matrix of the helper
+    this->matrix.copy(pimpl_->light.matrixWorld);
+    this->matrixWorldNeedsUpdate = true;
+}
+
+const Object3D* threepp::HemisphereLightHelper::matrixWorldSource() const {
+
+    return &pimpl_->light;
+}
+
 void threepp::HemisphereLightHelper::dispose() {
 
     pimpl_->dispose();
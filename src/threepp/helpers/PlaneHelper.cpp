@@ -41,7 +41,7 @@ std::shared_ptr<PlaneHelper> PlaneHelper::create(const Plane& plane, float size,
     return std::shared_ptr<PlaneHelper>(new PlaneHelper(plane, size, color));
 }
 
-void PlaneHelper::updateMatrixWorld(bool force) {
+void PlaneHelper::beforeUpdateMatrixWorld() {
 
     auto scale = -plane.constant;
     if (std::abs(scale) < 1e-8) scale = 1e-8f;
@@ -51,6 +51,4 @@ void PlaneHelper::updateMatrixWorld(bool force) {
     this->children[0]->material()->side = (scale < 0) ? BackSide : FrontSide;// renderer flips side when determinant < 0; flipping not wanted here
 
     this->lookAt(this->plane.normal);
-
-    Object3D::updateMatrixWorld(force);
 }
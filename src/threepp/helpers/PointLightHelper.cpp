@@ -19,7 +19,7 @@ PointLightHelper::PointLightHelper(std::shared_ptr<PointLight> light, float sphe
 
     this->light->updateMatrixWorld();
 
-    this->matrix = this->light->matrixWorld;
+    this->matrix.copy(this->light->matrixWorld);
     this->matrixAutoUpdate = false;
 
     update();
@@ -30,6 +30,18 @@ std::shared_ptr<PointLightHelper> PointLightHelper::create(const std::shared_ptr
     return std::shared_ptr<PointLightHelper>(new PointLightHelper(light, sphereSize, color));
 }
 
+void PointLightHelper::beforeUpdateMatrixWorld() {
+
+    // the world matrix of the light is the local matrix of the helper
+    this->matrix.copy(this->light->matrixWorld);
+    this->matrixWorldNeedsUpdate = true;
+}
+
+const Object3D* PointLightHelper::matrixWorldSource() const {
+
+    return this->light.get();
+}
+
 void PointLightHelper::update() {
 
     if (this->color) {
@@ -14,7 +14,7 @@ SpotLightHelper::SpotLightHelper(std::shared_ptr<SpotLight> light, std::optional
 
     this->light->updateMatrixWorld();
 
-    this->matrix = this->light->matrixWorld;
+    this->matrix.copy(this->light->matrixWorld);
     this->matrixAutoUpdate = false;
 
     auto geometry = BufferGeometry::create();
@@ -53,6 +53,18 @@ std::shared_ptr<SpotLightHelper> SpotLightHelper::create(const std::shared_ptr<S
     return std::shared_ptr<SpotLightHelper>(new SpotLightHelper(light, color));
 }
 
+void SpotLightHelper::beforeUpdateMatrixWorld() {
+
+    // the world matrix of the light is the local matrix of the helper
+    this->matrix.copy(this->light->matrixWorld);
+    this->matrixWorldNeedsUpdate = true;
+}
+
+const Object3D* SpotLightHelper::matrixWorldSource() const {
+
+    return this->light.get();
+}
+
 void SpotLightHelper::update() {
 
     this->light->updateMatrixWorld();
@@ -63,7 +75,7 @@ void SpotLightHelper::update() {
     this->cone->scale.set(coneWidth, coneWidth, coneLength);
 
     static Vector3 _vector;
-    _vector.setFromMatrixPosition(*this->light->target->matrixWorld);
+    _vector.setFromMatrixPosition(this->light->target->matrixWorld);
 
     this->cone->lookAt(_vector);
 
@@ -7,12 +7,18 @@
 #include "threepp/objects/LineSegments.hpp"
 #include "threepp/objects/Mesh.hpp"
 #include "threepp/objects/Points.hpp"
+#include "threepp/utils/MemoryMappedFile.hpp"
 #include "threepp/utils/StringUtils.hpp"
+#include "threepp/utils/ThreadPool.hpp"
 
+#include <atomic>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -30,12 +36,33 @@ namespace {
         return (index > 0 ? (index - 1) : index + len / 2) * 2;
     }
 
+    // zero based indices into the global arrays, -1 if absent
+    struct FaceCorner {
+        int v;
+        int vt;
+        int vn;
+    };
+
+    struct CornerSpan {
+        const FaceCorner* corners;
+        size_t count;
+    };
+
     struct OBJGeometry {
         std::string type;
         std::vector<float> vertices;
         std::vector<float> normals;
         std::vector<float> colors;
         std::vector<float> uvs;
+
+        // fast path: corners are expanded straight into the attributes once all objects are known
+        std::vector<CornerSpan> spans;
+        size_t streamedCount = 0;
+        std::shared_ptr<BufferGeometry> bufferGeometry;
+
+        [[nodiscard]] size_t vertexCount() const {
+            return vertices.size() / 3 + streamedCount;
+        }
     };
 
     struct OBJMaterial {
@@ -97,7 +124,7 @@ namespace {
             auto lastMultiMaterial = currentMaterial();
             if (lastMultiMaterial && lastMultiMaterial->groupEnd == -1) {
 
-                lastMultiMaterial->groupEnd = static_cast<int>(geometry.vertices.size()) / 3;
+                lastMultiMaterial->groupEnd = static_cast<int>(geometry.vertexCount());
                 lastMultiMaterial->groupCount = lastMultiMaterial->groupEnd - lastMultiMaterial->groupStart;
                 lastMultiMaterial->inherited = false;
             }
@@ -266,6 +293,24 @@ namespace {
             }
         }
 
+        // a polyline, drawn as line segments between consecutive vertices
+        void addLineGeometry(const std::vector<std::string>& verts, const std::vector<std::string>& uvIndices) {
+
+            object->geometry.type = "Line";
+
+            const auto vLen = vertices.size();
+            for (size_t i = 1; i < verts.size(); i++) {
+                addVertexPointOrLine(parseVertexOrNormalIndex(verts[i - 1], vLen));
+                addVertexPointOrLine(parseVertexOrNormalIndex(verts[i], vLen));
+            }
+
+            const auto uvLen = uvs.size();
+            for (size_t i = 1; i < uvIndices.size(); i++) {
+                addUvLine(parseUvIndex(uvIndices[i - 1], uvLen));
+                addUvLine(parseUvIndex(uvIndices[i], uvLen));
+            }
+        }
+
         void addPointGeometry(const std::vector<std::string>& verts) {
 
             object->geometry.type = "Points";
@@ -278,6 +323,275 @@ namespace {
         }
     };
 
+    struct ParseEvent {
+
+        enum class Type {
+            Object,
+            UseMaterial,
+            MaterialLibrary,
+            Smooth,
+            Points,
+            Line
+        };
+
+        Type type;
+        size_t corner;// number of corners emitted by the chunk before this event
+        std::string value;
+    };
+
+    struct OBJChunk {
+        const char* begin;
+        const char* end;
+
+        size_t vertexCount = 0;
+        size_t normalCount = 0;
+        size_t uvCount = 0;
+
+        size_t vertexOffset = 0;
+        size_t normalOffset = 0;
+        size_t uvOffset = 0;
+
+        std::vector<float> colors;// empty unless a vertex in the chunk has a color
+        std::vector<FaceCorner> corners;
+        std::vector<ParseEvent> events;
+    };
+
+    // calls f(begin, end) for every non-blank line, leading blanks and line endings are stripped
+    template<class F>
+    void forEachLine(const char* begin, const char* end, F&& f) {
+
+        while (begin < end) {
+
+            auto eol = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+            if (!eol) eol = end;
+
+            auto lineEnd = eol;
+            if (lineEnd > begin && lineEnd[-1] == '\r') --lineEnd;
+
+            utils::skipBlanks(begin, lineEnd);
+            if (begin < lineEnd) f(begin, lineEnd);
+
+            begin = eol + 1;
+        }
+    }
+
+    bool isBlank(const char* it, const char* end) {
+        return it == end || *it == ' ' || *it == '\t';
+    }
+
+    bool startsWith(const char* it, const char* end, const char* keyword) {
+        const auto len = std::strlen(keyword);
+        return static_cast<size_t>(end - it) > len && std::memcmp(it, keyword, len) == 0 && isBlank(it + len, end);
+    }
+
+    // 'v', 'n' or 't' for vertex, normal and uv lines
+    char vertexLineType(const char* it, const char* end) {
+        if (isBlank(it + 1, end)) return 'v';
+        if (it[1] == 'n' && isBlank(it + 2, end)) return 'n';
+        if (it[1] == 't' && isBlank(it + 2, end)) return 't';
+        return 0;
+    }
+
+    std::runtime_error unexpectedLine(const char* it, const char* end) {
+        return std::runtime_error("[OBJLoader] Unexpected line: " + std::string(it, end));
+    }
+
+    int resolveIndex(int index, size_t count, const char* line, const char* end) {
+        const auto resolved = index > 0 ? static_cast<long long>(index) - 1 : static_cast<long long>(count) + index;
+        if (resolved < 0 || resolved >= static_cast<long long>(count)) throw unexpectedLine(line, end);
+        return static_cast<int>(resolved);
+    }
+
+    void countChunk(OBJChunk& chunk) {
+
+        forEachLine(chunk.begin, chunk.end, [&](const char* it, const char* end) {
+            if (*it != 'v') return;
+
+            switch (vertexLineType(it, end)) {
+                case 'v': ++chunk.vertexCount; break;
+                case 'n': ++chunk.normalCount; break;
+                case 't': ++chunk.uvCount; break;
+                default: break;
+            }
+        });
+    }
+
+    void parseChunk(OBJChunk& chunk, float* vertices, float* normals, float* uvs) {
+
+        auto v = chunk.vertexOffset;
+        auto n = chunk.normalOffset;
+        auto t = chunk.uvOffset;
+
+        std::vector<FaceCorner> polygon;
+
+        forEachLine(chunk.begin, chunk.end, [&](const char* line, const char* end) {
+            auto it = line;
+            const auto first = *it;
+
+            if (first == '#') return;
+
+            if (first == 'v') {
+
+                switch (vertexLineType(it, end)) {
+                    case 'v': {
+                        ++it;
+                        auto dst = vertices + v * 3;
+                        if (!utils::parseFloat(it, end, dst[0]) ||
+                            !utils::parseFloat(it, end, dst[1]) ||
+                            !utils::parseFloat(it, end, dst[2])) {
+                            throw unexpectedLine(line, end);
+                        }
+
+                        float rgb[3];
+                        if (utils::parseFloat(it, end, rgb[0]) &&
+                            utils::parseFloat(it, end, rgb[1]) &&
+                            utils::parseFloat(it, end, rgb[2])) {
+
+                            if (chunk.colors.empty()) chunk.colors.assign(chunk.vertexCount * 3, 1);
+                            std::copy(rgb, rgb + 3, chunk.colors.begin() + static_cast<long>((v - chunk.vertexOffset) * 3));
+                        }
+                        ++v;
+                        break;
+                    }
+                    case 'n': {
+                        it += 2;
+                        auto dst = normals + n * 3;
+                        if (!utils::parseFloat(it, end, dst[0]) ||
+                            !utils::parseFloat(it, end, dst[1]) ||
+                            !utils::parseFloat(it, end, dst[2])) {
+                            throw unexpectedLine(line, end);
+                        }
+                        ++n;
+                        break;
+                    }
+                    case 't': {
+                        it += 2;
+                        auto dst = uvs + t * 2;
+                        if (!utils::parseFloat(it, end, dst[0])) throw unexpectedLine(line, end);
+                        if (!utils::parseFloat(it, end, dst[1])) dst[1] = 0;
+                        ++t;
+                        break;
+                    }
+                    default:
+                        break;
+                }
+
+            } else if (first == 'f') {
+
+                ++it;
+                polygon.clear();
+
+                int index;
+                while (utils::parseInt(it, end, index)) {
+
+                    FaceCorner corner{resolveIndex(index, v, line, end), -1, -1};
+
+                    if (it < end && *it == '/') {
+                        ++it;
+                        if (it < end && *it != '/') {
+                            if (!utils::parseInt(it, end, index)) throw unexpectedLine(line, end);
+                            corner.vt = resolveIndex(index, t, line, end);
+                        }
+                        if (it < end && *it == '/') {
+                            ++it;
+                            if (!utils::parseInt(it, end, index)) throw unexpectedLine(line, end);
+                            corner.vn = resolveIndex(index, n, line, end);
+                        }
+                    }
+
+                    polygon.emplace_back(corner);
+                }
+
+                utils::skipBlanks(it, end);
+                if (it != end) throw unexpectedLine(line, end);
+
+                for (size_t j = 1; j + 1 < polygon.size(); ++j) {
+                    chunk.corners.insert(chunk.corners.end(), {polygon[0], polygon[j], polygon[j + 1]});
+                }
+
+            } else if (first == 'l') {
+
+                ++it;
+                chunk.events.push_back({ParseEvent::Type::Line, chunk.corners.size(), {}});
+                polygon.clear();
+
+                int index;
+                while (utils::parseInt(it, end, index)) {
+
+                    FaceCorner corner{resolveIndex(index, v, line, end), -1, -1};
+
+                    if (it < end && *it == '/') {
+                        ++it;
+                        if (!utils::parseInt(it, end, index)) throw unexpectedLine(line, end);
+                        corner.vt = resolveIndex(index, t, line, end);
+                    }
+
+                    polygon.emplace_back(corner);
+                }
+
+                utils::skipBlanks(it, end);
+                if (it != end) throw unexpectedLine(line, end);
+
+                // a polyline, drawn as line segments between consecutive vertices
+                for (size_t j = 1; j < polygon.size(); ++j) {
+                    chunk.corners.insert(chunk.corners.end(), {polygon[j - 1], polygon[j]});
+                }
+
+            } else if (first == 'p') {
+
+                ++it;
+                chunk.events.push_back({ParseEvent::Type::Points, chunk.corners.size(), {}});
+
+                int index;
+                while (utils::parseInt(it, end, index)) {
+                    chunk.corners.push_back({resolveIndex(index, v, line, end), -1, -1});
+                }
+
+            } else if (first == 's' && isBlank(it + 1, end)) {
+
+                chunk.events.push_back({ParseEvent::Type::Smooth, chunk.corners.size(), utils::trim(std::string(it + 1, end))});
+
+            } else if (first == 'o' || first == 'g') {
+
+                chunk.events.push_back({ParseEvent::Type::Object, chunk.corners.size(), utils::trim(std::string(it + 1, end))});
+
+            } else if (startsWith(it, end, "usemtl")) {
+
+                chunk.events.push_back({ParseEvent::Type::UseMaterial, chunk.corners.size(), utils::trim(std::string(it + 6, end))});
+
+            } else if (startsWith(it, end, "mtllib")) {
+
+                chunk.events.push_back({ParseEvent::Type::MaterialLibrary, chunk.corners.size(), utils::trim(std::string(it + 6, end))});
+
+            } else {
+
+                throw unexpectedLine(line, end);
+            }
+        });
+    }
+
+    // serializes progress callbacks from worker threads and keeps the reported value monotonic
+    class ProgressReporter {
+
+    public:
+        explicit ProgressReporter(const std::function<void(float)>& callback): callback_(callback) {}
+
+        void report(float progress) {
+            if (!callback_) return;
+
+            std::lock_guard<std::mutex> lock(m_);
+            if (progress > last_) {
+                last_ = progress;
+                callback_(progress);
+            }
+        }
+
+    private:
+        const std::function<void(float)>& callback_;
+        std::mutex m_;
+        float last_ = 0;
+    };
+
 }// namespace
 
 struct OBJLoader::Impl {
@@ -305,8 +619,6 @@ struct OBJLoader::Impl {
             return nullptr;
         }
 
-        std::ifstream in(path);
-
         if (tryLoadMtl) {
             std::filesystem::path mtlFile{path.parent_path() / (path.stem().string() + ".mtl")};
             if (std::filesystem::exists(mtlFile)) {
@@ -317,6 +629,34 @@ struct OBJLoader::Impl {
 
         ParserState state;
 
+        if (scope.fastMode) {
+            parseFast(path, state);
+        } else {
+            parse(path, state);
+        }
+
+        auto container = Group::create();
+
+        for (const auto& object : state.objects) {
+
+            auto& geometry = object->geometry;
+
+            if (geometry.vertexCount() == 0) continue;
+
+            auto bufferGeometry = geometry.bufferGeometry ? geometry.bufferGeometry : createBufferGeometry(geometry);
+
+            container->add(createObject(*object, bufferGeometry));
+        }
+
+        if (scope.useCache) cache_[path.string()] = container;
+
+        return container;
+    }
+
+    static void parse(const std::filesystem::path& path, ParserState& state) {
+
+        std::ifstream in(path);
+
         std::string line;
         while (std::getline(in, line)) {
             utils::trimStartInplace(line);
@@ -381,7 +721,20 @@ struct OBJLoader::Impl {
 
             } else if (lineFirstChar == 'l') {
 
-                // TODO
+                auto lineData = utils::trim(line.substr(1));
+                std::vector<std::string> lineVertices;
+                std::vector<std::string> lineUVs;
+
+                for (const auto& part : utils::split(lineData, ' ')) {
+
+                    auto parts = utils::split(part, '/');
+                    if (parts.empty()) continue;
+
+                    if (!parts[0].empty()) lineVertices.emplace_back(parts[0]);
+                    if (parts.size() > 1 && !parts[1].empty()) lineUVs.emplace_back(parts[1]);
+                }
+
+                state.addLineGeometry(lineVertices, lineUVs);
 
             } else if (lineFirstChar == 'p') {
 
@@ -435,122 +788,348 @@ struct OBJLoader::Impl {
         }
 
         state.finalize();
+    }
 
-        auto container = Group::create();
+    static std::shared_ptr<BufferGeometry> createBufferGeometry(const OBJGeometry& geometry) {
 
-        for (const auto& object : state.objects) {
+        auto bufferGeometry = BufferGeometry::create();
 
-            auto& geometry = object->geometry;
-            auto& materials = object->materials;
-            bool isLine = geometry.type == "Line";
-            bool isPoints = geometry.type == "Points";
-            bool hasVertexColors = false;
+        bufferGeometry->setAttribute("position", FloatBufferAttribute::create(geometry.vertices, 3));
 
-            if (geometry.vertices.empty()) continue;
+        if (!geometry.normals.empty()) {
 
-            auto bufferGeometry = BufferGeometry::create();
+            bufferGeometry->setAttribute("normal", FloatBufferAttribute::create(geometry.normals, 3));
 
-            bufferGeometry->setAttribute("position", FloatBufferAttribute::create(geometry.vertices, 3));
+        } else {
 
-            if (!geometry.normals.empty()) {
+            //TODO
+        }
 
-                bufferGeometry->setAttribute("normal", FloatBufferAttribute::create(geometry.normals, 3));
+        if (!geometry.colors.empty()) {
 
-            } else {
+            bufferGeometry->setAttribute("color", FloatBufferAttribute::create(geometry.colors, 3));
+        }
 
-                //TODO
-            }
+        if (!geometry.uvs.empty()) {
 
-            if (!geometry.colors.empty()) {
+            bufferGeometry->setAttribute("uv", FloatBufferAttribute::create(geometry.uvs, 2));
+        }
 
-                bufferGeometry->setAttribute("color", FloatBufferAttribute::create(geometry.colors, 3));
-            }
+        return bufferGeometry;
+    }
 
-            if (!geometry.uvs.empty()) {
+    std::shared_ptr<Object3D> createObject(const OBJObject& object, const std::shared_ptr<BufferGeometry>& bufferGeometry) {
 
-                bufferGeometry->setAttribute("uv", FloatBufferAttribute::create(geometry.uvs, 2));
-            }
+        auto& geometry = object.geometry;
+        auto& materials = object.materials;
+        bool isLine = geometry.type == "Line";
+        bool isPoints = geometry.type == "Points";
+        bool hasVertexColors = false;
 
-            std::vector<std::shared_ptr<Material>> createdMaterials;
+        std::vector<std::shared_ptr<Material>> createdMaterials;
 
-            for (auto& sourceMaterial : materials) {
+        for (auto& sourceMaterial : materials) {
 
-                std::shared_ptr<Material> material;
+            std::shared_ptr<Material> material;
 
-                if (this->materials) {
-                    material = this->materials->create(sourceMaterial->name);
+            if (this->materials) {
+                material = this->materials->create(sourceMaterial->name);
 
-                    if (isLine && material && !material->is<LineBasicMaterial>()) {
+                if (isLine && material && !material->is<LineBasicMaterial>()) {
 
-                        // TODO
+                    // TODO
 
-                    } else if (isPoints && material && !material->is<PointsMaterial>()) {
+                } else if (isPoints && material && !material->is<PointsMaterial>()) {
 
-                        // TODO
-                    }
+                    // TODO
                 }
+            }
 
-                if (!material) {
-
-                    if (isLine) {
-                        material = LineBasicMaterial::create();
-                    } else if (isPoints) {
-                        auto pointsMaterial = PointsMaterial::create();
-                        pointsMaterial->size = 1;
-                        pointsMaterial->sizeAttenuation = false;
-                        material = std::move(pointsMaterial);
-                    } else {
-                        material = MeshPhongMaterial::create();
-                    }
+            if (!material) {
 
-                    material->name = sourceMaterial->name;
+                if (isLine) {
+                    material = LineBasicMaterial::create();
+                } else if (isPoints) {
+                    auto pointsMaterial = PointsMaterial::create();
+                    pointsMaterial->size = 1;
+                    pointsMaterial->sizeAttenuation = false;
+                    material = std::move(pointsMaterial);
+                } else {
+                    material = MeshPhongMaterial::create();
                 }
 
-                material->vertexColors = hasVertexColors;
-                if (material->is<MaterialWithFlatShading>()) {
-                    std::dynamic_pointer_cast<MaterialWithFlatShading>(material)->flatShading = !sourceMaterial->smooth;
-                }
+                material->name = sourceMaterial->name;
+            }
 
-                createdMaterials.emplace_back(material);
+            material->vertexColors = hasVertexColors;
+            if (material->is<MaterialWithFlatShading>()) {
+                std::dynamic_pointer_cast<MaterialWithFlatShading>(material)->flatShading = !sourceMaterial->smooth;
             }
 
-            std::shared_ptr<Object3D> mesh;
+            createdMaterials.emplace_back(material);
+        }
 
-            if (!createdMaterials.empty()) {
+        std::shared_ptr<Object3D> mesh;
 
-                for (int mi = 0; mi < materials.size(); ++mi) {
+        if (!createdMaterials.empty()) {
 
-                    auto& sourceMaterial = materials.at(mi);
-                    bufferGeometry->addGroup(sourceMaterial->groupStart, sourceMaterial->groupCount, mi);
-                }
+            for (unsigned mi = 0; mi < materials.size(); ++mi) {
 
-                if (isLine) {
-                    mesh = LineSegments::create(bufferGeometry, createdMaterials.front());
-                } else if (isPoints) {
-                    mesh = Points::create(bufferGeometry, createdMaterials.front());
-                } else {
-                    mesh = Mesh::create(bufferGeometry, createdMaterials);
-                }
+                auto& sourceMaterial = materials.at(mi);
+                bufferGeometry->addGroup(sourceMaterial->groupStart, sourceMaterial->groupCount, static_cast<int>(mi));
+            }
 
+            if (isLine) {
+                mesh = LineSegments::create(bufferGeometry, createdMaterials.front());
+            } else if (isPoints) {
+                mesh = Points::create(bufferGeometry, createdMaterials.front());
             } else {
+                mesh = Mesh::create(bufferGeometry, createdMaterials);
+            }
 
-                if (isLine) {
-                    mesh = LineSegments::create(bufferGeometry, createdMaterials.front());
-                } else if (isPoints) {
-                    mesh = Points::create(bufferGeometry, createdMaterials.front());
-                } else {
-                    mesh = Mesh::create(bufferGeometry, createdMaterials.front());
+        } else {
+
+            if (isLine) {
+                mesh = LineSegments::create(bufferGeometry, createdMaterials.front());
+            } else if (isPoints) {
+                mesh = Points::create(bufferGeometry, createdMaterials.front());
+            } else {
+                mesh = Mesh::create(bufferGeometry, createdMaterials.front());
+            }
+        }
+
+        mesh->name = object.name;
+
+        return mesh;
+    }
+
+    // Memory maps the file and parses chunks split at line boundaries in parallel:
+    // the v/vn/vt lines of every chunk are counted first so that each chunk knows
+    // where its data goes in the global arrays and can resolve relative indices,
+    // then the chunks are parsed, their object/material statements replayed in order,
+    // and the face corners expanded straight into the attribute storage.
+    void parseFast(const std::filesystem::path& path, ParserState& state) const {
+
+        ProgressReporter progress(scope.onProgress);
+
+        utils::MemoryMappedFile file(path);
+        const auto data = file.data();
+        const auto size = file.size();
+
+        constexpr size_t minChunkSize = 1 << 20;
+        const size_t maxChunks = utils::ThreadPool::instance().threadCount() * 8;
+        const size_t numChunks = std::max(size_t(1), std::min(maxChunks, size / minChunkSize));
+
+        std::vector<OBJChunk> chunks;
+        chunks.reserve(numChunks);
+
+        const char* chunkBegin = data;
+        for (size_t i = 1; i <= numChunks && chunkBegin < data + size; i++) {
+
+            const char* chunkEnd = data + size * i / numChunks;
+            if (i == numChunks) {
+                chunkEnd = data + size;
+            } else if (chunkEnd < chunkBegin) {
+                continue;
+            } else {
+                auto eol = static_cast<const char*>(std::memchr(chunkEnd, '\n', data + size - chunkEnd));
+                chunkEnd = eol ? eol + 1 : data + size;
+            }
+
+            auto& chunk = chunks.emplace_back();
+            chunk.begin = chunkBegin;
+            chunk.end = chunkEnd;
+            chunkBegin = chunkEnd;
+        }
+
+        std::atomic<size_t> done{0};
+        const auto reportChunk = [&](float from, float to) {
+            progress.report(from + (to - from) * static_cast<float>(++done) / static_cast<float>(chunks.size()));
+        };
+
+        utils::parallel_for(size_t(0), chunks.size(), size_t(1), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+                countChunk(chunks[i]);
+                reportChunk(0.f, 0.1f);
+            }
+        });
+
+        size_t vertexCount = 0, normalCount = 0, uvCount = 0;
+        for (auto& chunk : chunks) {
+            chunk.vertexOffset = vertexCount;
+            chunk.normalOffset = normalCount;
+            chunk.uvOffset = uvCount;
+            vertexCount += chunk.vertexCount;
+            normalCount += chunk.normalCount;
+            uvCount += chunk.uvCount;
+        }
+
+        state.vertices.resize(vertexCount * 3);
+        state.normals.resize(normalCount * 3);
+        state.uvs.resize(uvCount * 2);
+
+        done = 0;
+        utils::parallel_for(size_t(0), chunks.size(), size_t(1), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+                parseChunk(chunks[i], state.vertices.data(), state.normals.data(), state.uvs.data());
+                reportChunk(0.1f, 0.8f);
+            }
+        });
+
+        const bool hasColors = std::any_of(chunks.begin(), chunks.end(), [](auto& chunk) { return !chunk.colors.empty(); });
+        if (hasColors) {
+            state.colors.assign(vertexCount * 3, 1);
+            for (auto& chunk : chunks) {
+                std::copy(chunk.colors.begin(), chunk.colors.end(), state.colors.begin() + static_cast<long>(chunk.vertexOffset * 3));
+            }
+        }
+
+        for (auto& chunk : chunks) {
+
+            size_t position = 0;
+            const auto flush = [&](size_t upTo) {
+                if (upTo > position) {
+                    auto& geometry = state.object->geometry;
+                    geometry.spans.push_back({chunk.corners.data() + position, upTo - position});
+                    geometry.streamedCount += upTo - position;
+                    position = upTo;
+                }
+            };
+
+            for (const auto& event : chunk.events) {
+
+                flush(event.corner);
+
+                switch (event.type) {
+                    case ParseEvent::Type::Object:
+                        state.startObject(event.value);
+                        break;
+                    case ParseEvent::Type::UseMaterial:
+                        state.object->startMaterial(event.value, state.materialLibraries);
+                        break;
+                    case ParseEvent::Type::MaterialLibrary:
+                        state.materialLibraries.emplace_back(event.value);
+                        break;
+                    case ParseEvent::Type::Points:
+                        state.object->geometry.type = "Points";
+                        break;
+                    case ParseEvent::Type::Line:
+                        state.object->geometry.type = "Line";
+                        break;
+                    case ParseEvent::Type::Smooth: {
+                        auto value = event.value;
+                        utils::toLowerInplace(value);
+                        state.object->smooth = value.empty() || (value != "0" && value != "off");
+
+                        auto material = state.object->currentMaterial();
+                        if (material) {
+                            material->smooth = state.object->smooth;
+                        }
+                        break;
+                    }
                 }
             }
 
-            mesh->name = object->name;
+            flush(chunk.corners.size());
+        }
+
+        state.finalize();
+        progress.report(0.85f);
+
+        struct Job {
+            const CornerSpan* span;
+            OBJGeometry* geometry;
+            size_t offset;
+            bool hasNormals = false;
+            bool hasUvs = false;
+        };
 
-            container->add(mesh);
+        std::vector<Job> jobs;
+        for (const auto& object : state.objects) {
+
+            size_t offset = 0;
+            for (const auto& span : object->geometry.spans) {
+                jobs.push_back({&span, &object->geometry, offset});
+                offset += span.count;
+            }
         }
 
-        if (scope.useCache) cache_[path.string()] = container;
+        // faces may or may not reference normals and uvs, only objects that use them get the attribute
+        utils::parallel_for(size_t(0), jobs.size(), size_t(1), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
 
-        return container;
+                auto& job = jobs[i];
+                const auto corners = job.span->corners;
+                job.hasNormals = std::any_of(corners, corners + job.span->count, [](auto& corner) { return corner.vn >= 0; });
+                job.hasUvs = std::any_of(corners, corners + job.span->count, [](auto& corner) { return corner.vt >= 0; });
+            }
+        });
+
+        struct Attributes {
+            float* position = nullptr;
+            float* normal = nullptr;
+            float* uv = nullptr;
+            float* color = nullptr;
+        };
+
+        std::unordered_map<const OBJGeometry*, Attributes> attributes;
+        for (auto job = jobs.begin(); job != jobs.end();) {
+
+            auto& geometry = *job->geometry;
+
+            // jobs of an object are contiguous
+            bool hasNormals = false, hasUvs = false;
+            for (; job != jobs.end() && job->geometry == &geometry; ++job) {
+                hasNormals |= job->hasNormals;
+                hasUvs |= job->hasUvs;
+            }
+
+            geometry.bufferGeometry = BufferGeometry::create();
+
+            const auto createAttribute = [&](const std::string& name, int itemSize) {
+                auto attribute = FloatBufferAttribute::create(std::vector<float>(geometry.streamedCount * itemSize), itemSize);
+                auto data = attribute->array().data();
+                geometry.bufferGeometry->setAttribute(name, std::move(attribute));
+                return data;
+            };
+
+            auto& target = attributes[&geometry];
+            target.position = createAttribute("position", 3);
+            if (hasNormals) target.normal = createAttribute("normal", 3);
+            if (hasUvs) target.uv = createAttribute("uv", 2);
+            if (hasColors) target.color = createAttribute("color", 3);
+        }
+
+        done = 0;
+        utils::parallel_for(size_t(0), jobs.size(), size_t(1), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+
+                const auto& job = jobs[i];
+                const auto& target = attributes.at(job.geometry);
+
+                for (size_t c = 0; c < job.span->count; c++) {
+
+                    const auto& corner = job.span->corners[c];
+                    const auto out = job.offset + c;
+
+                    std::copy_n(state.vertices.data() + corner.v * 3, 3, target.position + out * 3);
+
+                    if (target.normal && corner.vn >= 0) {
+                        std::copy_n(state.normals.data() + corner.vn * 3, 3, target.normal + out * 3);
+                    }
+                    if (target.uv && corner.vt >= 0) {
+                        std::copy_n(state.uvs.data() + corner.vt * 2, 2, target.uv + out * 2);
+                    }
+                    if (target.color) {
+                        std::copy_n(state.colors.data() + corner.v * 3, 3, target.color + out * 3);
+                    }
+                }
+
+                progress.report(0.85f + 0.15f * static_cast<float>(++done) / static_cast<float>(jobs.size()));
+            }
+        });
+
+        progress.report(1.f);
     }
 };
 
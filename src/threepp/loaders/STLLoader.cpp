@@ -1,68 +1,223 @@
 
 #include "threepp/loaders/STLLoader.hpp"
 
-#include <fstream>
+#include "threepp/utils/MemoryMappedFile.hpp"
+#include "threepp/utils/StringUtils.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <cctype>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 using namespace threepp;
 
+namespace {
 
-std::shared_ptr<BufferGeometry> STLLoader::load(const std::filesystem::path& path) const {
+    constexpr size_t headerLength = 84;
+    constexpr size_t faceLength = 12 * 4 + 2;
 
-    if (!std::filesystem::exists(path)) {
-        std::cerr << "[STLLoader] No such file: '" << absolute(path).string() << "'!" << std::endl;
-        return nullptr;
+    bool isBinary(const char* data, size_t size) {
+
+        if (size < headerLength) return false;
+
+        uint32_t faces;
+        std::memcpy(&faces, data + 80, sizeof(uint32_t));
+
+        if (headerLength + static_cast<size_t>(faces) * faceLength == size) return true;
+
+        // some binary files start with "solid" as well, so only treat the file as text if the header says so
+        auto it = data;
+        const auto end = data + std::min(size, size_t(80));
+        while (it < end && std::isspace(static_cast<unsigned char>(*it))) ++it;
+
+        return !(end - it >= 5 && std::strncmp(it, "solid", 5) == 0);
     }
 
-    std::ifstream reader(path, std::ios::binary);
-    reader.seekg(80, std::ios::beg);
+    void parseBinary(const char* data, size_t size, std::vector<float>& vertices, std::vector<float>& normals) {
+
+        uint32_t faces;
+        std::memcpy(&faces, data + 80, sizeof(uint32_t));
+
+        const auto available = (size - headerLength) / faceLength;
+        if (faces > available) {
+            std::cerr << "[STLLoader] File is truncated, expected " << faces << " faces but found " << available << std::endl;
+            faces = static_cast<uint32_t>(available);
+        }
+
+        vertices.resize(faces * 9);
+        normals.resize(faces * 9);
+
+        utils::parallel_for(size_t(0), size_t(faces), size_t(1 << 16), [&](size_t begin, size_t end) {
+            for (auto face = begin; face < end; face++) {
+
+                const auto record = data + headerLength + face * faceLength;
+
+                float normal[3];
+                std::memcpy(normal, record, sizeof(normal));
+                std::memcpy(vertices.data() + face * 9, record + 12, 9 * sizeof(float));
+
+                for (int i = 0; i < 3; i++) {
+                    std::memcpy(normals.data() + face * 9 + i * 3, normal, sizeof(normal));
+                }
+            }
+        });
+    }
+
+    bool nextToken(const char*& it, const char* end, std::string_view& token) {
+
+        while (it < end && std::isspace(static_cast<unsigned char>(*it))) ++it;
+
+        auto begin = it;
+        while (it < end && !std::isspace(static_cast<unsigned char>(*it))) ++it;
+
+        token = std::string_view(begin, it - begin);
+
+        return !token.empty();
+    }
+
+    void parseAscii(const char* data, size_t size, std::vector<float>& vertices, std::vector<float>& normals) {
+
+        auto it = data;
+        const auto end = data + size;
+
+        float normal[3]{};
+        std::vector<float> polygon;
+
+        const auto readVector = [&](float* v) {
+            if (!utils::parseFloat(it, end, v[0]) ||
+                !utils::parseFloat(it, end, v[1]) ||
+                !utils::parseFloat(it, end, v[2])) {
+                throw std::runtime_error("[STLLoader] Malformed vector near offset " + std::to_string(it - data));
+            }
+        };
+
+        std::string_view token;
+        while (nextToken(it, end, token)) {
+
+            if (token == "vertex") {
 
-    uint32_t faces;
-    reader.read(reinterpret_cast<char*>(&faces), sizeof(uint32_t));
+                float v[3];
+                readVector(v);
+                polygon.insert(polygon.end(), v, v + 3);
 
-    const int dataOffset = 84;
-    const int faceLength = 12 * 4 + 2;
+            } else if (token == "facet") {
 
-    auto geometry = std::make_shared<BufferGeometry>();
+                if (!nextToken(it, end, token) || token != "normal") {
+                    throw std::runtime_error("[STLLoader] Expected 'normal' near offset " + std::to_string(it - data));
+                }
+                readVector(normal);
+                polygon.clear();
 
-    std::vector<float> vertices(faces * 3 * 3);
-    std::vector<float> normals(faces * 3 * 3);
+            } else if (token == "endloop") {
 
-    float normalX;
-    float normalY;
-    float normalZ;
+                const auto count = polygon.size() / 3;
+                for (size_t i = 1; i + 1 < count; i++) {
 
-    for (int face = 0; face < faces; face++) {
-        int start = dataOffset + face * faceLength;
-        reader.seekg(start, std::ios::beg);
+                    vertices.insert(vertices.end(), polygon.begin(), polygon.begin() + 3);
+                    vertices.insert(vertices.end(), polygon.begin() + static_cast<long>(i * 3), polygon.begin() + static_cast<long>(i * 3 + 6));
 
-        reader.read(reinterpret_cast<char*>(&normalX), sizeof(float));
-        reader.read(reinterpret_cast<char*>(&normalY), sizeof(float));
-        reader.read(reinterpret_cast<char*>(&normalZ), sizeof(float));
+                    for (int j = 0; j < 3; j++) {
+                        normals.insert(normals.end(), normal, normal + 3);
+                    }
+                }
+                polygon.clear();
 
+            } else if (token == "solid" || token == "endsolid") {
 
-        for (int i = 1; i <= 3; i++) {
-            int vertexStart = start + i * 12;
-            int componentIdx = face * 3 * 3 + (i - 1) * 3;
-            reader.seekg(vertexStart, std::ios::beg);
+                // the name runs to the end of the line
+                while (it < end && *it != '\n') ++it;
 
-            float& x = vertices.emplace_back();
-            float& y = vertices.emplace_back();
-            float& z = vertices.emplace_back();
+            } else if (token != "outer" && token != "loop" && token != "endfacet") {
 
-            reader.read(reinterpret_cast<char*>(&vertices[componentIdx]), 4);
-            reader.read(reinterpret_cast<char*>(&vertices[componentIdx + 1]), 4);
-            reader.read(reinterpret_cast<char*>(&vertices[componentIdx + 2]), 4);
+                throw std::runtime_error("[STLLoader] Unexpected token: " + std::string(token));
+            }
+        }
+    }
+
+    struct VertexKey {
+        uint32_t bits[6];
+
+        bool operator==(const VertexKey& other) const {
+            return std::memcmp(bits, other.bits, sizeof(bits)) == 0;
+        }
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const {
+            size_t hash = 14695981039346656037ull;
+            for (auto bits : key.bits) {
+                hash = (hash ^ bits) * 1099511628211ull;
+            }
+            return hash;
+        }
+    };
+
+    void weld(std::vector<float>& vertices, std::vector<float>& normals, std::vector<unsigned int>& index) {
+
+        const auto count = vertices.size() / 3;
 
-            normals[componentIdx] = normalX;
-            normals[componentIdx + 1] = normalY;
-            normals[componentIdx + 2] = normalZ;
+        std::unordered_map<VertexKey, unsigned int, VertexKeyHash> unique;
+        unique.reserve(count / 2);
+
+        index.resize(count);
+
+        size_t next = 0;
+        for (size_t i = 0; i < count; i++) {
+
+            VertexKey key;
+            std::memcpy(key.bits, vertices.data() + i * 3, 3 * sizeof(float));
+            std::memcpy(key.bits + 3, normals.data() + i * 3, 3 * sizeof(float));
+
+            auto [entry, inserted] = unique.emplace(key, static_cast<unsigned int>(next));
+            if (inserted) {
+                // compact in place, next <= i so unread data is never overwritten
+                std::copy_n(vertices.data() + i * 3, 3, vertices.data() + next * 3);
+                std::copy_n(normals.data() + i * 3, 3, normals.data() + next * 3);
+                ++next;
+            }
+
+            index[i] = entry->second;
         }
+
+        vertices.resize(next * 3);
+        normals.resize(next * 3);
+    }
+
+}// namespace
+
+
+std::shared_ptr<BufferGeometry> STLLoader::load(const std::filesystem::path& path) const {
+
+    if (!std::filesystem::exists(path)) {
+        std::cerr << "[STLLoader] No such file: '" << absolute(path).string() << "'!" << std::endl;
+        return nullptr;
+    }
+
+    utils::MemoryMappedFile file(path);
+
+    std::vector<float> vertices;
+    std::vector<float> normals;
+
+    if (isBinary(file.data(), file.size())) {
+        parseBinary(file.data(), file.size(), vertices, normals);
+    } else {
+        parseAscii(file.data(), file.size(), vertices, normals);
+    }
+
+    auto geometry = BufferGeometry::create();
+
+    if (weldVertices) {
+
+        std::vector<unsigned int> index;
+        weld(vertices, normals, index);
+        geometry->setIndex(std::move(index));
     }
 
-    geometry->setAttribute("position", FloatBufferAttribute::create(vertices, 3));
-    geometry->setAttribute("normal", FloatBufferAttribute::create(normals, 3));
+    geometry->setAttribute("position", FloatBufferAttribute::create(std::move(vertices), 3));
+    geometry->setAttribute("normal", FloatBufferAttribute::create(std::move(normals), 3));
 
     return geometry;
 }
@@ -11,36 +11,20 @@ using namespace threepp;
 
 namespace {
 
-    Vector3 _vector;
-    
-    Vector3 _v0;
-    Vector3 _v1;
-    Vector3 _v2;
+    template<size_t N>
+    bool satForAxes(const std::array<float, N>& axes, const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& extents) {
 
-    Vector3 _f0;
-    Vector3 _f1;
-    Vector3 _f2;
+        Vector3 testAxis;
 
-    Vector3 _center;
-    Vector3 _extents;
+        for (size_t i = 0; i + 3 <= N; i += 3) {
 
-    Vector3 _triangleNormal;
-    Vector3 _testAxis;
-
-    std::array<Vector3, 8> _points;
-
-
-    bool satForAxes(const std::vector<float>& axes, const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& extents) {
-
-        for (unsigned i = 0, j = axes.size() - 3; i <= j; i += 3) {
-
-            _testAxis.fromArray(axes, i);
+            testAxis.set(axes[i], axes[i + 1], axes[i + 2]);
             // project the aabb onto the separating axis
-            const float r = extents.x * std::abs(_testAxis.x) + extents.y * std::abs(_testAxis.y) + extents.z * std::abs(_testAxis.z);
+            const float r = extents.x * std::abs(testAxis.x) + extents.y * std::abs(testAxis.y) + extents.z * std::abs(testAxis.z);
             // project all 3 vertices of the triangle onto the seperating axis
-            const float p0 = v0.dot(_testAxis);
-            const float p1 = v1.dot(_testAxis);
-            const float p2 = v2.dot(_testAxis);
+            const float p0 = v0.dot(testAxis);
+            const float p1 = v1.dot(testAxis);
+            const float p2 = v2.dot(testAxis);
             // actual test, basically see if either of the most extreme of the triangle points intersects r
             if (std::max(-std::max(p0, std::max(p1, p2)), std::min(p0, std::min(p1, p2))) > r) {
 
@@ -90,7 +74,8 @@ Box3& Box3::set(float minX, float minY, float minZ, float maxX, float maxY, floa
 
 Box3& Box3::setFromCenterAndSize(const Vector3& center, const Vector3& size) {
 
-    const auto halfSize = _vector.copy(size).multiplyScalar(0.5f);
+    Vector3 halfSize;
+    halfSize.copy(size).multiplyScalar(0.5f);
 
     this->min_.copy(center).sub(halfSize);
     this->max_.copy(center).add(halfSize);
@@ -192,11 +177,10 @@ Box3& Box3::expandByObject(Object3D& object) {
             geometry->computeBoundingBox();
         }
 
-        Box3 _box{};
-        _box.copy(geometry->boundingBox.value());
-        _box.applyMatrix4(*object.matrixWorld);
+        Box3 box(geometry->boundingBox.value());
+        box.applyMatrix4(object.matrixWorld);
 
-        this->union_(_box);
+        this->union_(box);
     }
 
     for (auto& child : object.children) {
@@ -238,11 +222,12 @@ bool Box3::intersectsBox(const Box3& box) const {
 bool Box3::intersectsSphere(const Sphere& sphere) const {
 
     // Find the point on the AABB closest to the sphere center.
-    this->clampPoint(sphere.center, _vector);
+    Vector3 closest;
+    this->clampPoint(sphere.center, closest);
 
     // If that point is inside the sphere, the AABB and sphere intersect.
     const float radius = sphere.radius;
-    return _vector.distanceToSquared(sphere.center) <= (radius * radius);
+    return closest.distanceToSquared(sphere.center) <= (radius * radius);
 }
 
 bool Box3::intersectsPlane(const Plane& plane) const {
@@ -295,45 +280,50 @@ bool Box3::intersectsTriangle(const Triangle& triangle) const {
         return false;
     }
 
+    Vector3 center, extents;
+    Vector3 v0, v1, v2;
+    Vector3 f0, f1, f2;
+
     // compute box center and extents
-    this->getCenter(_center);
-    _extents.subVectors(this->max_, _center);
+    this->getCenter(center);
+    extents.subVectors(this->max_, center);
 
     // translate triangle to aabb origin
-    _v0.subVectors(triangle.a(), _center);
-    _v1.subVectors(triangle.b(), _center);
-    _v2.subVectors(triangle.c(), _center);
+    v0.subVectors(triangle.a(), center);
+    v1.subVectors(triangle.b(), center);
+    v2.subVectors(triangle.c(), center);
 
     // compute edge vectors for triangle
-    _f0.subVectors(_v1, _v0);
-    _f1.subVectors(_v2, _v1);
-    _f2.subVectors(_v0, _v2);
+    f0.subVectors(v1, v0);
+    f1.subVectors(v2, v1);
+    f2.subVectors(v0, v2);
 
     // test against axes that are given by cross product combinations of the edges of the triangle and the edges of the aabb
     // make an axis testing of each of the 3 sides of the aabb against each of the 3 sides of the triangle = 9 axis of separation
     // axis_ij = u_i x f_j (u0, u1, u2 = face normals of aabb = x,y,z axes vectors since aabb is axis aligned)
-    std::vector<float> axes = {
-            0, -_f0.z, _f0.y, 0, -_f1.z, _f1.y, 0, -_f2.z, _f2.y,
-            _f0.z, 0, -_f0.x, _f1.z, 0, -_f1.x, _f2.z, 0, -_f2.x,
-            -_f0.y, _f0.x, 0, -_f1.y, _f1.x, 0, -_f2.y, _f2.x, 0};
-    if (!satForAxes(axes, _v0, _v1, _v2, _extents)) {
+    const std::array<float, 27> edgeAxes = {
+            0, -f0.z, f0.y, 0, -f1.z, f1.y, 0, -f2.z, f2.y,
+            f0.z, 0, -f0.x, f1.z, 0, -f1.x, f2.z, 0, -f2.x,
+            -f0.y, f0.x, 0, -f1.y, f1.x, 0, -f2.y, f2.x, 0};
+    if (!satForAxes(edgeAxes, v0, v1, v2, extents)) {
 
         return false;
     }
 
     // test 3 face normals from the aabb
-    axes = {1, 0, 0, 0, 1, 0, 0, 0, 1};
-    if (!satForAxes(axes, _v0, _v1, _v2, _extents)) {
+    const std::array<float, 9> faceAxes = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+    if (!satForAxes(faceAxes, v0, v1, v2, extents)) {
 
         return false;
     }
 
     // finally testing the face normal of the triangle
     // use already existing triangle edge vectors here
-    _triangleNormal.crossVectors(_f0, _f1);
-    axes = {_triangleNormal.x, _triangleNormal.y, _triangleNormal.z};
+    Vector3 triangleNormal;
+    triangleNormal.crossVectors(f0, f1);
+    const std::array<float, 3> normalAxis = {triangleNormal.x, triangleNormal.y, triangleNormal.z};
 
-    return satForAxes(axes, _v0, _v1, _v2, _extents);
+    return satForAxes(normalAxis, v0, v1, v2, extents);
 }
 
 Vector3& Box3::clampPoint(const Vector3& point, Vector3& target) const {
@@ -343,7 +333,8 @@ Vector3& Box3::clampPoint(const Vector3& point, Vector3& target) const {
 
 float Box3::distanceToPoint(const Vector3& point) const {
 
-    auto clampedPoint = _vector.copy(point).clamp(this->min_, this->max_);
+    Vector3 clampedPoint;
+    clampedPoint.copy(point).clamp(this->min_, this->max_);
 
     return clampedPoint.sub(point).length();
 }
@@ -352,8 +343,9 @@ void Box3::getBoundingSphere(Sphere& target) const {
 
     this->getCenter(target.center);
 
-    this->getSize(_vector);
-    target.radius = _vector.length() * 0.5f;
+    Vector3 size;
+    this->getSize(size);
+    target.radius = size.length() * 0.5f;
 }
 
 Box3& Box3::intersect(const Box3& box) {
@@ -380,17 +372,19 @@ Box3& Box3::applyMatrix4(const Matrix4& matrix) {
     // transform of empty box is an empty box.
     if (this->isEmpty()) return *this;
 
+    std::array<Vector3, 8> points;
+
     // NOTE: I am using a binary pattern to specify all 2^3 combinations below
-    _points[0].set(this->min_.x, this->min_.y, this->min_.z).applyMatrix4(matrix);// 000
-    _points[1].set(this->min_.x, this->min_.y, this->max_.z).applyMatrix4(matrix);// 001
-    _points[2].set(this->min_.x, this->max_.y, this->min_.z).applyMatrix4(matrix);// 010
-    _points[3].set(this->min_.x, this->max_.y, this->max_.z).applyMatrix4(matrix);// 011
-    _points[4].set(this->max_.x, this->min_.y, this->min_.z).applyMatrix4(matrix);// 100
-    _points[5].set(this->max_.x, this->min_.y, this->max_.z).applyMatrix4(matrix);// 101
-    _points[6].set(this->max_.x, this->max_.y, this->min_.z).applyMatrix4(matrix);// 110
-    _points[7].set(this->max_.x, this->max_.y, this->max_.z).applyMatrix4(matrix);// 111
-
-    this->setFromPoints(_points);
+    points[0].set(this->min_.x, this->min_.y, this->min_.z).applyMatrix4(matrix);// 000
+    points[1].set(this->min_.x, this->min_.y, this->max_.z).applyMatrix4(matrix);// 001
+    points[2].set(this->min_.x, this->max_.y, this->min_.z).applyMatrix4(matrix);// 010
+    points[3].set(this->min_.x, this->max_.y, this->max_.z).applyMatrix4(matrix);// 011
+    points[4].set(this->max_.x, this->min_.y, this->min_.z).applyMatrix4(matrix);// 100
+    points[5].set(this->max_.x, this->min_.y, this->max_.z).applyMatrix4(matrix);// 101
+    points[6].set(this->max_.x, this->max_.y, this->min_.z).applyMatrix4(matrix);// 110
+    points[7].set(this->max_.x, this->max_.y, this->max_.z).applyMatrix4(matrix);// 111
+
+    this->setFromPoints(points);
 
     return *this;
 }
@@ -10,10 +10,6 @@ using namespace threepp;
 
 namespace {
 
-    Vector3 _v1;
-    Vector3 _v2;
-    Vector3 _v3;
-
     const float EPS = 1e-10;
 
 }// namespace
@@ -79,9 +75,9 @@ bool Capsule::intersectsBox(const Box3& box) const {
 
 std::pair<Vector3, Vector3> Capsule::lineLineMinimumPoints(const Line3& line1, const Line3& line2) const {
 
-    auto r = _v1.copy(line1.end()).sub(line1.start());
-    auto s = _v2.copy(line2.end()).sub(line2.start());
-    const auto w = _v3.copy(line2.start()).sub(line1.start());
+    auto r = Vector3().copy(line1.end()).sub(line1.start());
+    auto s = Vector3().copy(line2.end()).sub(line2.start());
+    const auto w = Vector3().copy(line2.start()).sub(line1.start());
 
     const auto a = r.dot(s),
                b = r.dot(r),
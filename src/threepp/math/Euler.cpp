@@ -12,7 +12,15 @@
 using namespace threepp;
 
 Euler::Euler(float x, float y, float z, Euler::RotationOrders order)
-    : x(x), y(y), z(z), order_() {}
+    : x(x), y(y), z(z), order_(order) {}
+
+Euler::Euler(const Euler& e)
+    : x(e.x()), y(e.y()), z(e.z()), order_(e.order_) {}
+
+Euler& Euler::operator=(const Euler& e) {
+
+    return copy(e);
+}
 
 Euler& Euler::set(float x, float y, float z, const std::optional<RotationOrders>& order) {
 
@@ -21,18 +29,18 @@ Euler& Euler::set(float x, float y, float z, const std::optional<RotationOrders>
     this->z.value_ = z;
     this->order_ = order.value_or(this->order_);
 
-    this->onChangeCallback_();
+    this->changed();
 
     return *this;
 }
 
 Euler& Euler::copy(const Euler& euler) {
-    this->x = euler.x;
-    this->y = euler.y;
-    this->z = euler.z;
+    this->x.value_ = euler.x();
+    this->y.value_ = euler.y();
+    this->z.value_ = euler.z();
     this->order_ = euler.order_;
 
-    this->onChangeCallback_();
+    this->changed();
 
     return *this;
 }
@@ -153,7 +161,7 @@ Euler& Euler::setFromRotationMatrix(const Matrix4& m, std::optional<RotationOrde
             break;
     }
 
-    if (update) this->onChangeCallback_();
+    if (update) this->changed();
 
     return *this;
 }
@@ -173,10 +181,15 @@ Euler& Euler::setFromVector3(const Vector3& v, std::optional<RotationOrders> ord
 
 Euler& Euler::_onChange(std::function<void()> callback) {
 
-    this->onChangeCallback_ = std::move(callback);
-    this->x.setCallback(this->onChangeCallback_);
-    this->y.setCallback(this->onChangeCallback_);
-    this->z.setCallback(this->onChangeCallback_);
+    this->callback_ = std::make_unique<float_view::callback_observer>(std::move(callback));
+    this->observe(this->callback_.get());
 
     return *this;
 }
+
+void Euler::observe(float_view::observer* observer) {
+
+    this->x.observer_ = observer;
+    this->y.observer_ = observer;
+    this->z.observer_ = observer;
+}
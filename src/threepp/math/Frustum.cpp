@@ -6,11 +6,6 @@
 
 using namespace threepp;
 
-namespace {
-    Sphere _sphere{};
-    Vector3 _vector{};
-}// namespace
-
 Frustum::Frustum(Plane p0, Plane p1, Plane p2, Plane p3, Plane p4, Plane p5)
     : planes_{p0, p1, p2, p3, p4, p5} {}
 
@@ -60,17 +55,17 @@ bool Frustum::intersectsObject(Object3D& object) const {
 
     if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
-    _sphere.copy(geometry->boundingSphere.value()).applyMatrix4(*object.matrixWorld);
+    Sphere sphere(geometry->boundingSphere.value());
+    sphere.applyMatrix4(object.matrixWorld);
 
-    return this->intersectsSphere(_sphere);
+    return this->intersectsSphere(sphere);
 }
 
 bool Frustum::intersectsSprite(const Sprite& sprite) const {
-    _sphere.center.set(0, 0, 0);
-    _sphere.radius = 0.7071067811865476f;
-    _sphere.applyMatrix4(*sprite.matrixWorld);
+    Sphere sphere(Vector3(), 0.7071067811865476f);
+    sphere.applyMatrix4(sprite.matrixWorld);
 
-    return this->intersectsSphere(_sphere);
+    return this->intersectsSphere(sphere);
 }
 
 bool Frustum::intersectsSphere(const Sphere& sphere) const {
@@ -93,17 +88,19 @@ bool Frustum::intersectsSphere(const Sphere& sphere) const {
 
 bool Frustum::intersectsBox(const Box3& box) const {
 
+    Vector3 corner;
+
     for (int i = 0; i < 6; i++) {
 
         const auto& plane = planes_[i];
 
         // corner at max distance
 
-        _vector.x = plane.normal.x > 0 ? box.max().x : box.min().x;
-        _vector.y = plane.normal.y > 0 ? box.max().y : box.min().y;
-        _vector.z = plane.normal.z > 0 ? box.max().z : box.min().z;
+        corner.x = plane.normal.x > 0 ? box.max().x : box.min().x;
+        corner.y = plane.normal.y > 0 ? box.max().y : box.min().y;
+        corner.z = plane.normal.z > 0 ? box.max().z : box.min().z;
 
-        if (plane.distanceToPoint(_vector) < 0) {
+        if (plane.distanceToPoint(corner) < 0) {
 
             return false;
         }
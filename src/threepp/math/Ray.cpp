@@ -10,20 +10,6 @@
 
 using namespace threepp;
 
-namespace {
-
-    Vector3 _vector;
-
-    Vector3 _segCenter;
-    Vector3 _segDir;
-    Vector3 _diff;
-
-    Vector3 _edge1;
-    Vector3 _edge2;
-    Vector3 _normal;
-
-}
-
 Ray::Ray(const Vector3& origin, const Vector3& direction): origin(origin), direction(direction) {}
 
 Ray& Ray::set(const Vector3& origin, const Vector3& direction) {
@@ -84,7 +70,8 @@ float Ray::distanceToPoint(const Vector3& point) const {
 
 float Ray::distanceSqToPoint(const Vector3& point) const {
 
-    const auto directionDistance = _vector.subVectors(point, this->origin).dot(this->direction);
+    Vector3 v;
+    const auto directionDistance = v.subVectors(point, this->origin).dot(this->direction);
 
     // point behind the ray
 
@@ -94,9 +81,9 @@ float Ray::distanceSqToPoint(const Vector3& point) const {
     }
 
 
-    _vector.copy(this->direction).multiplyScalar(directionDistance).add(this->origin);
+    v.copy(this->direction).multiplyScalar(directionDistance).add(this->origin);
 
-    return _vector.distanceToSquared(point);
+    return v.distanceToSquared(point);
 }
 
 float Ray::distanceSqToSegment(const Vector3& v0, const Vector3& v1, Vector3* optionalPointOnRay, Vector3* optionalPointOnSegment) const {
@@ -108,15 +95,17 @@ float Ray::distanceSqToSegment(const Vector3& v0, const Vector3& v1, Vector3* op
     // - The closest point on the ray
     // - The closest point on the segment
 
-    _segCenter.copy(v0).add(v1).multiplyScalar(0.5f);
-    _segDir.copy(v1).sub(v0).normalize();
-    _diff.copy(this->origin).sub(_segCenter);
+    Vector3 segCenter, segDir, diff;
+
+    segCenter.copy(v0).add(v1).multiplyScalar(0.5f);
+    segDir.copy(v1).sub(v0).normalize();
+    diff.copy(this->origin).sub(segCenter);
 
     const float segExtent = v0.distanceTo(v1) * 0.5f;
-    const float a01 = -this->direction.dot(_segDir);
-    const float b0 = _diff.dot(this->direction);
-    const float b1 = -_diff.dot(_segDir);
-    const float c = _diff.lengthSq();
+    const float a01 = -this->direction.dot(segDir);
+    const float b0 = diff.dot(this->direction);
+    const float b1 = -diff.dot(segDir);
+    const float c = diff.lengthSq();
     const float det = std::abs(1 - a01 * a01);
     float s0, s1, sqrDist, extDet;
 
@@ -204,7 +193,7 @@ float Ray::distanceSqToSegment(const Vector3& v0, const Vector3& v1, Vector3* op
 
     if (optionalPointOnSegment) {
 
-        optionalPointOnSegment->copy(_segCenter).addScaledVector(_segDir, s1);
+        optionalPointOnSegment->copy(segCenter).addScaledVector(segDir, s1);
     }
 
     return sqrDist;
@@ -212,9 +201,10 @@ float Ray::distanceSqToSegment(const Vector3& v0, const Vector3& v1, Vector3* op
 
 void Ray::intersectSphere(const Sphere& sphere, Vector3& target) const {
 
-    _vector.subVectors(sphere.center, this->origin);
-    const auto tca = _vector.dot(this->direction);
-    const auto d2 = _vector.dot(_vector) - tca * tca;
+    Vector3 v;
+    v.subVectors(sphere.center, this->origin);
+    const auto tca = v.dot(this->direction);
+    const auto d2 = v.dot(v) - tca * tca;
     const auto radius2 = sphere.radius * sphere.radius;
 
     if (d2 > radius2) {
@@ -392,9 +382,10 @@ void Ray::intersectBox(const Box3& box, Vector3& target) const {
 
 bool Ray::intersectsBox(const Box3& box) const {
 
-    this->intersectBox(box, _vector);
+    Vector3 v;
+    this->intersectBox(box, v);
 
-    return !_vector.isNan();
+    return !v.isNan();
 }
 
 std::optional<Vector3> Ray::intersectTriangle(const Vector3& a, const Vector3& b, const Vector3& c, bool backfaceCulling, Vector3& target) const {
@@ -403,16 +394,18 @@ std::optional<Vector3> Ray::intersectTriangle(const Vector3& a, const Vector3& b
 
     // from http://www.geometrictools.com/GTEngine/Include/Mathematics/GteIntrRay3Triangle3.h
 
-    _edge1.subVectors(b, a);
-    _edge2.subVectors(c, a);
-    _normal.crossVectors(_edge1, _edge2);
+    Vector3 edge1, edge2, normal, diff;
+
+    edge1.subVectors(b, a);
+    edge2.subVectors(c, a);
+    normal.crossVectors(edge1, edge2);
 
     // Solve Q + t*D = b1*E1 + b2*E2 (Q = kDiff, D = ray direction,
     // E1 = kEdge1, E2 = kEdge2, N = Cross(E1,E2)) by
     //   |Dot(D,N)|*b1 = sign(Dot(D,N))*Dot(D,Cross(Q,E2))
     //   |Dot(D,N)|*b2 = sign(Dot(D,N))*Dot(D,Cross(E1,Q))
     //   |Dot(D,N)|*t = -sign(Dot(D,N))*Dot(Q,N)
-    float DdN = this->direction.dot(_normal);
+    float DdN = this->direction.dot(normal);
     float sign;
 
     if (DdN > 0) {
@@ -435,8 +428,8 @@ std::optional<Vector3> Ray::intersectTriangle(const Vector3& a, const Vector3& b
         return std::nullopt;
     }
 
-    _diff.subVectors(this->origin, a);
-    const float DdQxE2 = sign * this->direction.dot(_edge2.crossVectors(_diff, _edge2));
+    diff.subVectors(this->origin, a);
+    const float DdQxE2 = sign * this->direction.dot(edge2.crossVectors(diff, edge2));
 
     // b1 < 0, no intersection
     if (DdQxE2 < 0) {
@@ -445,7 +438,7 @@ std::optional<Vector3> Ray::intersectTriangle(const Vector3& a, const Vector3& b
         return std::nullopt;
     }
 
-    const float DdE1xQ = sign * this->direction.dot(_edge1.cross(_diff));
+    const float DdE1xQ = sign * this->direction.dot(edge1.cross(diff));
 
     // b2 < 0, no intersection
     if (DdE1xQ < 0) {
@@ -462,7 +455,7 @@ std::optional<Vector3> Ray::intersectTriangle(const Vector3& a, const Vector3& b
     }
 
     // Line intersects triangle, check if ray does.
-    const float QdN = -sign * _diff.dot(_normal);
+    const float QdN = -sign * diff.dot(normal);
 
     // t < 0, no intersection
     if (QdN < 0) {
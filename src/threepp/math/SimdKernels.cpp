@@ -0,0 +1,327 @@
+
+#include "threepp/math/SimdKernels.hpp"
+
+#include "simd/Kernels.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(THREEPP_SIMD_X86) && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+using namespace threepp;
+using namespace threepp::simd;
+
+namespace {
+
+    void multiplyMatricesScalar(const float* ae, const float* be, float* te) {
+
+        const float a11 = ae[0], a12 = ae[4], a13 = ae[8], a14 = ae[12];
+        const float a21 = ae[1], a22 = ae[5], a23 = ae[9], a24 = ae[13];
+        const float a31 = ae[2], a32 = ae[6], a33 = ae[10], a34 = ae[14];
+        const float a41 = ae[3], a42 = ae[7], a43 = ae[11], a44 = ae[15];
+
+        const float b11 = be[0], b12 = be[4], b13 = be[8], b14 = be[12];
+        const float b21 = be[1], b22 = be[5], b23 = be[9], b24 = be[13];
+        const float b31 = be[2], b32 = be[6], b33 = be[10], b34 = be[14];
+        const float b41 = be[3], b42 = be[7], b43 = be[11], b44 = be[15];
+
+        te[0] = a11 * b11 + a12 * b21 + a13 * b31 + a14 * b41;
+        te[4] = a11 * b12 + a12 * b22 + a13 * b32 + a14 * b42;
+        te[8] = a11 * b13 + a12 * b23 + a13 * b33 + a14 * b43;
+        te[12] = a11 * b14 + a12 * b24 + a13 * b34 + a14 * b44;
+
+        te[1] = a21 * b11 + a22 * b21 + a23 * b31 + a24 * b41;
+        te[5] = a21 * b12 + a22 * b22 + a23 * b32 + a24 * b42;
+        te[9] = a21 * b13 + a22 * b23 + a23 * b33 + a24 * b43;
+        te[13] = a21 * b14 + a22 * b24 + a23 * b34 + a24 * b44;
+
+        te[2] = a31 * b11 + a32 * b21 + a33 * b31 + a34 * b41;
+        te[6] = a31 * b12 + a32 * b22 + a33 * b32 + a34 * b42;
+        te[10] = a31 * b13 + a32 * b23 + a33 * b33 + a34 * b43;
+        te[14] = a31 * b14 + a32 * b24 + a33 * b34 + a34 * b44;
+
+        te[3] = a41 * b11 + a42 * b21 + a43 * b31 + a44 * b41;
+        te[7] = a41 * b12 + a42 * b22 + a43 * b32 + a44 * b42;
+        te[11] = a41 * b13 + a42 * b23 + a43 * b33 + a44 * b43;
+        te[15] = a41 * b14 + a42 * b24 + a43 * b34 + a44 * b44;
+    }
+
+    void invertScalar(const float* m, float* te) {
+
+        // based on http://www.euclideanspace.com/maths/algebra/matrix/functions/inverse/fourD/index.htm
+        const float n11 = m[0], n21 = m[1], n31 = m[2], n41 = m[3],
+                    n12 = m[4], n22 = m[5], n32 = m[6], n42 = m[7],
+                    n13 = m[8], n23 = m[9], n33 = m[10], n43 = m[11],
+                    n14 = m[12], n24 = m[13], n34 = m[14], n44 = m[15],
+
+                    t11 = n23 * n34 * n42 - n24 * n33 * n42 + n24 * n32 * n43 - n22 * n34 * n43 - n23 * n32 * n44 + n22 * n33 * n44,
+                    t12 = n14 * n33 * n42 - n13 * n34 * n42 - n14 * n32 * n43 + n12 * n34 * n43 + n13 * n32 * n44 - n12 * n33 * n44,
+                    t13 = n13 * n24 * n42 - n14 * n23 * n42 + n14 * n22 * n43 - n12 * n24 * n43 - n13 * n22 * n44 + n12 * n23 * n44,
+                    t14 = n14 * n23 * n32 - n13 * n24 * n32 - n14 * n22 * n33 + n12 * n24 * n33 + n13 * n22 * n34 - n12 * n23 * n34;
+
+
+        const float det = n11 * t11 + n21 * t12 + n31 * t13 + n41 * t14;
+
+        if (det == 0) {
+
+            std::fill(te, te + 16, 0.f);
+            return;
+        }
+
+        const float detInv = 1.0f / det;
+
+        te[0] = t11 * detInv;
+        te[1] = (n24 * n33 * n41 - n23 * n34 * n41 - n24 * n31 * n43 + n21 * n34 * n43 + n23 * n31 * n44 - n21 * n33 * n44) * detInv;
+        te[2] = (n22 * n34 * n41 - n24 * n32 * n41 + n24 * n31 * n42 - n21 * n34 * n42 - n22 * n31 * n44 + n21 * n32 * n44) * detInv;
+        te[3] = (n23 * n32 * n41 - n22 * n33 * n41 - n23 * n31 * n42 + n21 * n33 * n42 + n22 * n31 * n43 - n21 * n32 * n43) * detInv;
+
+        te[4] = t12 * detInv;
+        te[5] = (n13 * n34 * n41 - n14 * n33 * n41 + n14 * n31 * n43 - n11 * n34 * n43 - n13 * n31 * n44 + n11 * n33 * n44) * detInv;
+        te[6] = (n14 * n32 * n41 - n12 * n34 * n41 - n14 * n31 * n42 + n11 * n34 * n42 + n12 * n31 * n44 - n11 * n32 * n44) * detInv;
+        te[7] = (n12 * n33 * n41 - n13 * n32 * n41 + n13 * n31 * n42 - n11 * n33 * n42 - n12 * n31 * n43 + n11 * n32 * n43) * detInv;
+
+        te[8] = t13 * detInv;
+        te[9] = (n14 * n23 * n41 - n13 * n24 * n41 - n14 * n21 * n43 + n11 * n24 * n43 + n13 * n21 * n44 - n11 * n23 * n44) * detInv;
+        te[10] = (n12 * n24 * n41 - n14 * n22 * n41 + n14 * n21 * n42 - n11 * n24 * n42 - n12 * n21 * n44 + n11 * n22 * n44) * detInv;
+        te[11] = (n13 * n22 * n41 - n12 * n23 * n41 - n13 * n21 * n42 + n11 * n23 * n42 + n12 * n21 * n43 - n11 * n22 * n43) * detInv;
+
+        te[12] = t14 * detInv;
+        te[13] = (n13 * n24 * n31 - n14 * n23 * n31 + n14 * n21 * n33 - n11 * n24 * n33 - n13 * n21 * n34 + n11 * n23 * n34) * detInv;
+        te[14] = (n14 * n22 * n31 - n12 * n24 * n31 - n14 * n21 * n32 + n11 * n24 * n32 + n12 * n21 * n34 - n11 * n22 * n34) * detInv;
+        te[15] = (n12 * n23 * n31 - n13 * n22 * n31 + n13 * n21 * n32 - n11 * n23 * n32 - n12 * n21 * n33 + n11 * n22 * n33) * detInv;
+    }
+
+    // as Vector3::normalize
+    inline void normalizeScalar(float* p) {
+
+        const float l = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+        const float length = std::isnan(l) ? 1 : l;
+
+        p[0] /= length;
+        p[1] /= length;
+        p[2] /= length;
+    }
+
+    void transformScalar(float* array, size_t count, size_t stride, const float* e, Transform transform) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            float* p = array + i * stride;
+            const float x = p[0], y = p[1], z = p[2];
+
+            if (transform == Transform::Point) {
+
+                const float w = 1.0f / (e[3] * x + e[7] * y + e[11] * z + e[15]);
+
+                p[0] = (e[0] * x + e[4] * y + e[8] * z + e[12]) * w;
+                p[1] = (e[1] * x + e[5] * y + e[9] * z + e[13]) * w;
+                p[2] = (e[2] * x + e[6] * y + e[10] * z + e[14]) * w;
+
+            } else {
+
+                p[0] = e[0] * x + e[4] * y + e[8] * z;
+                p[1] = e[1] * x + e[5] * y + e[9] * z;
+                p[2] = e[2] * x + e[6] * y + e[10] * z;
+
+                if (transform == Transform::Direction) normalizeScalar(p);
+            }
+        }
+    }
+
+    void normalizeArrayScalar(float* array, size_t count, size_t stride) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            normalizeScalar(array + i * stride);
+        }
+    }
+
+    void computeBoundsScalar(const float* array, size_t count, size_t stride, float* min, float* max) {
+
+        min[0] = min[1] = min[2] = std::numeric_limits<float>::infinity();
+        max[0] = max[1] = max[2] = -std::numeric_limits<float>::infinity();
+
+        for (size_t i = 0; i < count; i++) {
+
+            const float* p = array + i * stride;
+
+            for (int c = 0; c < 3; c++) {
+
+                if (p[c] < min[c]) min[c] = p[c];
+                if (p[c] > max[c]) max[c] = p[c];
+            }
+        }
+    }
+
+    void planeDistancesScalar(float* spheres, size_t count, const float* planes, size_t planeCount) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            float* p = spheres + i * 4;
+
+            float distance = std::numeric_limits<float>::infinity();
+            for (size_t j = 0; j < planeCount; j++) {
+
+                const float* plane = planes + j * 4;
+                const float d = p[0] * plane[0] + p[1] * plane[1] + p[2] * plane[2] + plane[3];
+
+                if (d < distance) distance = d;
+            }
+
+            p[3] += distance;
+        }
+    }
+
+    // 3x3 matrix expanded to the 4x4 layout of the array kernels
+    std::array<float, 16> expand(const float* m) {
+
+        return {m[0], m[1], m[2], 0,
+                m[3], m[4], m[5], 0,
+                m[6], m[7], m[8], 0,
+                0, 0, 0, 1};
+    }
+
+    bool supportsAVX2() {
+
+#if defined(THREEPP_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(THREEPP_SIMD_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 1);
+        const bool fma = (info[2] & (1 << 12)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        // the OS saves the YMM registers
+        if (!fma || !osxsave || (_xgetbv(0) & 6) != 6) return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return false;
+#endif
+    }
+
+    // sets are ordered with NEON last, so asking for NEON selects the best one available
+    const Kernels& kernelsFor(InstructionSet set) {
+
+#ifdef THREEPP_SIMD_X86
+        if (set >= InstructionSet::AVX2 && avx2Kernels().set == InstructionSet::AVX2 && supportsAVX2()) return avx2Kernels();
+        if (set >= InstructionSet::SSE) return sseKernels();
+#endif
+
+#ifdef THREEPP_SIMD_NEON
+        if (set >= InstructionSet::NEON) return neonKernels();
+#endif
+
+        return scalarKernels();
+    }
+
+    std::atomic<const Kernels*>& activeKernels() {
+
+        static std::atomic<const Kernels*> kernels{&kernelsFor(InstructionSet::NEON)};
+
+        return kernels;
+    }
+
+    const Kernels& kernels() {
+
+        return *activeKernels().load(std::memory_order_relaxed);
+    }
+
+}// namespace
+
+const Kernels& simd::scalarKernels() {
+
+    static const Kernels kernels{
+            InstructionSet::Scalar,
+            &multiplyMatricesScalar,
+            &invertScalar,
+            &transformScalar,
+            &normalizeArrayScalar,
+            &computeBoundsScalar,
+            &planeDistancesScalar};
+
+    return kernels;
+}
+
+InstructionSet simd::detectInstructionSet() {
+
+    return kernelsFor(InstructionSet::NEON).set;
+}
+
+InstructionSet simd::instructionSet() {
+
+    return kernels().set;
+}
+
+void simd::setInstructionSet(InstructionSet set) {
+
+    activeKernels().store(&kernelsFor(set), std::memory_order_relaxed);
+}
+
+const char* simd::name(InstructionSet set) {
+
+    switch (set) {
+        case InstructionSet::SSE:
+            return "SSE";
+        case InstructionSet::AVX2:
+            return "AVX2";
+        case InstructionSet::NEON:
+            return "NEON";
+        default:
+            return "Scalar";
+    }
+}
+
+void simd::multiplyMatrices(const float* a, const float* b, float* out) {
+
+    kernels().multiplyMatrices(a, b, out);
+}
+
+void simd::invert(const float* m, float* out) {
+
+    kernels().invert(m, out);
+}
+
+void simd::applyMatrix4(float* array, size_t count, size_t stride, const float* m) {
+
+    kernels().transform(array, count, stride, m, Transform::Point);
+}
+
+void simd::applyMatrix3(float* array, size_t count, size_t stride, const float* m) {
+
+    const auto e = expand(m);
+    kernels().transform(array, count, stride, e.data(), Transform::Linear);
+}
+
+void simd::applyNormalMatrix(float* array, size_t count, size_t stride, const float* m) {
+
+    const auto e = expand(m);
+    kernels().transform(array, count, stride, e.data(), Transform::Direction);
+}
+
+void simd::transformDirection(float* array, size_t count, size_t stride, const float* m) {
+
+    kernels().transform(array, count, stride, m, Transform::Direction);
+}
+
+void simd::normalize(float* array, size_t count, size_t stride) {
+
+    kernels().normalize(array, count, stride);
+}
+
+void simd::computeBounds(const float* array, size_t count, size_t stride, float* min, float* max) {
+
+    kernels().computeBounds(array, count, stride, min, max);
+}
+
+void simd::planeDistances(float* spheres, size_t count, const float* planes, size_t planeCount) {
+
+    kernels().planeDistances(spheres, count, planes, planeCount);
+}
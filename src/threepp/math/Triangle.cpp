@@ -5,15 +5,6 @@
 
 using namespace threepp;
 
-namespace {
-
-    Vector3 _v0{};
-    Vector3 _v1{};
-    Vector3 _v2{};
-    Vector3 _v3{};
-
-}
-
 Triangle::Triangle(Vector3 a, Vector3 b, Vector3 c): a_(a), b_(b), c_(c) {}
 
 const Vector3& Triangle::a() const {
@@ -31,9 +22,11 @@ const Vector3& Triangle::c() const {
 
 void Triangle::getNormal(const Vector3& a, const Vector3& b, const Vector3& c, Vector3& target) {
 
+    Vector3 v0;
+
     target.subVectors(c, b);
-    _v0.subVectors(a, b);
-    target.cross(_v0);
+    v0.subVectors(a, b);
+    target.cross(v0);
 
     const auto targetLengthSq = target.lengthSq();
     if (targetLengthSq > 0) {
@@ -48,15 +41,17 @@ void Triangle::getNormal(const Vector3& a, const Vector3& b, const Vector3& c, V
 
 void Triangle::getBarycoord(const Vector3& point, const Vector3& a, const Vector3& b, const Vector3& c, Vector3& target) {
 
-    _v0.subVectors(c, a);
-    _v1.subVectors(b, a);
-    _v2.subVectors(point, a);
+    Vector3 v0, v1, v2;
+
+    v0.subVectors(c, a);
+    v1.subVectors(b, a);
+    v2.subVectors(point, a);
 
-    const auto dot00 = _v0.dot(_v0);
-    const auto dot01 = _v0.dot(_v1);
-    const auto dot02 = _v0.dot(_v2);
-    const auto dot11 = _v1.dot(_v1);
-    const auto dot12 = _v1.dot(_v2);
+    const auto dot00 = v0.dot(v0);
+    const auto dot01 = v0.dot(v1);
+    const auto dot02 = v0.dot(v2);
+    const auto dot11 = v1.dot(v1);
+    const auto dot12 = v1.dot(v2);
 
     const float denom = (dot00 * dot11 - dot01 * dot01);
 
@@ -80,28 +75,32 @@ void Triangle::getBarycoord(const Vector3& point, const Vector3& a, const Vector
 
 bool Triangle::containsPoint(const Vector3& point, const Vector3& a, const Vector3& b, const Vector3& c) {
 
-    getBarycoord(point, a, b, c, _v3);
+    Vector3 v3;
+    getBarycoord(point, a, b, c, v3);
 
-    return (_v3.x >= 0) && (_v3.y >= 0) && ((_v3.x + _v3.y) <= 1);
+    return (v3.x >= 0) && (v3.y >= 0) && ((v3.x + v3.y) <= 1);
 }
 
 void Triangle::getUV(const Vector3& point, const Vector3& p1, const Vector3& p2, const Vector3& p3, const Vector2& uv1, const Vector2& uv2, const Vector2& uv3, Vector2& target) {
 
-    getBarycoord(point, p1, p2, p3, _v3);
+    Vector3 v3;
+    getBarycoord(point, p1, p2, p3, v3);
 
     target.set(0, 0);
-    target.addScaledVector(uv1, _v3.x);
-    target.addScaledVector(uv2, _v3.y);
-    target.addScaledVector(uv3, _v3.z);
+    target.addScaledVector(uv1, v3.x);
+    target.addScaledVector(uv2, v3.y);
+    target.addScaledVector(uv3, v3.z);
 }
 
 bool Triangle::isFrontFacing(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& direction) {
 
-    _v0.subVectors(c, b);
-    _v1.subVectors(a, b);
+    Vector3 v0, v1;
+
+    v0.subVectors(c, b);
+    v1.subVectors(a, b);
 
     // strictly front facing
-    return _v0.cross(_v1).dot(direction) < 0;
+    return v0.cross(v1).dot(direction) < 0;
 }
 
 Triangle& Triangle::set(const Vector3& a, const Vector3& b, const Vector3& c) {
@@ -115,10 +114,12 @@ Triangle& Triangle::set(const Vector3& a, const Vector3& b, const Vector3& c) {
 
 float Triangle::getArea() const {
 
-    _v0.subVectors(this->c_, this->b_);
-    _v1.subVectors(this->a_, this->b_);
+    Vector3 v0, v1;
+
+    v0.subVectors(this->c_, this->b_);
+    v1.subVectors(this->a_, this->b_);
 
-    return _v0.cross(_v1).length() * 0.5f;
+    return v0.cross(v1).length() * 0.5f;
 }
 
 void Triangle::getMidpoint(Vector3& target) {
@@ -156,12 +157,7 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
     const auto a = this->a_, b = this->b_, c = this->c_;
     float v, w;
 
-    static Vector3 _vab{};
-    static Vector3 _vac{};
-    static Vector3 _vap{};
-    static Vector3 _vbp{};
-    static Vector3 _vcp{};
-    static Vector3 _vbc{};
+    Vector3 vab, vac, vap, vbp, vcp, vbc;
 
 
     // algorithm thanks to Real-Time Collision Detection by Christer Ericson,
@@ -170,11 +166,11 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
     // basically, we're distinguishing which of the voronoi regions of the Triangle
     // the point lies in with the minimum amount of redundant computation.
 
-    _vab.subVectors(b, a);
-    _vac.subVectors(c, a);
-    _vap.subVectors(p, a);
-    const float d1 = _vab.dot(_vap);
-    const float d2 = _vac.dot(_vap);
+    vab.subVectors(b, a);
+    vac.subVectors(c, a);
+    vap.subVectors(p, a);
+    const float d1 = vab.dot(vap);
+    const float d2 = vac.dot(vap);
     if (d1 <= 0 && d2 <= 0) {
 
         // vertex region of A; barycentric coords (1, 0, 0)
@@ -182,9 +178,9 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
         return;
     }
 
-    _vbp.subVectors(p, b);
-    const float d3 = _vab.dot(_vbp);
-    const float d4 = _vac.dot(_vbp);
+    vbp.subVectors(p, b);
+    const float d3 = vab.dot(vbp);
+    const float d4 = vac.dot(vbp);
     if (d3 >= 0 && d4 <= d3) {
 
         // vertex region of B; barycentric coords (0, 1, 0)
@@ -198,13 +194,13 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
         v = d1 / (d1 - d3);
         // edge region of AB; barycentric coords (1-v, v, 0)
         target = (a);
-        target.addScaledVector(_vab, v);
+        target.addScaledVector(vab, v);
         return;
     }
 
-    _vcp.subVectors(p, c);
-    const float d5 = _vab.dot(_vcp);
-    const float d6 = _vac.dot(_vcp);
+    vcp.subVectors(p, c);
+    const float d5 = vab.dot(vcp);
+    const float d6 = vac.dot(vcp);
     if (d6 >= 0 && d5 <= d6) {
 
         // vertex region of C; barycentric coords (0, 0, 1)
@@ -218,18 +214,18 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
         w = d2 / (d2 - d6);
         // edge region of AC; barycentric coords (1-w, 0, w)
         target = (a);
-        target.addScaledVector(_vac, w);
+        target.addScaledVector(vac, w);
         return;
     }
 
     const float va = d3 * d6 - d5 * d4;
     if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
 
-        _vbc.subVectors(c, b);
+        vbc.subVectors(c, b);
         w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
         // edge region of BC; barycentric coords (0, 1-w, w)
         target = (b);
-        target.addScaledVector(_vbc, w);// edge region of BC
+        target.addScaledVector(vbc, w);// edge region of BC
         return;
     }
 
@@ -240,7 +236,7 @@ void Triangle::closestPointToPoint(const Vector3& p, Vector3& target) {
     w = vc * denom;
 
     target = (a);
-    target.addScaledVector(_vab, v).addScaledVector(_vac, w);
+    target.addScaledVector(vab, v).addScaledVector(vac, w);
 }
 const Vector3& Triangle::operator[](char c) const {
     switch (c) {
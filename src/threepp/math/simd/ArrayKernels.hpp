@@ -0,0 +1,202 @@
+
+#ifndef THREEPP_SIMD_ARRAYKERNELS_HPP
+#define THREEPP_SIMD_ARRAYKERNELS_HPP
+
+#include "Kernels.hpp"
+
+#include <limits>
+
+// Array kernels written once against a Pack, which loads Pack::width vectors at a time
+// into one register per component:
+//
+//     using V;                                    register of width floats
+//     static V set1(float), add, mul, div, sqrt;
+//     static V lessOf(V x, V m);                  x < m ? x : m per lane, so NaN in x keeps m
+//     static V greaterOf(V x, V m);               x > m ? x : m per lane
+//     static V nanToOne(V v);
+//     static float reduceMin(V), reduceMax(V);
+//     static void load(const float* p, size_t stride, V& x, V& y, V& z, V& w);
+//     static void store(float* p, size_t stride, V x, V y, V z, V w);
+//
+// with load and store supporting a stride of 3 and 4, w being the untouched fourth component of the latter.
+// Included by the translation unit of each instruction set, so everything here has internal linkage
+// and no code with vector instructions is shared between units built with different target flags.
+namespace threepp::simd {
+
+    namespace {
+
+        template<class P, Transform T>
+        void transformPacked(float* array, size_t count, size_t stride, const float* m) {
+
+            using V = typename P::V;
+
+            const V m0 = P::set1(m[0]), m1 = P::set1(m[1]), m2 = P::set1(m[2]);
+            const V m4 = P::set1(m[4]), m5 = P::set1(m[5]), m6 = P::set1(m[6]);
+            const V m8 = P::set1(m[8]), m9 = P::set1(m[9]), m10 = P::set1(m[10]);
+
+            const V one = P::set1(1);
+
+            for (size_t i = 0; i < count; i += P::width) {
+
+                float* p = array + i * stride;
+
+                V x, y, z, w;
+                P::load(p, stride, x, y, z, w);
+
+                // same order of operations as the scalar code
+                V rx = P::add(P::add(P::mul(m0, x), P::mul(m4, y)), P::mul(m8, z));
+                V ry = P::add(P::add(P::mul(m1, x), P::mul(m5, y)), P::mul(m9, z));
+                V rz = P::add(P::add(P::mul(m2, x), P::mul(m6, y)), P::mul(m10, z));
+
+                if constexpr (T == Transform::Point) {
+
+                    const V rw = P::div(one, P::add(P::add(P::add(P::mul(P::set1(m[3]), x), P::mul(P::set1(m[7]), y)), P::mul(P::set1(m[11]), z)), P::set1(m[15])));
+
+                    rx = P::mul(P::add(rx, P::set1(m[12])), rw);
+                    ry = P::mul(P::add(ry, P::set1(m[13])), rw);
+                    rz = P::mul(P::add(rz, P::set1(m[14])), rw);
+                }
+
+                if constexpr (T == Transform::Direction) {
+
+                    const V length = P::nanToOne(P::sqrt(P::add(P::add(P::mul(rx, rx), P::mul(ry, ry)), P::mul(rz, rz))));
+
+                    rx = P::div(rx, length);
+                    ry = P::div(ry, length);
+                    rz = P::div(rz, length);
+                }
+
+                P::store(p, stride, rx, ry, rz, w);
+            }
+        }
+
+        template<class P>
+        void transformArray(float* array, size_t count, size_t stride, const float* m, Transform transform) {
+
+            if (stride == 3 || stride == 4) {
+
+                const size_t packed = count - count % P::width;
+
+                switch (transform) {
+                    case Transform::Point:
+                        transformPacked<P, Transform::Point>(array, packed, stride, m);
+                        break;
+                    case Transform::Linear:
+                        transformPacked<P, Transform::Linear>(array, packed, stride, m);
+                        break;
+                    case Transform::Direction:
+                        transformPacked<P, Transform::Direction>(array, packed, stride, m);
+                        break;
+                }
+
+                array += packed * stride;
+                count -= packed;
+            }
+
+            scalarKernels().transform(array, count, stride, m, transform);
+        }
+
+        template<class P>
+        void normalizeArray(float* array, size_t count, size_t stride) {
+
+            using V = typename P::V;
+
+            if (stride == 3 || stride == 4) {
+
+                const size_t packed = count - count % P::width;
+
+                for (size_t i = 0; i < packed; i += P::width) {
+
+                    float* p = array + i * stride;
+
+                    V x, y, z, w;
+                    P::load(p, stride, x, y, z, w);
+
+                    const V length = P::nanToOne(P::sqrt(P::add(P::add(P::mul(x, x), P::mul(y, y)), P::mul(z, z))));
+
+                    P::store(p, stride, P::div(x, length), P::div(y, length), P::div(z, length), w);
+                }
+
+                array += packed * stride;
+                count -= packed;
+            }
+
+            scalarKernels().normalize(array, count, stride);
+        }
+
+        template<class P>
+        void computeBoundsArray(const float* array, size_t count, size_t stride, float* min, float* max) {
+
+            using V = typename P::V;
+
+            min[0] = min[1] = min[2] = std::numeric_limits<float>::infinity();
+            max[0] = max[1] = max[2] = -std::numeric_limits<float>::infinity();
+
+            if (stride == 3 || stride == 4) {
+
+                const size_t packed = count - count % P::width;
+
+                V minX = P::set1(min[0]), minY = minX, minZ = minX;
+                V maxX = P::set1(max[0]), maxY = maxX, maxZ = maxX;
+
+                for (size_t i = 0; i < packed; i += P::width) {
+
+                    V x, y, z, w;
+                    P::load(array + i * stride, stride, x, y, z, w);
+
+                    minX = P::lessOf(x, minX), minY = P::lessOf(y, minY), minZ = P::lessOf(z, minZ);
+                    maxX = P::greaterOf(x, maxX), maxY = P::greaterOf(y, maxY), maxZ = P::greaterOf(z, maxZ);
+                }
+
+                min[0] = P::reduceMin(minX), min[1] = P::reduceMin(minY), min[2] = P::reduceMin(minZ);
+                max[0] = P::reduceMax(maxX), max[1] = P::reduceMax(maxY), max[2] = P::reduceMax(maxZ);
+
+                array += packed * stride;
+                count -= packed;
+            }
+
+            float tailMin[3], tailMax[3];
+            scalarKernels().computeBounds(array, count, stride, tailMin, tailMax);
+
+            for (int i = 0; i < 3; i++) {
+
+                if (tailMin[i] < min[i]) min[i] = tailMin[i];
+                if (tailMax[i] > max[i]) max[i] = tailMax[i];
+            }
+        }
+
+        template<class P>
+        void planeDistancesArray(float* spheres, size_t count, const float* planes, size_t planeCount) {
+
+            using V = typename P::V;
+
+            const size_t packed = count - count % P::width;
+
+            for (size_t i = 0; i < packed; i += P::width) {
+
+                float* p = spheres + i * 4;
+
+                V x, y, z, radius;
+                P::load(p, 4, x, y, z, radius);
+
+                V distance = P::set1(std::numeric_limits<float>::infinity());
+                for (size_t j = 0; j < planeCount; j++) {
+
+                    const float* plane = planes + j * 4;
+
+                    // same order of operations as Plane::distanceToPoint
+                    const V d = P::add(P::add(P::add(P::mul(x, P::set1(plane[0])), P::mul(y, P::set1(plane[1]))), P::mul(z, P::set1(plane[2]))), P::set1(plane[3]));
+                    distance = P::lessOf(d, distance);
+                }
+
+                P::store(p, 4, x, y, z, P::add(distance, radius));
+            }
+
+            scalarKernels().planeDistances(spheres + packed * 4, count - packed, planes, planeCount);
+        }
+
+    }// namespace
+
+}// namespace threepp::simd
+
+#endif//THREEPP_SIMD_ARRAYKERNELS_HPP
@@ -0,0 +1,53 @@
+
+#ifndef THREEPP_SIMD_KERNELS_HPP
+#define THREEPP_SIMD_KERNELS_HPP
+
+#include "threepp/math/SimdKernels.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define THREEPP_SIMD_X86
+#endif
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define THREEPP_SIMD_NEON
+#endif
+
+namespace threepp::simd {
+
+    // how the array kernels transform each vector
+    enum class Transform {
+        Point,    // x, y, z, 1 by a 4x4 matrix, then divided by w
+        Linear,   // x, y, z by the upper 3x3 of a 4x4 matrix
+        Direction // Linear, then normalized
+    };
+
+    // One implementation of every kernel. Matrices of the array kernels are always 4x4, 3x3 ones are expanded by the caller.
+    // Implementations for an instruction set handle as many vectors as their lanes allow and leave the rest to the scalar ones.
+    struct Kernels {
+
+        InstructionSet set;
+
+        void (*multiplyMatrices)(const float* a, const float* b, float* out);
+        void (*invert)(const float* m, float* out);
+
+        void (*transform)(float* array, size_t count, size_t stride, const float* m, Transform transform);
+        void (*normalize)(float* array, size_t count, size_t stride);
+        void (*computeBounds)(const float* array, size_t count, size_t stride, float* min, float* max);
+        void (*planeDistances)(float* spheres, size_t count, const float* planes, size_t planeCount);
+    };
+
+    const Kernels& scalarKernels();
+
+#ifdef THREEPP_SIMD_X86
+    const Kernels& sseKernels();
+
+    const Kernels& avx2Kernels();
+#endif
+
+#ifdef THREEPP_SIMD_NEON
+    const Kernels& neonKernels();
+#endif
+
+}// namespace threepp::simd
+
+#endif//THREEPP_SIMD_KERNELS_HPP
@@ -0,0 +1,123 @@
+
+#include "Kernels.hpp"
+
+#ifdef THREEPP_SIMD_X86
+
+// built with AVX2 enabled (see src/CMakeLists.txt), only called after the CPU has been checked for it
+#ifdef __AVX2__
+
+#include "ArrayKernels.hpp"
+#include "PackSSE.hpp"
+
+#include <immintrin.h>
+
+using namespace threepp::simd;
+
+namespace {
+
+    // two SSE packs side by side
+    struct PackAVX2 {
+
+        using V = __m256;
+        static constexpr size_t width = 8;
+
+        static V set1(float value) { return _mm256_set1_ps(value); }
+        static V add(V a, V b) { return _mm256_add_ps(a, b); }
+        static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+        static V div(V a, V b) { return _mm256_div_ps(a, b); }
+        static V sqrt(V v) { return _mm256_sqrt_ps(v); }
+
+        static V lessOf(V x, V m) { return _mm256_min_ps(x, m); }
+        static V greaterOf(V x, V m) { return _mm256_max_ps(x, m); }
+
+        static V nanToOne(V v) {
+
+            return _mm256_blendv_ps(v, _mm256_set1_ps(1), _mm256_cmp_ps(v, v, _CMP_UNORD_Q));
+        }
+
+        static float reduceMin(V v) {
+
+            return PackSSE::reduceMin(_mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+        }
+
+        static float reduceMax(V v) {
+
+            return PackSSE::reduceMax(_mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+        }
+
+        static V combine(__m128 low, __m128 high) {
+
+            return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+        }
+
+        static void load(const float* p, size_t stride, V& x, V& y, V& z, V& w) {
+
+            __m128 x0, y0, z0, w0, x1, y1, z1, w1;
+            PackSSE::load(p, stride, x0, y0, z0, w0);
+            PackSSE::load(p + 4 * stride, stride, x1, y1, z1, w1);
+
+            x = combine(x0, x1);
+            y = combine(y0, y1);
+            z = combine(z0, z1);
+            w = combine(w0, w1);
+        }
+
+        static void store(float* p, size_t stride, V x, V y, V z, V w) {
+
+            PackSSE::store(p, stride, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), _mm256_castps256_ps128(w));
+            PackSSE::store(p + 4 * stride, stride, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), _mm256_extractf128_ps(w, 1));
+        }
+    };
+
+    // two columns of the result at a time, each lane of b broadcast within its half
+    void multiplyMatricesAVX2(const float* a, const float* b, float* out) {
+
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+        const __m256 b01 = _mm256_loadu_ps(b);
+        const __m256 b23 = _mm256_loadu_ps(b + 8);
+
+        const auto columns = [&](__m256 bj) {
+            __m256 r = _mm256_mul_ps(a0, _mm256_permute_ps(bj, _MM_SHUFFLE(0, 0, 0, 0)));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a1, _mm256_permute_ps(bj, _MM_SHUFFLE(1, 1, 1, 1))));
+            r = _mm256_add_ps(r, _mm256_mul_ps(a2, _mm256_permute_ps(bj, _MM_SHUFFLE(2, 2, 2, 2))));
+            return _mm256_add_ps(r, _mm256_mul_ps(a3, _mm256_permute_ps(bj, _MM_SHUFFLE(3, 3, 3, 3))));
+        };
+
+        const __m256 r01 = columns(b01);
+        const __m256 r23 = columns(b23);
+
+        _mm256_storeu_ps(out, r01);
+        _mm256_storeu_ps(out + 8, r23);
+    }
+
+}// namespace
+
+const Kernels& threepp::simd::avx2Kernels() {
+
+    // a single 4x4 inverse does not fill 8 lanes, it stays on SSE
+    static const Kernels kernels{
+            InstructionSet::AVX2,
+            &multiplyMatricesAVX2,
+            &invertSSE,
+            &transformArray<PackAVX2>,
+            &normalizeArray<PackAVX2>,
+            &computeBoundsArray<PackAVX2>,
+            &planeDistancesArray<PackAVX2>};
+
+    return kernels;
+}
+
+#else
+
+const threepp::simd::Kernels& threepp::simd::avx2Kernels() {
+
+    return sseKernels();
+}
+
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+
+#include "Kernels.hpp"
+
+#ifdef THREEPP_SIMD_NEON
+
+#include "ArrayKernels.hpp"
+
+#include <arm_neon.h>
+
+using namespace threepp::simd;
+
+namespace {
+
+    // AArch64 NEON, which has lane wise division, square root and horizontal min/max
+    struct PackNEON {
+
+        using V = float32x4_t;
+        static constexpr size_t width = 4;
+
+        static V set1(float value) { return vdupq_n_f32(value); }
+        static V add(V a, V b) { return vaddq_f32(a, b); }
+        static V mul(V a, V b) { return vmulq_f32(a, b); }
+        static V div(V a, V b) { return vdivq_f32(a, b); }
+        static V sqrt(V v) { return vsqrtq_f32(v); }
+
+        // vminq/vmaxq propagate NaN, compare and select instead
+        static V lessOf(V x, V m) { return vbslq_f32(vcltq_f32(x, m), x, m); }
+        static V greaterOf(V x, V m) { return vbslq_f32(vcgtq_f32(x, m), x, m); }
+
+        static V nanToOne(V v) { return vbslq_f32(vceqq_f32(v, v), v, vdupq_n_f32(1)); }
+
+        static float reduceMin(V v) { return vminvq_f32(v); }
+        static float reduceMax(V v) { return vmaxvq_f32(v); }
+
+        static void load(const float* p, size_t stride, V& x, V& y, V& z, V& w) {
+
+            if (stride == 4) {
+
+                const float32x4x4_t v = vld4q_f32(p);
+                x = v.val[0], y = v.val[1], z = v.val[2], w = v.val[3];
+
+            } else {
+
+                const float32x4x3_t v = vld3q_f32(p);
+                x = v.val[0], y = v.val[1], z = v.val[2], w = vdupq_n_f32(0);
+            }
+        }
+
+        static void store(float* p, size_t stride, V x, V y, V z, V w) {
+
+            if (stride == 4) {
+
+                vst4q_f32(p, float32x4x4_t{{x, y, z, w}});
+
+            } else {
+
+                vst3q_f32(p, float32x4x3_t{{x, y, z}});
+            }
+        }
+    };
+
+    void multiplyMatricesNEON(const float* a, const float* b, float* out) {
+
+        const float32x4_t a0 = vld1q_f32(a), a1 = vld1q_f32(a + 4), a2 = vld1q_f32(a + 8), a3 = vld1q_f32(a + 12);
+        const float32x4_t b0 = vld1q_f32(b), b1 = vld1q_f32(b + 4), b2 = vld1q_f32(b + 8), b3 = vld1q_f32(b + 12);
+
+        const auto column = [&](float32x4_t bj) {
+            float32x4_t r = vmulq_laneq_f32(a0, bj, 0);
+            r = vaddq_f32(r, vmulq_laneq_f32(a1, bj, 1));
+            r = vaddq_f32(r, vmulq_laneq_f32(a2, bj, 2));
+            return vaddq_f32(r, vmulq_laneq_f32(a3, bj, 3));
+        };
+
+        const float32x4_t r0 = column(b0), r1 = column(b1), r2 = column(b2), r3 = column(b3);
+
+        vst1q_f32(out, r0);
+        vst1q_f32(out + 4, r1);
+        vst1q_f32(out + 8, r2);
+        vst1q_f32(out + 12, r3);
+    }
+
+}// namespace
+
+const Kernels& threepp::simd::neonKernels() {
+
+    // without a shuffle as flexible as shufps the block wise inverse does not pay off, it stays scalar
+    static const Kernels kernels{
+            InstructionSet::NEON,
+            &multiplyMatricesNEON,
+            scalarKernels().invert,
+            &transformArray<PackNEON>,
+            &normalizeArray<PackNEON>,
+            &computeBoundsArray<PackNEON>,
+            &planeDistancesArray<PackNEON>};
+
+    return kernels;
+}
+
+#endif
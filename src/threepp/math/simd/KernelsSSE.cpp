@@ -0,0 +1,25 @@
+
+#include "Kernels.hpp"
+
+#ifdef THREEPP_SIMD_X86
+
+#include "ArrayKernels.hpp"
+#include "PackSSE.hpp"
+
+using namespace threepp::simd;
+
+const Kernels& threepp::simd::sseKernels() {
+
+    static const Kernels kernels{
+            InstructionSet::SSE,
+            &multiplyMatricesSSE,
+            &invertSSE,
+            &transformArray<PackSSE>,
+            &normalizeArray<PackSSE>,
+            &computeBoundsArray<PackSSE>,
+            &planeDistancesArray<PackSSE>};
+
+    return kernels;
+}
+
+#endif
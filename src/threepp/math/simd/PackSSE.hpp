@@ -0,0 +1,207 @@
+
+#ifndef THREEPP_SIMD_PACKSSE_HPP
+#define THREEPP_SIMD_PACKSSE_HPP
+
+#include <cstddef>
+
+#include <emmintrin.h>
+
+// SSE2 pack and matrix kernels, shared by the SSE and AVX2 translation units.
+namespace threepp::simd {
+
+    namespace {
+
+        struct PackSSE {
+
+            using V = __m128;
+            static constexpr size_t width = 4;
+
+            static V set1(float value) { return _mm_set1_ps(value); }
+            static V add(V a, V b) { return _mm_add_ps(a, b); }
+            static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+            static V div(V a, V b) { return _mm_div_ps(a, b); }
+            static V sqrt(V v) { return _mm_sqrt_ps(v); }
+
+            // minps and maxps return their second operand when comparing with NaN
+            static V lessOf(V x, V m) { return _mm_min_ps(x, m); }
+            static V greaterOf(V x, V m) { return _mm_max_ps(x, m); }
+
+            static V nanToOne(V v) {
+
+                const V nan = _mm_cmpunord_ps(v, v);
+                return _mm_or_ps(_mm_and_ps(nan, _mm_set1_ps(1)), _mm_andnot_ps(nan, v));
+            }
+
+            static float reduceMin(V v) {
+
+                v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+                v = _mm_min_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+                return _mm_cvtss_f32(v);
+            }
+
+            static float reduceMax(V v) {
+
+                v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+                v = _mm_max_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+                return _mm_cvtss_f32(v);
+            }
+
+            static void load(const float* p, size_t stride, V& x, V& y, V& z, V& w) {
+
+                if (stride == 4) {
+
+                    x = _mm_loadu_ps(p);
+                    y = _mm_loadu_ps(p + 4);
+                    z = _mm_loadu_ps(p + 8);
+                    w = _mm_loadu_ps(p + 12);
+                    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                    return;
+                }
+
+                // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+                const V a = _mm_loadu_ps(p);
+                const V b = _mm_loadu_ps(p + 4);
+                const V c = _mm_loadu_ps(p + 8);
+
+                x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+                y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+                w = _mm_setzero_ps();
+            }
+
+            static void store(float* p, size_t stride, V x, V y, V z, V w) {
+
+                if (stride == 4) {
+
+                    _MM_TRANSPOSE4_PS(x, y, z, w);
+                    _mm_storeu_ps(p, x);
+                    _mm_storeu_ps(p + 4, y);
+                    _mm_storeu_ps(p + 8, z);
+                    _mm_storeu_ps(p + 12, w);
+
+                    return;
+                }
+
+                const V xyLow = _mm_unpacklo_ps(x, y); // x0 y0 x1 y1
+                const V xyHigh = _mm_unpackhi_ps(x, y);// x2 y2 x3 y3
+
+                const V a = _mm_shuffle_ps(xyLow, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+                const V b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xyHigh, _MM_SHUFFLE(1, 0, 2, 0));
+                const V c = _mm_shuffle_ps(_mm_shuffle_ps(z, xyHigh, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(xyHigh, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+                _mm_storeu_ps(p, a);
+                _mm_storeu_ps(p + 4, b);
+                _mm_storeu_ps(p + 8, c);
+            }
+        };
+
+        // columns of a combined by the components of each column of b, in the order of the scalar code
+        inline void multiplyMatricesSSE(const float* a, const float* b, float* out) {
+
+            const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+            const __m128 b0 = _mm_loadu_ps(b), b1 = _mm_loadu_ps(b + 4), b2 = _mm_loadu_ps(b + 8), b3 = _mm_loadu_ps(b + 12);
+
+            const auto column = [&](__m128 bj) {
+                __m128 r = _mm_mul_ps(a0, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(0, 0, 0, 0)));
+                r = _mm_add_ps(r, _mm_mul_ps(a1, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(1, 1, 1, 1))));
+                r = _mm_add_ps(r, _mm_mul_ps(a2, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(2, 2, 2, 2))));
+                return _mm_add_ps(r, _mm_mul_ps(a3, _mm_shuffle_ps(bj, bj, _MM_SHUFFLE(3, 3, 3, 3))));
+            };
+
+            const __m128 r0 = column(b0), r1 = column(b1), r2 = column(b2), r3 = column(b3);
+
+            _mm_storeu_ps(out, r0);
+            _mm_storeu_ps(out + 4, r1);
+            _mm_storeu_ps(out + 8, r2);
+            _mm_storeu_ps(out + 12, r3);
+        }
+
+        // 2x2 matrices stored row major in one register
+        inline __m128 mat2Mul(__m128 a, __m128 b) {
+
+            return _mm_add_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 3, 0))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        // adjugate(a) * b
+        inline __m128 mat2AdjMul(__m128 a, __m128 b) {
+
+            return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(0, 0, 3, 3)), b),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 2, 1, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))));
+        }
+
+        // a * adjugate(b)
+        inline __m128 mat2MulAdj(__m128 a, __m128 b) {
+
+            return _mm_sub_ps(_mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 3, 0, 3))),
+                              _mm_mul_ps(_mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 2, 1, 2))));
+        }
+
+        // Inverse through the 2x2 blocks of the matrix. The columns of m are treated as rows,
+        // which inverts the transpose and so gives the transpose of the inverse, again stored by columns.
+        inline void invertSSE(const float* m, float* out) {
+
+            const __m128 r0 = _mm_loadu_ps(m), r1 = _mm_loadu_ps(m + 4), r2 = _mm_loadu_ps(m + 8), r3 = _mm_loadu_ps(m + 12);
+
+            const __m128 A = _mm_movelh_ps(r0, r1);
+            const __m128 B = _mm_movehl_ps(r1, r0);
+            const __m128 C = _mm_movelh_ps(r2, r3);
+            const __m128 D = _mm_movehl_ps(r3, r2);
+
+            // determinants of the blocks as |A| |B| |C| |D|
+            const __m128 detSub = _mm_sub_ps(
+                    _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(3, 1, 3, 1))),
+                    _mm_mul_ps(_mm_shuffle_ps(r0, r2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(r1, r3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+            const __m128 detA = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(0, 0, 0, 0));
+            const __m128 detB = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(1, 1, 1, 1));
+            const __m128 detC = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(2, 2, 2, 2));
+            const __m128 detD = _mm_shuffle_ps(detSub, detSub, _MM_SHUFFLE(3, 3, 3, 3));
+
+            const __m128 D_C = mat2AdjMul(D, C);
+            const __m128 A_B = mat2AdjMul(A, B);
+
+            __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), mat2Mul(B, D_C));
+            __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), mat2Mul(C, A_B));
+            __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), mat2MulAdj(D, A_B));
+            __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), mat2MulAdj(A, D_C));
+
+            // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+            __m128 tr = _mm_mul_ps(A_B, _mm_shuffle_ps(D_C, D_C, _MM_SHUFFLE(3, 1, 2, 0)));
+            tr = _mm_add_ps(tr, _mm_movehl_ps(tr, tr));
+            tr = _mm_add_ps(tr, _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(1, 1, 1, 1)));
+            tr = _mm_shuffle_ps(tr, tr, _MM_SHUFFLE(0, 0, 0, 0));
+
+            const __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+            if (_mm_cvtss_f32(detM) == 0) {
+
+                const __m128 zero = _mm_setzero_ps();
+                _mm_storeu_ps(out, zero);
+                _mm_storeu_ps(out + 4, zero);
+                _mm_storeu_ps(out + 8, zero);
+                _mm_storeu_ps(out + 12, zero);
+
+                return;
+            }
+
+            const __m128 rDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+
+            X = _mm_mul_ps(X, rDetM);
+            Y = _mm_mul_ps(Y, rDetM);
+            Z = _mm_mul_ps(Z, rDetM);
+            W = _mm_mul_ps(W, rDetM);
+
+            // the adjugates of the blocks, shuffled into place
+            _mm_storeu_ps(out, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out + 4, _mm_shuffle_ps(X, Y, _MM_SHUFFLE(0, 2, 0, 2)));
+            _mm_storeu_ps(out + 8, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(1, 3, 1, 3)));
+            _mm_storeu_ps(out + 12, _mm_shuffle_ps(Z, W, _MM_SHUFFLE(0, 2, 0, 2)));
+        }
+
+    }// namespace
+
+}// namespace threepp::simd
+
+#endif//THREEPP_SIMD_PACKSSE_HPP
@@ -3,18 +3,11 @@
 
 #include "threepp/core/Raycaster.hpp"
 
-using namespace threepp;
-
-namespace {
-
-    Matrix4 _instanceLocalMatrix;
-    Matrix4 _instanceWorldMatrix;
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
-    std::vector<Intersection> _instanceIntersects;
-
-    auto _mesh = Mesh::create();
-
-}// namespace
+using namespace threepp;
 
 
 InstancedMesh::InstancedMesh(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material, unsigned int count)
@@ -28,6 +21,11 @@ std::string InstancedMesh::type() const {
     return "InstancedMesh";
 }
 
+int InstancedMesh::capacity() const {
+
+    return instanceMatrix->count();
+}
+
 void InstancedMesh::getColorAt(size_t index, Color& color) const {
 
     color.fromArray(this->instanceColor->array(), index * 3);
@@ -42,7 +40,7 @@ void InstancedMesh::setColorAt(size_t index, const Color& color) {
 
     if (!this->instanceColor) {
 
-        this->instanceColor = FloatBufferAttribute ::create(std::vector<float>(count * 3), 3);
+        this->instanceColor = FloatBufferAttribute ::create(std::vector<float>(capacity() * 3), 3);
     }
 
     color.toArray(this->instanceColor->array(), index * 3);
@@ -53,6 +51,26 @@ void InstancedMesh::setMatrixAt(size_t index, const Matrix4& matrix) const {
     matrix.toArray(this->instanceMatrix->array(), index * 16);
 }
 
+InstancedMesh& InstancedMesh::addLevel(std::shared_ptr<BufferGeometry> geometry, float distance) {
+
+    // instance levels are kept in a byte per instance, with one value marking culled instances
+    assert(levels_.size() < 254);
+
+    distance = std::abs(distance);
+
+    const auto it = std::upper_bound(levels_.begin(), levels_.end(), distance, [](float d, const InstanceLevel& level) {
+        return d < level.distance;
+    });
+    levels_.insert(it, {distance, std::move(geometry)});
+
+    return *this;
+}
+
+const std::vector<InstanceLevel>& InstancedMesh::levels() const {
+
+    return levels_;
+}
+
 void InstancedMesh::dispose() {
 
     dispatchEvent("dispose", this);
@@ -60,38 +78,37 @@ void InstancedMesh::dispose() {
 
 void InstancedMesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects) {
 
+    if (!material()) return;
+
     const auto& matrixWorld = this->matrixWorld;
-    const auto raycastTimes = this->count;
+    const auto raycastTimes = std::min(this->count, capacity());
 
-    _mesh->setGeometry(geometry_);
-    _mesh->setMaterials(materials_);
+    // the mesh represents a single instance, one per call so that concurrent raycasts do not share it
+    const auto mesh = Mesh::create(geometry_, materials_);
 
-    if (!_mesh->material()) return;
+    Matrix4 instanceLocalMatrix;
+    std::vector<Intersection> instanceIntersects;
 
     for (int instanceId = 0; instanceId < raycastTimes; instanceId++) {
 
         // calculate the world matrix for each instance
 
-        this->getMatrixAt(instanceId, _instanceLocalMatrix);
-
-        _instanceWorldMatrix.multiplyMatrices(*matrixWorld, _instanceLocalMatrix);
-
-        // the mesh represents this single instance
+        this->getMatrixAt(instanceId, instanceLocalMatrix);
 
-        _mesh->matrixWorld->copy(_instanceWorldMatrix);
+        mesh->matrixWorld.multiplyMatrices(matrixWorld, instanceLocalMatrix);
 
-        _mesh->raycast(raycaster, _instanceIntersects);
+        mesh->raycast(raycaster, instanceIntersects);
 
         // process the result of raycast
 
-        for (auto& intersect : _instanceIntersects) {
+        for (auto& intersect : instanceIntersects) {
 
             intersect.instanceId = instanceId;
             intersect.object = this;
             intersects.emplace_back(intersect);
         }
 
-        _instanceIntersects.clear();
+        instanceIntersects.clear();
     }
 }
 
@@ -43,15 +43,13 @@ size_t LOD::getCurrentLevel() const {
 
 void LOD::update(Camera* camera) {
 
-    static Vector3 _v1;
-    static Vector3 _v2;
-
     if (levels.size() > 1) {
 
-        _v1.setFromMatrixPosition(*camera->matrixWorld);
-        _v2.setFromMatrixPosition(*this->matrixWorld);
+        Vector3 cameraPosition, position;
+        cameraPosition.setFromMatrixPosition(camera->matrixWorld);
+        position.setFromMatrixPosition(this->matrixWorld);
 
-        float distance = _v1.distanceTo(_v2) / camera->zoom;
+        float distance = cameraPosition.distanceTo(position) / camera->zoom;
 
         levels[0].object->visible = true;
 
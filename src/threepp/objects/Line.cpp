@@ -8,14 +8,6 @@
 
 using namespace threepp;
 
-namespace {
-
-    Sphere _sphere;
-    Matrix4 _inverseMatrix;
-    Ray _ray;
-
-}// namespace
-
 
 Line::Line(std::shared_ptr<BufferGeometry> geometry, std::shared_ptr<Material> material)
     : geometry_(geometry ? std::move(geometry) : BufferGeometry::create()),
@@ -62,7 +54,7 @@ void Line::computeLineDistances() {
 
     if (!geometry_->hasIndex()) {
 
-        const auto positionAttribute = geometry_->getAttribute<float>("position");
+        const auto positionAttribute = geometry_->getAttribute("position");
         std::vector<float> lineDistances{0};
 
         for (int i = 1, l = positionAttribute->count(); i < l; i++) {
@@ -91,16 +83,19 @@ void Line::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
 
     if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
-    _sphere.copy(*geometry->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
-    _sphere.radius += threshold;
+    Sphere sphere(*geometry->boundingSphere);
+    sphere.applyMatrix4(matrixWorld);
+    sphere.radius += threshold;
 
-    if (!raycaster.ray.intersectsSphere(_sphere)) return;
+    if (!raycaster.ray.intersectsSphere(sphere)) return;
 
     //
 
-    _inverseMatrix.copy(*matrixWorld).invert();
-    _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
+    Matrix4 inverseMatrix;
+    inverseMatrix.copy(matrixWorld).invert();
+
+    Ray ray(raycaster.ray);
+    ray.applyMatrix4(inverseMatrix);
 
     const auto localThreshold = threshold / ((this->scale.x + this->scale.y + this->scale.z) / 3);
     const auto localThresholdSq = localThreshold * localThreshold;
@@ -112,7 +107,7 @@ void Line::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
     const auto step = type() == "LineSegments" ? 2 : 1;
 
     auto index = geometry->getIndex();
-    auto positionAttribute = geometry->getAttribute<float>("position");
+    auto positionAttribute = geometry->getAttribute("position");
 
     if (index) {
 
@@ -127,11 +122,11 @@ void Line::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
             positionAttribute->setFromBufferAttribute(vStart, a);
             positionAttribute->setFromBufferAttribute(vEnd, b);
 
-            const auto distSq = _ray.distanceSqToSegment(vStart, vEnd, &interRay, &interSegment);
+            const auto distSq = ray.distanceSqToSegment(vStart, vEnd, &interRay, &interSegment);
 
             if (distSq > localThresholdSq) continue;
 
-            interRay.applyMatrix4(*this->matrixWorld);//Move back to world space for distance calculation
+            interRay.applyMatrix4(this->matrixWorld);//Move back to world space for distance calculation
 
             const auto distance = raycaster.ray.origin.distanceTo(interRay);
 
@@ -139,7 +134,7 @@ void Line::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
 
             Intersection intersection;
             intersection.distance = distance;
-            intersection.point = interSegment.clone().applyMatrix4(*this->matrixWorld);
+            intersection.point = interSegment.clone().applyMatrix4(this->matrixWorld);
             intersection.index = i;
             intersection.object = this;
 
@@ -156,11 +151,11 @@ void Line::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
             positionAttribute->setFromBufferAttribute(vStart, i);
             positionAttribute->setFromBufferAttribute(vEnd, i + 1);
 
-            const auto distSq = _ray.distanceSqToSegment(vStart, vEnd, &interRay, &interSegment);
+            const auto distSq = ray.distanceSqToSegment(vStart, vEnd, &interRay, &interSegment);
 
             if (distSq > localThresholdSq) continue;
 
-            interRay.applyMatrix4(*this->matrixWorld);//Move back to world space for distance calculation
+            interRay.applyMatrix4(this->matrixWorld);//Move back to world space for distance calculation
 
             const auto distance = raycaster.ray.origin.distanceTo(interRay);
 
@@ -168,7 +163,7 @@ void Line::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
 
             Intersection intersection;
             intersection.distance = distance;
-            intersection.point = interSegment.clone().applyMatrix4(*this->matrixWorld);
+            intersection.point = interSegment.clone().applyMatrix4(this->matrixWorld);
             intersection.index = i;
             intersection.object = this;
 
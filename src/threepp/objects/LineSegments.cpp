@@ -22,7 +22,7 @@ void LineSegments::computeLineDistances() {
 
     if (geometry_->getIndex() == nullptr) {
 
-        const auto positionAttribute = geometry_->getAttribute<float>("position");
+        const auto positionAttribute = geometry_->getAttribute("position");
         std::vector<float> lineDistances;
 
         for (int i = 0, l = positionAttribute->count(); i < l; i += 2) {
@@ -17,8 +17,6 @@ namespace {
 
     std::optional<Intersection> checkIntersection(Object3D* object, Material* material, Raycaster& raycaster, Ray& ray, const Vector3& pA, const Vector3& pB, const Vector3& pC, Vector3& point) {
 
-        static Vector3 _intersectionPointWorld{};
-
         if (material->side == BackSide) {
 
             ray.intersectTriangle(pC, pB, pA, true, point);
@@ -30,16 +28,16 @@ namespace {
 
         if (point.isNan()) return std::nullopt;
 
-        _intersectionPointWorld.copy(point);
-        _intersectionPointWorld.applyMatrix4(*object->matrixWorld);
+        Vector3 intersectionPointWorld(point);
+        intersectionPointWorld.applyMatrix4(object->matrixWorld);
 
-        const auto distance = raycaster.ray.origin.distanceTo(_intersectionPointWorld);
+        const auto distance = raycaster.ray.origin.distanceTo(intersectionPointWorld);
 
         if (distance < raycaster.near || distance > raycaster.far) return std::nullopt;
 
         Intersection intersection{};
         intersection.distance = distance;
-        intersection.point = _intersectionPointWorld;
+        intersection.point = intersectionPointWorld;
         intersection.object = object;
 
         return intersection;
@@ -47,51 +45,47 @@ namespace {
 
     std::optional<Intersection> checkBufferGeometryIntersection(
             Object3D* object, Material* material, Raycaster& raycaster, Ray& ray,
-            const FloatBufferAttribute& position, const FloatBufferAttribute* uv, const FloatBufferAttribute* uv2,
+            const BufferAttribute& position, const BufferAttribute* uv, const BufferAttribute* uv2,
             unsigned int a, unsigned int b, unsigned int c) {
 
-        static Vector3 _vA{};
-        static Vector3 _vB{};
-        static Vector3 _vC{};
-        static Vector3 _intersectionPoint{};
+        Vector3 vA, vB, vC;
+        Vector3 intersectionPoint;
 
-        position.setFromBufferAttribute(_vA, a);
-        position.setFromBufferAttribute(_vB, b);
-        position.setFromBufferAttribute(_vC, c);
+        position.setFromBufferAttribute(vA, a);
+        position.setFromBufferAttribute(vB, b);
+        position.setFromBufferAttribute(vC, c);
 
-        auto intersection = checkIntersection(object, material, raycaster, ray, _vA, _vB, _vC, _intersectionPoint);
+        auto intersection = checkIntersection(object, material, raycaster, ray, vA, vB, vC, intersectionPoint);
 
         if (intersection) {
 
-            static Vector2 _uvA{};
-            static Vector2 _uvB{};
-            static Vector2 _uvC{};
+            Vector2 uvA, uvB, uvC;
 
             if (uv) {
 
-                uv->setFromBufferAttribute(_uvA, a);
-                uv->setFromBufferAttribute(_uvB, c);
-                uv->setFromBufferAttribute(_uvC, c);
+                uv->setFromBufferAttribute(uvA, a);
+                uv->setFromBufferAttribute(uvB, b);
+                uv->setFromBufferAttribute(uvC, c);
 
                 Vector2 uvTarget{};
-                Triangle::getUV(_intersectionPoint, _vA, _vB, _vC, _uvA, _uvB, _uvC, uvTarget);
+                Triangle::getUV(intersectionPoint, vA, vB, vC, uvA, uvB, uvC, uvTarget);
                 intersection->uv = uvTarget;
             }
 
             if (uv2) {
 
-                uv2->setFromBufferAttribute(_uvA, a);
-                uv2->setFromBufferAttribute(_uvB, c);
-                uv2->setFromBufferAttribute(_uvC, c);
+                uv2->setFromBufferAttribute(uvA, a);
+                uv2->setFromBufferAttribute(uvB, b);
+                uv2->setFromBufferAttribute(uvC, c);
 
                 Vector2 uv2Target{};
-                Triangle::getUV(_intersectionPoint, _vA, _vB, _vC, _uvA, _uvB, _uvC, uv2Target);
+                Triangle::getUV(intersectionPoint, vA, vB, vC, uvA, uvB, uvC, uv2Target);
                 intersection->uv2 = uv2Target;
             }
 
             Face3 face{a, b, c, {}, 0};
 
-            Triangle::getNormal(_vA, _vB, _vC, face.normal);
+            Triangle::getNormal(vA, vB, vC, face.normal);
 
             intersection->face = face;
         }
@@ -99,6 +93,122 @@ namespace {
         return intersection;
     }
 
+    void raycastBoundsTree(
+            Object3D* object, const std::vector<std::shared_ptr<Material>>& materials, BufferGeometry& geometry,
+            Raycaster& raycaster, Ray& ray, std::vector<Intersection>& intersects) {
+
+        const auto& bvh = *geometry.boundsTree;
+
+        const auto index = geometry.getIndex();
+        const auto position = geometry.getAttribute("position");
+        const auto uv = geometry.getAttribute("uv");
+        const auto uv2 = geometry.getAttribute("uv2");
+        const auto& groups = geometry.groups;
+        const auto& drawRange = geometry.drawRange;
+
+        const int count = index ? index->count() : position->count();
+        const bool singleMaterial = materials.size() == 1;
+        const bool fullRange = drawRange.start <= 0 && drawRange.start + drawRange.count >= count;
+
+        const auto getTriangle = [&](unsigned int faceIndex, unsigned int& a, unsigned int& b, unsigned int& c) {
+            if (index) {
+                a = index->getX(faceIndex * 3);
+                b = index->getX(faceIndex * 3 + 1);
+                c = index->getX(faceIndex * 3 + 2);
+            } else {
+                a = faceIndex * 3;
+                b = faceIndex * 3 + 1;
+                c = faceIndex * 3 + 2;
+            }
+        };
+
+        if (raycaster.firstHitOnly && singleMaterial && fullRange) {
+
+            // the local ray direction is normalized, so convert near/far to local units
+
+            Vector3 o = ray.origin;
+            Vector3 d = ray.origin;
+            d.add(ray.direction);
+            o.applyMatrix4(object->matrixWorld);
+            d.applyMatrix4(object->matrixWorld);
+            const float scale = o.distanceTo(d);
+
+            if (scale == 0) return;
+
+            auto material = materials.front().get();
+            auto hit = bvh.closestHit(ray, material->side, raycaster.near / scale, raycaster.far / scale);
+
+            if (hit) {
+
+                unsigned int a, b, c;
+                getTriangle(hit->faceIndex, a, b, c);
+
+                auto intersection = checkBufferGeometryIntersection(object, material, raycaster, ray, *position, uv, uv2, a, b, c);
+
+                if (intersection) {
+
+                    intersection->faceIndex = static_cast<int>(hit->faceIndex);
+                    intersects.emplace_back(*intersection);
+                }
+            }
+
+            return;
+        }
+
+        std::optional<Intersection> closest;
+        const auto emit = [&](Intersection& intersection) {
+            if (!raycaster.firstHitOnly) {
+                intersects.emplace_back(intersection);
+            } else if (!closest || intersection.distance < closest->distance) {
+                closest = intersection;
+            }
+        };
+
+        bvh.intersectRay(ray, [&](unsigned int faceIndex) {
+            const int j = static_cast<int>(faceIndex) * 3;
+
+            unsigned int a, b, c;
+            getTriangle(faceIndex, a, b, c);
+
+            if (singleMaterial) {
+
+                if (j < drawRange.start || j >= drawRange.start + drawRange.count) return;
+
+                auto intersection = checkBufferGeometryIntersection(object, materials.front().get(), raycaster, ray, *position, uv, uv2, a, b, c);
+
+                if (intersection) {
+
+                    intersection->faceIndex = static_cast<int>(faceIndex);
+                    emit(*intersection);
+                }
+
+            } else {
+
+                for (auto& group : groups) {
+
+                    const auto start = std::max(group.start, drawRange.start);
+                    const auto end = std::min((group.start + group.count), (drawRange.start + drawRange.count));
+
+                    if (j < start || j >= end) continue;
+
+                    auto intersection = checkBufferGeometryIntersection(object, materials[group.materialIndex].get(), raycaster, ray, *position, uv, uv2, a, b, c);
+
+                    if (intersection) {
+
+                        intersection->faceIndex = static_cast<int>(faceIndex);
+                        intersection->face->materialIndex = group.materialIndex;
+                        emit(*intersection);
+                    }
+                }
+            }
+        });
+
+        if (closest) {
+
+            intersects.emplace_back(*closest);
+        }
+    }
+
 }// namespace
 
 
@@ -123,40 +233,47 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
 
     if (material() == nullptr) return;
 
-    static Sphere _sphere{};
-
     // Checking boundingSphere distance to ray
 
     if (!geometry_->boundingSphere) geometry_->computeBoundingSphere();
 
-    _sphere.copy(*geometry_->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
+    Sphere sphere(*geometry_->boundingSphere);
+    sphere.applyMatrix4(matrixWorld);
 
-    if (!raycaster.ray.intersectsSphere(_sphere)) return;
+    if (!raycaster.ray.intersectsSphere(sphere)) return;
 
     //
 
-    static Ray _ray{};
-    static Matrix4 _inverseMatrix{};
+    Matrix4 inverseMatrix;
+    inverseMatrix.copy(matrixWorld).invert();
 
-    _inverseMatrix.copy(*matrixWorld).invert();
-    _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
+    Ray ray(raycaster.ray);
+    ray.applyMatrix4(inverseMatrix);
 
     // Check boundingBox before continuing
 
     if (geometry_->boundingBox) {
 
-        if (!_ray.intersectsBox(*geometry_->boundingBox)) return;
+        if (!ray.intersectsBox(*geometry_->boundingBox)) return;
+    }
+
+    // a stale tree is left to its owner to update, raycasting only reads the scene
+    if (geometry_->boundsTree && !geometry_->boundsTree->stale() && geometry_->hasAttribute("position")) {
+
+        raycastBoundsTree(this, materials_, *geometry_, raycaster, ray, intersects);
+
+        return;
     }
 
     std::optional<Intersection> intersection;
+    const auto firstIntersect = intersects.size();
 
     const auto index = geometry_->getIndex();
-    const auto position = geometry_->getAttribute<float>("position");
-    const auto uv = geometry_->getAttribute<float>("uv");
-    const auto uv2 = geometry_->getAttribute<float>("uv2");
-    const auto groups = geometry_->groups;
-    const auto drawRange = geometry_->drawRange;
+    const auto position = geometry_->getAttribute("position");
+    const auto uv = geometry_->getAttribute("uv");
+    const auto uv2 = geometry_->getAttribute("uv2");
+    const auto& groups = geometry_->groups;
+    const auto& drawRange = geometry_->drawRange;
 
     if (index != nullptr) {
 
@@ -177,7 +294,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                     const auto b = index->getX(j + 1);
                     const auto c = index->getX(j + 2);
 
-                    intersection = checkBufferGeometryIntersection(this, groupMaterial, raycaster, _ray, *position, uv, uv2, a, b, c);
+                    intersection = checkBufferGeometryIntersection(this, groupMaterial, raycaster, ray, *position, uv, uv2, a, b, c);
 
                     if (intersection) {
 
@@ -199,7 +316,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                 const auto b = index->getX(i + 1);
                 const auto c = index->getX(i + 2);
 
-                intersection = checkBufferGeometryIntersection(this, material(), raycaster, _ray, *position, uv, uv2, a, b, c);
+                intersection = checkBufferGeometryIntersection(this, material(), raycaster, ray, *position, uv, uv2, a, b, c);
 
                 if (intersection) {
 
@@ -228,7 +345,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                     const auto b = j + 1;
                     const auto c = j + 2;
 
-                    intersection = checkBufferGeometryIntersection(this, groupMaterial, raycaster, _ray, *position, uv, uv2, a, b, c);
+                    intersection = checkBufferGeometryIntersection(this, groupMaterial, raycaster, ray, *position, uv, uv2, a, b, c);
 
                     if (intersection) {
 
@@ -250,7 +367,7 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
                 const int b = i + 1;
                 const int c = i + 2;
 
-                intersection = checkBufferGeometryIntersection(this, material(), raycaster, _ray, *position, uv, uv2, a, b, c);
+                intersection = checkBufferGeometryIntersection(this, material(), raycaster, ray, *position, uv, uv2, a, b, c);
 
                 if (intersection) {
 
@@ -260,6 +377,13 @@ void Mesh::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects)
             }
         }
     }
+
+    if (raycaster.firstHitOnly && intersects.size() > firstIntersect + 1) {
+
+        auto closest = std::min_element(intersects.begin() + firstIntersect, intersects.end(), [](auto& a, auto& b) { return a.distance < b.distance; });
+        std::iter_swap(intersects.begin() + firstIntersect, closest);
+        intersects.erase(intersects.begin() + firstIntersect + 1, intersects.end());
+    }
 }
 
 std::shared_ptr<Object3D> Mesh::clone(bool recursive) {
@@ -8,12 +8,8 @@ using namespace threepp;
 
 namespace {
 
-    Sphere _sphere;
-    Vector3 _position;
-    Matrix4 _inverseMatrix;
-    Ray _ray;
-
     void testPoint(
+            const Ray& ray,
             const Vector3& point,
             unsigned int index,
             float localThresholdSq,
@@ -22,13 +18,13 @@ namespace {
             std::vector<Intersection>& intersects,
             Object3D* object) {
 
-        const auto rayPointDistanceSq = _ray.distanceSqToPoint(point);
+        const auto rayPointDistanceSq = ray.distanceSqToPoint(point);
 
         if (rayPointDistanceSq < localThresholdSq) {
 
             Vector3 intersectPoint;
 
-            _ray.closestPointToPoint(point, intersectPoint);
+            ray.closestPointToPoint(point, intersectPoint);
             intersectPoint.applyMatrix4(matrixWorld);
 
             const auto distance = raycaster.ray.origin.distanceTo(intersectPoint);
@@ -93,22 +89,27 @@ void Points::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects
 
     if (!geometry->boundingSphere) geometry->computeBoundingSphere();
 
-    _sphere.copy(*geometry->boundingSphere);
-    _sphere.applyMatrix4(*matrixWorld);
-    _sphere.radius += threshold;
+    Sphere sphere(*geometry->boundingSphere);
+    sphere.applyMatrix4(matrixWorld);
+    sphere.radius += threshold;
 
-    if (!raycaster.ray.intersectsSphere(_sphere)) return;
+    if (!raycaster.ray.intersectsSphere(sphere)) return;
 
     //
 
-    _inverseMatrix.copy(*matrixWorld).invert();
-    _ray.copy(raycaster.ray).applyMatrix4(_inverseMatrix);
+    Matrix4 inverseMatrix;
+    inverseMatrix.copy(matrixWorld).invert();
+
+    Ray ray(raycaster.ray);
+    ray.applyMatrix4(inverseMatrix);
 
     const auto localThreshold = threshold / ((this->scale.x + this->scale.y + this->scale.z) / 3);
     const auto localThresholdSq = localThreshold * localThreshold;
 
     const auto index = geometry->getIndex();
-    const auto positionAttribute = geometry->getAttribute<float>("position");
+    const auto positionAttribute = geometry->getAttribute("position");
+
+    Vector3 position;
 
     if (index) {
 
@@ -119,9 +120,9 @@ void Points::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects
 
             const auto a = index->getX(i);
 
-            positionAttribute->setFromBufferAttribute(_position, a);
+            positionAttribute->setFromBufferAttribute(position, a);
 
-            testPoint(_position, a, localThresholdSq, *matrixWorld, raycaster, intersects, this);
+            testPoint(ray, position, a, localThresholdSq, matrixWorld, raycaster, intersects, this);
         }
 
     } else {
@@ -131,9 +132,9 @@ void Points::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects
 
         for (unsigned i = start, l = end; i < l; i++) {
 
-            positionAttribute->setFromBufferAttribute(_position, i);
+            positionAttribute->setFromBufferAttribute(position, i);
 
-            testPoint(_position, i, localThresholdSq, *matrixWorld, raycaster, intersects, this);
+            testPoint(ray, position, i, localThresholdSq, matrixWorld, raycaster, intersects, this);
         }
     }
 }
@@ -14,27 +14,13 @@ using namespace threepp;
 
 namespace {
 
-    Vector3 _intersectPoint;
-    Vector3 _worldScale;
-    Vector3 _mvPosition;
+    void transformVertex(Vector3& vertexPosition, const Vector3& mvPosition, const Vector2& center, const Vector3& scale, const std::optional<std::pair<float, float>>& sincos, const Matrix4& viewWorldMatrix) {
 
-    Vector2 _alignedPosition;
-    Vector2 _rotatedPosition;
-    Matrix4 _viewWorldMatrix;
-
-    Vector3 _vA;
-    Vector3 _vB;
-    Vector3 _vC;
-
-    Vector2 _uvA;
-    Vector2 _uvB;
-    Vector2 _uvC;
-
-
-    void transformVertex(Vector3& vertexPosition, const Vector3& mvPosition, const Vector2& center, const Vector3& scale, const std::optional<std::pair<float, float>>& sincos) {
+        Vector2 alignedPosition;
+        Vector2 rotatedPosition;
 
         // compute position in camera space
-        _alignedPosition.subVectors(vertexPosition, center).addScalar(0.5f).multiply(scale);
+        alignedPosition.subVectors(vertexPosition, center).addScalar(0.5f).multiply(scale);
 
         // to check if rotation is not zero
         if (sincos) {
@@ -42,21 +28,21 @@ namespace {
             float sin = sincos->first;
             float cos = sincos->second;
 
-            _rotatedPosition.x = (cos * _alignedPosition.x) - (sin * _alignedPosition.y);
-            _rotatedPosition.y = (sin * _alignedPosition.x) + (cos * _alignedPosition.y);
+            rotatedPosition.x = (cos * alignedPosition.x) - (sin * alignedPosition.y);
+            rotatedPosition.y = (sin * alignedPosition.x) + (cos * alignedPosition.y);
 
         } else {
 
-            _rotatedPosition.copy(_alignedPosition);
+            rotatedPosition.copy(alignedPosition);
         }
 
 
         vertexPosition.copy(mvPosition);
-        vertexPosition.x += _rotatedPosition.x;
-        vertexPosition.y += _rotatedPosition.y;
+        vertexPosition.x += rotatedPosition.x;
+        vertexPosition.y += rotatedPosition.y;
 
         // transform to world space
-        vertexPosition.applyMatrix4(_viewWorldMatrix);
+        vertexPosition.applyMatrix4(viewWorldMatrix);
     }
 }// namespace
 
@@ -99,16 +85,21 @@ void Sprite::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects
         throw std::runtime_error("THREE.Sprite: 'Raycaster.camera' needs to be set in order to raycast against sprites.");
     }
 
-    _worldScale.setFromMatrixScale(*this->matrixWorld);
+    Vector3 worldScale;
+    worldScale.setFromMatrixScale(this->matrixWorld);
+
+    const auto& viewWorldMatrix = raycaster.camera->matrixWorld;
 
-    _viewWorldMatrix.copy(*raycaster.camera->matrixWorld);
-    this->modelViewMatrix.multiplyMatrices(raycaster.camera->matrixWorldInverse, *this->matrixWorld);
+    // modelViewMatrix is left to the renderer so that concurrent raycasts do not write to the sprite
+    Matrix4 modelViewMatrix;
+    modelViewMatrix.multiplyMatrices(raycaster.camera->matrixWorldInverse, this->matrixWorld);
 
-    _mvPosition.setFromMatrixPosition(this->modelViewMatrix);
+    Vector3 mvPosition;
+    mvPosition.setFromMatrixPosition(modelViewMatrix);
 
     if (raycaster.camera->is<PerspectiveCamera>() && !this->material->sizeAttenuation) {
 
-        _worldScale.multiplyScalar(-_mvPosition.z);
+        worldScale.multiplyScalar(-mvPosition.z);
     }
 
     float rotation = material->rotation;
@@ -118,39 +109,42 @@ void Sprite::raycast(Raycaster& raycaster, std::vector<Intersection>& intersects
         sincos = std::make_pair(std::sin(rotation), std::cos(rotation));
     }
 
-    transformVertex(_vA.set(-0.5f, -0.5f, 0.f), _mvPosition, center, _worldScale, sincos);
-    transformVertex(_vB.set(0.5f, -0.5f, 0.f), _mvPosition, center, _worldScale, sincos);
-    transformVertex(_vC.set(0.5f, 0.5f, 0.f), _mvPosition, center, _worldScale, sincos);
+    Vector3 vA, vB, vC;
+    transformVertex(vA.set(-0.5f, -0.5f, 0.f), mvPosition, center, worldScale, sincos, viewWorldMatrix);
+    transformVertex(vB.set(0.5f, -0.5f, 0.f), mvPosition, center, worldScale, sincos, viewWorldMatrix);
+    transformVertex(vC.set(0.5f, 0.5f, 0.f), mvPosition, center, worldScale, sincos, viewWorldMatrix);
 
-    _uvA.set(0, 0);
-    _uvB.set(1, 0);
-    _uvC.set(1, 1);
+    Vector2 uvA, uvB, uvC;
+    uvA.set(0, 0);
+    uvB.set(1, 0);
+    uvC.set(1, 1);
 
     // check first triangle
-    auto intersect = raycaster.ray.intersectTriangle(_vA, _vB, _vC, false, _intersectPoint);
+    Vector3 intersectPoint;
+    auto intersect = raycaster.ray.intersectTriangle(vA, vB, vC, false, intersectPoint);
 
     if (!intersect) {
 
         // check second triangle
-        transformVertex(_vB.set(-0.5f, 0.5f, 0.f), _mvPosition, center, _worldScale, sincos);
-        _uvB.set(0, 1);
+        transformVertex(vB.set(-0.5f, 0.5f, 0.f), mvPosition, center, worldScale, sincos, viewWorldMatrix);
+        uvB.set(0, 1);
 
-        intersect = raycaster.ray.intersectTriangle(_vA, _vC, _vB, false, _intersectPoint);
+        intersect = raycaster.ray.intersectTriangle(vA, vC, vB, false, intersectPoint);
         if (!intersect) {
 
             return;
         }
     }
 
-    auto distance = raycaster.ray.origin.distanceTo(_intersectPoint);
+    auto distance = raycaster.ray.origin.distanceTo(intersectPoint);
 
     if (distance < raycaster.near || distance > raycaster.far) return;
 
     Intersection intersection{};
     intersection.distance = distance;
     intersection.object = this;
-    intersection.point = _intersectPoint;
+    intersection.point = intersectPoint;
     intersection.uv = Vector2();
-    Triangle::getUV(_intersectPoint, _vA, _vB, _vC, _uvA, _uvB, _uvC, *intersection.uv);
+    Triangle::getUV(intersectPoint, vA, vB, vC, uvA, uvB, uvC, *intersection.uv);
     intersects.emplace_back(intersection);
 }
@@ -0,0 +1,214 @@
+
+#include "threepp/renderers/GLReadback.hpp"
+
+#include "threepp/renderers/GLRenderer.hpp"
+
+#include <glad/glad.h>
+
+#include <cstring>
+#include <queue>
+#include <stdexcept>
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    struct PixelBuffer {
+
+        unsigned int buffer{};
+        GLsync fence{};
+        size_t capacity{};
+
+        unsigned int width{};
+        unsigned int height{};
+    };
+
+}// namespace
+
+struct GLReadback::Impl {
+
+    GLReadback& scope;
+    GLRenderer& renderer;
+
+    std::vector<PixelBuffer> ring;
+    size_t head = 0;
+    size_t inFlight = 0;
+
+    std::queue<Image> frames;
+
+    Impl(GLReadback& scope, GLRenderer& renderer, unsigned int ringSize)
+        : scope(scope), renderer(renderer), ring(std::max(ringSize, 1u)) {
+
+        for (auto& pbo : ring) {
+
+            glGenBuffers(1, &pbo.buffer);
+        }
+    }
+
+    PixelBuffer& oldest() {
+
+        return ring[(head + ring.size() - inFlight) % ring.size()];
+    }
+
+    void read(const std::shared_ptr<GLRenderTarget>& renderTarget) {
+
+        poll();
+
+        if (inFlight == ring.size()) {
+
+            deliver(oldest(), true);
+        }
+
+        unsigned int width, height;
+        if (renderTarget) {
+
+            width = renderTarget->width;
+            height = renderTarget->height;
+
+        } else {
+
+            Vector2 size;
+            renderer.getDrawingBufferSize(size);
+            width = static_cast<unsigned int>(size.x);
+            height = static_cast<unsigned int>(size.y);
+        }
+
+        auto& pbo = ring[head];
+        const size_t byteLength = static_cast<size_t>(width) * height * 4;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo.buffer);
+        if (byteLength > pbo.capacity) {
+
+            glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(byteLength), nullptr, GL_STREAM_READ);
+            pbo.capacity = byteLength;
+        }
+
+        // with a pack buffer bound the pixels land in the buffer, nothing is copied to the client yet
+        const bool issued = renderer.readRenderTargetPixels(renderTarget, 0, 0, static_cast<int>(width), static_cast<int>(height), nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (!issued) return;
+
+        pbo.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        pbo.width = width;
+        pbo.height = height;
+
+        head = (head + 1) % ring.size();
+        ++inFlight;
+    }
+
+    size_t poll() {
+
+        size_t delivered = 0;
+        while (inFlight > 0 && deliver(oldest(), false)) {
+
+            ++delivered;
+        }
+
+        return delivered;
+    }
+
+    void flush() {
+
+        while (inFlight > 0) {
+
+            deliver(oldest(), true);
+        }
+    }
+
+    bool deliver(PixelBuffer& pbo, bool block) {
+
+        const GLuint64 timeout = block ? 1000000000 : 0;
+
+        GLenum status;
+        do {
+
+            status = glClientWaitSync(pbo.fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        } while (block && status == GL_TIMEOUT_EXPIRED);
+
+        if (status == GL_TIMEOUT_EXPIRED) return false;
+
+        glDeleteSync(pbo.fence);
+        pbo.fence = nullptr;
+        --inFlight;
+
+        if (status == GL_WAIT_FAILED) {
+
+            throw std::runtime_error("[GLReadback] Waiting for pixel transfer failed");
+        }
+
+        const size_t byteLength = static_cast<size_t>(pbo.width) * pbo.height * 4;
+        std::shared_ptr<unsigned char> data(new unsigned char[byteLength], std::default_delete<unsigned char[]>());
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pbo.buffer);
+        const auto mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(byteLength), GL_MAP_READ_BIT);
+        if (mapped) {
+
+            std::memcpy(data.get(), mapped, byteLength);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        if (!mapped) {
+
+            throw std::runtime_error("[GLReadback] Unable to map pixel buffer");
+        }
+
+        // GL returns the bottom row first, which is what Image::flipped() describes
+        Image image(data, pbo.width, pbo.height, true);
+        if (scope.onFrame) {
+
+            scope.onFrame(image);
+        } else {
+
+            frames.push(std::move(image));
+        }
+
+        return true;
+    }
+
+    ~Impl() {
+
+        for (auto& pbo : ring) {
+
+            if (pbo.fence) glDeleteSync(pbo.fence);
+            glDeleteBuffers(1, &pbo.buffer);
+        }
+    }
+};
+
+GLReadback::GLReadback(GLRenderer& renderer, unsigned int ringSize)
+    : pimpl_(std::make_unique<Impl>(*this, renderer, ringSize)) {}
+
+void GLReadback::read(const std::shared_ptr<GLRenderTarget>& renderTarget) {
+
+    pimpl_->read(renderTarget);
+}
+
+size_t GLReadback::poll() {
+
+    return pimpl_->poll();
+}
+
+void GLReadback::flush() {
+
+    pimpl_->flush();
+}
+
+std::optional<Image> GLReadback::nextFrame() {
+
+    if (pimpl_->frames.empty()) return std::nullopt;
+
+    auto image = std::move(pimpl_->frames.front());
+    pimpl_->frames.pop();
+
+    return image;
+}
+
+size_t GLReadback::pending() const {
+
+    return pimpl_->inFlight;
+}
+
+GLReadback::~GLReadback() = default;
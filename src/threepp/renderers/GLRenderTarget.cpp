@@ -14,7 +14,8 @@ std::shared_ptr<GLRenderTarget> GLRenderTarget::create(unsigned int width, unsig
 }
 
 GLRenderTarget::GLRenderTarget(unsigned int width, unsigned int height, const GLRenderTarget::Options& options)
-    : width(width), height(height),
+    : uuid(math::generateUUID()),
+      width(width), height(height),
       scissor(0.f, 0.f, (float) width, (float) height),
       viewport(0.f, 0.f, (float) width, (float) height),
       depthBuffer(options.depthBuffer), stencilBuffer(options.stencilBuffer), depthTexture(options.depthTexture),
@@ -2,10 +2,12 @@
 #include "threepp/renderers/GLRenderer.hpp"
 
 #include "threepp/renderers/gl/GLAttributes.hpp"
+#include "threepp/renderers/gl/GLAutoInstancing.hpp"
 #include "threepp/renderers/gl/GLBackground.hpp"
 #include "threepp/renderers/gl/GLBindingStates.hpp"
 #include "threepp/renderers/gl/GLBufferRenderer.hpp"
 #include "threepp/renderers/gl/GLGeometries.hpp"
+#include "threepp/renderers/gl/GLInstanceCulling.hpp"
 #include "threepp/renderers/gl/GLMaterials.hpp"
 #include "threepp/renderers/gl/GLObjects.hpp"
 #include "threepp/renderers/gl/GLPrograms.hpp"
@@ -14,6 +16,7 @@
 #include "threepp/renderers/gl/GLTextures.hpp"
 
 #include "threepp/core/InstancedBufferGeometry.hpp"
+#include "threepp/core/TransformSystem.hpp"
 
 #include "threepp/cameras/OrthographicCamera.hpp"
 
@@ -34,7 +37,9 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
 #include <cmath>
+#include <iostream>
 
 
 using namespace threepp;
@@ -115,6 +120,7 @@ struct GLRenderer::Impl {
     Matrix4 _projScreenMatrix;
 
     Vector3 _vector3;
+    Vector3 _cameraPosition;
 
     gl::GLInfo _info;
 
@@ -129,6 +135,8 @@ struct GLRenderer::Impl {
     gl::GLRenderStates renderStates;
     gl::GLRenderLists renderLists;
     gl::GLObjects objects;
+    gl::GLAutoInstancing autoInstancing;
+    gl::GLInstanceCulling instanceCulling;
     gl::GLPrograms programCache;
 
     std::unique_ptr<gl::GLBufferRenderer> bufferRenderer;
@@ -150,9 +158,9 @@ struct GLRenderer::Impl {
           textures(state, properties, _info),
           objects(geometries, attributes, _info),
           renderLists(properties),
-          shadowMap(objects),
+          shadowMap(objects, properties),
           materials(properties),
-          programCache(bindingStates, clipping),
+          programCache(bindingStates, clipping, _info),
           onMaterialDispose(std::make_shared<OnMaterialDispose>(this)),
           _currentDrawBuffers(GL_BACK) {}
 
@@ -160,12 +168,12 @@ struct GLRenderer::Impl {
 
         releaseMaterialProgramReferences(material);
 
-        properties.materialProperties.remove(material->uuid());
+        properties.materialProperties.remove(material->slot);
     }
 
     void releaseMaterialProgramReferences(Material* material) {
 
-        auto& programs = properties.materialProperties.get(material->uuid())->programs;
+        auto& programs = properties.materialProperties.get(material->slot)->programs;
 
         if (!programs.empty()) {
 
@@ -180,7 +188,21 @@ struct GLRenderer::Impl {
 
         // update scene graph
 
-        if (scene->autoUpdate) scene->updateMatrixWorld();
+        if (scene->autoUpdate) {
+
+            if (scene->transforms) {
+
+                scene->transforms->update();
+
+            } else if (scene->incrementalUpdate) {
+
+                scene->updateMatrixWorldIncremental();
+
+            } else {
+
+                scene->updateMatrixWorld();
+            }
+        }
 
         // update camera matrices and frustum
 
@@ -206,6 +228,7 @@ struct GLRenderer::Impl {
         renderListStack.emplace_back(currentRenderList);
 
         projectObject(scene, camera, 0, scope.sortObjects);
+        instanceCulling.evict(_info.render.frame);
 
         currentRenderList->finish();
 
@@ -240,7 +263,22 @@ struct GLRenderer::Impl {
         auto& opaqueObjects = currentRenderList->opaque;
         auto& transparentObjects = currentRenderList->transparent;
         //
-        if (!opaqueObjects.empty()) renderObjects(opaqueObjects, scene, camera);
+        if (!opaqueObjects.empty()) {
+
+            if (scope.autoInstancing) {
+
+                const auto depth = renderListStack.size() - 1;
+                const auto& batched = autoInstancing.batch(opaqueObjects, scope.autoInstancingThreshold, depth, _info.render.frame);
+
+                for (auto mesh : autoInstancing.meshes(depth)) objects.update(mesh);
+
+                renderObjects(batched, scene, camera);
+
+            } else {
+
+                renderObjects(opaqueObjects, scene, camera);
+            }
+        }
         if (!transparentObjects.empty()) renderObjects(transparentObjects, scene, camera);
 
         //
@@ -303,7 +341,7 @@ struct GLRenderer::Impl {
         }
 
         bool isMesh = object->is<Mesh>();
-        const auto frontFaceCW = (isMesh && object->matrixWorld->determinant() < 0);
+        const auto frontFaceCW = (isMesh && object->matrixWorld.determinant() < 0);
 
         auto program = setProgram(camera, scene, material, object);
 
@@ -312,7 +350,7 @@ struct GLRenderer::Impl {
         //
 
         auto index = geometry->getIndex();
-        const auto& position = geometry->getAttribute<float>("position");
+        const auto position = geometry->getAttribute("position");
 
         //
 
@@ -414,7 +452,7 @@ struct GLRenderer::Impl {
 
         if (auto im = object->as<InstancedMesh>()) {
 
-            renderer->renderInstances(drawStart, drawCount, im->count);
+            renderer->renderInstances(drawStart, drawCount, std::clamp(im->count, 0, im->capacity()));
 
         } else if (auto g = dynamic_cast<InstancedBufferGeometry*>(geometry)) {
 
@@ -458,7 +496,7 @@ struct GLRenderer::Impl {
 
                     if (sortObjects) {
 
-                        _vector3.setFromMatrixPosition(*sprite->matrixWorld)
+                        _vector3.setFromMatrixPosition(sprite->matrixWorld)
                                 .applyMatrix4(_projScreenMatrix);
                     }
 
@@ -473,34 +511,31 @@ struct GLRenderer::Impl {
 
             } else if (object->is<Mesh>() || object->is<Line>() || object->is<Points>()) {
 
-                if (!object->frustumCulled || _frustum.intersectsObject(*object)) {
+                auto instancedMesh = object->as<InstancedMesh>();
+
+                // the bounds of the geometry say nothing about where the instances are, they are tested one by one
+                const bool perInstanceFrustumCulled = instancedMesh && instancedMesh->perInstanceFrustumCulled;
+
+                if (!object->frustumCulled || perInstanceFrustumCulled || _frustum.intersectsObject(*object)) {
 
                     if (sortObjects) {
 
-                        _vector3.setFromMatrixPosition(*object->matrixWorld)
+                        _vector3.setFromMatrixPosition(object->matrixWorld)
                                 .applyMatrix4(_projScreenMatrix);
                     }
 
-                    auto geometry = objects.update(object);
-                    const auto& materials = object->materials();
-
-                    if (materials.size() > 1) {
-
-                        const auto& groups = geometry->groups;
+                    if (instancedMesh && (instancedMesh->perInstanceFrustumCulled || !instancedMesh->levels().empty())) {
 
-                        for (const auto& group : groups) {
+                        _cameraPosition.setFromMatrixPosition(camera->matrixWorld);
 
-                            Material* groupMaterial = materials.at(group.materialIndex);
+                        for (auto proxy : instanceCulling.cull(*instancedMesh, _frustum, _cameraPosition, camera->zoom, renderListStack.size() - 1, _info.render.frame)) {
 
-                            if (groupMaterial && groupMaterial->visible) {
-
-                                currentRenderList->push(object, geometry, groupMaterial, groupOrder, _vector3.z, group);
-                            }
+                            pushObject(proxy, groupOrder);
                         }
 
-                    } else if (materials.front()->visible) {
+                    } else {
 
-                        currentRenderList->push(object, geometry, materials.front(), groupOrder, _vector3.z, std::nullopt);
+                        pushObject(object, groupOrder);
                     }
                 }
             }
@@ -512,6 +547,31 @@ struct GLRenderer::Impl {
         }
     }
 
+    void pushObject(Object3D* object, unsigned int groupOrder) {
+
+        auto geometry = objects.update(object);
+        const auto& materials = object->materials();
+
+        if (materials.size() > 1) {
+
+            const auto& groups = geometry->groups;
+
+            for (const auto& group : groups) {
+
+                Material* groupMaterial = materials.at(group.materialIndex);
+
+                if (groupMaterial && groupMaterial->visible) {
+
+                    currentRenderList->push(object, geometry, groupMaterial, groupOrder, _vector3.z, group);
+                }
+            }
+
+        } else if (materials.front()->visible) {
+
+            currentRenderList->push(object, geometry, materials.front(), groupOrder, _vector3.z, std::nullopt);
+        }
+    }
+
     void renderObjects(const std::vector<gl::RenderItem*>& renderList, Scene* scene, Camera* camera) {
 
         auto& overrideMaterial = scene->overrideMaterial;
@@ -534,7 +594,7 @@ struct GLRenderer::Impl {
             object->onBeforeRender.value()(&scope, scene, camera, geometry, material, group);
         }
 
-        object->modelViewMatrix.multiplyMatrices(camera->matrixWorldInverse, *object->matrixWorld);
+        object->modelViewMatrix.multiplyMatrices(camera->matrixWorldInverse, object->matrixWorld);
         object->normalMatrix.getNormalMatrix(object->modelViewMatrix);
 
         renderBufferDirect(camera, scene, geometry, material, object, group);
@@ -551,7 +611,7 @@ struct GLRenderer::Impl {
         //
         //    if (!isScene) scene = &_emptyScene;// scene could be a Mesh, Line, Points, ...
 
-        auto materialProperties = properties.materialProperties.get(material->uuid());
+        auto materialProperties = properties.materialProperties.get(material->slot);
 
         auto& lights = currentRenderState->getLights();
         auto& shadowsArray = currentRenderState->getShadowsArray();
@@ -650,7 +710,7 @@ struct GLRenderer::Impl {
 
     void updateCommonMaterialProperties(Material* material, gl::ProgramParameters& parameters) {
 
-        auto materialProperties = properties.materialProperties.get(material->uuid());
+        auto materialProperties = properties.materialProperties.get(material->slot);
 
         materialProperties->outputEncoding = parameters.outputEncoding;
         materialProperties->instancing = parameters.instancing;
@@ -684,9 +744,9 @@ struct GLRenderer::Impl {
         bool vertexAlphas = material->vertexColors &&
                             object->geometry() &&
                             object->geometry()->hasAttribute("color") &&
-                            object->geometry()->getAttribute<float>("color")->itemSize() == 4;
+                            object->geometry()->getAttribute("color")->itemSize() == 4;
 
-        auto materialProperties = properties.materialProperties.get(material->uuid());
+        auto materialProperties = properties.materialProperties.get(material->slot);
         auto& lights = currentRenderState->getLights();
 
         if (_clippingEnabled) {
@@ -813,7 +873,7 @@ struct GLRenderer::Impl {
                 if (p_uniforms->map.count("cameraPosition")) {
 
                     auto& uCamPos = p_uniforms->map["cameraPosition"];
-                    _vector3.setFromMatrixPosition(*camera->matrixWorld);
+                    _vector3.setFromMatrixPosition(camera->matrixWorld);
                     uCamPos->setValue(_vector3);
                 }
             }
@@ -895,7 +955,7 @@ struct GLRenderer::Impl {
 
         p_uniforms->setValue("modelViewMatrix", object->modelViewMatrix);
         p_uniforms->setValue("normalMatrix", object->normalMatrix);
-        p_uniforms->setValue("modelMatrix", *object->matrixWorld);
+        p_uniforms->setValue("modelMatrix", object->matrixWorld);
 
         return program;
     }
@@ -937,7 +997,7 @@ struct GLRenderer::Impl {
         _currentActiveCubeFace = activeCubeFace;
         _currentActiveMipmapLevel = activeMipmapLevel;
 
-        if (renderTarget && !properties.renderTargetProperties.get(renderTarget->uuid)->glFramebuffer) {
+        if (renderTarget && !properties.renderTargetProperties.get(renderTarget->slot)->glFramebuffer) {
 
             textures.setupRenderTarget(renderTarget);
         }
@@ -948,7 +1008,7 @@ struct GLRenderer::Impl {
 
             const auto& texture = renderTarget->texture;
 
-            framebuffer = *properties.renderTargetProperties.get(renderTarget->uuid)->glFramebuffer;
+            framebuffer = *properties.renderTargetProperties.get(renderTarget->slot)->glFramebuffer;
 
             _currentViewport.copy(renderTarget->viewport);
             _currentScissor.copy(renderTarget->scissor);
@@ -999,6 +1059,46 @@ struct GLRenderer::Impl {
         state.setScissorTest(_currentScissorTest.value_or(false));
     }
 
+    bool readRenderTargetPixels(const std::shared_ptr<GLRenderTarget>& renderTarget, int x, int y, int width, int height, unsigned char* buffer) {
+
+        unsigned int framebuffer = 0;
+
+        if (renderTarget) {
+
+            const auto glFramebuffer = properties.renderTargetProperties.get(renderTarget->slot)->glFramebuffer;
+            if (!glFramebuffer) return false;
+
+            const auto& texture = renderTarget->texture;
+            if (texture->format != RGBAFormat || texture->type != UnsignedByteType) {
+
+                std::cerr << "GLRenderer.readRenderTargetPixels: renderTarget is not in RGBA or UnsignedByteType format." << std::endl;
+                return false;
+            }
+
+            if (x < 0 || y < 0 || x + width > static_cast<int>(renderTarget->width) || y + height > static_cast<int>(renderTarget->height)) {
+
+                std::cerr << "GLRenderer.readRenderTargetPixels: requested region is outside of renderTarget." << std::endl;
+                return false;
+            }
+
+            framebuffer = *glFramebuffer;
+        }
+
+        unsigned int currentFramebuffer = 0;
+        if (_currentRenderTarget) {
+
+            currentFramebuffer = properties.renderTargetProperties.get(_currentRenderTarget->slot)->glFramebuffer.value_or(0);
+        }
+
+        state.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+        glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, buffer);
+
+        state.bindFramebuffer(GL_FRAMEBUFFER, currentFramebuffer);
+
+        return true;
+    }
+
     void setViewport(int x, int y, int width, int height) {
 
         _viewport.set(static_cast<float>(x), static_cast<float>(y), static_cast<float>(width), static_cast<float>(height));
@@ -1024,6 +1124,8 @@ struct GLRenderer::Impl {
         properties.dispose();
         //    cubemaps.dispose();
         objects.dispose();
+        autoInstancing.dispose();
+        instanceCulling.dispose();
         bindingStates.dispose();
     }
 
@@ -1249,6 +1351,11 @@ void GLRenderer::setRenderTarget(const std::shared_ptr<GLRenderTarget>& renderTa
     pimpl_->setRenderTarget(renderTarget, activeCubeFace, activeMipmapLevel);
 }
 
+bool GLRenderer::readRenderTargetPixels(const std::shared_ptr<GLRenderTarget>& renderTarget, int x, int y, int width, int height, unsigned char* buffer) {
+
+    return pimpl_->readRenderTargetPixels(renderTarget, x, y, width, height, buffer);
+}
+
 void GLRenderer::enableTextRendering() {
 
     pimpl_->enableTextRendering();
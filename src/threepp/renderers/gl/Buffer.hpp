@@ -9,6 +9,8 @@ namespace threepp::gl {
         int type{};
         int bytesPerElement{};
         unsigned int version{};
+        // unique for every created buffer, unlike GL names which may be reused
+        unsigned int id{};
     };
 
 }// namespace threepp::gl
@@ -4,9 +4,56 @@
 
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
 using namespace threepp;
 using namespace threepp::gl;
 
+namespace {
+
+    GLenum toGLType(ComponentType type) {
+
+        switch (type) {
+            case ComponentType::Float:
+                return GL_FLOAT;
+            case ComponentType::HalfFloat:
+                return GL_HALF_FLOAT;
+            case ComponentType::Byte:
+                return GL_BYTE;
+            case ComponentType::UnsignedByte:
+                return GL_UNSIGNED_BYTE;
+            case ComponentType::Short:
+                return GL_SHORT;
+            case ComponentType::UnsignedShort:
+                return GL_UNSIGNED_SHORT;
+            case ComponentType::Int:
+                return GL_INT;
+            case ComponentType::UnsignedInt:
+                return GL_UNSIGNED_INT;
+        }
+
+        throw std::runtime_error("Unsupported attribute component type");
+    }
+
+    // 32-bit indices are stored as 16-bit on the GPU while every index fits
+    bool narrowIndices(BufferAttribute* attribute, GLenum bufferType) {
+
+        return bufferType == GL_ELEMENT_ARRAY_BUFFER && attribute->componentType() == ComponentType::UnsignedInt;
+    }
+
+    bool fitsUnsignedShort(const unsigned int* data, size_t begin, size_t end) {
+
+        unsigned int max = 0;
+        for (auto i = begin; i < end; i++) max = std::max(max, data[i]);
+
+        return max <= std::numeric_limits<uint16_t>::max();
+    }
+
+}// namespace
+
 Buffer GLAttributes::createBuffer(BufferAttribute* attribute, GLenum bufferType) {
 
     const auto usage = attribute->getUsage();
@@ -15,75 +62,113 @@ Buffer GLAttributes::createBuffer(BufferAttribute* attribute, GLenum bufferType)
     glGenBuffers(1, &buffer);
     glBindBuffer(bufferType, buffer);
 
-    GLint type;
-    GLsizei bytesPerElement;
-    if (attribute->typed<unsigned int>()) {
-        type = GL_UNSIGNED_INT;
-        bytesPerElement = sizeof(unsigned int);
-        auto attr = attribute->typed<unsigned int>();
-        const auto& array = attr->array();
-        glBufferData(bufferType, (GLsizei) (array.size() * bytesPerElement), array.data(), usage);
-
-    } else if (attribute->typed<float>()) {
-        type = GL_FLOAT;
-        bytesPerElement = sizeof(float);
-        auto attr = attribute->typed<float>();
-        const auto& array = attr->array();
-        glBufferData(bufferType, (GLsizei) (array.size() * bytesPerElement), array.data(), usage);
-    } else {
+    GLenum type = toGLType(attribute->componentType());
+    GLsizei bytesPerElement = attribute->bytesPerComponent();
+
+    const void* data = attribute->rawData();
+    auto byteLength = attribute->byteLength();
+
+    if (narrowIndices(attribute, bufferType)) {
+
+        const auto indices = static_cast<const unsigned int*>(data);
+        const auto size = byteLength / sizeof(unsigned int);
 
-        throw std::runtime_error("TODO");
+        if (fitsUnsignedShort(indices, 0, size)) {
+
+            narrowed_.assign(indices, indices + size);
+
+            type = GL_UNSIGNED_SHORT;
+            bytesPerElement = sizeof(uint16_t);
+            data = narrowed_.data();
+            byteLength = size * sizeof(uint16_t);
+        }
     }
 
-    return {buffer, type, bytesPerElement, attribute->version + 1};
+    glBufferData(bufferType, static_cast<GLsizeiptr>(byteLength), data, usage);
+
+    return {buffer, static_cast<int>(type), bytesPerElement, attribute->version, ++nextId_};
 }
 
-void GLAttributes::updateBuffer(GLuint buffer, BufferAttribute* attribute, GLenum bufferType, int bytesPerElement) {
+void GLAttributes::updateBuffer(Buffer& buffer, BufferAttribute* attribute, GLenum bufferType) {
+
+    const void* data = attribute->rawData();
+    const size_t size = attribute->byteLength() / attribute->bytesPerComponent();
 
+    auto& ranges = attribute->updateRanges;
     auto& updateRange = attribute->updateRange;
 
-    glBindBuffer(bufferType, buffer);
+    if (updateRange.count != -1) {
+
+        ranges.emplace_back(updateRange);
+        updateRange.count = -1;
+    }
 
-    if (updateRange.count == -1) {
+    if (ranges.empty()) {
 
-        if (attribute->typed<unsigned int>()) {
+        ranges.push_back({0, static_cast<int>(size)});
+    }
 
-            auto attr = attribute->typed<unsigned int>();
-            const auto& array = attr->array();
-            glBufferSubData(bufferType, 0, (GLsizei) (array.size() * bytesPerElement), array.data());
+    const bool narrowed = buffer.type == GL_UNSIGNED_SHORT && narrowIndices(attribute, bufferType);
 
-        } else if (attribute->typed<float>()) {
+    if (narrowed) {
 
-            auto attr = attribute->typed<float>();
-            const auto& array = attr->array();
-            glBufferSubData(bufferType, 0, (GLsizei) (array.size() * bytesPerElement), array.data());
-        } else {
+        const auto indices = static_cast<const unsigned int*>(data);
+
+        for (const auto& range : ranges) {
+
+            const auto begin = std::min(static_cast<size_t>(range.offset), size);
+            const auto end = std::min(begin + static_cast<size_t>(range.count), size);
+
+            if (!fitsUnsignedShort(indices, begin, end)) {
+
+                // widen in place, keeping the buffer name so vertex array bindings stay valid
+                glBindBuffer(bufferType, buffer.buffer);
+                glBufferData(bufferType, static_cast<GLsizeiptr>(attribute->byteLength()), data, attribute->getUsage());
+
+                buffer.type = GL_UNSIGNED_INT;
+                buffer.bytesPerElement = sizeof(unsigned int);
 
-            throw std::runtime_error("TODO");
+                ranges.clear();
+                return;
+            }
         }
+    }
 
-    } else {
+    const auto bytesPerElement = buffer.bytesPerElement;
+    const auto streamed = attribute->getUsage() != StaticDrawUsage;
+    if (streamed && !stream_) stream_ = std::make_unique<GLStreamBuffer>();
 
-        if (attribute->typed<unsigned int>()) {
+    if (!streamed) glBindBuffer(bufferType, buffer.buffer);
 
-            auto attr = attribute->typed<unsigned int>();
-            const auto& array = attr->array();
-            std::vector<unsigned int> sub(array.begin() + updateRange.offset, array.begin() + updateRange.offset + updateRange.count);
-            glBufferSubData(bufferType, updateRange.offset * bytesPerElement, (GLsizei) (sub.size() * bytesPerElement), sub.data());
+    for (const auto& range : ranges) {
 
-        } else if (attribute->typed<float>()) {
+        const auto begin = std::min(static_cast<size_t>(range.offset), size);
+        const auto end = std::min(begin + static_cast<size_t>(range.count), size);
+        if (end <= begin) continue;
 
-            auto attr = attribute->typed<float>();
-            const auto& array = attr->array();
-            std::vector<float> sub(array.begin() + updateRange.offset, array.begin() + updateRange.offset + updateRange.count);
-            glBufferSubData(bufferType, updateRange.offset * bytesPerElement, (GLsizei) (sub.size() * bytesPerElement), sub.data());
-        } else {
+        const auto offset = begin * bytesPerElement;
+        const auto bytes = (end - begin) * bytesPerElement;
+        auto src = static_cast<const unsigned char*>(data) + offset;
 
-            throw std::runtime_error("TODO");
+        if (narrowed) {
+
+            // only the indices of the range, both uploads copy them before the next range
+            const auto indices = static_cast<const unsigned int*>(data);
+            narrowed_.assign(indices + begin, indices + end);
+            src = reinterpret_cast<const unsigned char*>(narrowed_.data());
         }
 
-        updateRange.count = -1;
+        if (streamed) {
+
+            stream_->upload(buffer.buffer, offset, src, bytes);
+
+        } else {
+
+            glBufferSubData(bufferType, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes), src);
+        }
     }
+
+    ranges.clear();
 }
 
 Buffer GLAttributes::get(BufferAttribute* attribute) {
@@ -126,8 +211,8 @@ void GLAttributes::update(BufferAttribute* attribute, GLenum bufferType) {
         auto& data = buffers_.at(attribute);
 
         if (data.version < attribute->version) {
-            updateBuffer(data.buffer, attribute, bufferType, data.bytesPerElement);
-            ++data.version;
+            updateBuffer(data, attribute, bufferType);
+            data.version = attribute->version;
         }
     }
 }
@@ -6,8 +6,12 @@
 #include "threepp/core/BufferAttribute.hpp"
 
 #include "threepp/renderers/gl/Buffer.hpp"
+#include "threepp/renderers/gl/GLStreamBuffer.hpp"
 
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace threepp::gl {
 
@@ -15,7 +19,7 @@ namespace threepp::gl {
 
         Buffer createBuffer(BufferAttribute* attribute, unsigned int bufferType);
 
-        void updateBuffer(unsigned int buffer, BufferAttribute* attribute, unsigned int bufferType, int bytesPerElement);
+        void updateBuffer(Buffer& buffer, BufferAttribute* attribute, unsigned int bufferType);
 
         Buffer get(BufferAttribute* attribute);
 
@@ -25,6 +29,13 @@ namespace threepp::gl {
 
     private:
         std::unordered_map<BufferAttribute*, Buffer> buffers_;
+        unsigned int nextId_{0};
+
+        // scratch storage for index buffers uploaded as 16-bit
+        std::vector<uint16_t> narrowed_;
+
+        // staging ring for DynamicDrawUsage and StreamDrawUsage attributes, created on first use
+        std::unique_ptr<GLStreamBuffer> stream_;
     };
 
 }// namespace threepp::gl
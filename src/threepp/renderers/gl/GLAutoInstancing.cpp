@@ -0,0 +1,221 @@
+
+#include "threepp/renderers/gl/GLAutoInstancing.hpp"
+
+#include "threepp/core/InstancedBufferGeometry.hpp"
+#include "threepp/materials/RawShaderMaterial.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <typeinfo>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // frames a batch may go unused before its instance buffers are released
+    constexpr size_t proxyLifetime = 120;
+
+    // plain meshes whose draw does not depend on per-object state other than the world matrix
+    bool batchable(const RenderItem& item) {
+
+        const auto object = item.object;
+
+        if (typeid(*object) != typeid(Mesh)) return false;
+        if (object->onBeforeRender || object->onAfterRender) return false;
+
+        // custom shaders may not handle the instance matrix
+        if (item.material->is<ShaderMaterial>()) return false;
+
+        if (dynamic_cast<InstancedBufferGeometry*>(item.geometry)) return false;
+
+        // mirrored objects need the opposite front face, which is set per draw
+        return object->matrixWorld.determinant() > 0;
+    }
+
+}// namespace
+
+size_t GLAutoInstancing::KeyHash::operator()(const Key& key) const {
+
+    auto hash = std::hash<const void*>()(key.geometry);
+    hash ^= std::hash<const void*>()(key.material) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.groupStart) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.groupCount) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<int>()(key.castShadow | key.receiveShadow << 1) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+    return hash;
+}
+
+const std::vector<RenderItem*>& GLAutoInstancing::batch(const std::vector<RenderItem*>& items, unsigned int minInstances, size_t depth, size_t frame) {
+
+    minInstances = std::max(minInstances, 2u);
+
+    if (layers_.size() <= depth) layers_.resize(depth + 1);
+    auto& layer = layers_[depth];
+
+    layer.result.clear();
+    layer.result.reserve(items.size());
+    layer.meshes.clear();
+
+    // a batch holds at least two items, so pointers into batchItems stay valid
+    layer.batchItems.clear();
+    layer.batchItems.reserve(items.size() / 2 + 1);
+
+    size_t runStart = 0;
+    for (size_t i = 0; i < items.size(); i++) {
+
+        const auto item = items[i];
+
+        if (item->groupOrder != items[runStart]->groupOrder || item->renderOrder != items[runStart]->renderOrder) {
+
+            flush(layer, minInstances, frame);
+            runStart = i;
+        }
+
+        if (slots_.size() == slotCount_) slots_.emplace_back();
+
+        if (!batchable(*item)) {
+
+            auto& slot = slots_[slotCount_++];
+            slot.item = item;
+            slot.members.clear();
+            continue;
+        }
+
+        const Key key{item->geometry, item->material,
+                      item->group ? item->group->start : -1,
+                      item->group ? item->group->count : -1,
+                      item->object->castShadow, item->object->receiveShadow};
+
+        const auto [it, inserted] = runSlots_.try_emplace(key, slotCount_);
+        if (inserted) {
+
+            auto& slot = slots_[slotCount_++];
+            slot.item = nullptr;
+            slot.key = key;
+            slot.members.clear();
+        }
+
+        slots_[it->second].members.emplace_back(item);
+    }
+
+    flush(layer, minInstances, frame);
+    evict(frame);
+
+    return layer.result;
+}
+
+const std::vector<InstancedMesh*>& GLAutoInstancing::meshes(size_t depth) const {
+
+    static const std::vector<InstancedMesh*> none;
+
+    return depth < layers_.size() ? layers_[depth].meshes : none;
+}
+
+void GLAutoInstancing::flush(Layer& layer, unsigned int minInstances, size_t frame) {
+
+    for (size_t i = 0; i < slotCount_; i++) {
+
+        const auto& slot = slots_[i];
+
+        if (slot.item) {
+
+            layer.result.emplace_back(slot.item);
+
+        } else if (slot.members.size() >= minInstances) {
+
+            layer.result.emplace_back(emitBatch(layer, slot.key, slot.members, frame));
+
+        } else {
+
+            layer.result.insert(layer.result.end(), slot.members.begin(), slot.members.end());
+        }
+    }
+
+    slotCount_ = 0;
+    runSlots_.clear();
+}
+
+RenderItem* GLAutoInstancing::emitBatch(Layer& layer, const Key& key, const std::vector<RenderItem*>& members, size_t frame) {
+
+    const auto count = static_cast<int>(members.size());
+
+    // the render list keeps geometry and material alive while the batch is drawn
+    const std::shared_ptr<BufferGeometry> geometry(std::shared_ptr<BufferGeometry>(), key.geometry);
+    const std::shared_ptr<Material> material(std::shared_ptr<Material>(), key.material);
+
+    auto& proxy = layer.proxies[key];
+
+    if (!proxy.mesh || proxy.mesh->capacity() < count) {
+
+        const auto capacity = proxy.mesh ? std::max(count, proxy.mesh->capacity() * 2) : count;
+        if (proxy.mesh) proxy.mesh->dispose();
+
+        proxy.mesh = InstancedMesh::create(geometry, material, capacity);
+        proxy.mesh->instanceMatrix->setUsage(DynamicDrawUsage);
+
+    } else {
+
+        proxy.mesh->setGeometry(geometry);
+        proxy.mesh->setMaterial(material);
+    }
+
+    proxy.frame = frame;
+
+    auto& mesh = *proxy.mesh;
+    mesh.count = count;
+    mesh.castShadow = key.castShadow;
+    mesh.receiveShadow = key.receiveShadow;
+
+    auto& matrices = mesh.instanceMatrix->array();
+    for (int i = 0; i < count; i++) {
+
+        members[i]->object->matrixWorld.toArray(matrices, i * 16);
+    }
+
+    mesh.instanceMatrix->clearUpdateRanges();
+    mesh.instanceMatrix->addUpdateRange(0, count * 16);
+    mesh.instanceMatrix->needsUpdate();
+
+    layer.meshes.emplace_back(&mesh);
+
+    auto& item = layer.batchItems.emplace_back(*members.front());
+    item.object = &mesh;
+
+    return &item;
+}
+
+void GLAutoInstancing::evict(size_t frame) {
+
+    for (auto& layer : layers_) {
+
+        for (auto it = layer.proxies.begin(); it != layer.proxies.end();) {
+
+            if (frame > it->second.frame + proxyLifetime) {
+
+                it->second.mesh->dispose();
+                it = layer.proxies.erase(it);
+
+            } else {
+
+                ++it;
+            }
+        }
+    }
+}
+
+void GLAutoInstancing::dispose() {
+
+    for (auto& layer : layers_) {
+
+        for (auto& [key, proxy] : layer.proxies) {
+
+            proxy.mesh->dispose();
+        }
+    }
+
+    layers_.clear();
+}
+
+GLAutoInstancing::~GLAutoInstancing() = default;
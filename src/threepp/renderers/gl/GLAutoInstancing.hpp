@@ -0,0 +1,108 @@
+
+#ifndef THREEPP_GLAUTOINSTANCING_HPP
+#define THREEPP_GLAUTOINSTANCING_HPP
+
+#include "threepp/renderers/gl/GLRenderLists.hpp"
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace threepp {
+
+    class InstancedMesh;
+
+    namespace gl {
+
+        // Merges opaque draws of plain meshes sharing geometry, material, group and shadow flags into instanced draws.
+        // Each batch is drawn through a pooled InstancedMesh whose instance matrices are rewritten every
+        // frame from the world matrices of the merged objects and streamed as a dynamic attribute.
+        // Batches and proxies are kept per render call depth, so a nested render does not touch those of the outer one.
+        struct GLAutoInstancing {
+
+            GLAutoInstancing() = default;
+
+            GLAutoInstancing(const GLAutoInstancing&) = delete;
+            GLAutoInstancing& operator=(const GLAutoInstancing&) = delete;
+
+            // items with batches of at least minInstances draws replaced by one instanced item each.
+            // Batches only merge draws with the same group and render order and take the place of their first draw.
+            // The result stays valid until the next call with the same depth.
+            const std::vector<RenderItem*>& batch(const std::vector<RenderItem*>& items, unsigned int minInstances, size_t depth, size_t frame);
+
+            // instanced meshes drawn by the result of the last batch() at depth, to be updated before drawing
+            const std::vector<InstancedMesh*>& meshes(size_t depth) const;
+
+            void dispose();
+
+            ~GLAutoInstancing();
+
+        private:
+            struct Key {
+
+                BufferGeometry* geometry;
+                Material* material;
+                int groupStart;
+                int groupCount;
+                bool castShadow;
+                bool receiveShadow;
+
+                bool operator==(const Key& other) const {
+
+                    return geometry == other.geometry && material == other.material &&
+                           groupStart == other.groupStart && groupCount == other.groupCount &&
+                           castShadow == other.castShadow && receiveShadow == other.receiveShadow;
+                }
+            };
+
+            struct KeyHash {
+
+                size_t operator()(const Key& key) const;
+            };
+
+            struct Proxy {
+
+                std::shared_ptr<InstancedMesh> mesh;
+                size_t frame{};
+            };
+
+            // a draw in the output, either a single item or the items of a batch
+            struct Slot {
+
+                RenderItem* item{};
+                Key key{};
+                std::vector<RenderItem*> members;
+            };
+
+            // state of one render call depth
+            struct Layer {
+
+                std::unordered_map<Key, Proxy, KeyHash> proxies;
+
+                std::vector<RenderItem*> result;
+                std::vector<RenderItem> batchItems;
+                std::vector<InstancedMesh*> meshes;
+            };
+
+            // a deque, so that adding a depth leaves the layers in use by outer calls in place
+            std::deque<Layer> layers_;
+
+            // slots of the current run, reused across frames
+            std::vector<Slot> slots_;
+            size_t slotCount_{};
+            std::unordered_map<Key, size_t, KeyHash> runSlots_;
+
+            void flush(Layer& layer, unsigned int minInstances, size_t frame);
+
+            RenderItem* emitBatch(Layer& layer, const Key& key, const std::vector<RenderItem*>& members, size_t frame);
+
+            // proxies unused for a while release their instance buffers
+            void evict(size_t frame);
+        };
+
+    }// namespace gl
+
+}// namespace threepp
+
+#endif//THREEPP_GLAUTOINSTANCING_HPP
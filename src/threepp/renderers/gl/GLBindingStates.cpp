@@ -3,6 +3,7 @@
 
 #include "threepp/renderers/gl/GLBindingStates.hpp"
 
+#include "threepp/renderers/gl/GLProperties.hpp"
 #include "threepp/renderers/gl/GLUtils.hpp"
 
 #include "threepp/core/InterleavedBufferAttribute.hpp"
@@ -13,7 +14,8 @@
 using namespace threepp;
 using namespace threepp::gl;
 
-typedef std::unordered_map<bool, std::shared_ptr<GLBindingState>> StateMap;
+// binding state per wireframe flag
+typedef std::array<std::shared_ptr<GLBindingState>, 2> StateMap;
 typedef std::unordered_map<int, StateMap> ProgramMap;
 
 struct GLBindingStates::Impl {
@@ -24,7 +26,7 @@ struct GLBindingStates::Impl {
     const std::shared_ptr<GLBindingState> defaultState_;
     std::shared_ptr<GLBindingState> currentState_;
 
-    std::unordered_map<unsigned int, ProgramMap> bindingStates;
+    GLTypeProperties<ProgramMap> bindingStates;
 
     explicit Impl(GLAttributes& attributes)
         : maxVertexAttributes_(glGetParameter(GL_MAX_VERTEX_ATTRIBS)),
@@ -43,15 +45,10 @@ struct GLBindingStates::Impl {
             bindVertexArrayObject(*currentState_->object);
         }
 
-        bool updateBuffers = needsUpdate(geometry, index);
+        bool updateBuffers = needsUpdate(object, geometry, index);
 
         if (updateBuffers) {
-            saveCache(geometry, index);
-        }
-
-        if (object->is<InstancedMesh>()) {
-
-            updateBuffers = true;
+            saveCache(object, geometry, index);
         }
 
         if (index) {
@@ -96,16 +93,16 @@ struct GLBindingStates::Impl {
             wireframe = wm->wireframe;
         }
 
-        auto& programMap = bindingStates[geometry->id];
+        auto& programMap = *bindingStates.get(geometry->slot);
 
-        auto& stateMap = programMap[program->id];
+        auto& state = programMap[program->id][wireframe];
 
-        if (!stateMap.count(wireframe)) {
+        if (!state) {
 
-            stateMap[wireframe] = createBindingState(createVertexArrayObject());
+            state = createBindingState(createVertexArrayObject());
         }
 
-        return stateMap.at(wireframe);
+        return state;
     }
 
     [[nodiscard]] std::shared_ptr<GLBindingState> createBindingState(std::optional<GLuint> vao) const {
@@ -117,55 +114,32 @@ struct GLBindingStates::Impl {
                 vao);
     }
 
-    bool needsUpdate(BufferGeometry* geometry, BufferAttribute* index) const {
-
-        const auto& cachedAttributes = currentState_->attributes;
-        const auto& geometryAttributes = geometry->getAttributes();
-
-        int attributesNum = 0;
-
-        for (const auto& [key, value] : geometryAttributes) {
-
-            if (!cachedAttributes.count(key)) return true;
-
-
-            const auto& geometryAttribute = geometryAttributes.at(key);
-
-            if (!cachedAttributes.count(key)) return true;
-
-            const auto& cachedAttribute = cachedAttributes.at(key);
-
-            if (cachedAttribute != geometryAttribute.get()) return true;
+    // a binding state belongs to a single geometry, so an unchanged layout version means the same attributes
+    // are bound. Instanced meshes sharing the geometry may still differ in their instance buffers
+    bool needsUpdate(Object3D* object, BufferGeometry* geometry, BufferAttribute* index) const {
 
-            //          if (cachedAttribute.data != geometryAttribute.data) return true;
-
-            ++attributesNum;
-        }
-
-        if (currentState_->attributesNum != attributesNum) return true;
+        if (currentState_->layoutVersion != geometry->layoutVersion()) return true;
 
         if (currentState_->index != index) return true;
 
-        return false;
+        return currentState_->instanceBuffers != instanceBuffers(object);
     }
 
-    void saveCache(BufferGeometry* geometry, BufferAttribute* index) const {
+    void saveCache(Object3D* object, BufferGeometry* geometry, BufferAttribute* index) const {
 
-        std::unordered_map<std::string, BufferAttribute*> cache;
-        const auto& attributes = geometry->getAttributes();
-        int attributesNum = 0;
+        currentState_->layoutVersion = geometry->layoutVersion();
+        currentState_->index = index;
+        currentState_->instanceBuffers = instanceBuffers(object);
+    }
 
-        for (const auto& [key, attribute] : attributes) {
+    std::pair<unsigned int, unsigned int> instanceBuffers(Object3D* object) const {
 
-            cache[key] = attribute.get();
+        auto instancedMesh = object->as<InstancedMesh>();
+        if (!instancedMesh) return {0, 0};
 
-            ++attributesNum;
-        }
+        const auto instanceColor = instancedMesh->instanceColor.get();
 
-        currentState_->attributes = cache;
-        currentState_->attributesNum = attributesNum;
-
-        currentState_->index = index;
+        return {attributes_.get(instancedMesh->instanceMatrix.get()).id, instanceColor ? attributes_.get(instanceColor).id : 0};
     }
 
     void initAttributes() const {
@@ -349,70 +323,46 @@ struct GLBindingStates::Impl {
 
         reset();
 
-        for (const auto& geometryId : bindingStates) {
-
-            auto& programMap = bindingStates.at(geometryId.first);
-
-            for (const auto& programId : programMap) {
-
-                auto& stateMap = programMap.at(programId.first);
-
-                for (const auto& wireframe : stateMap) {
-
-                    deleteVertexArrayObject(*stateMap.at(wireframe.first)->object);
+        bindingStates.forEach([&](ProgramMap& programMap) {
+            releaseStates(programMap);
+        });
+        bindingStates.dispose();
+    }
 
-                    stateMap.erase(wireframe.first);
-                }
+    void releaseStates(StateMap& stateMap) {
 
-                programMap.erase(programId.first);
-            }
+        for (auto& state : stateMap) {
 
-            bindingStates.erase(geometryId.first);
+            if (state) deleteVertexArrayObject(*state->object);
+            state = nullptr;
         }
     }
 
-    void releaseStatesOfGeometry(BufferGeometry* geometry) {
-
-        if (!bindingStates.count(geometry->id)) return;
-
-        ProgramMap& programMap = bindingStates[geometry->id];
-
-        for (const auto& programId : programMap) {
-
-            StateMap& stateMap = programMap.at(programId.first);
-
-            for (const auto& wireframe : stateMap) {
+    void releaseStates(ProgramMap& programMap) {
 
-                deleteVertexArrayObject(*stateMap.at(wireframe.first)->object);
-            }
+        for (auto& [programId, stateMap] : programMap) {
 
-            stateMap.clear();
+            releaseStates(stateMap);
         }
-
         programMap.clear();
-
-        bindingStates.erase(geometry->id);
     }
 
-    void releaseStatesOfProgram(GLProgram& program) {
-
-        for (const auto& geometryId : bindingStates) {
-
-            auto& programMap = bindingStates[geometryId.first];
+    void releaseStatesOfGeometry(BufferGeometry* geometry) {
 
-            if (!programMap.count(program.id)) continue;
+        releaseStates(*bindingStates.get(geometry->slot));
 
-            auto& stateMap = programMap.at(program.id);
+        bindingStates.remove(geometry->slot);
+    }
 
-            for (const auto& wireframe : stateMap) {
+    void releaseStatesOfProgram(GLProgram& program) {
 
-                auto& value = stateMap.at(wireframe.first);
-                deleteVertexArrayObject(*value->object);
-            }
-            stateMap.clear();
+        bindingStates.forEach([&](ProgramMap& programMap) {
+            auto it = programMap.find(program.id);
+            if (it == programMap.end()) return;
 
-            programMap.erase(program.id);
-        }
+            releaseStates(it->second);
+            programMap.erase(it);
+        });
     }
 
     void reset() {
@@ -458,14 +408,14 @@ std::shared_ptr<GLBindingState> GLBindingStates::createBindingState(std::optiona
     return pimpl_->createBindingState(vao);
 }
 
-bool GLBindingStates::needsUpdate(BufferGeometry* geometry, BufferAttribute* index) {
+bool GLBindingStates::needsUpdate(Object3D* object, BufferGeometry* geometry, BufferAttribute* index) {
 
-    return pimpl_->needsUpdate(geometry, index);
+    return pimpl_->needsUpdate(object, geometry, index);
 }
 
-void GLBindingStates::saveCache(BufferGeometry* geometry, BufferAttribute* index) {
+void GLBindingStates::saveCache(Object3D* object, BufferGeometry* geometry, BufferAttribute* index) {
 
-    pimpl_->saveCache(geometry, index);
+    pimpl_->saveCache(object, geometry, index);
 }
 
 void GLBindingStates::initAttributes() {
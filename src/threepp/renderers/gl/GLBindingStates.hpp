@@ -22,10 +22,11 @@ namespace threepp::gl {
         std::vector<int> enabledAttributes;
         std::vector<int> attributeDivisors;
         std::optional<unsigned int> object;
-        std::unordered_map<std::string, BufferAttribute*> attributes;
+        // layout of the geometry the attribute pointers were specified for
+        std::optional<unsigned int> layoutVersion;
         BufferAttribute* index = nullptr;
-
-        int attributesNum = 0;
+        // ids of the GL buffers bound for instanceMatrix and instanceColor
+        std::pair<unsigned int, unsigned int> instanceBuffers;
 
         GLBindingState(
                 std::vector<int> newAttributes,
@@ -54,9 +55,9 @@ namespace threepp::gl {
 
         [[nodiscard]] std::shared_ptr<GLBindingState> createBindingState(std::optional<unsigned int> vao) const;
 
-        bool needsUpdate(BufferGeometry* geometry, BufferAttribute* index);
+        bool needsUpdate(Object3D* object, BufferGeometry* geometry, BufferAttribute* index);
 
-        void saveCache(BufferGeometry* geometry, BufferAttribute* index);
+        void saveCache(Object3D* object, BufferGeometry* geometry, BufferAttribute* index);
 
         void initAttributes();
 
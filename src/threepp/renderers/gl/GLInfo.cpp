@@ -46,4 +46,6 @@ void gl::GLInfo::reset() {
     render.triangles = 0;
     render.points = 0;
     render.lines = 0;
+    render.uniformUploads = 0;
+    render.uniformUploadsSkipped = 0;
 }
@@ -0,0 +1,291 @@
+
+#include "threepp/renderers/gl/GLInstanceCulling.hpp"
+
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/SimdKernels.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // frames a mesh may go without being culled before its proxies are released
+    constexpr size_t proxyLifetime = 120;
+
+    // instances classified and compacted per task
+    constexpr size_t chunkSize = 16384;
+
+    // instance level of culled instances
+    constexpr std::uint8_t culled = 255;
+
+}// namespace
+
+const std::vector<InstancedMesh*>& GLInstanceCulling::cull(InstancedMesh& mesh, const Frustum& frustum, const Vector3& cameraPosition, float zoom, size_t depth, size_t frame) {
+
+    if (layers_.size() <= depth) layers_.resize(depth + 1);
+    auto& layer = layers_[depth];
+
+    auto& result = layer.result;
+    result.clear();
+
+    auto& entry = layer.entries[&mesh];
+    entry.frame = frame;
+
+    const auto count = static_cast<size_t>(std::clamp(mesh.count, 0, mesh.capacity()));
+    if (count == 0) return result;
+
+    auto geometry = mesh.geometry();
+    if (!geometry->boundingSphere) geometry->computeBoundingSphere();
+
+    const auto& sphere = *geometry->boundingSphere;
+
+    const auto& levels = mesh.levels();
+    const size_t levelCount = levels.size() + 1;
+    assert(levelCount <= culled);
+
+    // compared against squared world distances, distance / zoom >= level.distance
+    levelDistancesSq_.clear();
+    for (const auto& level : levels) {
+
+        const auto distance = level.distance * zoom;
+        levelDistancesSq_.emplace_back(distance * distance);
+    }
+
+    // planes in the flat layout of simd::planeDistances
+    float planes[6][4];
+    for (size_t p = 0; p < 6; p++) {
+
+        const auto& plane = frustum.planes()[p];
+        planes[p][0] = plane.normal.x;
+        planes[p][1] = plane.normal.y;
+        planes[p][2] = plane.normal.z;
+        planes[p][3] = plane.constant;
+    }
+
+    const bool frustumCulled = mesh.perInstanceFrustumCulled;
+    const auto& m = mesh.matrixWorld.elements;
+    const float radius = sphere.radius * mesh.matrixWorld.getMaxScaleOnAxis();
+    const float cx = sphere.center.x, cy = sphere.center.y, cz = sphere.center.z;
+    const float camX = cameraPosition.x, camY = cameraPosition.y, camZ = cameraPosition.z;
+
+    const float* matrices = mesh.instanceMatrix->array().data();
+
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+    instanceLevels_.resize(count);
+    spheres_.resize(count * 4);
+    chunkCounts_.assign(chunks * levelCount, 0);
+
+    utils::parallel_for(size_t(0), chunks, size_t(1), [&](size_t chunkBegin, size_t chunkEnd) {
+        for (auto chunk = chunkBegin; chunk < chunkEnd; chunk++) {
+
+            int* counts = chunkCounts_.data() + chunk * levelCount;
+
+            const size_t begin = chunk * chunkSize;
+            const size_t end = std::min(count, begin + chunkSize);
+            float* spheres = spheres_.data() + begin * 4;
+
+            // bounding sphere of every instance in the space of the mesh, as center and radius
+            for (size_t i = begin; i < end; i++) {
+
+                const float* e = matrices + i * 16;
+                float* sphere = spheres_.data() + i * 4;
+
+                sphere[0] = e[0] * cx + e[4] * cy + e[8] * cz + e[12];
+                sphere[1] = e[1] * cx + e[5] * cy + e[9] * cz + e[13];
+                sphere[2] = e[2] * cx + e[6] * cy + e[10] * cz + e[14];
+
+                if (frustumCulled) {
+
+                    const float scaleXSq = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+                    const float scaleYSq = e[4] * e[4] + e[5] * e[5] + e[6] * e[6];
+                    const float scaleZSq = e[8] * e[8] + e[9] * e[9] + e[10] * e[10];
+                    sphere[3] = radius * std::sqrt(std::max(scaleXSq, std::max(scaleYSq, scaleZSq)));
+                }
+            }
+
+            // centers to world space, then the radius becomes the distance to the frustum, negative when outside
+            simd::applyMatrix4(spheres, end - begin, 4, m.data());
+            if (frustumCulled) simd::planeDistances(spheres, end - begin, planes[0], 6);
+
+            for (size_t i = begin; i < end; i++) {
+
+                const float* sphere = spheres_.data() + i * 4;
+
+                if (frustumCulled && !(sphere[3] >= 0)) {
+
+                    instanceLevels_[i] = culled;
+                    continue;
+                }
+
+                const float dx = sphere[0] - camX, dy = sphere[1] - camY, dz = sphere[2] - camZ;
+                const float distanceSq = dx * dx + dy * dy + dz * dz;
+
+                size_t level = 0;
+                while (level < levelDistancesSq_.size() && distanceSq >= levelDistancesSq_[level]) level++;
+
+                instanceLevels_[i] = static_cast<std::uint8_t>(level);
+                counts[level]++;
+            }
+        }
+    });
+
+    // per chunk counts become the offsets each chunk writes its instances to
+    targets_.assign(levelCount, nullptr);
+    for (size_t level = 0; level < levelCount; level++) {
+
+        int total = 0;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+
+            auto& chunkCount = chunkCounts_[chunk * levelCount + level];
+            const auto visible = chunkCount;
+            chunkCount = total;
+            total += visible;
+        }
+
+        if (total > 0) {
+
+            targets_[level] = &prepareLevel(entry, mesh, level, total);
+            result.emplace_back(targets_[level]);
+        }
+    }
+
+    const float* colors = mesh.instanceColor ? mesh.instanceColor->array().data() : nullptr;
+
+    utils::parallel_for(size_t(0), chunks, size_t(1), [&](size_t chunkBegin, size_t chunkEnd) {
+        for (auto chunk = chunkBegin; chunk < chunkEnd; chunk++) {
+
+            int* offsets = chunkCounts_.data() + chunk * levelCount;
+
+            const size_t end = std::min(count, (chunk + 1) * chunkSize);
+            for (size_t i = chunk * chunkSize; i < end; i++) {
+
+                const auto level = instanceLevels_[i];
+                if (level == culled) continue;
+
+                auto& target = *targets_[level];
+                const auto offset = static_cast<size_t>(offsets[level]++);
+
+                std::memcpy(target.instanceMatrix->array().data() + offset * 16, matrices + i * 16, 16 * sizeof(float));
+
+                if (colors) {
+
+                    std::memcpy(target.instanceColor->array().data() + offset * 3, colors + i * 3, 3 * sizeof(float));
+                }
+            }
+        }
+    });
+
+    for (auto target : result) {
+
+        target->instanceMatrix->clearUpdateRanges();
+        target->instanceMatrix->addUpdateRange(0, target->count * 16);
+        target->instanceMatrix->needsUpdate();
+
+        if (target->instanceColor) {
+
+            target->instanceColor->clearUpdateRanges();
+            target->instanceColor->addUpdateRange(0, target->count * 3);
+            target->instanceColor->needsUpdate();
+        }
+    }
+
+    return result;
+}
+
+InstancedMesh& GLInstanceCulling::prepareLevel(Entry& entry, InstancedMesh& mesh, size_t level, int count) {
+
+    if (entry.levels.size() <= level) entry.levels.resize(level + 1);
+
+    auto& proxy = entry.levels[level];
+
+    // the scene keeps geometry and materials alive while the proxy is drawn
+    const std::shared_ptr<BufferGeometry> geometry = level == 0
+                                                             ? std::shared_ptr<BufferGeometry>(std::shared_ptr<BufferGeometry>(), mesh.geometry())
+                                                             : mesh.levels()[level - 1].geometry;
+
+    std::vector<std::shared_ptr<Material>> materials;
+    for (auto material : mesh.materials()) {
+
+        materials.emplace_back(std::shared_ptr<Material>(), material);
+    }
+
+    const bool colored = mesh.instanceColor != nullptr;
+
+    if (!proxy || proxy->capacity() < count || (proxy->instanceColor != nullptr) != colored) {
+
+        const auto capacity = proxy ? std::max(count, proxy->capacity() * 2) : count;
+        if (proxy) proxy->dispose();
+
+        proxy = InstancedMesh::create(geometry, nullptr, capacity);
+        proxy->instanceMatrix->setUsage(DynamicDrawUsage);
+
+        if (colored) {
+
+            proxy->instanceColor = FloatBufferAttribute::create(std::vector<float>(capacity * 3), 3);
+            proxy->instanceColor->setUsage(DynamicDrawUsage);
+        }
+
+    } else {
+
+        proxy->setGeometry(geometry);
+    }
+
+    proxy->setMaterials(materials);
+
+    proxy->count = count;
+    proxy->matrixWorld.copy(mesh.matrixWorld);
+    proxy->castShadow = mesh.castShadow;
+    proxy->receiveShadow = mesh.receiveShadow;
+    proxy->onBeforeRender = mesh.onBeforeRender;
+    proxy->onAfterRender = mesh.onAfterRender;
+
+    return *proxy;
+}
+
+void GLInstanceCulling::evict(size_t frame) {
+
+    for (auto& layer : layers_) {
+
+        for (auto it = layer.entries.begin(); it != layer.entries.end();) {
+
+            if (frame > it->second.frame + proxyLifetime) {
+
+                for (auto& proxy : it->second.levels) {
+
+                    if (proxy) proxy->dispose();
+                }
+                it = layer.entries.erase(it);
+
+            } else {
+
+                ++it;
+            }
+        }
+    }
+}
+
+void GLInstanceCulling::dispose() {
+
+    for (auto& layer : layers_) {
+
+        for (auto& [mesh, entry] : layer.entries) {
+
+            for (auto& proxy : entry.levels) {
+
+                if (proxy) proxy->dispose();
+            }
+        }
+    }
+
+    layers_.clear();
+}
+
+GLInstanceCulling::~GLInstanceCulling() = default;
@@ -0,0 +1,74 @@
+
+#ifndef THREEPP_GLINSTANCECULLING_HPP
+#define THREEPP_GLINSTANCECULLING_HPP
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace threepp {
+
+    class Frustum;
+    class InstancedMesh;
+    class Vector3;
+
+    namespace gl {
+
+        // Culls the instances of an InstancedMesh one by one and sorts the visible ones into its levels.
+        // Each level with visible instances is drawn through a pooled InstancedMesh holding a compacted
+        // copy of their matrices and colors, streamed as dynamic attributes.
+        // Proxies are kept per render call depth, so a nested render does not touch those of the outer one.
+        struct GLInstanceCulling {
+
+            GLInstanceCulling() = default;
+
+            GLInstanceCulling(const GLInstanceCulling&) = delete;
+            GLInstanceCulling& operator=(const GLInstanceCulling&) = delete;
+
+            // Instanced meshes to draw in place of mesh, one per level with visible instances.
+            // They take over the transform and materials of mesh and stay valid until mesh is culled again at the same depth.
+            // Instance bounds are the bounding sphere of the geometry of mesh, distances are divided by zoom as in LOD.
+            const std::vector<InstancedMesh*>& cull(InstancedMesh& mesh, const Frustum& frustum, const Vector3& cameraPosition, float zoom, size_t depth, size_t frame);
+
+            // proxies of meshes not culled for a while release their instance buffers
+            void evict(size_t frame);
+
+            void dispose();
+
+            ~GLInstanceCulling();
+
+        private:
+            struct Entry {
+
+                std::vector<std::shared_ptr<InstancedMesh>> levels;
+                size_t frame{};
+            };
+
+            struct Layer {
+
+                std::unordered_map<const InstancedMesh*, Entry> entries;
+                std::vector<InstancedMesh*> result;
+            };
+
+            // a deque, so that adding a depth leaves the layers in use by outer calls in place
+            std::deque<Layer> layers_;
+
+            // level of every instance, 255 when culled
+            std::vector<std::uint8_t> instanceLevels_;
+            // world space bounding sphere of every instance as x, y, z and radius, see simd::planeDistances
+            std::vector<float> spheres_;
+            // visible instances per chunk and level, turned into write offsets before compaction
+            std::vector<int> chunkCounts_;
+            std::vector<float> levelDistancesSq_;
+            std::vector<InstancedMesh*> targets_;
+
+            InstancedMesh& prepareLevel(Entry& entry, InstancedMesh& mesh, size_t level, int count);
+        };
+
+    }// namespace gl
+
+}// namespace threepp
+
+#endif//THREEPP_GLINSTANCECULLING_HPP
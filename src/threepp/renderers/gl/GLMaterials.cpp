@@ -64,7 +64,7 @@ struct GLMaterials::Impl {
             uniforms.at("specularMap").setValue(specularMaterial->specularMap.get());
         }
 
-        auto envMap = properties.materialProperties.get(material->uuid())->envMap;
+        auto envMap = properties.materialProperties.get(material->slot)->envMap;
         if (envMap) {
 
             uniforms.at("envMap").setValue(envMap.get());
@@ -76,7 +76,7 @@ struct GLMaterials::Impl {
                 uniforms.at("refractionRatio").value<float>() = reflectiveMaterial->refractionRatio;
             }
 
-            const auto& maxMipMapLevel = properties.textureProperties.get(envMap->uuid)->maxMipLevel;
+            const auto& maxMipMapLevel = properties.textureProperties.get(envMap->slot)->maxMipLevel;
             if (maxMipMapLevel) {
                 uniforms.at("maxMipLevel").value<int>() = *maxMipMapLevel;
             }
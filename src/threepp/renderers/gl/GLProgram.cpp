@@ -2,6 +2,7 @@
 #include "threepp/renderers/gl/GLProgram.hpp"
 
 #include "threepp/renderers/gl/GLBindingStates.hpp"
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
 #include "threepp/renderers/gl/GLPrograms.hpp"
 #include "threepp/renderers/gl/GLUniforms.hpp"
 
@@ -324,8 +325,8 @@ namespace {
 }// namespace
 
 
-GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates)
-    : cacheKey(std::move(cacheKey)), bindingStates(bindingStates) {
+GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates, GLInfo* info, GLProgramBinaryCache* binaryCache)
+    : cacheKey(std::move(cacheKey)), bindingStates(bindingStates), info(info) {
 
     auto& defines = parameters->defines;
 
@@ -654,6 +655,20 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
     std::string vertexGlsl = prefixVertex + vertexShader;
     std::string fragmentGlsl = prefixFragment + fragmentShader;
 
+    const bool useBinaryCache = binaryCache && !renderer->programCacheDirectory.empty() && binaryCache->supported();
+
+    std::string binaryKey;
+    if (useBinaryCache) {
+
+        binaryKey = binaryCache->computeKey(this->cacheKey, vertexGlsl, fragmentGlsl);
+
+        if (binaryCache->load(renderer->programCacheDirectory, binaryKey, program)) {
+            return;
+        }
+
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+
     const auto glVertexShader = createShader(GL_VERTEX_SHADER, vertexGlsl.c_str());
     const auto glFragmentShader = createShader(GL_FRAGMENT_SHADER, fragmentGlsl.c_str());
 
@@ -684,12 +699,17 @@ GLProgram::GLProgram(const GLRenderer* renderer, std::string cacheKey, const Pro
 
     glDeleteShader(glVertexShader);
     glDeleteShader(glFragmentShader);
+
+    if (useBinaryCache) {
+
+        binaryCache->store(renderer->programCacheDirectory, binaryKey, program);
+    }
 }
 
 std::shared_ptr<GLUniforms> GLProgram::getUniforms() {
 
     if (!cachedUniforms) {
-        cachedUniforms = std::make_shared<GLUniforms>(program);
+        cachedUniforms = std::make_shared<GLUniforms>(program, info);
     }
 
     return cachedUniforms;
@@ -15,6 +15,8 @@ namespace threepp {
     namespace gl {
 
         struct GLBindingStates;
+        struct GLInfo;
+        struct GLProgramBinaryCache;
         struct GLUniforms;
 
         struct GLProgram {
@@ -25,7 +27,7 @@ namespace threepp {
             int usedTimes = 1;
             unsigned int program = -1;
 
-            GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates);
+            GLProgram(const GLRenderer* renderer, std::string cacheKey, const ProgramParameters* parameters, GLBindingStates* bindingStates, GLInfo* info = nullptr, GLProgramBinaryCache* binaryCache = nullptr);
 
             std::shared_ptr<GLUniforms> getUniforms();
 
@@ -35,6 +37,7 @@ namespace threepp {
 
         private:
             GLBindingStates* bindingStates;
+            GLInfo* info;
             std::shared_ptr<GLUniforms> cachedUniforms;
             std::unordered_map<std::string, int> cachedAttributes;
 
@@ -0,0 +1,204 @@
+
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <glad/glad.h>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    constexpr uint32_t magic = 0x42505054;// "TPPB"
+    constexpr uint32_t fileVersion = 1;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t check;
+        uint32_t format;
+        uint32_t length;
+    };
+
+    uint64_t fnv1a(const std::string& str, uint64_t hash) {
+
+        for (auto c : str) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    // the file name is derived from the first hash, the second one guards against collisions
+    uint64_t checkHash(const std::string& key) {
+
+        return fnv1a(key, 0x84222325cbf29ce4ull);
+    }
+
+    std::string glString(GLenum name) {
+
+        auto str = glGetString(name);
+
+        return str ? reinterpret_cast<const char*>(str) : "";
+    }
+
+}// namespace
+
+
+bool GLProgramBinaryCache::supported() const {
+
+    if (!supported_) {
+
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported_ = formats > 0;
+    }
+
+    return *supported_;
+}
+
+std::string GLProgramBinaryCache::computeKey(const std::string& cacheKey, const std::string& vertexGlsl, const std::string& fragmentGlsl) const {
+
+    if (driver_.empty()) {
+        driver_ = glString(GL_VENDOR) + '\n' + glString(GL_RENDERER) + '\n' + glString(GL_VERSION);
+    }
+
+    return composeKey(driver_, cacheKey, vertexGlsl, fragmentGlsl);
+}
+
+bool GLProgramBinaryCache::load(const std::filesystem::path& directory, const std::string& key, unsigned int program) {
+
+    const auto entry = readEntry(directory, key);
+
+    if (!entry) {
+
+        ++info_.programs.binaryCacheMisses;
+        return false;
+    }
+
+    glProgramBinary(program, entry->format, entry->binary.data(), static_cast<GLsizei>(entry->binary.size()));
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    if (linked != GL_TRUE) {
+
+        // typically after a driver update, the entry is replaced once the program has been compiled
+        ++info_.programs.binaryCacheRejected;
+        ++info_.programs.binaryCacheMisses;
+        return false;
+    }
+
+    ++info_.programs.binaryCacheHits;
+    return true;
+}
+
+void GLProgramBinaryCache::store(const std::filesystem::path& directory, const std::string& key, unsigned int program) {
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+
+    if (linked != GL_TRUE || length <= 0) return;
+
+    Entry entry;
+    entry.binary.resize(length);
+
+    GLenum format = 0;
+    glGetProgramBinary(program, length, &length, &format, entry.binary.data());
+
+    entry.format = format;
+    entry.binary.resize(length);
+
+    writeEntry(directory, key, entry);
+}
+
+std::string GLProgramBinaryCache::composeKey(const std::string& driver, const std::string& cacheKey, const std::string& vertexGlsl, const std::string& fragmentGlsl) {
+
+    std::string key;
+    key.reserve(driver.size() + cacheKey.size() + vertexGlsl.size() + fragmentGlsl.size() + 3);
+    key.append(driver).append(1, '\0');
+    key.append(cacheKey).append(1, '\0');
+    key.append(vertexGlsl).append(1, '\0');
+    key.append(fragmentGlsl);
+
+    return key;
+}
+
+std::filesystem::path GLProgramBinaryCache::entryPath(const std::filesystem::path& directory, const std::string& key) {
+
+    std::stringstream ss;
+    ss << std::hex << std::setw(16) << std::setfill('0') << fnv1a(key, 14695981039346656037ull) << ".bin";
+
+    return directory / ss.str();
+}
+
+std::optional<GLProgramBinaryCache::Entry> GLProgramBinaryCache::readEntry(const std::filesystem::path& directory, const std::string& key) {
+
+    const auto path = entryPath(directory, key);
+
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec) return std::nullopt;
+
+    std::ifstream in(path, std::ios::binary);
+
+    Header header{};
+    if (!in || !in.read(reinterpret_cast<char*>(&header), sizeof(Header)) ||
+        header.magic != magic || header.version != fileVersion || header.check != checkHash(key)) {
+
+        return std::nullopt;
+    }
+
+    // a corrupt length must not allocate more than the file holds
+    if (header.length == 0 || size != sizeof(Header) + header.length) return std::nullopt;
+
+    Entry entry;
+    entry.format = header.format;
+    entry.binary.resize(header.length);
+    if (!in.read(entry.binary.data(), static_cast<std::streamsize>(entry.binary.size()))) {
+
+        return std::nullopt;
+    }
+
+    return entry;
+}
+
+bool GLProgramBinaryCache::writeEntry(const std::filesystem::path& directory, const std::string& key, const Entry& entry) {
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const auto path = entryPath(directory, key);
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[GLProgramBinaryCache] Unable to write '" << tmpPath.string() << "'" << std::endl;
+            return false;
+        }
+
+        Header header{magic, fileVersion, checkHash(key), entry.format, static_cast<uint32_t>(entry.binary.size())};
+        out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        out.write(entry.binary.data(), static_cast<std::streamsize>(entry.binary.size()));
+    }
+
+    // written to the side and renamed so concurrent readers never see a partial entry
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,55 @@
+
+#ifndef THREEPP_GLPROGRAMBINARYCACHE_HPP
+#define THREEPP_GLPROGRAMBINARYCACHE_HPP
+
+#include "threepp/renderers/gl/GLInfo.hpp"
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace threepp::gl {
+
+    // Stores linked program binaries on disk so that later runs can skip shader compilation.
+    // Entries are keyed by the program cache key, the final shader sources and the driver identity.
+    struct GLProgramBinaryCache {
+
+        explicit GLProgramBinaryCache(GLInfo& info): info_(info) {}
+
+        [[nodiscard]] bool supported() const;
+
+        [[nodiscard]] std::string computeKey(const std::string& cacheKey, const std::string& vertexGlsl, const std::string& fragmentGlsl) const;
+
+        // links program from a stored binary, returns false if there is none or the driver rejected it
+        bool load(const std::filesystem::path& directory, const std::string& key, unsigned int program);
+
+        void store(const std::filesystem::path& directory, const std::string& key, unsigned int program);
+
+        // The on-disk format, free of GL calls.
+
+        struct Entry {
+
+            unsigned int format{};
+            std::vector<char> binary;
+        };
+
+        [[nodiscard]] static std::string composeKey(const std::string& driver, const std::string& cacheKey, const std::string& vertexGlsl, const std::string& fragmentGlsl);
+
+        [[nodiscard]] static std::filesystem::path entryPath(const std::filesystem::path& directory, const std::string& key);
+
+        // the entry stored for key, none if the file is missing, truncated, corrupt or written for another key
+        [[nodiscard]] static std::optional<Entry> readEntry(const std::filesystem::path& directory, const std::string& key);
+
+        static bool writeEntry(const std::filesystem::path& directory, const std::string& key, const Entry& entry);
+
+    private:
+        GLInfo& info_;
+
+        mutable std::optional<bool> supported_;
+        mutable std::string driver_;
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLPROGRAMBINARYCACHE_HPP
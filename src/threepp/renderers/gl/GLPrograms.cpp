@@ -32,13 +32,15 @@ namespace {
 }// namespace
 
 
-GLPrograms::GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping)
+GLPrograms::GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping, GLInfo& info)
     : logarithmicDepthBuffer(GLCapabilities::instance().logarithmicDepthBuffer),
       floatVertexTextures(GLCapabilities::instance().floatVertexTextures),
       maxVertexUniforms(GLCapabilities::instance().maxVertexUniforms),
       vertexTextures(GLCapabilities::instance().vertexTextures),
       bindingStates(bindingStates),
-      clipping(clipping) {}
+      clipping(clipping),
+      info(info),
+      binaryCache(info) {}
 
 
 ProgramParameters GLPrograms::getParameters(
@@ -128,7 +130,7 @@ std::shared_ptr<GLProgram> GLPrograms::acquireProgram(const GLRenderer& renderer
 
     if (!program) {
 
-        program = programs.emplace_back(std::make_shared<GLProgram>(&renderer, cacheKey, &parameters, &bindingStates));
+        program = programs.emplace_back(std::make_shared<GLProgram>(&renderer, cacheKey, &parameters, &bindingStates, &info, &binaryCache));
     }
 
     return program;
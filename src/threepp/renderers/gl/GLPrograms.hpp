@@ -7,6 +7,7 @@
 #include "GLClipping.hpp"
 #include "GLLights.hpp"
 #include "GLProgram.hpp"
+#include "GLProgramBinaryCache.hpp"
 #include "ProgramParameters.hpp"
 
 #include "threepp/core/Object3D.hpp"
@@ -40,9 +41,11 @@ namespace threepp {
         private:
             GLClipping& clipping;
             GLBindingStates& bindingStates;
+            GLInfo& info;
+            GLProgramBinaryCache binaryCache;
 
         public:
-            GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping);
+            GLPrograms(GLBindingStates& bindingStates, GLClipping& clipping, GLInfo& info);
 
             static ProgramParameters getParameters(
                     const GLRenderer& renderer,
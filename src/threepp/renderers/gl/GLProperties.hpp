@@ -5,10 +5,14 @@
 
 #include "threepp/scenes/Scene.hpp"
 
+#include "threepp/core/ResourceSlot.hpp"
 #include "threepp/core/Uniform.hpp"
 
+#include <array>
+#include <memory>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace threepp::gl {
 
@@ -59,26 +63,74 @@ namespace threepp::gl {
         unsigned int version{};
     };
 
+    // Per-resource state indexed by ResourceSlot. Entries live in fixed size pages so pointers
+    // stay valid while other slots are added, an entry left by a previous owner of the slot is reset on access.
     template<class T>
     struct GLTypeProperties {
 
-        T* get(const std::string& key) {
+        T* get(const ResourceSlot& slot) {
 
-            return &properties_[key];
+            const auto& handle = slot.handle();
+
+            const auto page = handle.index / PageSize;
+            if (page >= pages_.size()) pages_.resize(page + 1);
+            if (!pages_[page]) pages_[page] = std::make_unique<Page>();
+
+            auto& entry = (*pages_[page])[handle.index % PageSize];
+            if (entry.generation != handle.generation) {
+
+                entry.value = T{};
+                entry.generation = handle.generation;
+            }
+
+            return &entry.value;
+        }
+
+        void remove(const ResourceSlot& slot) {
+
+            const auto& handle = slot.handle();
+
+            const auto page = handle.index / PageSize;
+            if (page >= pages_.size() || !pages_[page]) return;
+
+            auto& entry = (*pages_[page])[handle.index % PageSize];
+            if (entry.generation == handle.generation) {
+
+                entry.value = T{};
+                entry.generation = 0;
+            }
         }
 
-        void remove(const std::string& key) {
+        template<class F>
+        void forEach(F&& f) {
+
+            for (auto& page : pages_) {
+
+                if (!page) continue;
 
-            properties_.erase(key);
+                for (auto& entry : *page) {
+
+                    if (entry.generation) f(entry.value);
+                }
+            }
         }
 
         void dispose() {
 
-            properties_.clear();
+            pages_.clear();
         }
 
     private:
-        std::unordered_map<std::string, T> properties_;
+        static constexpr size_t PageSize = 256;
+
+        struct Entry {
+
+            uint32_t generation = 0;
+            T value{};
+        };
+
+        using Page = std::array<Entry, PageSize>;
+        std::vector<std::unique_ptr<Page>> pages_;
     };
 
     struct GLProperties {
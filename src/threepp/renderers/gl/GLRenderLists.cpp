@@ -1,7 +1,10 @@
 
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 
+#include "threepp/core/BufferGeometry.hpp"
+
 #include <algorithm>
+#include <cstring>
 #include <memory>
 
 using namespace threepp;
@@ -43,6 +46,83 @@ namespace {
         }
     } reversePainterSortStable;
 
+    // fewer depth bits than this and the comparison sort is used instead
+    constexpr unsigned int MinDepthBits = 16;
+
+    unsigned int bitWidth(unsigned int value) {
+
+        unsigned int bits = 0;
+        while (value) {
+
+            ++bits;
+            value >>= 1;
+        }
+
+        return bits;
+    }
+
+    // maps a float to an unsigned integer with the same ordering
+    uint32_t orderedBits(float value) {
+
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    // items without a program yet sort first
+    unsigned int programKey(const RenderItem* item) {
+
+        return item->program ? static_cast<unsigned int>(item->program->id) + 1 : 0;
+    }
+
+    // stable LSD radix sort on 8 bit digits, digits that are equal for every key are skipped
+    void radixSort(std::vector<GLRenderList::SortEntry>& entries, std::vector<GLRenderList::SortEntry>& scratch) {
+
+        const auto keyLess = [](const GLRenderList::SortEntry& a, const GLRenderList::SortEntry& b) {
+            return a.key < b.key;
+        };
+
+        if (entries.size() < 64) {
+
+            std::stable_sort(entries.begin(), entries.end(), keyLess);
+            return;
+        }
+
+        uint64_t varyingBits = 0;
+        for (const auto& entry : entries) {
+
+            varyingBits |= entry.key ^ entries.front().key;
+        }
+
+        scratch.resize(entries.size());
+        for (unsigned int shift = 0; shift < 64; shift += 8) {
+
+            if (((varyingBits >> shift) & 0xFF) == 0) continue;
+
+            size_t offsets[256]{};
+            for (const auto& entry : entries) {
+
+                ++offsets[(entry.key >> shift) & 0xFF];
+            }
+
+            size_t sum = 0;
+            for (auto& offset : offsets) {
+
+                const auto count = offset;
+                offset = sum;
+                sum += count;
+            }
+
+            for (const auto& entry : entries) {
+
+                scratch[offsets[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+
+            entries.swap(scratch);
+        }
+    }
+
 }// namespace
 
 gl::GLRenderList::GLRenderList(gl::GLProperties& properties): properties(properties) {}
@@ -61,44 +141,52 @@ gl::RenderItem* gl::GLRenderList::getNextRenderItem(
         Material* material,
         unsigned int groupOrder, float z, std::optional<GeometryGroup> group) {
 
-    gl::RenderItem* renderItem = nullptr;
-    auto materialProperties = properties.materialProperties.get(material->uuid());
+    auto materialProperties = properties.materialProperties.get(material->slot);
 
     if (renderItemsIndex >= renderItems.size()) {
-        auto r = std::make_unique<RenderItem>(RenderItem{object->id,
-                                                         object,
-                                                         geometry,
-                                                         material,
-                                                         materialProperties->program.get(),
-                                                         groupOrder,
-                                                         object->renderOrder,
-                                                         z,
-                                                         group});
-        renderItems.emplace_back(std::move(r));
-        renderItem = renderItems.back().get();
-
-    } else {
 
-        renderItem = renderItems.at(renderItemsIndex).get();
+        if (renderItems.size() == renderItems.capacity()) {
 
-        renderItem->id = object->id;
-        renderItem->object = object;
-        renderItem->geometry = geometry;
-        renderItem->material = material;
-        if (materialProperties->program) {
-            renderItem->program = materialProperties->program.get();
+            reserve(std::max(size_t(64), renderItems.capacity() * 2));
         }
-        renderItem->groupOrder = groupOrder;
-        renderItem->renderOrder = object->renderOrder;
-        renderItem->z = z;
-        renderItem->group = group;
+        renderItems.emplace_back();
     }
 
+    auto renderItem = &renderItems[renderItemsIndex];
+
+    renderItem->id = object->id;
+    renderItem->object = object;
+    renderItem->geometry = geometry;
+    renderItem->material = material;
+    renderItem->program = materialProperties->program.get();
+    renderItem->groupOrder = groupOrder;
+    renderItem->renderOrder = object->renderOrder;
+    renderItem->z = z;
+    renderItem->group = group;
+
     ++renderItemsIndex;
 
     return renderItem;
 }
 
+void gl::GLRenderList::reserve(size_t capacity) {
+
+    // opaque and transparent point into renderItems, move them along with the storage
+    std::vector<RenderItem> items;
+    items.reserve(capacity);
+    items.insert(items.end(), renderItems.begin(), renderItems.end());
+
+    for (auto list : {&opaque, &transparent}) {
+
+        for (auto& item : *list) {
+
+            item = items.data() + (item - renderItems.data());
+        }
+    }
+
+    renderItems.swap(items);
+}
+
 void gl::GLRenderList::push(
         Object3D* object,
         BufferGeometry* geometry,
@@ -137,8 +225,71 @@ void GLRenderList::unshift(
 
 void GLRenderList::sort() {
 
-    if (opaque.size() > 1) std::stable_sort(opaque.begin(), opaque.end(), painterSortStable);
-    if (transparent.size() > 1) std::stable_sort(transparent.begin(), transparent.end(), reversePainterSortStable);
+    if (opaque.size() > 1) sort(opaque, false);
+    if (transparent.size() > 1) sort(transparent, true);
+}
+
+// Opaque items are keyed (groupOrder, renderOrder, program, material, geometry, depth) so that
+// state changes are minimized, transparent items (groupOrder, renderOrder, inverted depth) for back-to-front order.
+// Every field gets as many bits as its largest value in the list needs, depth takes the remaining bits.
+void GLRenderList::sort(std::vector<RenderItem*>& items, bool backToFront) {
+
+    unsigned int maxGroupOrder = 0, maxRenderOrder = 0, maxProgram = 0, maxMaterial = 0, maxGeometry = 0;
+    for (const auto item : items) {
+
+        maxGroupOrder = std::max(maxGroupOrder, item->groupOrder);
+        maxRenderOrder = std::max(maxRenderOrder, item->renderOrder);
+        if (!backToFront) {
+
+            maxProgram = std::max(maxProgram, programKey(item));
+            maxMaterial = std::max(maxMaterial, item->material->slot.index());
+            maxGeometry = std::max(maxGeometry, item->geometry->slot.index());
+        }
+    }
+
+    const unsigned int groupOrderBits = bitWidth(maxGroupOrder);
+    const unsigned int renderOrderBits = bitWidth(maxRenderOrder);
+    const unsigned int programBits = bitWidth(maxProgram);
+    const unsigned int materialBits = bitWidth(maxMaterial);
+    const unsigned int geometryBits = bitWidth(maxGeometry);
+
+    const unsigned int fieldBits = groupOrderBits + renderOrderBits + programBits + materialBits + geometryBits;
+    if (fieldBits > 64 - MinDepthBits) {
+
+        if (backToFront) std::stable_sort(items.begin(), items.end(), reversePainterSortStable);
+        else std::stable_sort(items.begin(), items.end(), painterSortStable);
+        return;
+    }
+
+    const unsigned int depthBits = std::min(32u, 64 - fieldBits);
+
+    sortEntries_.resize(items.size());
+    for (size_t i = 0; i < items.size(); i++) {
+
+        const auto item = items[i];
+
+        uint64_t key = item->groupOrder;
+        key = (key << renderOrderBits) | item->renderOrder;
+        if (!backToFront) {
+
+            key = (key << programBits) | programKey(item);
+            key = (key << materialBits) | item->material->slot.index();
+            key = (key << geometryBits) | item->geometry->slot.index();
+        }
+
+        auto depth = orderedBits(item->z);
+        if (backToFront) depth = ~depth;
+        key = (key << depthBits) | (depth >> (32 - depthBits));
+
+        sortEntries_[i] = {key, item};
+    }
+
+    radixSort(sortEntries_, sortScratch_);
+
+    for (size_t i = 0; i < items.size(); i++) {
+
+        items[i] = sortEntries_[i].item;
+    }
 }
 
 void GLRenderList::finish() {
@@ -147,16 +298,16 @@ void GLRenderList::finish() {
 
     for (auto i = renderItemsIndex, il = renderItems.size(); i < il; ++i) {
 
-        auto& renderItem = renderItems.at(i);
+        auto& renderItem = renderItems[i];
 
-        if (!renderItem->id) break;
+        if (!renderItem.id) break;
 
-        renderItem->id = std::nullopt;
-        renderItem->object = nullptr;
-        renderItem->geometry = nullptr;
-        renderItem->material = nullptr;
-        renderItem->program = nullptr;
-        renderItem->group = std::nullopt;
+        renderItem.id = std::nullopt;
+        renderItem.object = nullptr;
+        renderItem.geometry = nullptr;
+        renderItem.material = nullptr;
+        renderItem.program = nullptr;
+        renderItem.group = std::nullopt;
     }
 }
 
@@ -164,24 +315,14 @@ GLRenderLists::GLRenderLists(GLProperties& properties): properties(properties) {
 
 std::shared_ptr<GLRenderList> GLRenderLists::get(Scene* scene, size_t renderCallDepth) {
 
-    if (!lists.count(scene->uuid)) {
+    auto& l = lists[scene->id];
+    if (renderCallDepth >= l.size()) {
 
-        auto& l = lists[scene->uuid] = std::vector<std::shared_ptr<GLRenderList>>{std::make_shared<GLRenderList>(properties)};
+        l.emplace_back(std::make_shared<GLRenderList>(properties));
         return l.back();
-
-    } else {
-
-        auto& l = lists.at(scene->uuid);
-        if (renderCallDepth >= l.size()) {
-
-            l.emplace_back(std::make_shared<GLRenderList>(properties));
-            return l.back();
-
-        } else {
-
-            return l.at(renderCallDepth);
-        }
     }
+
+    return l.at(renderCallDepth);
 }
 
 void GLRenderLists::dispose() {
@@ -15,13 +15,13 @@ namespace threepp::gl {
     struct RenderItem {
 
         std::optional<unsigned int> id;
-        Object3D* object;
-        BufferGeometry* geometry;
-        Material* material;
-        GLProgram* program;
-        unsigned int groupOrder;
-        unsigned int renderOrder;
-        float z;
+        Object3D* object{};
+        BufferGeometry* geometry{};
+        Material* material{};
+        GLProgram* program{};
+        unsigned int groupOrder{};
+        unsigned int renderOrder{};
+        float z{};
         std::optional<GeometryGroup> group;
     };
 
@@ -30,9 +30,16 @@ namespace threepp::gl {
         std::vector<RenderItem*> opaque;
         std::vector<RenderItem*> transparent;
 
-        std::vector<std::unique_ptr<RenderItem>> renderItems;
+        // contiguous, opaque and transparent point into it
+        std::vector<RenderItem> renderItems;
         size_t renderItemsIndex = 0;
 
+        struct SortEntry {
+
+            uint64_t key;
+            RenderItem* item;
+        };
+
         explicit GLRenderList(GLProperties& properties);
 
         void init();
@@ -61,6 +68,13 @@ namespace threepp::gl {
 
     private:
         GLProperties& properties;
+
+        std::vector<SortEntry> sortEntries_;
+        std::vector<SortEntry> sortScratch_;
+
+        void reserve(size_t capacity);
+
+        void sort(std::vector<RenderItem*>& items, bool backToFront);
     };
 
     struct GLRenderLists {
@@ -74,7 +88,7 @@ namespace threepp::gl {
     private:
         GLProperties& properties;
 
-        std::unordered_map<std::string, std::vector<std::shared_ptr<GLRenderList>>> lists;
+        std::unordered_map<unsigned int, std::vector<std::shared_ptr<GLRenderList>>> lists;
     };
 
 }// namespace threepp::gl
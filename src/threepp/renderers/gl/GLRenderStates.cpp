@@ -51,12 +51,14 @@ void GLRenderState::setupLightsView(Camera* camera) {
 
 std::shared_ptr<GLRenderState> GLRenderStates::get(Scene* scene, size_t renderCallDepth) {
 
-    if (renderCallDepth >= renderStates_[scene->uuid].size()) {
+    auto& states = renderStates_[scene->id];
 
-        renderStates_[scene->uuid].emplace_back(std::make_shared<GLRenderState>());
+    if (renderCallDepth >= states.size()) {
+
+        states.emplace_back(std::make_shared<GLRenderState>());
     }
 
-    return renderStates_[scene->uuid].at(renderCallDepth);
+    return states.at(renderCallDepth);
 }
 
 void GLRenderStates::dispose() {
@@ -40,7 +40,7 @@ namespace threepp::gl {
         void dispose();
 
     private:
-        std::unordered_map<std::string, std::vector<std::shared_ptr<GLRenderState>>> renderStates_;
+        std::unordered_map<unsigned int, std::vector<std::shared_ptr<GLRenderState>>> renderStates_;
     };
 
 }// namespace threepp::gl
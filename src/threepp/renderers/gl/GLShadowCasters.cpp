@@ -0,0 +1,207 @@
+
+#include "threepp/renderers/gl/GLShadowCasters.hpp"
+
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/objects/Line.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/objects/Points.hpp"
+
+#include <functional>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // render calls a scene may go without shadows before its caster states are dropped
+    constexpr size_t sceneLifetime = 600;
+
+    // transforms and geometry feed into the depth of a caster, as do the versions of its materials
+    unsigned int casterVersion(Object3D& object) {
+
+        unsigned int version = 0;
+
+        auto geometry = object.geometry();
+        if (auto position = geometry->getAttribute("position")) version += position->version;
+        if (auto index = geometry->getIndex()) version += index->version;
+
+        if (auto instancedMesh = object.as<InstancedMesh>()) version += instancedMesh->instanceMatrix->version;
+
+        for (auto material : object.materials()) {
+
+            if (material) version += material->version;
+        }
+
+        return version;
+    }
+
+    // instances drawn by a caster, an InstancedMesh may draw fewer than it holds
+    int instanceCount(Object3D& object) {
+
+        if (auto instancedMesh = object.as<InstancedMesh>()) return instancedMesh->count;
+
+        return 1;
+    }
+
+    // which materials a caster draws with, swapping one or toggling its visibility changes the result
+    size_t materialsHash(Object3D& object) {
+
+        size_t hash = 0;
+        for (auto material : object.materials()) {
+
+            const auto value = std::hash<const void*>()(material) ^ (material && material->visible ? 0x9e3779b9 : 0);
+            hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+        }
+
+        return hash;
+    }
+
+}// namespace
+
+void GLShadowCasters::gather(Object3D& scene, const Layers& cameraLayers, bool receivers) {
+
+    casters.clear();
+    gatherCasters(scene, cameraLayers, receivers);
+}
+
+void GLShadowCasters::gatherCasters(Object3D& object, const Layers& cameraLayers, bool receivers) {
+
+    if (!object.visible) return;
+
+    bool visible = object.layers.test(cameraLayers);
+
+    if (visible && (object.is<Mesh>() || object.is<Line>() || object.is<Points>())) {
+
+        if (object.castShadow || (object.receiveShadow && receivers)) {
+
+            auto& caster = casters.emplace_back();
+            caster.object = &object;
+            caster.frustumCulled = object.frustumCulled;
+            caster.isStatic = false;
+
+            if (caster.frustumCulled) {
+
+                auto geometry = object.geometry();
+                if (!geometry->boundingSphere) geometry->computeBoundingSphere();
+
+                caster.sphere.copy(*geometry->boundingSphere).applyMatrix4(object.matrixWorld);
+            }
+        }
+    }
+
+    for (auto& child : object.children) {
+
+        gatherCasters(*child, cameraLayers, receivers);
+    }
+}
+
+size_t GLShadowCasters::updateStates(const Object3D& scene) {
+
+    ++frame_;
+
+    auto [sceneIt, sceneInserted] = scenes_.try_emplace(&scene);
+    auto& states = sceneIt->second;
+    if (sceneInserted) states.epoch = ++nextEpoch_;
+    states.frame = frame_;
+
+    bool changed = false;
+
+    for (auto& caster : casters) {
+
+        auto object = caster.object;
+        auto geometry = object->geometry();
+        const auto version = casterVersion(*object);
+        const auto& drawRange = geometry->drawRange;
+        const auto instances = instanceCount(*object);
+        const auto materials = materialsHash(*object);
+
+        auto [it, inserted] = states.casters.try_emplace(object->id);
+        auto& state = it->second;
+
+        if (inserted) {
+
+            state.isStatic = true;
+            changed = true;
+
+        } else if (state.geometry != geometry || state.version != version || state.materials != materials ||
+                   state.drawRange.start != drawRange.start || state.drawRange.count != drawRange.count || state.instanceCount != instances ||
+                   !state.matrixWorld.equals(object->matrixWorld)) {
+
+            if (state.isStatic) changed = true;
+            state.isStatic = false;
+            state.stableFrames = 0;
+
+        } else if (!state.isStatic && ++state.stableFrames >= staticAfterFrames) {
+
+            state.isStatic = true;
+            changed = true;
+        }
+
+        state.matrixWorld.copy(object->matrixWorld);
+        state.geometry = geometry;
+        state.version = version;
+        state.drawRange = drawRange;
+        state.instanceCount = instances;
+        state.materials = materials;
+        state.frame = frame_;
+
+        caster.isStatic = state.isStatic;
+    }
+
+    for (auto it = states.casters.begin(); it != states.casters.end();) {
+
+        if (it->second.frame != frame_) {
+
+            if (it->second.isStatic) changed = true;
+            it = states.casters.erase(it);
+
+        } else {
+
+            ++it;
+        }
+    }
+
+    if (changed) states.epoch = ++nextEpoch_;
+
+    for (auto it = scenes_.begin(); it != scenes_.end();) {
+
+        if (frame_ > it->second.frame + sceneLifetime) {
+
+            it = scenes_.erase(it);
+
+        } else {
+
+            ++it;
+        }
+    }
+
+    return states.epoch;
+}
+
+void GLShadowCasters::addDraws(size_t casterIndex, bool split, std::vector<ShadowDraw>& draws, std::vector<ShadowDraw>& staticDraws) const {
+
+    const auto& caster = casters[casterIndex];
+    auto object = caster.object;
+    const auto material = object->materials();
+
+    auto& target = (split && caster.isStatic) ? staticDraws : draws;
+
+    if (material.size() > 1) {
+
+        for (const auto& group : object->geometry()->groups) {
+
+            if (material.size() > group.materialIndex) {
+                const auto groupMaterial = material[group.materialIndex];
+
+                if (groupMaterial && groupMaterial->visible) {
+
+                    target.push_back({casterIndex, groupMaterial, group});
+                }
+            }
+        }
+
+    } else if (material.front()->visible) {
+
+        target.push_back({casterIndex, material.front(), std::nullopt});
+    }
+}
@@ -0,0 +1,91 @@
+
+#ifndef THREEPP_GLSHADOWCASTERS_HPP
+#define THREEPP_GLSHADOWCASTERS_HPP
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/math/Matrix4.hpp"
+#include "threepp/math/Sphere.hpp"
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace threepp {
+
+    class Layers;
+    class Material;
+    class Object3D;
+
+    namespace gl {
+
+        struct ShadowCaster {
+
+            Object3D* object;
+            Sphere sphere;// world space, only set when frustumCulled
+            bool frustumCulled;
+            bool isStatic;
+        };
+
+        struct ShadowDraw {
+
+            size_t caster;
+            Material* material;
+            std::optional<GeometryGroup> group;
+        };
+
+        // Collects the shadow casters of a scene once for all shadow views, and tells which of them stayed
+        // unchanged long enough to be cached. Caster states are kept per scene, so rendering several scenes
+        // does not make them invalidate each other.
+        struct GLShadowCasters {
+
+            // frames a caster must stay unchanged before it moves back into the static set
+            static constexpr unsigned int staticAfterFrames = 30;
+
+            std::vector<ShadowCaster> casters;
+
+            // collects every visible mesh, line and points object below scene casting shadows,
+            // or receiving them when receivers is set
+            void gather(Object3D& scene, const Layers& cameraLayers, bool receivers);
+
+            // Classifies the gathered casters as static or dynamic. Returns the epoch of the static set of scene,
+            // which changes whenever a caster joins or leaves it, or one of them changes its transform, geometry,
+            // materials or their visibility. Epochs are unique across scenes.
+            size_t updateStates(const Object3D& scene);
+
+            // appends the draws of a caster to staticDraws if it is static and split is set, to draws otherwise
+            void addDraws(size_t caster, bool split, std::vector<ShadowDraw>& draws, std::vector<ShadowDraw>& staticDraws) const;
+
+        private:
+            // what a caster looked like when it was last seen, used to detect changes
+            struct CasterState {
+
+                Matrix4 matrixWorld;
+                BufferGeometry* geometry{};
+                unsigned int version{};
+                DrawRange drawRange{};
+                int instanceCount{};
+                size_t materials{};
+                unsigned int stableFrames{};
+                size_t frame{};
+                bool isStatic{};
+            };
+
+            struct SceneStates {
+
+                std::unordered_map<unsigned int, CasterState> casters;
+                size_t epoch{};
+                size_t frame{};
+            };
+
+            std::unordered_map<const Object3D*, SceneStates> scenes_;
+            size_t frame_{};
+            size_t nextEpoch_{};
+
+            void gatherCasters(Object3D& object, const Layers& cameraLayers, bool receivers);
+        };
+
+    }// namespace gl
+
+}// namespace threepp
+
+#endif//THREEPP_GLSHADOWCASTERS_HPP
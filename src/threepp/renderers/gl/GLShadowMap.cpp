@@ -2,12 +2,11 @@
 #include "threepp/constants.hpp"
 
 #include "threepp/math/Frustum.hpp"
+#include "threepp/math/Sphere.hpp"
 
 #include "threepp/scenes/Scene.hpp"
 
-#include "threepp/objects/Line.hpp"
 #include "threepp/objects/Mesh.hpp"
-#include "threepp/objects/Points.hpp"
 
 #include "threepp/materials/MeshDepthMaterial.hpp"
 #include "threepp/materials/MeshDistanceMaterial.hpp"
@@ -21,10 +20,16 @@
 
 #include "threepp/renderers/gl/GLCapabilities.hpp"
 #include "threepp/renderers/gl/GLObjects.hpp"
+#include "threepp/renderers/gl/GLProperties.hpp"
+#include "threepp/renderers/gl/GLShadowCasters.hpp"
 #include "threepp/renderers/gl/GLShadowMap.hpp"
 
+#include <glad/glad.h>
+
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <unordered_map>
 
 using namespace threepp;
 using namespace threepp::gl;
@@ -65,6 +70,47 @@ namespace {
     std::shared_ptr<ShaderMaterial> shadowMaterialVertical = createShadowMaterialVertical();
     std::shared_ptr<ShaderMaterial> shadowMaterialHorizontal = createShadowMaterialHorizontal();
 
+    // cached depth of the static casters of one shadow map
+    struct StaticLayer {
+
+        explicit StaticLayer(std::weak_ptr<LightShadow> shadow = {})
+            : shadow(std::move(shadow)) {}
+
+        std::weak_ptr<LightShadow> shadow;
+        std::weak_ptr<GLRenderTarget> map;
+        std::shared_ptr<GLRenderTarget> target;
+        std::vector<Matrix4> viewMatrices;
+        size_t epoch{};
+        // the shadow map holds exactly the static layer
+        bool mapIsStatic{};
+    };
+
+    // one viewport of one shadow map
+    struct ShadowView {
+
+        Light* light;
+        LightShadow* shadow;
+        unsigned int viewport;
+        Vector4 rect;
+        Frustum frustum;
+        Matrix4 viewMatrix;// projection * view of the shadow camera
+        StaticLayer* staticLayer;
+        std::vector<ShadowDraw> draws;
+        std::vector<ShadowDraw> staticDraws;
+    };
+
+    bool sameViews(const std::vector<Matrix4>& cached, const std::vector<ShadowView>& views, size_t first, size_t last) {
+
+        if (cached.size() != last - first) return false;
+
+        for (size_t i = first; i < last; i++) {
+
+            if (!cached[i - first].equals(views[i].viewMatrix)) return false;
+        }
+
+        return true;
+    }
+
 
 }// namespace
 
@@ -72,8 +118,15 @@ struct GLShadowMap::Impl {
 
     GLShadowMap* scope;
     GLObjects& _objects;
+    GLProperties& _properties;
 
-    Frustum _frustum;
+    GLShadowCasters _casters;
+    std::vector<ShadowView> _views;
+    size_t _viewCount = 0;
+
+    std::unordered_map<const LightShadow*, StaticLayer> _staticLayers;
+    // epoch of the static casters of the scene being rendered, see GLShadowCasters::updateStates
+    size_t _staticEpoch = 0;
 
     Vector2 _shadowMapSize;
     Vector2 _viewportSize;
@@ -89,9 +142,10 @@ struct GLShadowMap::Impl {
 
     std::shared_ptr<Mesh> fullScreenMesh;
 
-    Impl(GLShadowMap* scope, GLObjects& objects)
+    Impl(GLShadowMap* scope, GLObjects& objects, GLProperties& properties)
         : scope(scope),
           _objects(objects),
+          _properties(properties),
           _maxTextureSize(GLCapabilities::instance().maxTextureSize) {
 
         auto fullScreenTri = BufferGeometry::create();
@@ -219,7 +273,7 @@ struct GLShadowMap::Impl {
         auto distanceMaterial = result->as<MeshDistanceMaterial>();
         if (light->is<PointLight>() && distanceMaterial) {
 
-            distanceMaterial->referencePosition.setFromMatrixPosition(*light->matrixWorld);
+            distanceMaterial->referencePosition.setFromMatrixPosition(light->matrixWorld);
             distanceMaterial->nearDistance = shadowCameraNear;
             distanceMaterial->farDistance = shadowCameraFar;
         }
@@ -227,54 +281,137 @@ struct GLShadowMap::Impl {
         return result;
     }
 
-    void renderObject(GLRenderer& _renderer, Object3D* object, Camera* camera, Camera* shadowCamera, Light* light) {
+    // tests every caster against all shadow frusta in one pass over the casters
+    void cullCasters() {
 
-        if (!object->visible) return;
+        for (size_t i = 0; i < _viewCount; i++) {
 
-        bool visible = object->layers.test(camera->layers);
+            _views[i].draws.clear();
+            _views[i].staticDraws.clear();
+        }
 
-        if (visible && (object->is<Mesh>() || object->is<Line>() || object->is<Points>())) {
+        for (size_t c = 0; c < _casters.casters.size(); c++) {
 
-            if ((object->castShadow || (object->receiveShadow && scope->type == VSMShadowMap)) && (!object->frustumCulled || _frustum.intersectsObject(*object))) {
+            const auto& caster = _casters.casters[c];
 
-                object->modelViewMatrix.multiplyMatrices(shadowCamera->matrixWorldInverse, *object->matrixWorld);
+            for (size_t i = 0; i < _viewCount; i++) {
 
-                const auto geometry = _objects.update(object);
-                const auto material = object->materials();
+                auto& view = _views[i];
+                if (!caster.frustumCulled || view.frustum.intersectsSphere(caster.sphere)) {
 
-                if (material.size() > 1) {
+                    _casters.addDraws(c, view.staticLayer != nullptr, view.draws, view.staticDraws);
+                }
+            }
+        }
 
-                    const auto& groups = geometry->groups;
+        // draws sharing a source material also share the state of their depth material
+        const auto byMaterial = [this](const ShadowDraw& a, const ShadowDraw& b) {
+            const auto ma = a.material->slot.index(), mb = b.material->slot.index();
+            if (ma != mb) return ma < mb;
+            return _casters.casters[a.caster].object->geometry()->slot.index() < _casters.casters[b.caster].object->geometry()->slot.index();
+        };
 
-                    for (const auto& group : groups) {
+        for (size_t i = 0; i < _viewCount; i++) {
 
-                        if (material.size() > group.materialIndex) {
-                            const auto groupMaterial = material[group.materialIndex];
+            std::stable_sort(_views[i].draws.begin(), _views[i].draws.end(), byMaterial);
+            std::stable_sort(_views[i].staticDraws.begin(), _views[i].staticDraws.end(), byMaterial);
+        }
+    }
 
-                            if (groupMaterial && groupMaterial->visible) {
+    StaticLayer* getStaticLayer(const std::shared_ptr<LightShadow>& shadow) {
 
-                                const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, groupMaterial, light, shadowCamera->near, shadowCamera->far);
+        auto& layer = _staticLayers[shadow.get()];
+        if (layer.shadow.lock() != shadow) {
 
-                                _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, group);
-                            }
-                        }
-                    }
+            if (layer.target) layer.target->dispose();
+            layer = StaticLayer(shadow);
+        }
 
-                } else if (material.front()->visible) {
+        return &layer;
+    }
 
-                    auto depthMaterial = getDepthMaterial(_renderer, object, geometry, material.front(), light, shadowCamera->near, shadowCamera->far);
+    void pruneStaticLayers() {
 
-                    _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, std::nullopt);
-                }
+        for (auto it = _staticLayers.begin(); it != _staticLayers.end();) {
+
+            auto shadow = it->second.shadow.lock();
+
+            if (!shadow || !shadow->cacheStaticCasters) {
+
+                if (it->second.target) it->second.target->dispose();
+                it = _staticLayers.erase(it);
+
+            } else {
+
+                ++it;
+            }
+        }
+    }
+
+    // copies color and depth, the target must be the current render target.
+    // False if either has no framebuffer to copy with, leaving the target untouched.
+    bool copyRenderTarget(GLRenderTarget& source, GLRenderTarget& target) {
+
+        const auto read = _properties.renderTargetProperties.get(source.slot)->glFramebuffer;
+        const auto draw = _properties.renderTargetProperties.get(target.slot)->glFramebuffer;
+        if (!read || !draw) return false;
+
+        const auto width = static_cast<GLint>(target.width);
+        const auto height = static_cast<GLint>(target.height);
+
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, *read);
+        glBlitFramebuffer(0, 0, width, height, 0, 0, width, height, GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+        // binding GL_FRAMEBUFFER set both, GLState does not track the read binding on its own
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, *draw);
+
+        return true;
+    }
+
+    void renderViews(GLRenderer& _renderer, size_t first, size_t last, bool staticDraws) {
+
+        auto& _state = _renderer.state();
+
+        for (auto i = first; i < last; i++) {
+
+            auto& view = _views[i];
+
+            _state.viewport(view.rect);
+
+            // the shadow camera is shared by all viewports of a light
+            if (auto pointLightShadow = dynamic_cast<PointLightShadow*>(view.shadow)) {
+                pointLightShadow->updateMatrices(view.light->as<PointLight>(), view.viewport);
+            } else {
+                view.shadow->updateMatrices(view.light);
             }
+
+            renderDraws(_renderer, view, staticDraws ? view.staticDraws : view.draws);
         }
+    }
+
+    void renderDraws(GLRenderer& _renderer, ShadowView& view, const std::vector<ShadowDraw>& draws) {
+
+        auto shadowCamera = view.shadow->camera.get();
+
+        for (const auto& draw : draws) {
+
+            auto object = _casters.casters[draw.caster].object;
 
-        for (auto& child : object->children) {
+            object->modelViewMatrix.multiplyMatrices(shadowCamera->matrixWorldInverse, object->matrixWorld);
 
-            renderObject(_renderer, child.get(), camera, shadowCamera, light);
+            const auto geometry = _objects.update(object);
+            const auto depthMaterial = getDepthMaterial(_renderer, object, geometry, draw.material, view.light, shadowCamera->near, shadowCamera->far);
+
+            _renderer.renderBufferDirect(shadowCamera, nullptr, geometry, depthMaterial, object, draw.group);
         }
     }
 
+    ShadowView& nextView() {
+
+        if (_viewCount == _views.size()) _views.emplace_back();
+
+        return _views[_viewCount++];
+    }
+
     void render(GLRenderer& _renderer, const std::vector<Light*>& lights, Scene* scene, Camera* camera) {
 
         if (!scope->enabled) return;
@@ -294,7 +431,9 @@ struct GLShadowMap::Impl {
         _state.depthBuffer.setTest(true);
         _state.setScissorTest(false);
 
-        // render depth map
+        // set up shadow maps and collect the frustum of every viewport
+
+        _viewCount = 0;
 
         for (auto light : lights) {
 
@@ -363,52 +502,147 @@ struct GLShadowMap::Impl {
                 shadow->camera->updateProjectionMatrix();
             }
 
-            _renderer.setRenderTarget(shadow->map);
-            _renderer.clear();
-
+            auto pointLightShadow = std::dynamic_pointer_cast<PointLightShadow>(shadow);
             auto viewportCount = shadow->getViewportCount();
 
             for (unsigned vp = 0; vp < viewportCount; vp++) {
 
                 const auto& viewport = shadow->getViewport(vp);
 
-                _viewport.set(
+                auto& view = nextView();
+                view.light = light;
+                view.shadow = shadow.get();
+                view.viewport = vp;
+                view.rect.set(
                         _viewportSize.x * viewport.x,
                         _viewportSize.y * viewport.y,
                         _viewportSize.x * viewport.z,
                         _viewportSize.y * viewport.w);
 
-                _state.viewport(_viewport);
-
-                if (std::dynamic_pointer_cast<PointLightShadow>(shadow)) {
-                    std::dynamic_pointer_cast<PointLightShadow>(shadow)->updateMatrices(light->as<PointLight>(), vp);
+                if (pointLightShadow) {
+                    pointLightShadow->updateMatrices(light->as<PointLight>(), vp);
                 } else {
                     shadow->updateMatrices(light);
                 }
 
-                _frustum = shadow->getFrustum();
-
-                renderObject(_renderer, scene, camera, shadow->camera.get(), light);
+                view.frustum.copy(shadow->getFrustum());
+                view.viewMatrix.multiplyMatrices(shadow->camera->projectionMatrix, shadow->camera->matrixWorldInverse);
+                view.staticLayer = shadow->cacheStaticCasters ? getStaticLayer(shadow) : nullptr;
             }
+        }
+
+        if (_viewCount > 0) {
+
+            _casters.gather(*scene, camera->layers, scope->type == VSMShadowMap);
+
+            const auto anyCached = std::any_of(_views.begin(), _views.begin() + static_cast<std::ptrdiff_t>(_viewCount), [](const ShadowView& view) {
+                return view.staticLayer != nullptr;
+            });
+            if (anyCached) _staticEpoch = _casters.updateStates(*scene);
+
+            cullCasters();
+        }
+
+        // render depth map
+
+        for (size_t first = 0; first < _viewCount;) {
+
+            auto shadow = _views[first].shadow;
+            auto layer = _views[first].staticLayer;
+            const bool vsm = !dynamic_cast<PointLightShadow*>(shadow) && scope->type == VSMShadowMap;
+
+            auto last = first;
+            while (last < _viewCount && _views[last].shadow == shadow) last++;
+
+            if (layer) {
+
+                const bool hasDynamic = std::any_of(_views.begin() + static_cast<std::ptrdiff_t>(first), _views.begin() + static_cast<std::ptrdiff_t>(last), [](const ShadowView& view) {
+                    return !view.draws.empty();
+                });
+
+                if (layer->map.lock() != shadow->map) {
+
+                    layer->map = shadow->map;
+                    layer->mapIsStatic = false;
+                }
 
-            // do blur pass for VSM
+                if (layer->target && (layer->target->width != shadow->map->width || layer->target->height != shadow->map->height)) {
 
-            if (!std::dynamic_pointer_cast<PointLightShadow>(shadow) && scope->type == VSMShadowMap) {
+                    layer->target->dispose();
+                    layer->target = nullptr;
+                }
+
+                const bool valid = layer->target && layer->epoch == _staticEpoch && sameViews(layer->viewMatrices, _views, first, last);
+
+                if (!valid || hasDynamic || !layer->mapIsStatic) {
+
+                    if (!valid) {
+
+                        if (!layer->target) {
+
+                            GLRenderTarget::Options pars{};
+                            pars.minFilter = NearestFilter;
+                            pars.magFilter = NearestFilter;
+                            pars.format = RGBAFormat;
+
+                            layer->target = GLRenderTarget::create(shadow->map->width, shadow->map->height, pars);
+                            layer->target->texture->name = shadow->map->texture->name + ".static";
+                        }
+
+                        _renderer.setRenderTarget(layer->target);
+                        _renderer.clear();
+
+                        renderViews(_renderer, first, last, true);
+
+                        layer->epoch = _staticEpoch;
+                        layer->viewMatrices.clear();
+                        for (auto i = first; i < last; i++) layer->viewMatrices.emplace_back(_views[i].viewMatrix);
+                    }
+
+                    // composite the dynamic casters on top of the cached static ones
+                    _renderer.setRenderTarget(shadow->map);
+                    if (!copyRenderTarget(*layer->target, *shadow->map)) {
 
-                VSMPass(_renderer, shadow.get(), camera);
+                        _renderer.clear();
+                        renderViews(_renderer, first, last, true);
+                    }
+
+                    renderViews(_renderer, first, last, false);
+
+                    if (vsm) VSMPass(_renderer, shadow, camera);
+
+                    layer->mapIsStatic = !hasDynamic && !vsm;
+                }
+
+            } else {
+
+                _renderer.setRenderTarget(shadow->map);
+                _renderer.clear();
+
+                renderViews(_renderer, first, last, false);
+
+                // do blur pass for VSM
+
+                if (vsm) VSMPass(_renderer, shadow, camera);
             }
 
             shadow->needsUpdate = false;
+
+            first = last;
         }
 
+        pruneStaticLayers();
+
+        _casters.casters.clear();
+
         scope->needsUpdate = false;
 
         _renderer.setRenderTarget(currentRenderTarget, activeCubeFace, activeMipmapLevel);
     }
 };
 
-GLShadowMap::GLShadowMap(GLObjects& objects)
-    : pimpl_(std::make_unique<Impl>(this, objects)) {}
+GLShadowMap::GLShadowMap(GLObjects& objects, GLProperties& properties)
+    : pimpl_(std::make_unique<Impl>(this, objects, properties)) {}
 
 
 void GLShadowMap::render(GLRenderer& renderer, const std::vector<Light*>& lights, Scene* scene, Camera* camera) {
@@ -0,0 +1,189 @@
+
+#include "threepp/renderers/gl/GLStreamBuffer.hpp"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace threepp::gl;
+
+namespace {
+
+    constexpr size_t minRegionSize = 1 << 20;
+    constexpr size_t maxRegionSize = 64 << 20;
+    constexpr size_t alignment = 64;
+
+    bool bufferStorageSupported() {
+
+#ifdef GL_MAP_PERSISTENT_BIT
+        // the driver may report the version or extension without the loader having resolved the entry point
+        if (!glBufferStorage) return false;
+
+        GLint major = 0, minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        if (major > 4 || (major == 4 && minor >= 4)) return true;
+
+        GLint extensions = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensions);
+        for (GLint i = 0; i < extensions; i++) {
+
+            const auto name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+            if (name && std::strcmp(name, "GL_ARB_buffer_storage") == 0) return true;
+        }
+#endif
+        return false;
+    }
+
+    size_t alignUp(size_t value) {
+
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+}// namespace
+
+GLStreamBuffer::GLStreamBuffer()
+    : persistent_(bufferStorageSupported()) {
+
+    allocate(minRegionSize);
+}
+
+size_t GLStreamBuffer::capacity() const {
+
+    return regionSize_ * regionCount;
+}
+
+bool GLStreamBuffer::persistent() const {
+
+    return persistent_;
+}
+
+void GLStreamBuffer::allocate(size_t regionSize) {
+
+    release();
+
+    regionSize_ = regionSize;
+    region_ = 0;
+    offset_ = 0;
+
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer_);
+
+#ifdef GL_MAP_PERSISTENT_BIT
+    if (persistent_) {
+
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(capacity()), nullptr, flags);
+        mapped_ = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(capacity()), flags));
+
+        if (mapped_) return;
+
+        // fall back to mapping every upload
+        persistent_ = false;
+        glDeleteBuffers(1, &buffer_);
+        glGenBuffers(1, &buffer_);
+        glBindBuffer(GL_COPY_READ_BUFFER, buffer_);
+    }
+#endif
+
+    glBufferData(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(capacity()), nullptr, GL_STREAM_DRAW);
+}
+
+void GLStreamBuffer::release() {
+
+    for (auto& fence : fences_) {
+
+        if (fence) glDeleteSync(static_cast<GLsync>(fence));
+        fence = nullptr;
+    }
+
+    if (buffer_) {
+
+        if (mapped_) {
+
+            glBindBuffer(GL_COPY_READ_BUFFER, buffer_);
+            glUnmapBuffer(GL_COPY_READ_BUFFER);
+            mapped_ = nullptr;
+        }
+
+        // GL keeps the storage alive until pending copies from it have executed
+        glDeleteBuffers(1, &buffer_);
+        buffer_ = 0;
+    }
+}
+
+bool GLStreamBuffer::advance(bool wait) {
+
+    const auto next = (region_ + 1) % regionCount;
+    auto& fence = fences_[next];
+
+    if (fence) {
+
+        const auto sync = static_cast<GLsync>(fence);
+        auto status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+        if (status == GL_TIMEOUT_EXPIRED) {
+
+            if (!wait) return false;
+
+            do {
+                status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+            } while (status == GL_TIMEOUT_EXPIRED);
+        }
+
+        glDeleteSync(sync);
+        fence = nullptr;
+    }
+
+    // everything submitted so far that reads the current region is now fenced
+    fences_[region_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    region_ = next;
+    offset_ = 0;
+
+    return true;
+}
+
+void GLStreamBuffer::upload(unsigned int buffer, size_t offset, const void* data, size_t size) {
+
+    if (size == 0) return;
+
+    if (size > regionSize_) {
+
+        allocate(std::max(regionSize_ * 2, alignUp(size)));
+
+    } else if (offset_ + size > regionSize_ && !advance(regionSize_ >= maxRegionSize)) {
+
+        // the GPU is more than two regions behind, grow rather than stall
+        allocate(std::min(maxRegionSize, regionSize_ * 2));
+    }
+
+    const auto start = region_ * regionSize_ + offset_;
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer_);
+
+    if (persistent_) {
+
+        std::memcpy(mapped_ + start, data, size);
+
+    } else {
+
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+        auto ptr = glMapBufferRange(GL_COPY_READ_BUFFER, static_cast<GLintptr>(start), static_cast<GLsizeiptr>(size), flags);
+        if (!ptr) return;
+
+        std::memcpy(ptr, data, size);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(start), static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size));
+
+    offset_ = alignUp(offset_ + size);
+}
+
+GLStreamBuffer::~GLStreamBuffer() {
+
+    release();
+}
@@ -0,0 +1,52 @@
+#ifndef THREEPP_GLSTREAMBUFFER_HPP
+#define THREEPP_GLSTREAMBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace threepp::gl {
+
+    // Staging ring for attributes that change every frame. Data is written straight into mapped
+    // memory and copied into the destination buffer on the GPU, so the buffers bound to vertex
+    // arrays never change. The ring is split into three regions, each fenced once the copies
+    // reading from it have been submitted. The ring grows instead of waiting while the GPU is behind.
+    struct GLStreamBuffer {
+
+        GLStreamBuffer();
+
+        GLStreamBuffer(const GLStreamBuffer&) = delete;
+        GLStreamBuffer& operator=(const GLStreamBuffer&) = delete;
+
+        // copies size bytes from data into buffer at offset
+        void upload(unsigned int buffer, size_t offset, const void* data, size_t size);
+
+        [[nodiscard]] size_t capacity() const;
+
+        // true when the ring is persistently mapped (GL 4.4 or ARB_buffer_storage)
+        [[nodiscard]] bool persistent() const;
+
+        ~GLStreamBuffer();
+
+    private:
+        static constexpr size_t regionCount = 3;
+
+        unsigned int buffer_{};
+        unsigned char* mapped_{};
+        bool persistent_{};
+
+        size_t regionSize_{};
+        size_t region_{};
+        size_t offset_{};
+        std::array<void*, regionCount> fences_{};
+
+        void allocate(size_t regionSize);
+
+        void release();
+
+        // moves to the next region, returns false if it is still in use by the GPU
+        bool advance(bool wait);
+    };
+
+}// namespace threepp::gl
+
+#endif//THREEPP_GLSTREAMBUFFER_HPP
@@ -88,7 +88,7 @@ void gl::GLTextures::generateMipmap(GLuint target, const Texture& texture, GLuin
 
     glGenerateMipmap(target);
 
-    auto textureProperties = properties.textureProperties.get(texture.uuid);
+    auto textureProperties = properties.textureProperties.get(texture.slot);
 
     textureProperties->maxMipLevel = static_cast<int>(std::log2(std::max(width, height)));
 }
@@ -195,13 +195,13 @@ void gl::GLTextures::initTexture(TextureProperties* textureProperties, Texture&
 
 void gl::GLTextures::deallocateTexture(Texture* texture) {
 
-    auto textureProperties = properties.textureProperties.get(texture->uuid);
+    auto textureProperties = properties.textureProperties.get(texture->slot);
 
     if (!textureProperties->glInit) return;
 
     glDeleteTextures(1, &textureProperties->glTexture.value());
 
-    properties.textureProperties.remove(texture->uuid);
+    properties.textureProperties.remove(texture->slot);
 }
 
 void gl::GLTextures::deallocateRenderTarget(GLRenderTarget* renderTarget) {
@@ -210,8 +210,8 @@ void gl::GLTextures::deallocateRenderTarget(GLRenderTarget* renderTarget) {
 
     const auto& texture = renderTarget->texture;
 
-    auto renderTargetProperties = properties.renderTargetProperties.get(renderTarget->uuid);
-    const auto& textureProperties = properties.textureProperties.get(texture->uuid);
+    auto renderTargetProperties = properties.renderTargetProperties.get(renderTarget->slot);
+    const auto& textureProperties = properties.textureProperties.get(texture->slot);
 
     if (textureProperties->glTexture) {
 
@@ -228,8 +228,8 @@ void gl::GLTextures::deallocateRenderTarget(GLRenderTarget* renderTarget) {
     glDeleteFramebuffers(1, &renderTargetProperties->glFramebuffer.value());
     if (renderTargetProperties->glDepthbuffer) glDeleteRenderbuffers(1, &renderTargetProperties->glDepthbuffer.value());
 
-    properties.textureProperties.remove(texture->uuid);
-    properties.renderTargetProperties.remove(renderTarget->uuid);
+    properties.textureProperties.remove(texture->slot);
+    properties.renderTargetProperties.remove(renderTarget->slot);
 }
 
 void gl::GLTextures::resetTextureUnits() {
@@ -253,7 +253,7 @@ int gl::GLTextures::allocateTextureUnit() {
 
 void gl::GLTextures::setTexture2D(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties.textureProperties.get(texture.uuid);
+    auto textureProperties = properties.textureProperties.get(texture.slot);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -276,7 +276,7 @@ void gl::GLTextures::setTexture2D(Texture& texture, GLuint slot) {
 
 void gl::GLTextures::setTexture2DArray(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties.textureProperties.get(texture.uuid);
+    auto textureProperties = properties.textureProperties.get(texture.slot);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -290,7 +290,7 @@ void gl::GLTextures::setTexture2DArray(Texture& texture, GLuint slot) {
 
 void gl::GLTextures::setTexture3D(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties.textureProperties.get(texture.uuid);
+    auto textureProperties = properties.textureProperties.get(texture.slot);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -304,7 +304,7 @@ void gl::GLTextures::setTexture3D(Texture& texture, GLuint slot) {
 
 void gl::GLTextures::setTextureCube(Texture& texture, GLuint slot) {
 
-    auto textureProperties = properties.textureProperties.get(texture.uuid);
+    auto textureProperties = properties.textureProperties.get(texture.slot);
 
     if (texture.version() > 0 && textureProperties->version != texture.version()) {
 
@@ -339,7 +339,7 @@ void gl::GLTextures::setupFrameBufferTexture(
     }
 
     state.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, textureTarget, *properties.textureProperties.get(texture.uuid)->glTexture, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, textureTarget, *properties.textureProperties.get(texture.slot)->glTexture, 0);
     state.bindFramebuffer(GL_FRAMEBUFFER, 0);
 }
 
@@ -389,7 +389,7 @@ void gl::GLTextures::setupDepthTexture(unsigned int framebuffer, const std::shar
     }
 
     // upload an empty depth texture with framebuffer size
-    if (!properties.textureProperties.get(renderTarget->depthTexture->uuid)->glTexture ||
+    if (!properties.textureProperties.get(renderTarget->depthTexture->slot)->glTexture ||
         renderTarget->depthTexture->image->width != renderTarget->width ||
         renderTarget->depthTexture->image->height != renderTarget->height) {
 
@@ -400,7 +400,7 @@ void gl::GLTextures::setupDepthTexture(unsigned int framebuffer, const std::shar
 
     setTexture2D(*renderTarget->depthTexture, 0);
 
-    const auto glDepthTexture = properties.textureProperties.get(renderTarget->depthTexture->uuid)->glTexture;
+    const auto glDepthTexture = properties.textureProperties.get(renderTarget->depthTexture->slot)->glTexture;
 
     if (renderTarget->depthTexture->format == DepthFormat) {
 
@@ -418,7 +418,7 @@ void gl::GLTextures::setupDepthTexture(unsigned int framebuffer, const std::shar
 
 void gl::GLTextures::setupDepthRenderbuffer(const std::shared_ptr<GLRenderTarget>& renderTarget) {
 
-    auto renderTargetProperties = properties.renderTargetProperties.get(renderTarget->uuid);
+    auto renderTargetProperties = properties.renderTargetProperties.get(renderTarget->slot);
 
     if (renderTarget->depthTexture) {
 
@@ -440,8 +440,8 @@ void gl::GLTextures::setupRenderTarget(const std::shared_ptr<GLRenderTarget>& re
 
     const auto& texture = renderTarget->texture;
 
-    auto renderTargetProperties = properties.renderTargetProperties.get(renderTarget->uuid);
-    auto textureProperties = properties.textureProperties.get(texture->uuid);
+    auto renderTargetProperties = properties.renderTargetProperties.get(renderTarget->slot);
+    auto textureProperties = properties.textureProperties.get(texture->slot);
 
     renderTarget->addEventListener("dispose", onRenderTargetDispose_);
 
@@ -497,7 +497,7 @@ void gl::GLTextures::updateRenderTargetMipmap(const std::shared_ptr<GLRenderTarg
     if (textureNeedsGenerateMipmaps(*texture)) {
 
         const auto target = GL_TEXTURE_2D;
-        const auto glTexture = properties.textureProperties.get(texture->uuid)->glTexture;
+        const auto glTexture = properties.textureProperties.get(texture->slot)->glTexture;
 
         state.bindTexture(target, *glTexture);
         generateMipmap(target, *texture, renderTarget->width, renderTarget->height);
@@ -1,12 +1,14 @@
 
 #include "threepp/renderers/gl/GLUniforms.hpp"
 
-#include "threepp/renderers/gl/UniformUtils.hpp"
+#include "threepp/renderers/gl/GLInfo.hpp"
+#include "threepp/renderers/gl/GLTextures.hpp"
 
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <array>
 #include <iostream>
-#include <regex>
 
 using namespace threepp;
 using namespace threepp::gl;
@@ -37,307 +39,322 @@ namespace {
         }
     };
 
-    struct SingleUniform: UniformObject {
+    // Uniform bound to a location of one program. Keeps a shadow copy of the last
+    // uploaded value, glUniform* is only called when the value differs from it.
+    struct LocationUniform: UniformObject {
 
-        explicit SingleUniform(std::string id, ActiveUniformInfo activeInfo, int addr)
+        LocationUniform(std::string id, ActiveUniformInfo activeInfo, int addr, GLInfo* info)
             : UniformObject(std::move(id)),
               activeInfo(std::move(activeInfo)),
               addr(addr),
-              setValueFun(getSingularSetter()) {
-        }
+              info(info) {}
 
-        void setValue(const UniformValue& value, GLTextures* textures) override {
-            setValueFun(value, textures);
+    protected:
+        ActiveUniformInfo activeInfo;
+        int addr;
+
+        // returns true and records the new value if it differs from the last upload
+        template<class T>
+        bool changed(std::vector<T>& cache, const T* data, size_t n) {
+
+            if (cache.size() == n && std::equal(data, data + n, cache.begin())) {
+                if (info) ++info->render.uniformUploadsSkipped;
+                return false;
+            }
+
+            cache.assign(data, data + n);
+            if (info) ++info->render.uniformUploads;
+
+            return true;
         }
 
     private:
-        int addr;
-        std::vector<float> cache;
-        ActiveUniformInfo activeInfo;
-        std::function<void(const UniformValue&, GLTextures*)> setValueFun;
+        GLInfo* info;
+    };
 
-        std::function<void(const UniformValue&, GLTextures*)> getSingularSetter() {
+    struct SingleUniform: LocationUniform {
 
-            switch (activeInfo.type) {
+        SingleUniform(std::string id, ActiveUniformInfo activeInfo, int addr, GLInfo* info)
+            : LocationUniform(std::move(id), std::move(activeInfo), addr, info) {}
 
-                case 0x1406: // FLOAT
-                    return [&](const UniformValue& value, GLTextures*) { setValueV1f(value); };
+        void setValue(const UniformValue& value, GLTextures* textures) override {
 
-                case 0x8b50: // _VEC2
-                    return [&](const UniformValue& value, GLTextures*) { setValueV2f(value); };
+            switch (activeInfo.type) {
 
-                case 0x8b51: // _VEC3
-                    return [&](const UniformValue& value, GLTextures*) { setValueV3f(value); };
+                case GL_FLOAT:
+                    setValueV1f(value);
+                    break;
 
-                case 0x8b52: // _VEC4
-                    return [&](const UniformValue& value, GLTextures*) { setValueV4f(value); };
+                case GL_FLOAT_VEC2:
+                    setValueV2f(value);
+                    break;
 
-                case 0x8b5b: // _MAT3
-                    return [&](const UniformValue& value, GLTextures*) { setValueM3(value); };
+                case GL_FLOAT_VEC3:
+                    setValueV3f(value);
+                    break;
 
-                case 0x8b5c: // _MAT4
-                    return [&](const UniformValue& value, GLTextures*) { setValueM4(value); };
+                case GL_FLOAT_VEC4:
+                    setValueV4f(value);
+                    break;
 
-                case 0x8b5e: // SAMPLER_2D
-                case 0x8d66: // SAMPLER_EXTERNAL_OES
-                case 0x8dca: // INT_SAMPLER_2D
-                case 0x8dd2: // UNSIGNED_INT_SAMPLER_2D
-                case 0x8b62: // SAMPLER_2D_SHADOW
-                    return [&](const UniformValue& value, GLTextures* textures) { setValueT1(value, textures); };
+                case GL_FLOAT_MAT3:
+                    setValueM3(value);
+                    break;
 
-                case 0x8b5f: // SAMPLER_3D
-                case 0x8dcb: // INT_SAMPLER_3D
-                case 0x8dd3: // UNSIGNED_INT_SAMPLER_3D
-                    return [&](const UniformValue& value, GLTextures* textures) { setValueT3D1(value, textures); };
+                case GL_FLOAT_MAT4:
+                    setValueM4(value);
+                    break;
 
-                case 0x1404: // INT, BOOL
-                case 0x8b56:
-                    return [&](const UniformValue& value, GLTextures*) { setValueV1i(value); };
+                case GL_SAMPLER_2D:
+                case 0x8d66:// SAMPLER_EXTERNAL_OES
+                case GL_INT_SAMPLER_2D:
+                case GL_UNSIGNED_INT_SAMPLER_2D:
+                case GL_SAMPLER_2D_SHADOW:
+                    setValueT1(value, textures, false);
+                    break;
+
+                case GL_SAMPLER_3D:
+                case GL_INT_SAMPLER_3D:
+                case GL_UNSIGNED_INT_SAMPLER_3D:
+                    setValueT1(value, textures, true);
+                    break;
+
+                case GL_INT:
+                case GL_BOOL:
+                    setValueV1i(value);
+                    break;
 
                 default:
-                    return [&](const UniformValue& value, GLTextures*) {
-                        std::cout << "SingleUniform TODO: "
-                                  << "name=" << activeInfo.name << ",type=" << activeInfo.type << std::endl;
-                    };
+                    std::cout << "SingleUniform TODO: "
+                              << "name=" << activeInfo.name << ",type=" << activeInfo.type << std::endl;
             }
         }
 
-        void setValueT1(const UniformValue& value, GLTextures* textures) const {
-            const auto unit = textures->allocateTextureUnit();
-            glUniform1i(addr, unit);
-            auto tex = std::get<Texture*>(value);
-            textures->setTexture2D(*tex, unit);
-        }
+    private:
+        std::vector<float> cache;
+        std::vector<int> intCache;
+
+        void setValueT1(const UniformValue& value, GLTextures* textures, bool is3D) {
+
+            const int unit = textures->allocateTextureUnit();
+            if (changed(intCache, &unit, 1)) {
+                glUniform1i(addr, unit);
+            }
 
-        void setValueT3D1(const UniformValue& value, GLTextures* textures) const {
-            const auto unit = textures->allocateTextureUnit();
-            glUniform1i(addr, unit);
             auto tex = std::get<Texture*>(value);
-            textures->setTexture3D(*tex, unit);
+            if (is3D) {
+                textures->setTexture3D(*tex, unit);
+            } else {
+                textures->setTexture2D(*tex, unit);
+            }
         }
 
-        void setValueV1i(const UniformValue& value) const {
+        void setValueV1i(const UniformValue& value) {
 
+            int i;
             if (std::holds_alternative<bool>(value)) {
-                bool b = std::get<bool>(value);
-                glUniform1i(addr, b);
+                i = std::get<bool>(value);
             } else if (std::holds_alternative<int>(value)) {
-                int i = std::get<int>(value);
-                glUniform1i(addr, i);
+                i = std::get<int>(value);
             } else {
                 throw std::runtime_error("Illegal variant index: " + std::to_string(value.index()));
             }
-        }
-
-        void setValueV1f(const UniformValue& value) {
-
-            float f = std::get<float>(value);
 
-            ensureCapacity(cache, 1);
-            if (cache[0] == f) return;
-
-            glUniform1f(addr, f);
-            cache[0] = f;
+            if (changed(intCache, &i, 1)) {
+                glUniform1i(addr, i);
+            }
         }
 
-        template<class ArrayLike>
-        void setValueV2fHelper(ArrayLike& value) {
-
-            float x = value[0];
-            float y = value[1];
-
-            ensureCapacity(cache, 2);
-            if (cache[0] != x || cache[1] != y) {
+        void setValueV1f(const UniformValue& value) {
 
-                glUniform2f(addr, x, y);
+            const float f = std::get<float>(value);
 
-                cache[0] = x;
-                cache[1] = y;
+            if (changed(cache, &f, 1)) {
+                glUniform1f(addr, f);
             }
         }
 
         void setValueV2f(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto arg) { std::cerr << "setValueV2f: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Vector2 arg) { setValueV2fHelper(arg); },
-                       },
-                       value);
-        }
-
-        template<class ArrayLike>
-        void setValueV3fHelper(ArrayLike& value) {
-
-            float x = value[0];
-            float y = value[1];
-            float z = value[2];
+            if (auto v = std::get_if<Vector2>(&value)) {
 
-            ensureCapacity(cache, 3);
-            if (cache[0] != x || cache[1] != y || cache[2] != z) {
+                const float data[]{v->x, v->y};
+                if (changed(cache, data, 2)) {
+                    glUniform2fv(addr, 1, data);
+                }
 
-                glUniform3f(addr, x, y, z);
+            } else {
 
-                cache[0] = x;
-                cache[1] = y;
-                cache[2] = z;
+                std::cerr << "setValueV2f: unsupported variant at index: " << value.index() << std::endl;
             }
         }
 
         void setValueV3f(const UniformValue& value) {
 
+            std::array<float, 3> data{};
+
             std::visit(overloaded{
-                               [&](auto arg) { std::cerr << "setValueV3f: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Vector3 arg) { setValueV3fHelper(arg); },
-                               [&](Vector3* arg) { setValueV3fHelper(*arg); },
-                               [&](Color arg) { setValueV3fHelper(arg); },
+                               [&](const auto&) { std::cerr << "setValueV3f: unsupported variant at index: " << value.index() << std::endl; },
+                               [&](const Vector3& arg) { data = {arg.x, arg.y, arg.z}; },
+                               [&](Vector3* arg) { data = {arg->x, arg->y, arg->z}; },
+                               [&](const Color& arg) { data = {arg.r, arg.g, arg.b}; },
                        },
                        value);
-        }
-
-        template<class ArrayLike>
-        void setValueV4fHelper(ArrayLike& value) {
-
-            float x = value[0];
-            float y = value[1];
-            float z = value[2];
-            float w = value[3];
 
-            ensureCapacity(cache, 4);
-            if (cache[0] != x || cache[1] != y && cache[2] != z || cache[3] != w) {
-
-                glUniform4f(addr, x, y, z, w);
-
-                cache[0] = x;
-                cache[1] = y;
-                cache[2] = z;
-                cache[3] = w;
+            if (changed(cache, data.data(), 3)) {
+                glUniform3fv(addr, 1, data.data());
             }
         }
 
         void setValueV4f(const UniformValue& value) {
 
+            std::array<float, 4> data{};
+
             std::visit(overloaded{
-                               [&](auto arg) { std::cerr << "setValueV4f: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Vector4 arg) { setValueV4fHelper(arg); },
-                               [&](Quaternion arg) { setValueV4fHelper(arg); },
+                               [&](const auto&) { std::cerr << "setValueV4f: unsupported variant at index: " << value.index() << std::endl; },
+                               [&](const Vector4& arg) { data = {arg.x, arg.y, arg.z, arg.w}; },
+                               [&](const Quaternion& arg) { data = {arg[0], arg[1], arg[2], arg[3]}; },
                        },
                        value);
-        }
-
-        template<class ArrayLike>
-        void setValueM3Helper(ArrayLike& value) {
-
-            if (arraysEqual(cache, value)) return;
 
-            glUniformMatrix3fv(addr, 1, false, value.data());
-
-            ensureCapacity(cache, 9);
-            copyArray(cache, value);
+            if (changed(cache, data.data(), 4)) {
+                glUniform4fv(addr, 1, data.data());
+            }
         }
 
         void setValueM3(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto) { std::cerr << "setValueM3: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Matrix3 arg) { setValueM3Helper(arg.elements); },
-                       },
-                       value);
-        }
-
-        template<class ArrayLike>
-        void setValueM4Helper(ArrayLike& value) {
+            if (auto m = std::get_if<Matrix3>(&value)) {
 
-            if (arraysEqual(cache, value)) return;
+                if (changed(cache, m->elements.data(), 9)) {
+                    glUniformMatrix3fv(addr, 1, false, m->elements.data());
+                }
 
-            glUniformMatrix4fv(addr, 1, false, value.data());
+            } else {
 
-            ensureCapacity(cache, 16);
-            copyArray(cache, value);
+                std::cerr << "setValueM3: unsupported variant at index: " << value.index() << std::endl;
+            }
         }
 
         void setValueM4(const UniformValue& value) {
 
-            std::visit(overloaded{
-                               [&](auto arg) { std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl; },
-                               [&](Matrix4 arg) { setValueM4Helper(arg.elements); },
-                               [&](Matrix4* arg) { setValueM4Helper(arg->elements); }},
-                       value);
+            const Matrix4* m = nullptr;
+            if (auto p = std::get_if<Matrix4>(&value)) {
+                m = p;
+            } else if (auto pp = std::get_if<Matrix4*>(&value)) {
+                m = *pp;
+            }
+
+            if (!m) {
+                std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl;
+                return;
+            }
+
+            if (changed(cache, m->elements.data(), 16)) {
+                glUniformMatrix4fv(addr, 1, false, m->elements.data());
+            }
         }
     };
 
-    struct PureArrayUniform: UniformObject {
+    struct PureArrayUniform: LocationUniform {
 
-        explicit PureArrayUniform(std::string id, ActiveUniformInfo activeInfo, int addr)
-            : UniformObject(std::move(id)),
-              activeInfo(std::move(activeInfo)),
-              addr(addr),
-              setValueFun(getPureArraySetter()) {}
+        PureArrayUniform(std::string id, ActiveUniformInfo activeInfo, int addr, GLInfo* info)
+            : LocationUniform(std::move(id), std::move(activeInfo), addr, info) {}
 
         void setValue(const UniformValue& value, GLTextures* textures) override {
-            setValueFun(value, textures);
-        }
 
-        [[nodiscard]] std::function<void(const UniformValue&, GLTextures*)> getPureArraySetter() const {
+            const auto size = activeInfo.size;
 
             switch (activeInfo.type) {
 
-                case 0x1406:// FLOAT
-                    return [&](const UniformValue& value, GLTextures*) {
-                        auto& data = std::get<std::vector<float>>(value);
-                        glUniform2fv(addr, activeInfo.size, data.data());
-                    };
-                case 0x8b50:// VEC2
-                    return [&](const UniformValue& value, GLTextures*) {
-                        auto& data = std::get<std::vector<Vector2>>(value);
-                        glUniform2fv(addr, activeInfo.size, flatten(data, activeInfo.size, 2).data());
-                    };
-                case 0x8b51:// VEC3
-                    return [&](const UniformValue& value, GLTextures*) {
-                        auto& data = std::get<std::vector<Vector3>>(value);
-                        glUniform3fv(addr, activeInfo.size, flatten(data, activeInfo.size, 3).data());
-                    };
-
-                case 0x8b5b:// MAT3
-                    return [&](const UniformValue& value, GLTextures*) {
-                        auto& data = std::get<std::vector<Matrix3>>(value);
-                        glUniformMatrix3fv(addr, activeInfo.size, false, flatten(data, activeInfo.size, 9).data());
-                    };
-                case 0x8b5c:// MAT4
-                    return [&](const UniformValue& value, GLTextures*) {
-                        std::visit(overloaded{
-                                           [&](auto arg) { std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl; },
-                                           [&](std::vector<Matrix4> arg) { glUniformMatrix4fv(addr, activeInfo.size, false, flatten(arg, activeInfo.size, 16).data()); },
-                                           [&](std::vector<Matrix4*> arg) { glUniformMatrix4fv(addr, activeInfo.size, false, flattenP(arg, activeInfo.size, 16).data()); }},
-                                   value);
-                    };
-                case 0x8b5e:// SAMPLER_2D
+                case GL_FLOAT: {
+                    auto& data = std::get<std::vector<float>>(value);
+                    scratch.assign(size, 0);
+                    std::copy_n(data.begin(), std::min<size_t>(size, data.size()), scratch.begin());
+                    if (changed(cache, scratch.data(), scratch.size())) {
+                        glUniform1fv(addr, size, scratch.data());
+                    }
+                    break;
+                }
+                case GL_FLOAT_VEC2:
+                    if (flatten(std::get<std::vector<Vector2>>(value), 2)) {
+                        glUniform2fv(addr, size, scratch.data());
+                    }
+                    break;
+                case GL_FLOAT_VEC3:
+                    if (flatten(std::get<std::vector<Vector3>>(value), 3)) {
+                        glUniform3fv(addr, size, scratch.data());
+                    }
+                    break;
+                case GL_FLOAT_MAT3:
+                    if (flatten(std::get<std::vector<Matrix3>>(value), 9)) {
+                        glUniformMatrix3fv(addr, size, false, scratch.data());
+                    }
+                    break;
+                case GL_FLOAT_MAT4: {
+                    bool upload = false;
+                    std::visit(overloaded{
+                                       [&](const auto&) { std::cerr << "setValueM4: unsupported variant at index: " << value.index() << std::endl; },
+                                       [&](const std::vector<Matrix4>& arg) { upload = flatten(arg, 16); },
+                                       [&](const std::vector<Matrix4*>& arg) { upload = flatten(arg, 16); }},
+                               value);
+                    if (upload) {
+                        glUniformMatrix4fv(addr, size, false, scratch.data());
+                    }
+                    break;
+                }
+                case GL_SAMPLER_2D:
                 case 0x8d66:// SAMPLER_EXTERNAL_OES
-                case 0x8dca:// INT_SAMPLER_2D
-                case 0x8dd2:// UNSIGNED_INT_SAMPLER_2D
-                case 0x8b62:// SAMPLER_2D_SHADOW
-                    return [&](const UniformValue& value, GLTextures* textures) {
-                        auto& data = std::get<std::vector<Texture*>>(value);
-                        const auto n = data.size();
-                        auto units = allocTexUnits(*textures, n);
-
-                        glUniform1iv(addr, static_cast<int>(n), units.data());
-
-                        for (unsigned i = 0; i != n; ++i) {
-                            textures->setTexture2D(*data[i], units[i]);
-                        }
-                    };
+                case GL_INT_SAMPLER_2D:
+                case GL_UNSIGNED_INT_SAMPLER_2D:
+                case GL_SAMPLER_2D_SHADOW: {
+                    auto& data = std::get<std::vector<Texture*>>(value);
+
+                    units.resize(data.size());
+                    for (auto& unit : units) {
+                        unit = textures->allocateTextureUnit();
+                    }
+
+                    if (changed(unitCache, units.data(), units.size())) {
+                        glUniform1iv(addr, static_cast<int>(units.size()), units.data());
+                    }
+
+                    for (unsigned i = 0; i != data.size(); ++i) {
+                        textures->setTexture2D(*data[i], units[i]);
+                    }
+                    break;
+                }
                 default:
-                    return [&](const UniformValue& value, GLTextures*) {
-                        std::cout << "PureArrayUniform TODO: "
-                                  << "name=" << activeInfo.name << ",type=" << activeInfo.type << std::endl;
-                    };
+                    std::cout << "PureArrayUniform TODO: "
+                              << "name=" << activeInfo.name << ",type=" << activeInfo.type << std::endl;
             }
         }
 
     private:
-        int addr;
-        ActiveUniformInfo activeInfo;
-        std::function<void(const UniformValue&, GLTextures*)> setValueFun;
+        std::vector<float> scratch;
+        std::vector<float> cache;
+        std::vector<int> units;
+        std::vector<int> unitCache;
+
+        template<class T>
+        static const T& deref(const T& value) { return value; }
+
+        template<class T>
+        static const T& deref(T* value) { return *value; }
+
+        // packs the first activeInfo.size elements into scratch, returns true if they differ from the last upload
+        template<class T>
+        bool flatten(const std::vector<T>& array, int blockSize) {
+
+            const auto nBlocks = std::min<size_t>(activeInfo.size, array.size());
+
+            scratch.assign(static_cast<size_t>(activeInfo.size) * blockSize, 0);
+            for (size_t i = 0; i < nBlocks; ++i) {
+                deref(array[i]).toArray(scratch, i * blockSize);
+            }
+
+            return changed(cache, scratch.data(), scratch.size());
+        }
     };
 
     struct StructuredUniform: UniformObject, Container {
@@ -347,25 +364,24 @@ namespace {
               activeInfo(std::move(activeInfo)) {}
 
         void setValue(const UniformValue& value, GLTextures* textures) override {
-            //            std::cout << "StructuredUniform '" << id << "', index=" << value.index() << std::endl;
 
             std::visit(
                     overloaded{
-                            [&](auto) { std::cout << "StructuredUniform '" << activeInfo.name << "': unsupported variant at index: " << value.index() << std::endl; },
-                            [&](std::unordered_map<std::string, NestedUniformValue> arg) {
+                            [&](const auto&) { std::cout << "StructuredUniform '" << activeInfo.name << "': unsupported variant at index: " << value.index() << std::endl; },
+                            [&](const std::unordered_map<std::string, NestedUniformValue>& arg) {
                                 for (auto& u : seq) {
-                                    NestedUniformValue& v = arg.at(u->id);
+                                    const NestedUniformValue& v = arg.at(u->id);
                                     std::visit(overloaded{
-                                                       [&](auto) { std::cout << "Warning: Unhandled NestedUniformValue!" << std::endl; },
+                                                       [&](const auto&) { std::cout << "Warning: Unhandled NestedUniformValue!" << std::endl; },
                                                        [&](int arg) { u->setValue(arg, textures); },
                                                        [&](float arg) { u->setValue(arg, textures); },
-                                                       [&](Vector2 arg) { u->setValue(arg, textures); },
-                                                       [&](Vector3 arg) { u->setValue(arg, textures); },
-                                                       [&](Color arg) { u->setValue(arg, textures); }},
+                                                       [&](const Vector2& arg) { u->setValue(arg, textures); },
+                                                       [&](const Vector3& arg) { u->setValue(arg, textures); },
+                                                       [&](const Color& arg) { u->setValue(arg, textures); }},
                                                v);
                                 }
                             },
-                            [&](std::vector<std::unordered_map<std::string, NestedUniformValue>*> arg) {
+                            [&](const std::vector<std::unordered_map<std::string, NestedUniformValue>*>& arg) {
                                 for (auto& u : seq) {
                                     int index = std::stoi(u->id);
                                     u->setValue(*arg[index], textures);
@@ -384,34 +400,46 @@ namespace {
         container->map[uniformObject->id] = uniformObject;
     }
 
-    void parseUniform(ActiveUniformInfo& activeInfo, int addr, Container* container) {
+    bool isWordChar(char c) {
+
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
 
-        static std::regex rex(R"(([\w\d_]+)(\])?(\[|\.)?)");
+    // Splits names like "pointLights[0].color" or "boneMatrices[0]" into their path segments,
+    // equivalent to repeatedly matching ([\w\d_]+)(\])?(\[|\.)?
+    void parseUniform(const ActiveUniformInfo& activeInfo, int addr, Container* container, GLInfo* info) {
 
-        const auto path = activeInfo.name;
+        const auto& path = activeInfo.name;
         const auto pathLength = path.size();
 
-        std::sregex_iterator rex_it(path.cbegin(), path.cend(), rex);
-        std::sregex_iterator rex_end;
+        size_t pos = 0;
+        while (true) {
+
+            while (pos < pathLength && !isWordChar(path[pos])) ++pos;
+            if (pos == pathLength) break;
+
+            const auto matchStart = pos;
+            while (pos < pathLength && isWordChar(path[pos])) ++pos;
 
-        while (rex_it != rex_end) {
-            std::smatch match = *rex_it;
+            std::string id = path.substr(matchStart, pos - matchStart);
 
-            const auto matchEnd = match.length();
+            const bool isIndex = pos < pathLength && path[pos] == ']';
+            if (isIndex) ++pos;
 
-            std::string id = match[1];
-            bool isIndex = match[2] == "]";
-            std::string subscript = match[3];
+            char subscript = 0;
+            if (pos < pathLength && (path[pos] == '[' || path[pos] == '.')) subscript = path[pos++];
 
-            if (isIndex) id = std::to_string(std::stoi(id) | 0);
+            const auto matchEnd = pos - matchStart;
 
-            if (!match[3].matched || subscript == "[" && matchEnd + 2 == pathLength) {
+            if (isIndex) id = std::to_string(std::stoi(id));
+
+            if (!subscript || (subscript == '[' && matchEnd + 2 == pathLength)) {
 
                 // bare name or "pure" bottom-level array "[0]" suffix
-                if (!match[3].matched) {
-                    addUniform(container, std::make_shared<SingleUniform>(id, activeInfo, addr));
+                if (!subscript) {
+                    addUniform(container, std::make_shared<SingleUniform>(id, activeInfo, addr, info));
                 } else {
-                    addUniform(container, std::make_shared<PureArrayUniform>(id, activeInfo, addr));
+                    addUniform(container, std::make_shared<PureArrayUniform>(id, activeInfo, addr, info));
                 }
                 break;
 
@@ -423,34 +451,32 @@ namespace {
 
                 container = dynamic_cast<Container*>(container->map.at(id).get());
             }
-
-            ++rex_it;
         }
     }
 
-
 }// namespace
 
 
-GLUniforms::GLUniforms(unsigned int program) {
+GLUniforms::GLUniforms(unsigned int program, GLInfo* info) {
 
     int n{};
     glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &n);
 
     for (int i = 0; i < n; ++i) {
 
-        ActiveUniformInfo info(program, i);
-        GLint addr = glGetUniformLocation(program, info.name.c_str());
+        ActiveUniformInfo activeInfo(program, i);
+        GLint addr = glGetUniformLocation(program, activeInfo.name.c_str());
 
-        parseUniform(info, addr, dynamic_cast<Container*>(this));
+        parseUniform(activeInfo, addr, this, info);
     }
 }
 
 void GLUniforms::setValue(const std::string& name, const UniformValue& value, GLTextures* textures) {
 
-    if (map.count(name)) {
+    auto it = map.find(name);
+    if (it != map.end()) {
 
-        map.at(name)->setValue(value, textures);
+        it->second->setValue(value, textures);
     }
 }
 
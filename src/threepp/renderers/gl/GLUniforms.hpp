@@ -11,6 +11,7 @@
 
 namespace threepp::gl {
 
+    struct GLInfo;
     struct GLTextures;
 
     struct UniformObject {
@@ -34,7 +35,8 @@ namespace threepp::gl {
 
     struct GLUniforms: Container {
 
-        explicit GLUniforms(unsigned int program);
+        // uploads and skipped redundant uploads are counted in info when given
+        explicit GLUniforms(unsigned int program, GLInfo* info = nullptr);
 
         void setValue(const std::string& name, const UniformValue& value, GLTextures* textures = nullptr);
 
@@ -140,7 +140,7 @@ ProgramParameters::ProgramParameters(
     vertexAlphas = material->vertexColors &&
                    object->geometry() &&
                    object->geometry()->hasAttribute("color") &&
-                   object->geometry()->getAttribute<float>("color")->itemSize() == 4;
+                   object->geometry()->getAttribute("color")->itemSize() == 4;
     vertexUvs = true;     // TODO
     uvsVertexOnly = false;// TODO;
 
@@ -1,7 +1,16 @@
 
 #include "threepp/utils/BufferGeometryUtils.hpp"
 
+#include "threepp/core/InterleavedBufferAttribute.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
+#include <map>
+#include <numeric>
 
 using namespace threepp;
 
@@ -54,6 +63,525 @@ namespace {
         return TypedBufferAttribute<T>::create(array, itemSize.value(), normalized.value());
     }
 
+    constexpr auto noVertex = std::numeric_limits<unsigned int>::max();
+
+    // triangle ranges with more triangles than this are optimized as independent chunks in parallel
+    constexpr unsigned int chunkTriangles = 1 << 16;
+
+    template<class F>
+    std::unique_ptr<BufferAttribute> visitTyped(BufferAttribute& attribute, F&& f) {
+
+        switch (attribute.componentType()) {
+            case ComponentType::Float:
+                return f(*attribute.typed<float>());
+            case ComponentType::HalfFloat:
+                return f(*attribute.typed<Float16>());
+            case ComponentType::Byte:
+                return f(*attribute.typed<int8_t>());
+            case ComponentType::UnsignedByte:
+                return f(*attribute.typed<uint8_t>());
+            case ComponentType::Short:
+                return f(*attribute.typed<int16_t>());
+            case ComponentType::UnsignedShort:
+                return f(*attribute.typed<uint16_t>());
+            case ComponentType::Int:
+                return f(*attribute.typed<int32_t>());
+            case ComponentType::UnsignedInt:
+                return f(*attribute.typed<uint32_t>());
+        }
+
+        return nullptr;
+    }
+
+    // new attribute holding the listed vertices of attribute, in order
+    std::unique_ptr<BufferAttribute> gatherVertices(BufferAttribute& attribute, const std::vector<unsigned int>& vertices) {
+
+        auto result = visitTyped(attribute, [&](auto& typed) -> std::unique_ptr<BufferAttribute> {
+            using T = typename std::decay_t<decltype(typed.array())>::value_type;
+
+            const auto& array = typed.array();
+            const auto itemSize = static_cast<size_t>(typed.itemSize());
+
+            std::vector<T> gathered(vertices.size() * itemSize);
+            for (size_t i = 0; i < vertices.size(); i++) {
+
+                std::copy_n(array.begin() + vertices[i] * itemSize, itemSize, gathered.begin() + i * itemSize);
+            }
+
+            return TypedBufferAttribute<T>::create(std::move(gathered), typed.itemSize(), typed.normalized());
+        });
+
+        result->setUsage(attribute.getUsage());
+
+        return result;
+    }
+
+    // sets the listed vertices of every source attribute on target, one task per attribute
+    void gatherAttributes(const std::map<std::string, BufferAttribute*>& sources, const std::vector<unsigned int>& vertices, BufferGeometry& target) {
+
+        std::vector<std::pair<std::string, BufferAttribute*>> attributes(sources.begin(), sources.end());
+
+        std::vector<std::unique_ptr<BufferAttribute>> gathered(attributes.size());
+        utils::parallel_for(size_t(0), attributes.size(), size_t(1), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+
+                gathered[i] = gatherVertices(*attributes[i].second, vertices);
+            }
+        });
+
+        for (size_t i = 0; i < attributes.size(); i++) {
+
+            target.setAttribute(attributes[i].first, std::move(gathered[i]));
+        }
+
+        target.boundingBox = std::nullopt;
+        target.boundingSphere = std::nullopt;
+    }
+
+    // attributes sorted by name, or empty if any cannot be gathered per vertex
+    std::map<std::string, BufferAttribute*> vertexAttributes(const BufferGeometry& geometry, const char* caller) {
+
+        std::map<std::string, BufferAttribute*> attributes;
+
+        const auto& geometryAttributes = geometry.getAttributes();
+        if (!geometryAttributes.count("position")) {
+
+            std::cerr << "THREE.BufferGeometryUtils: ." << caller << "() failed. The geometry has no position attribute." << std::endl;
+            return {};
+        }
+
+        const auto vertexCount = geometryAttributes.at("position")->count();
+
+        for (const auto& [name, attribute] : geometryAttributes) {
+
+            if (dynamic_cast<InterleavedBufferAttribute*>(attribute.get())) {
+
+                std::cerr << "THREE.BufferGeometryUtils: ." << caller << "() failed. Interleaved attributes are not supported." << std::endl;
+                return {};
+            }
+
+            if (attribute->count() < vertexCount) {
+
+                std::cerr << "THREE.BufferGeometryUtils: ." << caller << "() failed. The " << name << " attribute has fewer items than the position attribute." << std::endl;
+                return {};
+            }
+
+            attributes[name] = attribute.get();
+        }
+
+        return attributes;
+    }
+
+    struct IndexRange {
+
+        unsigned int start;
+        unsigned int count;
+    };
+
+    // the index ranges covered by the geometry groups, or the whole index, split into chunks.
+    // Groups may share triangles, e.g. a wireframe group spanning the others, so the groups are cut at
+    // every group start and end: the segments are disjoint and each lies wholly inside or outside every group,
+    // reordering one keeps the triangles of every group in that group
+    std::vector<IndexRange> triangleRanges(const BufferGeometry& geometry, unsigned int indexCount) {
+
+        // coverage changes, +1 at a group start and -1 at its end
+        std::vector<std::pair<unsigned int, int>> bounds;
+        if (geometry.groups.empty()) {
+
+            bounds.emplace_back(0, 1);
+            bounds.emplace_back(indexCount, -1);
+
+        } else {
+
+            for (const auto& group : geometry.groups) {
+
+                const auto start = std::min(static_cast<unsigned int>(std::max(group.start, 0)), indexCount);
+                const auto end = std::min(start + static_cast<unsigned int>(std::max(group.count, 0)), indexCount);
+                if (start == end) continue;
+
+                bounds.emplace_back(start, 1);
+                bounds.emplace_back(end, -1);
+            }
+        }
+
+        std::sort(bounds.begin(), bounds.end());
+
+        std::vector<IndexRange> ranges;
+        int coverage = 0;
+        for (size_t i = 0; i + 1 < bounds.size(); i++) {
+
+            coverage += bounds[i].second;
+
+            const auto start = bounds[i].first;
+            const auto count = bounds[i + 1].first - start;
+            if (coverage == 0 || count < 3) continue;
+
+            const auto triangles = count - count % 3;
+            for (unsigned int offset = 0; offset < triangles; offset += chunkTriangles * 3) {
+
+                ranges.push_back({start + offset, std::min(chunkTriangles * 3, triangles - offset)});
+            }
+        }
+
+        return ranges;
+    }
+
+    // reorders the triangles of every range with f, in parallel as the ranges are disjoint
+    template<class F>
+    void reorderRanges(const std::vector<IndexRange>& ranges, F&& f) {
+
+        utils::parallel_for(size_t(0), ranges.size(), size_t(1), [&](size_t begin, size_t end) {
+            for (auto i = begin; i < end; i++) {
+
+                f(ranges[i]);
+            }
+        });
+    }
+
+    // dense local numbering of the vertices referenced by a range of indices, in first use order
+    struct LocalVertices {
+
+        std::vector<unsigned int> vertices;
+        std::vector<unsigned int> local;
+
+        LocalVertices(const unsigned int* indices, size_t count): local(count) {
+
+            if (count == 0) return;
+
+            const auto [min, max] = std::minmax_element(indices, indices + count);
+            const auto range = static_cast<size_t>(*max - *min) + 1;
+
+            // welded or fetch optimized indices reference a compact id range, use a direct table then
+            if (range <= count * 4) {
+
+                std::vector<unsigned int> table(range, noVertex);
+
+                for (size_t i = 0; i < count; i++) {
+
+                    auto& slot = table[indices[i] - *min];
+                    if (slot == noVertex) {
+
+                        slot = static_cast<unsigned int>(vertices.size());
+                        vertices.push_back(indices[i]);
+                    }
+
+                    local[i] = slot;
+                }
+
+            } else {
+
+                std::unordered_map<unsigned int, unsigned int> table;
+                table.reserve(count);
+
+                for (size_t i = 0; i < count; i++) {
+
+                    auto [it, inserted] = table.try_emplace(indices[i], static_cast<unsigned int>(vertices.size()));
+                    if (inserted) vertices.push_back(indices[i]);
+
+                    local[i] = it->second;
+                }
+            }
+        }
+    };
+
+    // FIFO cache simulation, timestamps are per vertex and a vertex is cached while younger than the cache size
+    struct CacheSimulation {
+
+        unsigned int cacheSize;
+        unsigned int timestamp;
+        std::vector<unsigned int> timestamps;
+
+        CacheSimulation(unsigned int cacheSize, size_t vertexCount)
+            : cacheSize(cacheSize), timestamp(cacheSize + 1), timestamps(vertexCount) {}
+
+        void reset() {
+
+            timestamp += cacheSize + 1;
+        }
+
+        unsigned int update(unsigned int a, unsigned int b, unsigned int c) {
+
+            return miss(a) + miss(b) + miss(c);
+        }
+
+    private:
+        unsigned int miss(unsigned int v) {
+
+            if (timestamp - timestamps[v] > cacheSize) {
+
+                timestamps[v] = timestamp++;
+                return 1;
+            }
+
+            return 0;
+        }
+    };
+
+    // Tom Forsyth, "Linear-Speed Vertex Cache Optimisation"
+    void optimizeTriangleOrder(unsigned int* indices, unsigned int triangleCount, unsigned int cacheSize) {
+
+        if (triangleCount < 2) return;
+
+        const LocalVertices vertices(indices, triangleCount * 3);
+        const auto vertexCount = vertices.vertices.size();
+        const auto& local = vertices.local;
+
+        cacheSize = std::max(cacheSize, 4u);
+
+        std::vector<float> cacheScores(cacheSize);
+        for (unsigned i = 0; i < cacheSize; i++) {
+
+            cacheScores[i] = i < 3 ? 0.75f : std::pow(1.f - static_cast<float>(i - 3) / static_cast<float>(cacheSize - 3), 1.5f);
+        }
+
+        constexpr unsigned int maxValenceScore = 32;
+        std::vector<float> valenceScores(maxValenceScore);
+        for (unsigned i = 1; i < maxValenceScore; i++) {
+
+            valenceScores[i] = 2.f / std::sqrt(static_cast<float>(i));
+        }
+
+        const auto vertexScore = [&](int cachePosition, unsigned int valence) {
+            if (valence == 0) return -1.f;
+
+            float score = cachePosition >= 0 ? cacheScores[cachePosition] : 0.f;
+            score += valence < maxValenceScore ? valenceScores[valence] : 2.f / std::sqrt(static_cast<float>(valence));
+
+            return score;
+        };
+
+        // live triangles per vertex, emitted triangles are swapped out of the vertex's range
+        std::vector<unsigned int> valence(vertexCount);
+        for (auto v : local) valence[v]++;
+
+        std::vector<unsigned int> offsets(vertexCount + 1);
+        for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + valence[v];
+
+        std::vector<unsigned int> adjacency(triangleCount * 3);
+        {
+            std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+            for (unsigned t = 0; t < triangleCount; t++) {
+
+                for (unsigned k = 0; k < 3; k++) adjacency[fill[local[t * 3 + k]]++] = t;
+            }
+        }
+
+        std::vector<int> cachePositions(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (size_t v = 0; v < vertexCount; v++) vertexScores[v] = vertexScore(-1, valence[v]);
+
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<char> emitted(triangleCount);
+        for (unsigned t = 0; t < triangleCount; t++) {
+
+            triangleScores[t] = vertexScores[local[t * 3]] + vertexScores[local[t * 3 + 1]] + vertexScores[local[t * 3 + 2]];
+        }
+
+        std::vector<unsigned int> cache, nextCache;
+        cache.reserve(cacheSize + 3);
+        nextCache.reserve(cacheSize + 3);
+
+        std::vector<unsigned int> result(triangleCount * 3);
+
+        int best = static_cast<int>(std::max_element(triangleScores.begin(), triangleScores.end()) - triangleScores.begin());
+        unsigned int cursor = 0;
+
+        for (unsigned int n = 0; n < triangleCount; n++) {
+
+            if (best < 0) {
+
+                while (emitted[cursor]) cursor++;
+                best = static_cast<int>(cursor);
+            }
+
+            const auto t = static_cast<unsigned int>(best);
+            const unsigned int* tri = &local[t * 3];
+
+            for (unsigned k = 0; k < 3; k++) result[n * 3 + k] = indices[t * 3 + k];
+            emitted[t] = 1;
+
+            nextCache.clear();
+            for (unsigned k = 0; k < 3; k++) {
+
+                const auto v = tri[k];
+
+                auto begin = adjacency.begin() + offsets[v];
+                auto end = begin + valence[v];
+                auto it = std::find(begin, end, t);
+                if (it != end) {
+
+                    std::iter_swap(it, end - 1);
+                    valence[v]--;
+                }
+
+                if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) nextCache.push_back(v);
+            }
+
+            for (auto v : cache) {
+
+                if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+            }
+
+            best = -1;
+            float bestScore = -1;
+
+            for (unsigned i = 0; i < nextCache.size(); i++) {
+
+                const auto v = nextCache[i];
+                cachePositions[v] = i < cacheSize ? static_cast<int>(i) : -1;
+
+                const auto score = vertexScore(cachePositions[v], valence[v]);
+                const auto delta = score - vertexScores[v];
+                vertexScores[v] = score;
+
+                for (auto a = offsets[v], e = offsets[v] + valence[v]; a < e; a++) {
+
+                    const auto adjacent = adjacency[a];
+                    triangleScores[adjacent] += delta;
+
+                    if (i < cacheSize && triangleScores[adjacent] > bestScore) {
+
+                        best = static_cast<int>(adjacent);
+                        bestScore = triangleScores[adjacent];
+                    }
+                }
+            }
+
+            if (nextCache.size() > cacheSize) nextCache.resize(cacheSize);
+            std::swap(cache, nextCache);
+        }
+
+        std::copy(result.begin(), result.end(), indices);
+    }
+
+    // Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw", as in meshoptimizer
+    void optimizeClusterOrder(unsigned int* indices, unsigned int triangleCount, const BufferAttribute& position, float threshold) {
+
+        if (triangleCount < 2) return;
+
+        constexpr unsigned int cacheSize = 16;
+
+        const LocalVertices vertices(indices, triangleCount * 3);
+        const auto& local = vertices.local;
+
+        CacheSimulation cache(cacheSize, vertices.vertices.size());
+
+        // a triangle missing all three vertices usually starts a new patch of the mesh
+
+        std::vector<unsigned int> hardBoundaries;
+        for (unsigned t = 0; t < triangleCount; t++) {
+
+            const auto misses = cache.update(local[t * 3], local[t * 3 + 1], local[t * 3 + 2]);
+            if (t == 0 || misses == 3) hardBoundaries.push_back(t);
+        }
+
+        // split patches further wherever the running miss ratio is within threshold of the patch's
+
+        std::vector<unsigned int> boundaries;
+        for (size_t c = 0; c < hardBoundaries.size(); c++) {
+
+            const auto start = hardBoundaries[c];
+            const auto end = c + 1 < hardBoundaries.size() ? hardBoundaries[c + 1] : triangleCount;
+
+            cache.reset();
+            unsigned int clusterMisses = 0;
+            for (auto t = start; t < end; t++) {
+
+                clusterMisses += cache.update(local[t * 3], local[t * 3 + 1], local[t * 3 + 2]);
+            }
+
+            const auto clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+            boundaries.push_back(start);
+
+            cache.reset();
+            unsigned int runningMisses = 0;
+            unsigned int runningTriangles = 0;
+            for (auto t = start; t < end; t++) {
+
+                runningMisses += cache.update(local[t * 3], local[t * 3 + 1], local[t * 3 + 2]);
+                runningTriangles++;
+
+                if (static_cast<float>(runningMisses) / static_cast<float>(runningTriangles) <= clusterThreshold) {
+
+                    boundaries.push_back(t + 1);
+
+                    cache.reset();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+
+            // the trailing cluster is rarely good on its own, merge it with the previous one
+            if (boundaries.back() != start) boundaries.pop_back();
+        }
+
+        // sort clusters so that the ones facing away from the center are drawn first
+
+        Vector3 meshCenter;
+        Vector3 v;
+        for (auto vertex : vertices.vertices) {
+
+            position.setFromBufferAttribute(v, vertex);
+            meshCenter.add(v);
+        }
+        meshCenter.divideScalar(static_cast<float>(vertices.vertices.size()));
+
+        const auto clusterCount = boundaries.size();
+        std::vector<float> sortKeys(clusterCount);
+
+        Vector3 a, b, c, ab, ac;
+        for (size_t i = 0; i < clusterCount; i++) {
+
+            const auto start = boundaries[i];
+            const auto end = i + 1 < clusterCount ? boundaries[i + 1] : triangleCount;
+
+            Vector3 centroid, normal;
+            float area = 0;
+
+            for (auto t = start; t < end; t++) {
+
+                position.setFromBufferAttribute(a, indices[t * 3]);
+                position.setFromBufferAttribute(b, indices[t * 3 + 1]);
+                position.setFromBufferAttribute(c, indices[t * 3 + 2]);
+
+                ab.subVectors(b, a);
+                ac.subVectors(c, a);
+                ab.cross(ac);
+
+                const auto triangleArea = ab.length();
+
+                centroid.addScaledVector(a.add(b).add(c), triangleArea / 3);
+                normal.add(ab);
+                area += triangleArea;
+            }
+
+            if (area > 0) centroid.divideScalar(area);
+            normal.normalize();
+
+            sortKeys[i] = centroid.sub(meshCenter).dot(normal);
+        }
+
+        std::vector<unsigned int> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](auto lhs, auto rhs) {
+            return sortKeys[lhs] > sortKeys[rhs];
+        });
+
+        std::vector<unsigned int> result;
+        result.reserve(triangleCount * 3);
+
+        for (auto cluster : order) {
+
+            const auto start = boundaries[cluster];
+            const auto end = cluster + 1 < clusterCount ? boundaries[cluster + 1] : triangleCount;
+
+            result.insert(result.end(), indices + start * 3, indices + end * 3);
+        }
+
+        std::copy(result.begin(), result.end(), indices);
+    }
+
 }// namespace
 
 std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector<BufferGeometry*>& geometries, bool useGroups) {
@@ -184,10 +712,303 @@ std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector
     return mergedGeometry;
 }
 
-std::shared_ptr<BufferGeometry> mergeBufferGeometries(const std::vector<std::shared_ptr<BufferGeometry>>& geometries, bool useGroups) {
+std::shared_ptr<BufferGeometry> threepp::mergeBufferGeometries(const std::vector<std::shared_ptr<BufferGeometry>>& geometries, bool useGroups) {
     std::vector<BufferGeometry*> arr;
     for (auto& g : geometries) {
         arr.emplace_back(g.get());
     }
     return mergeBufferGeometries(arr, useGroups);
 }
+
+std::shared_ptr<BufferGeometry> threepp::mergeVertices(const BufferGeometry& geometry, float tolerance) {
+
+    // sorted by name so that the result does not depend on hash map order
+    const auto attributes = vertexAttributes(geometry, "mergeVertices");
+    if (attributes.empty()) return nullptr;
+
+    const auto vertexCount = static_cast<unsigned int>(attributes.at("position")->count());
+
+    // flat list of the welded components, float data is read directly instead of through the virtual accessors
+    struct Component {
+        const BufferAttribute* attribute;
+        const float* floats;
+        int itemSize;
+        int component;
+    };
+
+    std::vector<Component> components;
+    for (const auto& [name, attribute] : attributes) {
+
+        const auto floats = attribute->componentType() == ComponentType::Float ? static_cast<const float*>(attribute->rawData()) : nullptr;
+        for (int c = 0; c < attribute->itemSize(); c++) components.push_back({attribute, floats, attribute->itemSize(), c});
+    }
+
+    const auto scale = tolerance > 0 ? 1.0 / tolerance : 0.0;
+    const auto quantize = [&](const Component& component, unsigned int vertex) {
+        const auto value = static_cast<double>(component.floats
+                                                       ? component.floats[static_cast<size_t>(vertex) * component.itemSize + component.component]
+                                                       : component.attribute->getComponent(vertex, component.component));
+        // adding zero folds -0 into +0
+        return (tolerance > 0 ? std::floor(value * scale + 0.5) : value) + 0.0;
+    };
+
+    const auto equal = [&](unsigned int a, unsigned int b) {
+        for (const auto& component : components) {
+
+            if (quantize(component, a) != quantize(component, b)) return false;
+        }
+
+        return true;
+    };
+
+    // spatial hash of the quantized attribute values
+
+    std::vector<uint64_t> hashes(vertexCount);
+    utils::parallel_for(0u, vertexCount, 4096u, [&](unsigned int begin, unsigned int end) {
+        for (auto v = begin; v < end; v++) {
+
+            uint64_t hash = 14695981039346656037ull;
+            for (const auto& component : components) {
+
+                const auto value = quantize(component, v);
+
+                uint64_t bits;
+                std::memcpy(&bits, &value, sizeof(bits));
+                hash = (hash ^ bits) * 1099511628211ull;
+            }
+
+            hashes[v] = hash ^ (hash >> 29);
+        }
+    });
+
+    // vertices are bucketed into shards by hash, every shard finds the lowest equal vertex independently
+
+    const unsigned int shardCount = vertexCount > 65536 ? 64 : 1;
+
+    std::vector<unsigned int> shardOffsets(shardCount + 1);
+    for (auto hash : hashes) shardOffsets[hash % shardCount + 1]++;
+    std::partial_sum(shardOffsets.begin(), shardOffsets.end(), shardOffsets.begin());
+
+    std::vector<unsigned int> shardVertices(vertexCount);
+    {
+        std::vector<unsigned int> fill(shardOffsets.begin(), shardOffsets.end() - 1);
+        for (unsigned int v = 0; v < vertexCount; v++) shardVertices[fill[hashes[v] % shardCount]++] = v;
+    }
+
+    std::vector<unsigned int> representatives(vertexCount);
+
+    utils::parallel_for(0u, shardCount, 1u, [&](unsigned int begin, unsigned int end) {
+        for (auto shard = begin; shard < end; shard++) {
+
+            const auto count = shardOffsets[shard + 1] - shardOffsets[shard];
+
+            // open addressing over vertex ids, probed with the hash bits not used for sharding
+            size_t tableSize = 1;
+            while (tableSize < count * 2) tableSize *= 2;
+            const auto mask = tableSize - 1;
+
+            std::vector<unsigned int> table(tableSize, noVertex);
+
+            for (auto i = shardOffsets[shard]; i < shardOffsets[shard + 1]; i++) {
+
+                const auto v = shardVertices[i];
+                const auto hash = hashes[v];
+
+                representatives[v] = v;
+
+                for (auto slot = static_cast<size_t>(hash >> 8) & mask;; slot = (slot + 1) & mask) {
+
+                    const auto candidate = table[slot];
+
+                    if (candidate == noVertex) {
+
+                        table[slot] = v;
+                        break;
+                    }
+
+                    if (hashes[candidate] == hash && equal(candidate, v)) {
+
+                        representatives[v] = candidate;
+                        break;
+                    }
+                }
+            }
+        }
+    });
+
+    // number the welded vertices in the order the triangles reference them
+
+    const auto index = geometry.getIndex();
+    const auto indexCount = index ? static_cast<unsigned int>(index->count()) : vertexCount;
+
+    std::vector<unsigned int> remap(vertexCount, noVertex);
+    std::vector<unsigned int> vertices;
+    std::vector<unsigned int> newIndex(indexCount);
+
+    for (unsigned int i = 0; i < indexCount; i++) {
+
+        const auto source = index ? index->getX(i) : i;
+
+        if (source >= vertexCount) {
+
+            std::cerr << "THREE.BufferGeometryUtils: .mergeVertices() failed. The index references a missing vertex." << std::endl;
+            return nullptr;
+        }
+
+        const auto representative = representatives[source];
+        if (remap[representative] == noVertex) {
+
+            remap[representative] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(representative);
+        }
+
+        newIndex[i] = remap[representative];
+    }
+
+    auto result = BufferGeometry::create();
+    result->name = geometry.name;
+
+    gatherAttributes(attributes, vertices, *result);
+
+    result->setIndex(std::move(newIndex));
+
+    for (const auto& group : geometry.groups) {
+
+        result->addGroup(group.start, group.count, group.materialIndex);
+    }
+
+    result->drawRange = geometry.drawRange;
+
+    return result;
+}
+
+void threepp::optimizeVertexCache(BufferGeometry& geometry, unsigned int cacheSize) {
+
+    const auto index = geometry.getIndex();
+
+    if (!index) {
+
+        std::cerr << "THREE.BufferGeometryUtils: .optimizeVertexCache() requires an indexed geometry." << std::endl;
+        return;
+    }
+
+    auto& indices = index->array();
+    reorderRanges(triangleRanges(geometry, static_cast<unsigned int>(indices.size())), [&](const IndexRange& range) {
+        optimizeTriangleOrder(indices.data() + range.start, range.count / 3, cacheSize);
+    });
+
+    index->needsUpdate();
+}
+
+void threepp::optimizeOverdraw(BufferGeometry& geometry, float threshold) {
+
+    const auto index = geometry.getIndex();
+    const auto position = geometry.getAttribute("position");
+
+    if (!index || !position) {
+
+        std::cerr << "THREE.BufferGeometryUtils: .optimizeOverdraw() requires an indexed geometry with a position attribute." << std::endl;
+        return;
+    }
+
+    auto& indices = index->array();
+    reorderRanges(triangleRanges(geometry, static_cast<unsigned int>(indices.size())), [&](const IndexRange& range) {
+        optimizeClusterOrder(indices.data() + range.start, range.count / 3, *position, threshold);
+    });
+
+    index->needsUpdate();
+}
+
+void threepp::optimizeVertexFetch(BufferGeometry& geometry) {
+
+    const auto index = geometry.getIndex();
+    if (!index) return;
+
+    const auto attributes = vertexAttributes(geometry, "optimizeVertexFetch");
+    if (attributes.empty()) return;
+
+    const auto vertexCount = attributes.at("position")->count();
+
+    auto& indices = index->array();
+
+    // validate before remapping in place
+    if (std::any_of(indices.begin(), indices.end(), [&](auto i) { return i >= static_cast<unsigned int>(vertexCount); })) {
+
+        std::cerr << "THREE.BufferGeometryUtils: .optimizeVertexFetch() failed. The index references a missing vertex." << std::endl;
+        return;
+    }
+
+    std::vector<unsigned int> remap(vertexCount, noVertex);
+    std::vector<unsigned int> vertices;
+    vertices.reserve(vertexCount);
+
+    for (auto& i : indices) {
+
+        if (remap[i] == noVertex) {
+
+            remap[i] = static_cast<unsigned int>(vertices.size());
+            vertices.push_back(i);
+        }
+
+        i = remap[i];
+    }
+
+    gatherAttributes(attributes, vertices, geometry);
+
+    index->needsUpdate();
+}
+
+float threepp::computeACMR(const BufferGeometry& geometry, unsigned int cacheSize) {
+
+    const auto index = geometry.getIndex();
+    if (!index) return 3;
+
+    const auto triangleCount = static_cast<unsigned int>(index->count() / 3);
+    if (triangleCount == 0) return 0;
+
+    unsigned int vertexCount = 0;
+    for (int i = 0; i < index->count(); i++) vertexCount = std::max(vertexCount, index->getX(i) + 1);
+
+    CacheSimulation cache(cacheSize, vertexCount);
+
+    unsigned int misses = 0;
+    for (unsigned t = 0; t < triangleCount; t++) {
+
+        misses += cache.update(index->getX(t * 3), index->getX(t * 3 + 1), index->getX(t * 3 + 2));
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+std::shared_ptr<BufferGeometry> threepp::optimizeGeometry(const BufferGeometry& geometry, const OptimizeGeometryOptions& options) {
+
+    std::shared_ptr<BufferGeometry> result;
+
+    if (options.tolerance >= 0) {
+
+        result = mergeVertices(geometry, options.tolerance);
+        if (!result) return nullptr;
+
+    } else {
+
+        result = geometry.clone();
+
+        if (!result->hasIndex() && result->hasAttribute("position")) {
+
+            std::vector<unsigned int> index(result->getAttribute("position")->count());
+            std::iota(index.begin(), index.end(), 0);
+            result->setIndex(std::move(index));
+        }
+    }
+
+    optimizeVertexCache(*result, options.cacheSize);
+
+    if (options.overdrawThreshold >= 1) {
+
+        optimizeOverdraw(*result, options.overdrawThreshold);
+    }
+
+    optimizeVertexFetch(*result);
+
+    return result;
+}
@@ -0,0 +1,109 @@
+
+#ifndef THREEPP_MEMORYMAPPEDFILE_HPP
+#define THREEPP_MEMORYMAPPEDFILE_HPP
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace threepp::utils {
+
+    // Read-only view of a whole file. Uses a memory mapping where available
+    // and falls back to reading the file into memory.
+    class MemoryMappedFile {
+
+    public:
+        explicit MemoryMappedFile(const std::filesystem::path& path) {
+
+#ifdef _WIN32
+            file_ = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (file_ != INVALID_HANDLE_VALUE) {
+                LARGE_INTEGER size;
+                if (GetFileSizeEx(file_, &size) && size.QuadPart > 0) {
+                    mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mapping_) {
+                        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+                        if (data_) size_ = static_cast<size_t>(size.QuadPart);
+                    }
+                }
+            }
+#else
+            fd_ = ::open(path.string().c_str(), O_RDONLY);
+            if (fd_ != -1) {
+                struct stat st {};
+                if (::fstat(fd_, &st) == 0 && st.st_size > 0) {
+                    void* ptr = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+                    if (ptr != MAP_FAILED) {
+                        ::madvise(ptr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+                        data_ = static_cast<const char*>(ptr);
+                        size_ = static_cast<size_t>(st.st_size);
+                    }
+                }
+            }
+#endif
+
+            if (!data_) {
+
+                std::ifstream in(path, std::ios::binary | std::ios::ate);
+                if (in) {
+                    buffer_.resize(static_cast<size_t>(in.tellg()));
+                    in.seekg(0);
+                    in.read(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+                }
+                size_ = buffer_.size();
+            }
+        }
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+        [[nodiscard]] const char* data() const {
+
+            return data_ ? data_ : buffer_.data();
+        }
+
+        [[nodiscard]] size_t size() const {
+
+            return size_;
+        }
+
+        ~MemoryMappedFile() {
+
+#ifdef _WIN32
+            if (data_) UnmapViewOfFile(data_);
+            if (mapping_) CloseHandle(mapping_);
+            if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+            if (data_) ::munmap(const_cast<char*>(data_), size_);
+            if (fd_ != -1) ::close(fd_);
+#endif
+        }
+
+    private:
+        const char* data_ = nullptr;
+        size_t size_ = 0;
+        std::vector<char> buffer_;
+
+#ifdef _WIN32
+        HANDLE file_ = INVALID_HANDLE_VALUE;
+        HANDLE mapping_ = nullptr;
+#else
+        int fd_ = -1;
+#endif
+    };
+
+}// namespace threepp::utils
+
+#endif//THREEPP_MEMORYMAPPEDFILE_HPP
@@ -0,0 +1,839 @@
+
+#include "threepp/utils/MeshSimplifier.hpp"
+
+#include "threepp/objects/LOD.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/utils/BufferGeometryUtils.hpp"
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <numeric>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr auto noVertex = std::numeric_limits<unsigned int>::max();
+
+    // weight of the planes through border and seam edges relative to the triangle planes
+    constexpr double edgeWeight = 10;
+
+    enum class VertexKind : unsigned char {
+        Manifold,// interior vertex, collapses in any direction
+        Border,  // on a single open boundary, collapses along it
+        Locked   // complex topology, material boundary or locked border
+    };
+
+    // symmetric 4x4 plane quadric and the weight it was accumulated with
+    struct Quadric {
+
+        double a00 = 0, a11 = 0, a22 = 0;
+        double a10 = 0, a20 = 0, a21 = 0;
+        double b0 = 0, b1 = 0, b2 = 0;
+        double c = 0;
+        double w = 0;
+
+        static Quadric fromPlane(double a, double b, double c, double d, double w) {
+
+            Quadric q;
+            q.a00 = a * a * w;
+            q.a11 = b * b * w;
+            q.a22 = c * c * w;
+            q.a10 = a * b * w;
+            q.a20 = a * c * w;
+            q.a21 = b * c * w;
+            q.b0 = a * d * w;
+            q.b1 = b * d * w;
+            q.b2 = c * d * w;
+            q.c = d * d * w;
+            q.w = w;
+
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& q) {
+
+            a00 += q.a00;
+            a11 += q.a11;
+            a22 += q.a22;
+            a10 += q.a10;
+            a20 += q.a20;
+            a21 += q.a21;
+            b0 += q.b0;
+            b1 += q.b1;
+            b2 += q.b2;
+            c += q.c;
+            w += q.w;
+
+            return *this;
+        }
+
+        // weighted mean squared distance of p to the accumulated planes
+        [[nodiscard]] double error(const float* p) const {
+
+            const double x = p[0], y = p[1], z = p[2];
+
+            const auto r = a00 * x * x + a11 * y * y + a22 * z * z +
+                           2 * (a10 * x * y + a20 * x * z + a21 * y * z) +
+                           2 * (b0 * x + b1 * y + b2 * z) + c;
+
+            return w > 0 ? std::abs(r) / w : std::abs(r);
+        }
+    };
+
+    struct Candidate {
+
+        unsigned int v0;// group collapsed
+        unsigned int v1;// group kept
+        float error;
+        float key;
+    };
+
+    // Vertices with the same position form a group, linked through a ring of wedges.
+    // Groups are identified by their lowest vertex, collapses move every wedge of a group
+    // onto the wedge of the target group it shares a triangle with, so seams stay seams.
+    class Simplifier {
+
+    public:
+        Simplifier(const BufferGeometry& geometry, const SimplifyOptions& options)
+            : options_(options) {
+
+            const auto position = geometry.getAttribute("position");
+            vertexCount_ = static_cast<unsigned int>(position->count());
+
+            readPositions(*position);
+            if (options.attributeWeight > 0) readAttributes(geometry);
+            buildGroups();
+
+            const auto index = geometry.getIndex();
+            const auto indexCount = static_cast<unsigned int>(index->count());
+
+            std::vector<int> triangleGroups(indexCount / 3, 0);
+            if (!geometry.groups.empty()) {
+
+                std::fill(triangleGroups.begin(), triangleGroups.end(), -1);
+                for (size_t g = 0; g < geometry.groups.size(); g++) {
+
+                    const auto& group = geometry.groups[g];
+                    const auto start = std::max(group.start, 0) / 3;
+                    const auto end = std::min(static_cast<long long>(group.start) + group.count, static_cast<long long>(indexCount)) / 3;
+                    for (auto t = start; t < end; t++) triangleGroups[t] = static_cast<int>(g);
+                }
+            }
+
+            indices_.reserve(indexCount);
+            for (unsigned int t = 0; t < indexCount / 3; t++) {
+
+                const auto a = index->getX(t * 3), b = index->getX(t * 3 + 1), c = index->getX(t * 3 + 2);
+
+                // triangles outside every group are not drawn and degenerate ones carry no surface
+                if (triangleGroups[t] < 0 || std::max({a, b, c}) >= vertexCount_) continue;
+                if (group_[a] == group_[b] || group_[a] == group_[c] || group_[b] == group_[c]) continue;
+
+                indices_.insert(indices_.end(), {a, b, c});
+                triangleGroups_.push_back(triangleGroups[t]);
+            }
+        }
+
+        // collapses edges until the target is reached, returns the largest error relative to the mesh extent
+        float run() {
+
+            const auto target = static_cast<size_t>(std::floor(static_cast<double>(triangleCount()) * std::clamp(options_.targetRatio, 0.f, 1.f)));
+            const auto errorLimit = static_cast<double>(options_.targetError) * options_.targetError;
+
+            double maxError = 0;
+            bool first = true;
+
+            while (triangleCount() > target) {
+
+                buildAdjacency();
+                classifyVertices();
+
+                if (first) {
+
+                    computeQuadrics();
+                    first = false;
+                }
+
+                auto candidates = collectCandidates(errorLimit);
+                if (candidates.empty()) break;
+
+                const auto byKey = [](const Candidate& lhs, const Candidate& rhs) {
+                    return lhs.key < rhs.key;
+                };
+
+                // an edge collapse removes two triangles, stop a pass early so that collapses
+                // later in the sorted order get re-evaluated against the updated mesh
+                const auto triangleGoal = triangleCount() - target;
+                const auto goal = candidates.begin() + static_cast<std::ptrdiff_t>(std::min(candidates.size() - 1, triangleGoal / 2 * 3 / 2));
+
+                // only the candidates up to the error goal need to be in order
+                std::nth_element(candidates.begin(), goal, candidates.end(), byKey);
+                std::sort(candidates.begin(), goal + 1, byKey);
+
+                const auto errorGoal = goal->key;
+
+                auto collapses = performCollapses(candidates.begin(), goal + 1, triangleGoal, errorGoal, maxError);
+                if (collapses == 0) {
+
+                    std::sort(goal + 1, candidates.end(), byKey);
+                    collapses = performCollapses(goal + 1, candidates.end(), triangleGoal, errorGoal, maxError);
+                }
+
+                if (collapses == 0) break;
+
+                compactTriangles();
+            }
+
+            return static_cast<float>(std::sqrt(maxError));
+        }
+
+        [[nodiscard]] size_t triangleCount() const {
+
+            return indices_.size() / 3;
+        }
+
+        [[nodiscard]] const std::vector<unsigned int>& indices() const {
+
+            return indices_;
+        }
+
+        [[nodiscard]] const std::vector<int>& triangleGroups() const {
+
+            return triangleGroups_;
+        }
+
+    private:
+        SimplifyOptions options_;
+        unsigned int vertexCount_ = 0;
+
+        std::vector<float> positions_;
+        std::vector<float> attributes_;
+        size_t attributeStride_ = 0;
+
+        std::vector<unsigned int> group_;
+        std::vector<unsigned int> wedge_;
+
+        std::vector<unsigned int> indices_;
+        std::vector<int> triangleGroups_;
+
+        // triangles around every vertex
+        std::vector<unsigned int> offsets_;
+        std::vector<unsigned int> adjacency_;
+
+        std::vector<VertexKind> kinds_;
+        std::vector<Quadric> quadrics_;
+        std::vector<unsigned int> remap_;
+
+        template<class F>
+        void forEachWedge(unsigned int group, F&& f) const {
+
+            auto w = group;
+            do {
+                f(w);
+                w = wedge_[w];
+            } while (w != group);
+        }
+
+        template<class F>
+        void forEachTriangle(unsigned int vertex, F&& f) const {
+
+            for (auto a = offsets_[vertex]; a < offsets_[vertex + 1]; a++) {
+
+                const auto t = adjacency_[a];
+                const auto k = indices_[t * 3] == vertex ? 0u : indices_[t * 3 + 1] == vertex ? 1u
+                                                                                               : 2u;
+                f(t, k);
+            }
+        }
+
+        [[nodiscard]] const float* position(unsigned int vertex) const {
+
+            return &positions_[static_cast<size_t>(vertex) * 3];
+        }
+
+        // positions are scaled into the unit cube so that errors are relative to the mesh extent
+        void readPositions(const BufferAttribute& position) {
+
+            positions_.resize(static_cast<size_t>(vertexCount_) * 3);
+
+            float min[3]{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+            float max[3]{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+            for (unsigned int v = 0; v < vertexCount_; v++) {
+
+                for (int c = 0; c < 3; c++) {
+
+                    const auto value = position.getComponent(v, c);
+                    positions_[v * 3 + c] = value;
+                    min[c] = std::min(min[c], value);
+                    max[c] = std::max(max[c], value);
+                }
+            }
+
+            auto extent = std::max({max[0] - min[0], max[1] - min[1], max[2] - min[2]});
+            if (!(extent > 0)) extent = 1;
+
+            const auto scale = 1.f / extent;
+            for (unsigned int v = 0; v < vertexCount_; v++) {
+
+                for (int c = 0; c < 3; c++) positions_[v * 3 + c] = (positions_[v * 3 + c] - min[c]) * scale;
+            }
+        }
+
+        void readAttributes(const BufferGeometry& geometry) {
+
+            std::vector<BufferAttribute*> attributes;
+            for (const auto& [name, attribute] : geometry.getAttributes()) {
+
+                if (name == "position" || static_cast<unsigned int>(attribute->count()) < vertexCount_) continue;
+
+                attributes.push_back(attribute.get());
+                attributeStride_ += attribute->itemSize();
+            }
+
+            attributes_.resize(attributeStride_ * vertexCount_);
+
+            utils::parallel_for(0u, vertexCount_, 4096u, [&](unsigned int begin, unsigned int end) {
+                for (auto v = begin; v < end; v++) {
+
+                    auto* values = &attributes_[v * attributeStride_];
+                    for (const auto attribute : attributes) {
+
+                        for (int c = 0; c < attribute->itemSize(); c++) *values++ = attribute->getComponent(v, c);
+                    }
+                }
+            });
+        }
+
+        // rings of vertices sharing a position, through an open addressing table over the position bits
+        void buildGroups() {
+
+            group_.resize(vertexCount_);
+            wedge_.resize(vertexCount_);
+
+            size_t tableSize = 1;
+            while (tableSize < static_cast<size_t>(vertexCount_) * 2) tableSize *= 2;
+            const auto mask = tableSize - 1;
+
+            std::vector<unsigned int> table(tableSize, noVertex);
+
+            const auto hash = [&](unsigned int v) {
+                uint32_t bits[3];
+                std::memcpy(bits, position(v), sizeof(bits));
+
+                return static_cast<size_t>((bits[0] * 73856093u) ^ (bits[1] * 19349663u) ^ (bits[2] * 83492791u));
+            };
+
+            const auto equal = [&](unsigned int a, unsigned int b) {
+                return std::equal(position(a), position(a) + 3, position(b));
+            };
+
+            for (unsigned int v = 0; v < vertexCount_; v++) {
+
+                group_[v] = v;
+                wedge_[v] = v;
+
+                for (auto slot = hash(v) & mask;; slot = (slot + 1) & mask) {
+
+                    const auto candidate = table[slot];
+
+                    if (candidate == noVertex) {
+
+                        table[slot] = v;
+                        break;
+                    }
+
+                    if (equal(candidate, v)) {
+
+                        group_[v] = candidate;
+                        wedge_[v] = wedge_[candidate];
+                        wedge_[candidate] = v;
+                        break;
+                    }
+                }
+            }
+        }
+
+        void buildAdjacency() {
+
+            offsets_.assign(vertexCount_ + 1, 0);
+            for (auto v : indices_) offsets_[v + 1]++;
+            std::partial_sum(offsets_.begin(), offsets_.end(), offsets_.begin());
+
+            adjacency_.resize(indices_.size());
+
+            std::vector<unsigned int> fill(offsets_.begin(), offsets_.end() - 1);
+            for (unsigned int i = 0; i < indices_.size(); i++) {
+
+                adjacency_[fill[indices_[i]]++] = i / 3;
+            }
+        }
+
+        // whether a triangle around group a has the directed edge a -> b
+        [[nodiscard]] bool hasEdge(unsigned int a, unsigned int b) const {
+
+            bool found = false;
+            forEachWedge(a, [&](unsigned int w) {
+                if (found) return;
+
+                forEachTriangle(w, [&](unsigned int t, unsigned int k) {
+                    if (group_[indices_[t * 3 + (k + 1) % 3]] == b) found = true;
+                });
+            });
+
+            return found;
+        }
+
+        // whether a triangle around vertex a has the directed edge a -> b
+        [[nodiscard]] bool hasVertexEdge(unsigned int a, unsigned int b) const {
+
+            bool found = false;
+            forEachTriangle(a, [&](unsigned int t, unsigned int k) {
+                if (indices_[t * 3 + (k + 1) % 3] == b) found = true;
+            });
+
+            return found;
+        }
+
+        void classifyVertices() {
+
+            kinds_.resize(vertexCount_);
+
+            utils::parallel_for(0u, vertexCount_, 4096u, [&](unsigned int begin, unsigned int end) {
+                std::vector<unsigned int> outgoing;
+
+                for (auto g = begin; g < end; g++) {
+
+                    if (group_[g] != g) continue;
+
+                    outgoing.clear();
+                    unsigned int openIn = 0, openOut = 0;
+                    int material = -1;
+                    bool locked = false;
+
+                    forEachWedge(g, [&](unsigned int w) {
+                        forEachTriangle(w, [&](unsigned int t, unsigned int k) {
+                            const auto next = group_[indices_[t * 3 + (k + 1) % 3]];
+                            const auto prev = group_[indices_[t * 3 + (k + 2) % 3]];
+
+                            if (material < 0) material = triangleGroups_[t];
+                            if (material != triangleGroups_[t]) locked = true;
+
+                            if (!hasEdge(next, g)) openOut++;
+                            if (!hasEdge(g, prev)) openIn++;
+
+                            outgoing.push_back(next);
+                        });
+                    });
+
+                    // an edge used twice in the same direction is non-manifold
+                    std::sort(outgoing.begin(), outgoing.end());
+                    if (std::adjacent_find(outgoing.begin(), outgoing.end()) != outgoing.end()) locked = true;
+
+                    auto kind = VertexKind::Locked;
+                    if (!locked && !outgoing.empty()) {
+
+                        if (openIn == 0 && openOut == 0) {
+
+                            kind = VertexKind::Manifold;
+
+                        } else if (openIn == 1 && openOut == 1 && !options_.lockBorder) {
+
+                            kind = VertexKind::Border;
+                        }
+                    }
+
+                    kinds_[g] = kind;
+                }
+            });
+        }
+
+        [[nodiscard]] Quadric triangleQuadric(unsigned int t) const {
+
+            const auto p0 = position(indices_[t * 3]);
+            const auto p1 = position(indices_[t * 3 + 1]);
+            const auto p2 = position(indices_[t * 3 + 2]);
+
+            const double e1[3]{p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            const double e2[3]{p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+
+            double n[3]{e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+            const auto area = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            if (area == 0) return {};
+
+            for (auto& c : n) c /= area;
+
+            return Quadric::fromPlane(n[0], n[1], n[2], -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]), area);
+        }
+
+        // plane through the edge a -> b perpendicular to the triangle, keeps borders and seams in place
+        [[nodiscard]] Quadric edgeQuadric(unsigned int a, unsigned int b, unsigned int c) const {
+
+            const auto pa = position(a);
+            const auto pb = position(b);
+            const auto pc = position(c);
+
+            double edge[3]{pb[0] - pa[0], pb[1] - pa[1], pb[2] - pa[2]};
+            const auto length = std::sqrt(edge[0] * edge[0] + edge[1] * edge[1] + edge[2] * edge[2]);
+            if (length == 0) return {};
+
+            for (auto& e : edge) e /= length;
+
+            const double toC[3]{pc[0] - pa[0], pc[1] - pa[1], pc[2] - pa[2]};
+            const auto along = edge[0] * toC[0] + edge[1] * toC[1] + edge[2] * toC[2];
+
+            double perpendicular[3]{toC[0] - edge[0] * along, toC[1] - edge[1] * along, toC[2] - edge[2] * along};
+            const auto distance = std::sqrt(perpendicular[0] * perpendicular[0] + perpendicular[1] * perpendicular[1] + perpendicular[2] * perpendicular[2]);
+            if (distance == 0) return {};
+
+            for (auto& p : perpendicular) p /= distance;
+
+            const auto d = -(perpendicular[0] * pa[0] + perpendicular[1] * pa[1] + perpendicular[2] * pa[2]);
+
+            return Quadric::fromPlane(perpendicular[0], perpendicular[1], perpendicular[2], d, length * edgeWeight);
+        }
+
+        void computeQuadrics() {
+
+            quadrics_.assign(vertexCount_, {});
+
+            utils::parallel_for(0u, vertexCount_, 4096u, [&](unsigned int begin, unsigned int end) {
+                for (auto g = begin; g < end; g++) {
+
+                    if (group_[g] != g) continue;
+
+                    auto& quadric = quadrics_[g];
+
+                    forEachWedge(g, [&](unsigned int w) {
+                        forEachTriangle(w, [&](unsigned int t, unsigned int k) {
+                            const auto next = indices_[t * 3 + (k + 1) % 3];
+                            const auto prev = indices_[t * 3 + (k + 2) % 3];
+
+                            quadric += triangleQuadric(t);
+
+                            // edges without a matching opposite vertex edge are border or attribute seam edges
+                            if (!hasVertexEdge(next, w)) quadric += edgeQuadric(w, next, prev);
+                            if (!hasVertexEdge(w, prev)) quadric += edgeQuadric(prev, w, next);
+                        });
+                    });
+                }
+            });
+        }
+
+        // the vertex of group g1 that shares a triangle with vertex w, noVertex if none or several do
+        [[nodiscard]] unsigned int wedgeTarget(unsigned int w, unsigned int g1) const {
+
+            auto target = noVertex;
+            bool ambiguous = false;
+
+            forEachTriangle(w, [&](unsigned int t, unsigned int) {
+                for (unsigned int k = 0; k < 3; k++) {
+
+                    const auto v = remap_.empty() ? indices_[t * 3 + k] : remap_[indices_[t * 3 + k]];
+                    if (group_[v] != g1) continue;
+
+                    if (target == noVertex) {
+
+                        target = v;
+
+                    } else if (target != v) {
+
+                        ambiguous = true;
+                    }
+                }
+            });
+
+            return ambiguous ? noVertex : target;
+        }
+
+        // geometric error and ordering key of collapsing group g0 onto group g1, infinite if not allowed
+        [[nodiscard]] std::pair<double, double> collapseCost(unsigned int g0, unsigned int g1) const {
+
+            constexpr auto infinity = std::numeric_limits<double>::infinity();
+
+            const auto kind = kinds_[g0];
+            if (kind == VertexKind::Locked) return {infinity, infinity};
+
+            // border vertices slide along the border only
+            if (kind == VertexKind::Border && hasEdge(g0, g1) && hasEdge(g1, g0)) return {infinity, infinity};
+
+            double attributeError = 0;
+            bool allowed = true;
+
+            forEachWedge(g0, [&](unsigned int w) {
+                if (!allowed || offsets_[w] == offsets_[w + 1]) return;
+
+                const auto target = wedgeTarget(w, g1);
+                if (target == noVertex) {
+
+                    allowed = false;
+                    return;
+                }
+
+                if (attributeStride_ == 0) return;
+
+                const auto* a = &attributes_[w * attributeStride_];
+                const auto* b = &attributes_[target * attributeStride_];
+                for (size_t i = 0; i < attributeStride_; i++) attributeError += (a[i] - b[i]) * (a[i] - b[i]);
+            });
+
+            if (!allowed) return {infinity, infinity};
+
+            const auto error = quadrics_[g0].error(position(g1));
+
+            return {error, error + options_.attributeWeight * attributeError};
+        }
+
+        std::vector<Candidate> collectCandidates(double errorLimit) const {
+
+            const auto count = triangleCount();
+
+            std::vector<Candidate> candidates(count * 3, {noVertex, noVertex, 0, 0});
+
+            utils::parallel_for(size_t(0), count, size_t(4096), [&](size_t begin, size_t end) {
+                for (auto t = begin; t < end; t++) {
+
+                    for (unsigned int e = 0; e < 3; e++) {
+
+                        const auto a = group_[indices_[t * 3 + e]];
+                        const auto b = group_[indices_[t * 3 + (e + 1) % 3]];
+
+                        // interior edges are seen from both of their triangles, keep one
+                        if (a > b && hasEdge(b, a)) continue;
+
+                        const auto [errorAB, keyAB] = collapseCost(a, b);
+                        const auto [errorBA, keyBA] = collapseCost(b, a);
+
+                        auto& candidate = candidates[t * 3 + e];
+                        if (keyAB <= keyBA && errorAB <= errorLimit) {
+
+                            candidate = {a, b, static_cast<float>(errorAB), static_cast<float>(keyAB)};
+
+                        } else if (errorBA <= errorLimit) {
+
+                            candidate = {b, a, static_cast<float>(errorBA), static_cast<float>(keyBA)};
+
+                        } else if (errorAB <= errorLimit) {
+
+                            candidate = {a, b, static_cast<float>(errorAB), static_cast<float>(keyAB)};
+                        }
+                    }
+                }
+            });
+
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [](const Candidate& c) {
+                                 return c.v0 == noVertex;
+                             }),
+                             candidates.end());
+
+            return candidates;
+        }
+
+        // whether moving group g0 onto g1 flips a remaining triangle, counts the triangles it removes
+        [[nodiscard]] bool hasTriangleFlips(unsigned int g0, unsigned int g1, size_t& removed) const {
+
+            const auto target = position(g1);
+            bool flips = false;
+
+            forEachWedge(g0, [&](unsigned int w) {
+                forEachTriangle(w, [&](unsigned int t, unsigned int k) {
+                    if (flips) return;
+
+                    const unsigned int v[3]{remap_[indices_[t * 3]], remap_[indices_[t * 3 + 1]], remap_[indices_[t * 3 + 2]]};
+                    const unsigned int g[3]{group_[v[0]], group_[v[1]], group_[v[2]]};
+
+                    // already removed by an earlier collapse of this pass
+                    if (g[0] == g[1] || g[0] == g[2] || g[1] == g[2]) return;
+
+                    if (g[0] == g1 || g[1] == g1 || g[2] == g1) {
+
+                        removed++;
+                        return;
+                    }
+
+                    const auto p0 = position(v[k]);
+                    const auto p1 = position(v[(k + 1) % 3]);
+                    const auto p2 = position(v[(k + 2) % 3]);
+
+                    const float e1[3]{p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                    const float e2[3]{p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                    const float f1[3]{p1[0] - target[0], p1[1] - target[1], p1[2] - target[2]};
+                    const float f2[3]{p2[0] - target[0], p2[1] - target[1], p2[2] - target[2]};
+
+                    const float n0[3]{e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+                    const float n1[3]{f1[1] * f2[2] - f1[2] * f2[1], f1[2] * f2[0] - f1[0] * f2[2], f1[0] * f2[1] - f1[1] * f2[0]};
+
+                    const auto dot = n0[0] * n1[0] + n0[1] * n1[1] + n0[2] * n1[2];
+                    const auto lengths = std::sqrt((n0[0] * n0[0] + n0[1] * n0[1] + n0[2] * n0[2]) * (n1[0] * n1[0] + n1[1] * n1[1] + n1[2] * n1[2]));
+
+                    // reject normals turning by more than ~85 degrees, including collapses to zero area
+                    if (dot <= 0.1f * lengths) flips = true;
+                });
+            });
+
+            return flips;
+        }
+
+        size_t performCollapses(std::vector<Candidate>::const_iterator first, std::vector<Candidate>::const_iterator last,
+                                size_t triangleGoal, float errorGoal, double& maxError) {
+
+            remap_.resize(vertexCount_);
+            std::iota(remap_.begin(), remap_.end(), 0);
+
+            // a group takes part in at most one collapse per pass, which keeps the costs above exact
+            std::vector<char> locked(vertexCount_);
+
+            size_t collapses = 0;
+            size_t removed = 0;
+
+            for (auto it = first; it != last; ++it) {
+
+                const auto& candidate = *it;
+
+                // past the error goal only until the first collapse, the candidates before may all have been rejected
+                if (removed >= triangleGoal || (candidate.key > errorGoal && collapses > 0)) break;
+
+                const auto g0 = candidate.v0;
+                const auto g1 = candidate.v1;
+                if (locked[g0] || locked[g1]) continue;
+
+                size_t collapseRemoved = 0;
+                if (hasTriangleFlips(g0, g1, collapseRemoved)) continue;
+
+                forEachWedge(g0, [&](unsigned int w) {
+                    if (offsets_[w] != offsets_[w + 1]) remap_[w] = wedgeTarget(w, g1);
+                });
+
+                quadrics_[g1] += quadrics_[g0];
+                locked[g0] = locked[g1] = 1;
+
+                maxError = std::max(maxError, static_cast<double>(candidate.error));
+                removed += collapseRemoved;
+                collapses++;
+            }
+
+            return collapses;
+        }
+
+        void compactTriangles() {
+
+            size_t kept = 0;
+            for (size_t t = 0; t < triangleCount(); t++) {
+
+                const unsigned int v[3]{remap_[indices_[t * 3]], remap_[indices_[t * 3 + 1]], remap_[indices_[t * 3 + 2]]};
+                if (group_[v[0]] == group_[v[1]] || group_[v[0]] == group_[v[2]] || group_[v[1]] == group_[v[2]]) continue;
+
+                std::copy_n(v, 3, indices_.begin() + kept * 3);
+                triangleGroups_[kept] = triangleGroups_[t];
+                kept++;
+            }
+
+            indices_.resize(kept * 3);
+            triangleGroups_.resize(kept);
+
+            remap_.clear();
+        }
+    };
+
+}// namespace
+
+std::shared_ptr<BufferGeometry> threepp::simplifyGeometry(const BufferGeometry& geometry, const SimplifyOptions& options, float* resultError) {
+
+    if (!geometry.hasAttribute("position")) {
+
+        std::cerr << "THREE.MeshSimplifier: .simplifyGeometry() failed. The geometry has no position attribute." << std::endl;
+        return nullptr;
+    }
+
+    auto result = geometry.hasIndex() ? geometry.clone() : mergeVertices(geometry);
+    if (!result) return nullptr;
+
+    Simplifier simplifier(*result, options);
+
+    const auto error = simplifier.run();
+    if (resultError) *resultError = error;
+
+    // triangles are written group by group, in the order of the source groups
+
+    const auto& indices = simplifier.indices();
+    const auto& triangleGroups = simplifier.triangleGroups();
+
+    std::vector<unsigned int> index;
+    index.reserve(indices.size());
+
+    if (geometry.groups.empty()) {
+
+        index = indices;
+
+    } else {
+
+        result->clearGroups();
+
+        for (size_t g = 0; g < geometry.groups.size(); g++) {
+
+            const auto start = index.size();
+            for (size_t t = 0; t < triangleGroups.size(); t++) {
+
+                if (triangleGroups[t] == static_cast<int>(g)) index.insert(index.end(), indices.begin() + t * 3, indices.begin() + t * 3 + 3);
+            }
+
+            result->addGroup(static_cast<int>(start), static_cast<int>(index.size() - start), geometry.groups[g].materialIndex);
+        }
+    }
+
+    result->setIndex(std::move(index));
+    result->setDrawRange(0, std::numeric_limits<int>::max() / 2);
+
+    // drops the vertices no triangle references anymore
+    optimizeVertexFetch(*result);
+
+    return result;
+}
+
+std::shared_ptr<LOD> threepp::generateLOD(Mesh& mesh, const std::vector<float>& distances, const SimplifyOptions& options) {
+
+    auto lod = LOD::create();
+    lod->name = mesh.name;
+    lod->position.copy(mesh.position);
+    lod->quaternion.copy(mesh.quaternion);
+    lod->scale.copy(mesh.scale);
+
+    const auto level = [&](const std::shared_ptr<BufferGeometry>& geometry) {
+        auto copy = std::dynamic_pointer_cast<Mesh>(mesh.clone(false));
+        if (geometry) copy->setGeometry(geometry);
+
+        copy->position.set(0, 0, 0);
+        copy->quaternion.identity();
+        copy->scale.set(1, 1, 1);
+
+        return copy;
+    };
+
+    auto previous = level(nullptr);
+    lod->addLevel(previous, 0);
+
+    const auto triangles = [](const BufferGeometry& geometry) {
+        return geometry.hasIndex() ? geometry.getIndex()->count() / 3 : geometry.getAttribute("position")->count() / 3;
+    };
+
+    for (auto distance : distances) {
+
+        const auto source = previous->geometry();
+        if (!source) break;
+
+        auto simplified = simplifyGeometry(*source, options);
+
+        // the error limit was reached, more levels would repeat this one
+        if (!simplified || triangles(*simplified) >= triangles(*source)) break;
+
+        previous = level(simplified);
+        lod->addLevel(previous, distance);
+    }
+
+    return lod;
+}
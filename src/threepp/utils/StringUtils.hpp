@@ -3,6 +3,7 @@
 #define THREEPP_STRINGUTILS_HPP
 
 #include <algorithm>
+#include <cmath>
 #include <regex>
 #include <sstream>
 #include <string>
@@ -97,6 +98,97 @@ namespace threepp::utils {
         );
     }
 
+    // Locale independent, non-allocating number parsing used by the loaders.
+    // Leading blanks are skipped, it is advanced past the number on success.
+
+    inline void skipBlanks(const char*& it, const char* end) {
+        while (it < end && (*it == ' ' || *it == '\t')) ++it;
+    }
+
+    inline bool parseInt(const char*& it, const char* end, int& value) {
+        skipBlanks(it, end);
+
+        auto p = it;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+        if (p == end || *p < '0' || *p > '9') return false;
+
+        long long result = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            result = result * 10 + (*p++ - '0');
+        }
+
+        value = static_cast<int>(negative ? -result : result);
+        it = p;
+
+        return true;
+    }
+
+    inline bool parseFloat(const char*& it, const char* end, float& value) {
+        static const double powersOf10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                                            1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        skipBlanks(it, end);
+
+        auto p = it;
+        bool negative = false;
+        if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+        unsigned long long mantissa = 0;
+        int exponent = 0;
+        int digits = 0;
+        bool any = false;
+
+        for (; p < end && *p >= '0' && *p <= '9'; ++p, any = true) {
+            if (digits < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) ++digits;
+            } else {
+                ++exponent;
+            }
+        }
+
+        if (p < end && *p == '.') {
+            for (++p; p < end && *p >= '0' && *p <= '9'; ++p, any = true) {
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    if (mantissa) ++digits;
+                    --exponent;
+                }
+            }
+        }
+
+        if (!any) return false;
+
+        if (p < end && (*p == 'e' || *p == 'E')) {
+            auto q = p + 1;
+            bool negativeExponent = false;
+            if (q < end && (*q == '-' || *q == '+')) negativeExponent = *q++ == '-';
+
+            if (q < end && *q >= '0' && *q <= '9') {
+                int e = 0;
+                for (; q < end && *q >= '0' && *q <= '9'; ++q) {
+                    if (e < 10000) e = e * 10 + (*q - '0');
+                }
+                exponent += negativeExponent ? -e : e;
+                p = q;
+            }
+        }
+
+        double result = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            result = -exponent <= 22 ? result / powersOf10[-exponent] : result * std::pow(10.0, exponent);
+        } else if (exponent > 0) {
+            result = exponent <= 22 ? result * powersOf10[exponent] : result * std::pow(10.0, exponent);
+        }
+
+        value = static_cast<float>(negative ? -result : result);
+        it = p;
+
+        return true;
+    }
+
 
 }// namespace threepp::utils
 
@@ -2,98 +2,222 @@
 #include "threepp/utils/ThreadPool.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
-#include <mutex>
-#include <queue>
+#include <deque>
 #include <thread>
 
 using namespace threepp::utils;
 
+namespace {
+
+    struct WorkerQueue {
+
+        std::mutex m;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    // identifies the pool and queue owned by the current thread, if it is a worker
+    thread_local const void* currentPool = nullptr;
+    thread_local unsigned int currentWorker = 0;
+
+    // unfinished tasks posted by the task executing on the current worker, created by its first post
+    using PendingCounter = std::shared_ptr<std::atomic<unsigned int>>;
+    thread_local PendingCounter* currentPending = nullptr;
+
+}// namespace
+
 struct ThreadPool::Impl {
 
     explicit Impl(unsigned int threadCount)
-        : done_(false), pendingTasks_(0) {
+        : queues_(std::max(1u, threadCount)) {
 
-        threadCount = std::min(std::thread::hardware_concurrency(), std::max(1u, threadCount));
+        threadCount = static_cast<unsigned int>(queues_.size());
         try {
             for (unsigned i = 0; i < threadCount; ++i) {
-                threads_.emplace_back(&Impl::worker_thread, this);
+                threads_.emplace_back(&Impl::worker_thread, this, i);
             }
         } catch (...) {
-            done_ = true;
+            shutdown();
             throw;
         }
     }
 
-    void wait() {
+    [[nodiscard]] unsigned int threadCount() const {
 
-        std::unique_lock<std::mutex> lck(m_);
-        cv_finished_.wait(lck, [this]() { return workQueue_.empty() && (pendingTasks_ == 0); });
+        return static_cast<unsigned int>(queues_.size());
     }
 
-    void submit(std::function<void()> f) {
+    void post(std::function<void()> f) {
 
-        std::unique_lock<std::mutex> lck(m_);
-        workQueue_.emplace(std::move(f));
-        lck.unlock();
+        ++unfinished_;
+
+        // counted for the posting task, so that its wait() does not depend on unrelated tasks
+        if (currentPool == this && currentPending) {
+
+            auto& pending = *currentPending;
+            if (!pending) pending = std::make_shared<std::atomic<unsigned int>>(0);
+            ++*pending;
+
+            f = [pending, f = std::move(f)] {
+                struct Done {
+                    std::atomic<unsigned int>& counter;
+                    ~Done() { --counter; }
+                } done{*pending};
+
+                f();
+            };
+        }
+
+        // tasks spawned by a worker stay on its own deque, others are spread round-robin
+        const auto target = currentPool == this
+                                    ? currentWorker
+                                    : nextQueue_.fetch_add(1, std::memory_order_relaxed) % threadCount();
+
+        {
+            std::lock_guard<std::mutex> lck(queues_[target].m);
+            queues_[target].tasks.emplace_back(std::move(f));
+        }
+
+        {
+            std::lock_guard<std::mutex> lck(m_);
+            ++queued_;
+        }
         cvWorker_.notify_one();
     }
 
-    ~Impl() noexcept {
+    bool runPendingTask() {
 
-        std::unique_lock<std::mutex> lck(m_);
-        done_ = true;
-        lck.unlock();
-        cvWorker_.notify_all();
+        std::function<void()> task;
+        if (!tryPop(task)) return false;
 
-        for (auto& thread : threads_) {
-            thread.join();
+        execute(task);
+
+        return true;
+    }
+
+    void wait() {
+
+        // a task waiting on its own pool waits for the tasks it posted only, executing pending tasks meanwhile.
+        // Waiting for every task would include the caller itself and any other task waiting concurrently.
+        if (currentPool == this) {
+
+            const auto pending = currentPending ? *currentPending : nullptr;
+            while (pending && pending->load() > 0) {
+
+                if (!runPendingTask()) std::this_thread::yield();
+            }
+            return;
         }
+
+        while (runPendingTask()) {}
+
+        std::unique_lock<std::mutex> lck(m_);
+        cvFinished_.wait(lck, [this]() { return unfinished_.load() == 0; });
+    }
+
+    ~Impl() noexcept {
+
+        shutdown();
     }
 
 private:
-    bool done_;
+    bool done_{false};
     std::mutex m_;
+    unsigned int queued_{0};
+    std::atomic<unsigned int> unfinished_{0};
+    std::atomic<unsigned int> nextQueue_{0};
 
-    unsigned int pendingTasks_;
-
+    std::vector<WorkerQueue> queues_;
     std::vector<std::thread> threads_;
-    std::queue<std::function<void()>> workQueue_;
 
     std::condition_variable cvWorker_;
-    std::condition_variable cv_finished_;
+    std::condition_variable cvFinished_;
 
-    void worker_thread() {
+    void shutdown() {
 
-        while (true) {
+        {
+            std::lock_guard<std::mutex> lck(m_);
+            done_ = true;
+        }
+        cvWorker_.notify_all();
 
-            std::unique_lock<std::mutex> lck(m_);
+        for (auto& thread : threads_) {
+            if (thread.joinable()) thread.join();
+        }
+    }
 
-            // If no work is available, block the thread here
-            cvWorker_.wait(lck, [this]() { return done_ || !workQueue_.empty(); });
-            if (!workQueue_.empty()) {
+    bool tryPop(std::function<void()>& task) {
 
-                ++pendingTasks_;
+        const auto count = threadCount();
+        const auto self = currentPool == this ? currentWorker : 0;
 
-                auto task = std::move(workQueue_.front());
-                workQueue_.pop();
+        // own queue first (LIFO), then steal from the others (FIFO)
+        if (currentPool == this) {
 
-                lck.unlock();
+            auto& queue = queues_[self];
+            std::lock_guard<std::mutex> lck(queue.m);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            }
+        }
 
-                // Run work function outside mutex lock context
-                task();
+        for (unsigned i = 1; !task && i <= count; ++i) {
 
-                lck.lock();
-                --pendingTasks_;
-                lck.unlock();
+            auto& queue = queues_[(self + i) % count];
+            std::lock_guard<std::mutex> lck(queue.m);
+            if (!queue.tasks.empty()) {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+        }
 
-                cv_finished_.notify_one();
+        if (!task) return false;
 
-            } else if (done_) {
+        std::lock_guard<std::mutex> lck(m_);
+        --queued_;
 
-                break;
-            }
+        return true;
+    }
+
+    void execute(std::function<void()>& task) {
+
+        {
+            PendingCounter pending;
+            auto* const outer = currentPending;
+            currentPending = &pending;
+
+            struct Restore {
+                PendingCounter*& current;
+                PendingCounter* outer;
+                ~Restore() { current = outer; }
+            } restore{currentPending, outer};
+
+            task();
+        }
+
+        if (--unfinished_ == 0) {
+
+            std::lock_guard<std::mutex> lck(m_);
+            cvFinished_.notify_all();
+        }
+    }
+
+    void worker_thread(unsigned int index) {
+
+        currentPool = this;
+        currentWorker = index;
+
+        while (true) {
+
+            if (runPendingTask()) continue;
+
+            std::unique_lock<std::mutex> lck(m_);
+
+            // If no work is available, block the thread here
+            cvWorker_.wait(lck, [this]() { return done_ || queued_ > 0; });
+            if (done_ && queued_ == 0) break;
         }
     }
 };
@@ -101,14 +225,91 @@ private:
 ThreadPool::ThreadPool(unsigned int threadCount)
     : pimpl_(std::make_unique<Impl>(threadCount)) {}
 
-void ThreadPool::submit(const std::function<void()>& f) {
+unsigned int ThreadPool::threadCount() const {
 
-    pimpl_->submit(f);
+    return pimpl_->threadCount();
 }
 
-void threepp::utils::ThreadPool::wait() {
+void ThreadPool::post(std::function<void()> f) {
+
+    pimpl_->post(std::move(f));
+}
+
+void ThreadPool::wait() {
 
     pimpl_->wait();
 }
 
+bool ThreadPool::runPendingTask() {
+
+    return pimpl_->runPendingTask();
+}
+
+ThreadPool& ThreadPool::instance() {
+
+    static ThreadPool pool(std::max(1u, std::thread::hardware_concurrency()));
+
+    return pool;
+}
+
 ThreadPool::~ThreadPool() = default;
+
+
+TaskGroup::TaskGroup(ThreadPool& pool)
+    : pool_(pool) {}
+
+void TaskGroup::run(std::function<void()> f) {
+
+    {
+        std::lock_guard<std::mutex> lck(m_);
+        ++pending_;
+    }
+
+    pool_.post([this, f = std::move(f)] {
+        std::exception_ptr error;
+        try {
+            f();
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        // the group may be destroyed as soon as pending_ reaches zero, so notify under the lock
+        std::lock_guard<std::mutex> lck(m_);
+        if (error && !error_) error_ = error;
+        if (--pending_ == 0) cv_.notify_all();
+    });
+}
+
+void TaskGroup::join() {
+
+    while (true) {
+
+        {
+            std::lock_guard<std::mutex> lck(m_);
+            if (pending_ == 0) return;
+        }
+
+        // help out instead of blocking, this is what makes nested groups safe
+        if (pool_.runPendingTask()) continue;
+
+        std::unique_lock<std::mutex> lck(m_);
+        cv_.wait_for(lck, std::chrono::microseconds(100), [this] { return pending_ == 0; });
+    }
+}
+
+void TaskGroup::wait() {
+
+    join();
+
+    std::lock_guard<std::mutex> lck(m_);
+    if (error_) {
+        auto error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+TaskGroup::~TaskGroup() {
+
+    join();
+}
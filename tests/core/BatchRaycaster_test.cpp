@@ -0,0 +1,233 @@
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/core/BatchRaycaster.hpp"
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Group.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+
+using namespace threepp;
+
+namespace {
+
+    struct Hits {
+
+        std::vector<float> distance, pointX, pointY, pointZ, normalX, normalY, normalZ;
+        std::vector<unsigned int> objectId, faceIndex, instanceId;
+
+        explicit Hits(size_t count)
+            : distance(count), pointX(count), pointY(count), pointZ(count),
+              normalX(count), normalY(count), normalZ(count),
+              objectId(count), faceIndex(count), instanceId(count) {}
+
+        RayBatchHits buffers() {
+
+            return {distance.data(), pointX.data(), pointY.data(), pointZ.data(),
+                    normalX.data(), normalY.data(), normalZ.data(),
+                    objectId.data(), faceIndex.data(), instanceId.data()};
+        }
+    };
+
+    // the instanceId BatchRaycaster reports for an intersection
+    unsigned int instanceId(const Intersection& intersection) {
+
+        return intersection.instanceId ? static_cast<unsigned int>(*intersection.instanceId) : BatchRaycaster::noHit;
+    }
+
+    std::shared_ptr<Group> makeScene() {
+
+        auto scene = Group::create();
+
+        auto sphere = Mesh::create(SphereGeometry::create(1, 32, 16), MeshBasicMaterial::create());
+        sphere->position.set(-2, 0, 0);
+        sphere->scale.set(1, 2, 1);
+        scene->add(sphere);
+
+        auto instanced = InstancedMesh::create(BoxGeometry::create(0.5f, 0.5f, 0.5f), MeshBasicMaterial::create(), 9);
+        Matrix4 matrix;
+        for (int i = 0; i < 9; i++) {
+
+            instanced->setMatrixAt(i, matrix.makeRotationZ(0.3f * static_cast<float>(i)).setPosition(static_cast<float>(i % 3) - 1, static_cast<float>(i / 3) - 1, 0));
+        }
+        instanced->position.set(2, 0, 0);
+        scene->add(instanced);
+
+        auto box = Mesh::create(BoxGeometry::create(2, 2, 2)->toNonIndexed(), MeshBasicMaterial::create());
+        box->position.set(0, 0, -3);
+        box->rotation.set(0.2f, 0.4f, 0);
+        scene->add(box);
+
+        scene->updateMatrixWorld();
+
+        return scene;
+    }
+
+    void randomRays(size_t count, std::vector<Vector3>& origins, std::vector<Vector3>& directions) {
+
+        for (size_t i = 0; i < count; i++) {
+
+            Vector3 origin(math::randomInRange(-5.f, 5.f), math::randomInRange(-5.f, 5.f), math::randomInRange(4.f, 6.f));
+            Vector3 target(math::randomInRange(-3.f, 3.f), math::randomInRange(-2.f, 2.f), math::randomInRange(-3.f, 1.f));
+
+            origins.emplace_back(origin);
+            directions.emplace_back(target.sub(origin).normalize());
+        }
+    }
+
+}// namespace
+
+TEST_CASE("closest hits match Raycaster") {
+
+    auto scene = makeScene();
+
+    std::vector<Vector3> origins, directions;
+    randomRays(1000, origins, directions);
+
+    Hits hits(origins.size());
+    BatchRaycaster batch;
+    const auto hitCount = batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits.buffers());
+
+    Raycaster raycaster;
+    size_t expectedHits = 0;
+    for (size_t i = 0; i < origins.size(); i++) {
+
+        raycaster.set(origins[i], directions[i]);
+        const auto intersects = raycaster.intersectObject(scene.get(), true);
+
+        if (intersects.empty()) {
+
+            CHECK(std::isinf(hits.distance[i]));
+            CHECK(hits.objectId[i] == BatchRaycaster::noHit);
+            continue;
+        }
+
+        expectedHits++;
+
+        const auto& expected = intersects.front();
+        REQUIRE(hits.distance[i] == Approx(expected.distance).margin(1e-4));
+        CHECK(hits.objectId[i] == expected.object->id);
+        CHECK(hits.instanceId[i] == instanceId(expected));
+
+        const Vector3 point(hits.pointX[i], hits.pointY[i], hits.pointZ[i]);
+        CHECK(point.distanceTo(expected.point) < 1e-4f);
+
+        // the normal is perpendicular to the hit triangle and faces the ray for front side hits
+        const Vector3 normal(hits.normalX[i], hits.normalY[i], hits.normalZ[i]);
+        CHECK(normal.length() == Approx(1));
+        CHECK(normal.dot(directions[i]) < 0);
+
+        if (!expected.instanceId) {
+            CHECK(hits.faceIndex[i] == static_cast<unsigned int>(*expected.faceIndex));
+        }
+    }
+
+    CHECK(hitCount == expectedHits);
+    CHECK(expectedHits > origins.size() / 4);
+}
+
+TEST_CASE("any hits") {
+
+    auto scene = makeScene();
+
+    std::vector<Vector3> origins, directions;
+    randomRays(1000, origins, directions);
+
+    Hits closest(origins.size());
+    BatchRaycaster batch;
+    batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), closest.buffers());
+
+    // only distances are required
+    std::vector<float> distance(origins.size());
+    RayBatchHits hits;
+    hits.distance = distance.data();
+
+    batch.mode = BatchRaycaster::Mode::AnyHit;
+    const auto hitCount = batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits);
+
+    size_t expectedHits = 0;
+    for (size_t i = 0; i < origins.size(); i++) {
+
+        REQUIRE(std::isinf(distance[i]) == std::isinf(closest.distance[i]));
+        CHECK(distance[i] >= closest.distance[i]);
+        expectedHits += !std::isinf(distance[i]);
+    }
+
+    CHECK(hitCount == expectedHits);
+}
+
+TEST_CASE("near, far and layers") {
+
+    auto scene = makeScene();
+
+    const std::vector<Vector3> origins{{-2, 0, 5}, {-2, 0, 5}, {2, 0, 5}};
+    const std::vector<Vector3> directions{{0, 0, -1}, {0, 0, -1}, {0, 0, -1}};
+
+    Hits hits(origins.size());
+    BatchRaycaster batch(0, 3);
+    CHECK(batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits.buffers()) == 0);
+
+    batch.far = 10;
+    CHECK(batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits.buffers()) == 3);
+    CHECK(hits.distance[0] == Approx(4));
+    CHECK(hits.distance[2] == Approx(4.75));
+    CHECK(hits.instanceId[2] == 4);
+
+    // not recursive, only the group itself which is no mesh
+    CHECK(batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits.buffers(), false) == 0);
+
+    batch.layers.set(1);
+    CHECK(batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits.buffers()) == 0);
+}
+
+TEST_CASE("many targets match Raycaster") {
+
+    // a grid of instances spread in depth, so most rays pass through several of them. Rotated
+    // about y they stay less than 0.6 wide, so none overlap and closest hits are unambiguous
+    auto scene = Group::create();
+
+    const int count = 600;
+    auto instanced = InstancedMesh::create(BoxGeometry::create(0.4f, 0.4f, 0.4f), MeshBasicMaterial::create(), count);
+    Matrix4 matrix;
+    for (int i = 0; i < count; i++) {
+
+        const auto x = static_cast<float>(i % 10) * 0.6f - 3;
+        const auto y = static_cast<float>(i / 10 % 6) * 0.6f - 2;
+        const auto z = -static_cast<float>(i / 60) * 0.6f;
+        instanced->setMatrixAt(i, matrix.makeRotationY(0.1f * static_cast<float>(i)).setPosition(x, y, z));
+    }
+    scene->add(instanced);
+    scene->updateMatrixWorld();
+
+    std::vector<Vector3> origins, directions;
+    randomRays(1000, origins, directions);
+
+    Hits hits(origins.size());
+    BatchRaycaster batch;
+    const auto hitCount = batch.intersectObject(*scene, origins.data(), directions.data(), origins.size(), hits.buffers());
+
+    Raycaster raycaster;
+    size_t expectedHits = 0;
+    for (size_t i = 0; i < origins.size(); i++) {
+
+        raycaster.set(origins[i], directions[i]);
+        const auto intersects = raycaster.intersectObject(scene.get(), true);
+
+        if (intersects.empty()) {
+
+            CHECK(std::isinf(hits.distance[i]));
+            continue;
+        }
+
+        expectedHits++;
+        REQUIRE(hits.distance[i] == Approx(intersects.front().distance).margin(1e-4));
+        CHECK(hits.instanceId[i] == instanceId(intersects.front()));
+    }
+
+    CHECK(hitCount == expectedHits);
+    CHECK(expectedHits > origins.size() / 4);
+}
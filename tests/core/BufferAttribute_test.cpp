@@ -0,0 +1,132 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/core/BufferGeometry.hpp"
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+#include <cmath>
+
+using namespace threepp;
+
+TEST_CASE("Test Float16 conversion") {
+
+    CHECK(Float16(0.f).bits == 0x0000);
+    CHECK(Float16(-0.f).bits == 0x8000);
+    CHECK(Float16(1.f).bits == 0x3c00);
+    CHECK(Float16(-2.f).bits == 0xc000);
+    CHECK(Float16(65504.f).bits == 0x7bff);
+    CHECK(Float16(1e6f).bits == 0x7c00);
+    CHECK(Float16(Infinity<float>).bits == 0x7c00);
+    CHECK(std::isnan(static_cast<float>(Float16(std::nanf("")))));
+
+    // smallest subnormal
+    CHECK(Float16(5.960464477539063e-8f).bits == 0x0001);
+    CHECK(static_cast<float>(Float16::fromBits(0x0001)) == Approx(5.960464477539063e-8f));
+
+    // ties round to even
+    CHECK(Float16(1.f + 1.f / 2048).bits == 0x3c00);
+    CHECK(Float16(1.f + 3.f / 2048).bits == 0x3c02);
+
+    for (float v : {0.5f, 0.25f, -3.75f, 1024.f, 0.1f}) {
+
+        CHECK(static_cast<float>(Float16(v)) == Approx(v).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("Test component types") {
+
+    CHECK(FloatBufferAttribute::create(std::vector<float>{0}, 1)->componentType() == ComponentType::Float);
+    CHECK(HalfFloatBufferAttribute::create(std::vector<Float16>{0.f}, 1)->componentType() == ComponentType::HalfFloat);
+    CHECK(Int8BufferAttribute::create(std::vector<int8_t>{0}, 1)->componentType() == ComponentType::Byte);
+    CHECK(Uint8BufferAttribute::create(std::vector<uint8_t>{0}, 1)->componentType() == ComponentType::UnsignedByte);
+    CHECK(Int16BufferAttribute::create(std::vector<int16_t>{0}, 1)->componentType() == ComponentType::Short);
+    CHECK(Uint16BufferAttribute::create(std::vector<uint16_t>{0}, 1)->componentType() == ComponentType::UnsignedShort);
+    CHECK(IntBufferAttribute::create(std::vector<unsigned int>{0}, 1)->componentType() == ComponentType::UnsignedInt);
+
+    auto attribute = Int16BufferAttribute::create(std::vector<int16_t>{1, 2, 3, 4, 5, 6}, 3);
+    CHECK(attribute->bytesPerComponent() == 2);
+    CHECK(attribute->byteLength() == 12);
+    CHECK(attribute->count() == 2);
+}
+
+TEST_CASE("Test normalized reads and writes") {
+
+    auto colors = Uint8BufferAttribute::create(std::vector<uint8_t>{255, 0, 51}, 3, true);
+
+    Vector3 v;
+    colors->setFromBufferAttribute(v, 0);
+    CHECK(v.x == Approx(1));
+    CHECK(v.y == Approx(0));
+    CHECK(v.z == Approx(0.2));
+
+    colors->setComponent(0, 1, 0.5f);
+    CHECK(colors->getX(0) == 255);
+    CHECK(colors->getY(0) == 128);
+
+    colors->setComponent(0, 2, 2.f);
+    CHECK(colors->getZ(0) == 255);
+
+    auto normals = Int16BufferAttribute::create(std::vector<int16_t>{32767, -32767, -32768}, 3, true);
+    normals->setFromBufferAttribute(v, 0);
+    CHECK(v.x == Approx(1));
+    CHECK(v.y == Approx(-1));
+    CHECK(v.z == Approx(-1));
+
+    // unnormalized integers are read as is
+    auto positions = Int16BufferAttribute::create(std::vector<int16_t>{-4, 10, 300}, 3);
+    positions->setFromBufferAttribute(v, 0);
+    CHECK(v == Vector3(-4, 10, 300));
+
+    auto half = HalfFloatBufferAttribute::create(std::vector<Float16>{0.5f, -1.5f, 8.f}, 3);
+    half->setFromBufferAttribute(v, 0);
+    CHECK(v == Vector3(0.5f, -1.5f, 8.f));
+}
+
+TEST_CASE("Test quantized geometry") {
+
+    auto geometry = BufferGeometry::create();
+    geometry->setAttribute("position", Int16BufferAttribute::create(std::vector<int16_t>{-1, -1, 0, 1, -1, 0, 1, 1, 0, -1, 1, 0}, 3));
+    geometry->setAttribute("normal", Int8BufferAttribute::create(std::vector<int8_t>{0, 0, 127, 0, 0, 127, 0, 0, 127, 0, 0, 127}, 3, true));
+    geometry->setIndex(std::vector<unsigned int>{0, 1, 2, 0, 2, 3});
+
+    SECTION("bounds") {
+
+        geometry->computeBoundingBox();
+        CHECK(geometry->boundingBox->min() == Vector3(-1, -1, 0));
+        CHECK(geometry->boundingBox->max() == Vector3(1, 1, 0));
+
+        geometry->computeBoundingSphere();
+        CHECK(geometry->boundingSphere->radius == Approx(std::sqrt(2.f)));
+    }
+
+    SECTION("copy") {
+
+        auto clone = geometry->clone();
+        auto position = clone->getAttribute<int16_t>("position");
+        REQUIRE(position);
+        CHECK(position->array() == geometry->getAttribute<int16_t>("position")->array());
+        CHECK(clone->getAttribute<int8_t>("normal")->normalized());
+
+        auto nonIndexed = geometry->toNonIndexed();
+        CHECK(nonIndexed->getAttribute<int16_t>("position")->count() == 6);
+    }
+
+    SECTION("raycast") {
+
+        auto mesh = Mesh::create(geometry, MeshBasicMaterial::create());
+
+        Raycaster raycaster;
+        raycaster.set({0.5f, 0.25f, 5}, {0, 0, -1});
+
+        auto intersects = raycaster.intersectObject(mesh.get());
+        REQUIRE(intersects.size() == 1);
+        CHECK(intersects.front().distance == Approx(5));
+
+        geometry->computeBoundsTree();
+        intersects = raycaster.intersectObject(mesh.get());
+        REQUIRE(intersects.size() == 1);
+        CHECK(intersects.front().point == Vector3(0.5f, 0.25f, 0));
+    }
+}
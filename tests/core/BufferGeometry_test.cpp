@@ -0,0 +1,44 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/core/BufferGeometry.hpp"
+
+using namespace threepp;
+
+TEST_CASE("Test layoutVersion") {
+
+    BufferGeometry geometry;
+    auto version = geometry.layoutVersion();
+
+    geometry.setAttribute("position", FloatBufferAttribute::create(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 3));
+    CHECK(geometry.layoutVersion() > version);
+    version = geometry.layoutVersion();
+
+    // replacing an attribute changes the layout
+    geometry.setAttribute("position", FloatBufferAttribute::create(std::vector<float>{0, 0, 0, 1, 0, 0, 0, 1, 0}, 3));
+    CHECK(geometry.layoutVersion() > version);
+    version = geometry.layoutVersion();
+
+    geometry.setIndex(std::vector<unsigned int>{0, 1, 2});
+    CHECK(geometry.layoutVersion() > version);
+    version = geometry.layoutVersion();
+
+    // updating attribute data does not
+    geometry.getAttribute<float>("position")->setX(0, 2);
+    geometry.getAttribute<float>("position")->needsUpdate();
+    geometry.translate(1, 0, 0);
+    CHECK(geometry.layoutVersion() == version);
+
+    geometry.deleteAttribute("normal");
+    CHECK(geometry.layoutVersion() == version);
+
+    geometry.deleteAttribute("position");
+    CHECK(!geometry.hasAttribute("position"));
+    CHECK(geometry.layoutVersion() > version);
+    version = geometry.layoutVersion();
+
+    BufferGeometry other;
+    other.setAttribute("normal", FloatBufferAttribute::create(std::vector<float>{0, 0, 1}, 3));
+    geometry.copy(other);
+    CHECK(geometry.layoutVersion() > version);
+}
@@ -0,0 +1,275 @@
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/materials/LineBasicMaterial.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/materials/PointsMaterial.hpp"
+#include "threepp/materials/SpriteMaterial.hpp"
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/math/Triangle.hpp"
+#include "threepp/objects/Group.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/objects/Line.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/objects/Points.hpp"
+#include "threepp/objects/Sprite.hpp"
+
+#include <thread>
+
+using namespace threepp;
+
+namespace {
+
+    constexpr int threadCount = 8;
+    constexpr int rounds = 50;
+
+    // runs f(thread) on threadCount threads at once
+    template<class F>
+    void hammer(F&& f) {
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++) {
+
+            threads.emplace_back([&f, t] { f(t); });
+        }
+
+        for (auto& thread : threads) {
+
+            thread.join();
+        }
+    }
+
+    std::vector<Ray> randomRays(size_t count) {
+
+        std::vector<Ray> rays;
+        for (size_t i = 0; i < count; i++) {
+
+            Vector3 origin(math::randomInRange(-5.f, 5.f), math::randomInRange(-5.f, 5.f), math::randomInRange(4.f, 6.f));
+            Vector3 target(math::randomInRange(-1.f, 1.f), math::randomInRange(-1.f, 1.f), math::randomInRange(-1.f, 1.f));
+
+            rays.emplace_back(origin, target.sub(origin).normalize());
+        }
+
+        return rays;
+    }
+
+    // distances, points and uvs of all hits, in order
+    std::vector<float> summary(const std::vector<Intersection>& intersects) {
+
+        std::vector<float> result;
+        for (const auto& intersect : intersects) {
+
+            result.insert(result.end(), {intersect.distance, intersect.point.x, intersect.point.y, intersect.point.z});
+
+            if (intersect.uv) result.insert(result.end(), {intersect.uv->x, intersect.uv->y});
+            if (intersect.instanceId) result.emplace_back(static_cast<float>(*intersect.instanceId));
+        }
+
+        return result;
+    }
+
+    std::shared_ptr<Group> makeScene(Camera& camera) {
+
+        auto scene = Group::create();
+
+        auto mesh = Mesh::create(SphereGeometry::create(1, 32, 16), MeshBasicMaterial::create());
+        mesh->position.set(-2, 0, 0);
+        scene->add(mesh);
+
+        auto instanced = InstancedMesh::create(BoxGeometry::create(0.5f, 0.5f, 0.5f), MeshBasicMaterial::create(), 9);
+        Matrix4 matrix;
+        for (int i = 0; i < 9; i++) {
+
+            instanced->setMatrixAt(i, matrix.makeTranslation(static_cast<float>(i % 3) - 1, static_cast<float>(i / 3) - 1, 0));
+        }
+        instanced->position.set(2, 0, 0);
+        scene->add(instanced);
+
+        auto line = Line::create(SphereGeometry::create(1.5f, 16, 8), LineBasicMaterial::create());
+        scene->add(line);
+
+        auto points = Points::create(SphereGeometry::create(2, 16, 8), PointsMaterial::create());
+        points->position.set(0, 2, 0);
+        scene->add(points);
+
+        auto sprite = Sprite::create(SpriteMaterial::create());
+        sprite->position.set(0, -2, 0);
+        scene->add(sprite);
+
+        scene->updateMatrixWorld();
+        camera.updateMatrixWorld();
+
+        // bounds are computed lazily on first use, which is a write
+        scene->traverse([](Object3D& object) {
+            auto geometry = object.geometry();
+            if (geometry && !object.is<Sprite>()) {
+                geometry->computeBoundingSphere();
+                geometry->computeBoundingBox();
+            }
+        });
+
+        return scene;
+    }
+
+}// namespace
+
+TEST_CASE("concurrent raycasts match serial raycasts") {
+
+    auto camera = PerspectiveCamera::create();
+    camera->position.z = 10;
+
+    auto scene = makeScene(*camera);
+
+    const auto rays = randomRays(200);
+
+    const auto cast = [&](const Ray& ray) {
+        Raycaster raycaster;
+        raycaster.ray = ray;
+        raycaster.camera = camera.get();
+        raycaster.params.lineThreshold = 0.1f;
+        raycaster.params.pointsThreshold = 0.1f;
+
+        return summary(raycaster.intersectObject(scene.get(), true));
+    };
+
+    std::vector<std::vector<float>> expected;
+    size_t hits = 0;
+    for (const auto& ray : rays) {
+
+        expected.emplace_back(cast(ray));
+        hits += !expected.back().empty();
+    }
+    REQUIRE(hits > rays.size() / 4);
+
+    std::vector<int> mismatches(threadCount);
+    hammer([&](int thread) {
+        for (int round = 0; round < rounds; round++) {
+            for (size_t i = thread; i < rays.size(); i += 3) {
+
+                if (cast(rays[i]) != expected[i]) mismatches[thread]++;
+            }
+        }
+    });
+
+    for (auto mismatch : mismatches) {
+
+        CHECK(mismatch == 0);
+    }
+}
+
+TEST_CASE("concurrent frustum culling matches serial culling") {
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 20);
+    camera->position.z = 10;
+
+    auto scene = makeScene(*camera);
+
+    std::vector<Frustum> frustums;
+    for (int i = 0; i < 32; i++) {
+
+        camera->lookAt(math::randomInRange(-10.f, 10.f), math::randomInRange(-10.f, 10.f), 0);
+        camera->updateMatrixWorld();
+
+        Matrix4 projScreenMatrix;
+        projScreenMatrix.multiplyMatrices(camera->projectionMatrix, camera->matrixWorldInverse);
+        frustums.emplace_back().setFromProjectionMatrix(projScreenMatrix);
+    }
+
+    std::vector<Object3D*> objects;
+    scene->traverse([&](Object3D& object) {
+        if (object.geometry()) objects.emplace_back(&object);
+    });
+
+    const auto cull = [&](const Frustum& frustum) {
+        std::vector<bool> visible;
+        for (auto object : objects) {
+
+            if (auto sprite = object->as<Sprite>()) {
+
+                visible.emplace_back(frustum.intersectsSprite(*sprite));
+
+            } else {
+
+                visible.emplace_back(frustum.intersectsObject(*object));
+                visible.emplace_back(frustum.intersectsBox(*object->geometry()->boundingBox));
+            }
+        }
+
+        return visible;
+    };
+
+    std::vector<std::vector<bool>> expected;
+    for (const auto& frustum : frustums) {
+
+        expected.emplace_back(cull(frustum));
+    }
+
+    std::vector<int> mismatches(threadCount);
+    hammer([&](int thread) {
+        for (int round = 0; round < rounds * 10; round++) {
+            for (size_t i = thread; i < frustums.size(); i += 2) {
+
+                if (cull(frustums[i]) != expected[i]) mismatches[thread]++;
+            }
+        }
+    });
+
+    for (auto mismatch : mismatches) {
+
+        CHECK(mismatch == 0);
+    }
+}
+
+TEST_CASE("concurrent primitive queries and attribute transforms") {
+
+    const Triangle triangle(Vector3(0, 0, 0), Vector3(1, 0, 0), Vector3(0, 1, 0));
+    const Box3 box(Vector3(-0.25f, -0.25f, -0.25f), Vector3(0.25f, 0.25f, 0.25f));
+
+    Matrix4 transform;
+    transform.makeRotationY(0.5f).setPosition(1, 2, 3);
+
+    const auto reference = SphereGeometry::create(1, 16, 8);
+    auto expected = reference->clone();
+    expected->applyMatrix4(transform);
+
+    std::vector<int> mismatches(threadCount);
+    hammer([&](int thread) {
+        auto geometry = reference->clone();
+
+        for (int round = 0; round < rounds * 100; round++) {
+
+            const float t = static_cast<float>(round % 100) / 100;
+
+            Vector3 closest;
+            Triangle(triangle).closestPointToPoint(Vector3(t, t, 1), closest);
+            if (closest.distanceTo(Vector3(std::min(t, 0.5f), std::min(t, 0.5f), 0)) > 1e-5f) mismatches[thread]++;
+
+            Vector3 barycoord;
+            Triangle::getBarycoord(Vector3(t / 2, t / 2, 0), triangle.a(), triangle.b(), triangle.c(), barycoord);
+            if (std::abs(barycoord.x + barycoord.y + barycoord.z - 1) > 1e-5f) mismatches[thread]++;
+
+            const bool intersects = box.intersectsTriangle(Triangle(Vector3(t, 0, 0), Vector3(t + 1, 0, 0), Vector3(t, 1, 0)));
+            if (intersects != (t <= 0.25f)) mismatches[thread]++;
+
+            Vector3 hit;
+            Ray(Vector3(t - 0.5f, 0, 5), Vector3(0, 0, -1)).intersectBox(box, hit);
+            if (hit.isNan() != (t < 0.25f || t > 0.75f)) mismatches[thread]++;
+        }
+
+        geometry->applyMatrix4(transform);
+
+        const auto& actual = geometry->getAttribute<float>("position")->array();
+        if (actual != expected->getAttribute<float>("position")->array()) mismatches[thread]++;
+    });
+
+    for (auto mismatch : mismatches) {
+
+        CHECK(mismatch == 0);
+    }
+}
@@ -0,0 +1,205 @@
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/core/MeshBVH.hpp"
+#include "threepp/core/Raycaster.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+using namespace threepp;
+
+namespace {
+
+    Ray randomRay() {
+
+        Vector3 origin(math::randomInRange(-3.f, 3.f), math::randomInRange(-3.f, 3.f), math::randomInRange(-3.f, 3.f));
+        Vector3 target(math::randomInRange(-0.5f, 0.5f), math::randomInRange(-0.5f, 0.5f), math::randomInRange(-0.5f, 0.5f));
+
+        return Ray(origin, target.sub(origin).normalize());
+    }
+
+    std::optional<float> bruteForceClosest(const BufferGeometry& geometry, const Ray& ray, int side) {
+
+        const auto position = geometry.getAttribute<float>("position");
+        const auto index = geometry.getIndex();
+        const auto count = index ? index->count() : position->count();
+
+        std::optional<float> closest;
+        Vector3 a, b, c, point;
+        for (int i = 0; i < count; i += 3) {
+
+            position->setFromBufferAttribute(a, index ? index->getX(i) : i);
+            position->setFromBufferAttribute(b, index ? index->getX(i + 1) : i + 1);
+            position->setFromBufferAttribute(c, index ? index->getX(i + 2) : i + 2);
+
+            bool hit = side == BackSide ? ray.intersectTriangle(c, b, a, true, point).has_value()
+                                        : ray.intersectTriangle(a, b, c, side != DoubleSide, point).has_value();
+
+            if (hit) {
+                const auto distance = ray.origin.distanceTo(point);
+                if (!closest || distance < *closest) closest = distance;
+            }
+        }
+
+        return closest;
+    }
+
+}// namespace
+
+TEST_CASE("build") {
+
+    auto geometry = SphereGeometry::create(1, 64, 32);
+    const auto& bvh = geometry->computeBoundsTree();
+
+    CHECK(bvh.triangleCount() == static_cast<size_t>(geometry->getIndex()->count() / 3));
+    CHECK(bvh.nodeCount() > 1);
+
+    geometry->computeBoundingBox();
+    CHECK(bvh.boundingBox().equals(*geometry->boundingBox));
+}
+
+TEST_CASE("closestHit matches brute force") {
+
+    auto indexed = SphereGeometry::create(1, 48, 24);
+    auto nonIndexed = indexed->toNonIndexed();
+
+    for (auto geometry : {std::static_pointer_cast<BufferGeometry>(indexed), nonIndexed}) {
+
+        const auto& bvh = geometry->computeBoundsTree(MeshBVH::Options{4});
+
+        for (int side : {FrontSide, BackSide, DoubleSide}) {
+
+            for (int i = 0; i < 200; i++) {
+
+                const auto ray = randomRay();
+                const auto expected = bruteForceClosest(*geometry, ray, side);
+                const auto hit = bvh.closestHit(ray, side);
+
+                REQUIRE(hit.has_value() == expected.has_value());
+                REQUIRE(bvh.anyHit(ray, side) == expected.has_value());
+
+                if (hit) {
+                    CHECK(hit->distance == Approx(*expected).margin(1e-5));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("intersectPacket matches closestHit") {
+
+    auto geometry = SphereGeometry::create(1, 48, 24);
+    const auto& bvh = geometry->computeBoundsTree(MeshBVH::Options{4});
+
+    for (int side : {FrontSide, BackSide, DoubleSide}) {
+
+        for (bool anyHit : {false, true}) {
+
+            BVHRayPacket packet;
+            packet.size = BVHRayPacket::maxSize;
+
+            std::vector<Ray> rays;
+            for (unsigned r = 0; r < packet.size; r++) {
+
+                const auto& ray = rays.emplace_back(randomRay());
+                packet.origin[0][r] = ray.origin.x, packet.origin[1][r] = ray.origin.y, packet.origin[2][r] = ray.origin.z;
+                packet.direction[0][r] = ray.direction.x, packet.direction[1][r] = ray.direction.y, packet.direction[2][r] = ray.direction.z;
+                packet.near[r] = 0;
+                packet.far[r] = Infinity<float>;
+            }
+
+            bvh.intersectPacket(packet, side, anyHit);
+
+            for (unsigned r = 0; r < packet.size; r++) {
+
+                const auto expected = bvh.closestHit(rays[r], side);
+
+                REQUIRE(packet.hit[r] == expected.has_value());
+
+                if (expected && !anyHit) {
+                    CHECK(packet.far[r] == Approx(expected->distance).margin(1e-5));
+                    CHECK(packet.faceIndex[r] == expected->faceIndex);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("refit after positions change") {
+
+    auto geometry = SphereGeometry::create(1, 32, 16);
+    auto& bvh = geometry->computeBoundsTree();
+
+    CHECK_FALSE(bvh.update());
+
+    geometry->translate(10, 0, 0);
+
+    CHECK(bvh.update());
+    CHECK(bvh.boundingBox().min().x == Approx(9));
+
+    Ray ray({20, 0, 0}, {-1, 0, 0});
+    const auto hit = bvh.closestHit(ray);
+    REQUIRE(hit);
+    CHECK(hit->distance == Approx(9).margin(1e-4));
+}
+
+TEST_CASE("Mesh raycast with boundsTree") {
+
+    auto geometry = SphereGeometry::create(1, 32, 16);
+    auto mesh = Mesh::create(geometry, MeshBasicMaterial::create());
+    mesh->position.set(0, 0, -5);
+    mesh->scale.setScalar(2);
+    mesh->updateMatrixWorld();
+
+    Raycaster raycaster({0.1f, 0.2f, 0}, {0, 0, -1});
+
+    const auto linear = raycaster.intersectObject(mesh.get());
+
+    geometry->computeBoundsTree();
+    const auto accelerated = raycaster.intersectObject(mesh.get());
+
+    REQUIRE(linear.size() == accelerated.size());
+    for (unsigned i = 0; i < linear.size(); i++) {
+        CHECK(linear[i].distance == Approx(accelerated[i].distance));
+        CHECK(linear[i].faceIndex == accelerated[i].faceIndex);
+    }
+
+    raycaster.firstHitOnly = true;
+    const auto first = raycaster.intersectObject(mesh.get());
+    REQUIRE(first.size() == 1);
+    CHECK(first.front().distance == Approx(linear.front().distance));
+    CHECK(first.front().faceIndex == linear.front().faceIndex);
+}
+
+TEST_CASE("Mesh raycast does not update a stale boundsTree") {
+
+    auto geometry = SphereGeometry::create(1, 32, 16);
+    auto mesh = Mesh::create(geometry, MeshBasicMaterial::create());
+    mesh->updateMatrixWorld();
+
+    auto& bvh = geometry->computeBoundsTree();
+    CHECK_FALSE(bvh.stale());
+
+    geometry->translate(0, 0, -5);
+    geometry->computeBoundingSphere();
+    CHECK(bvh.stale());
+
+    // the stale tree is skipped rather than refitted by the query
+    Raycaster raycaster({0.1f, 0.2f, 0}, {0, 0, -1});
+    const auto intersects = raycaster.intersectObject(mesh.get());
+
+    REQUIRE(!intersects.empty());
+    CHECK(intersects.front().distance == Approx(4).margin(0.05));
+    CHECK(bvh.stale());
+
+    CHECK(bvh.update());
+    CHECK_FALSE(bvh.stale());
+
+    const auto accelerated = raycaster.intersectObject(mesh.get());
+    REQUIRE(accelerated.size() == intersects.size());
+    CHECK(accelerated.front().distance == Approx(intersects.front().distance));
+    CHECK(accelerated.front().faceIndex == intersects.front().faceIndex);
+}
@@ -3,6 +3,8 @@
 #include <catch2/catch.hpp>
 
 #include "threepp/core/Object3D.hpp"
+#include "threepp/helpers/PointLightHelper.hpp"
+#include "threepp/lights/PointLight.hpp"
 #include "threepp/math/Euler.hpp"
 #include "threepp/math/MathUtils.hpp"
 #include "threepp/math/Matrix3.hpp"
@@ -115,6 +117,63 @@ TEST_CASE("lookAt") {
     REQUIRE(obj->rotation.x * math::RAD2DEG == Approx(45));
 }
 
+TEST_CASE("rotation and quaternion stay in sync") {
+
+    const float eps = 0.0001f;
+
+    auto obj = Object3D::create();
+
+    obj->rotation.y = math::PI / 2;
+    obj->rotation.x += math::PI / 4;
+
+    auto expected = Quaternion().setFromEuler(Euler(math::PI / 4, math::PI / 2, 0));
+    REQUIRE(obj->quaternion.x() == Approx(expected.x()).margin(eps));
+    REQUIRE(obj->quaternion.y() == Approx(expected.y()).margin(eps));
+    REQUIRE(obj->quaternion.z() == Approx(expected.z()).margin(eps));
+    REQUIRE(obj->quaternion.w() == Approx(expected.w()).margin(eps));
+
+    obj->quaternion.setFromAxisAngle(Vector3(0, 0, 1), math::PI / 3);
+    REQUIRE(obj->rotation.x() == Approx(0).margin(eps));
+    REQUIRE(obj->rotation.y() == Approx(0).margin(eps));
+    REQUIRE(obj->rotation.z() == Approx(math::PI / 3).margin(eps));
+
+    // a single component written while the other side is the current one
+    obj->quaternion.setFromAxisAngle(Vector3(1, 0, 0), math::PI / 6);
+    obj->rotation.z = math::PI / 2;
+    expected.setFromEuler(Euler(math::PI / 6, 0, math::PI / 2));
+    REQUIRE(obj->quaternion.x() == Approx(expected.x()).margin(eps));
+    REQUIRE(obj->quaternion.z() == Approx(expected.z()).margin(eps));
+    REQUIRE(obj->quaternion.w() == Approx(expected.w()).margin(eps));
+
+    obj->rotation.setOrder(Euler::ZYX);
+    expected.setFromEuler(Euler(math::PI / 6, 0, math::PI / 2, Euler::ZYX));
+    REQUIRE(obj->quaternion.x() == Approx(expected.x()).margin(eps));
+    REQUIRE(obj->quaternion.y() == Approx(expected.y()).margin(eps));
+
+    // copies are plain values
+    auto copy = obj->quaternion;
+    copy.set(0, 0, 0, 1);
+    REQUIRE(obj->quaternion.w() == Approx(expected.w()).margin(eps));
+    REQUIRE(obj->rotation.x() == Approx(math::PI / 6).margin(eps));
+
+    obj->updateMatrix();
+    Matrix4 m;
+    m.makeRotationFromEuler(obj->rotation);
+    for (int i = 0; i < 12; i++) {
+        REQUIRE(obj->matrix.elements[i] == Approx(m.elements[i]).margin(eps));
+    }
+}
+
+TEST_CASE("uuid") {
+
+    auto a = Object3D::create();
+    auto b = Object3D::create();
+
+    REQUIRE(a->uuid().size() == 36);
+    REQUIRE(a->uuid() == a->uuid());
+    REQUIRE(a->uuid() != b->uuid());
+}
+
 TEST_CASE("getWorldPosition") {
 
     float x = 1;
@@ -172,25 +231,25 @@ TEST_CASE("updateMatrixWorld") {
 
     parent->updateMatrixWorld();
 
-    REQUIRE(parent->matrix->elements == std::array<float, 16>{
+    REQUIRE(parent->matrix.elements == std::array<float, 16>{
                                                 1, 0, 0, 0,
                                                 0, 1, 0, 0,
                                                 0, 0, 1, 0,
                                                 1, 2, 3, 1});
 
-    REQUIRE(parent->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(parent->matrixWorld.elements == std::array<float, 16>{
                                                      1, 0, 0, 0,
                                                      0, 1, 0, 0,
                                                      0, 0, 1, 0,
                                                      1, 2, 3, 1});
 
-    REQUIRE(child->matrix->elements == std::array<float, 16>{
+    REQUIRE(child->matrix.elements == std::array<float, 16>{
                                                1, 0, 0, 0,
                                                0, 1, 0, 0,
                                                0, 0, 1, 0,
                                                4, 5, 6, 1});
 
-    REQUIRE(child->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(child->matrixWorld.elements == std::array<float, 16>{
                                                     1, 0, 0, 0,
                                                     0, 1, 0, 0,
                                                     0, 0, 1, 0,
@@ -203,7 +262,7 @@ TEST_CASE("updateMatrixWorld") {
     parent->position.set(0, 0, 0);
     parent->updateMatrix();
 
-    REQUIRE(parent->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(parent->matrixWorld.elements == std::array<float, 16>{
                                                      1, 0, 0, 0,
                                                      0, 1, 0, 0,
                                                      0, 0, 1, 0,
@@ -220,19 +279,19 @@ TEST_CASE("updateMatrixWorld") {
     child->matrixAutoUpdate = false;
     parent->updateMatrixWorld();
 
-    REQUIRE(parent->matrix->elements == std::array<float, 16>{
+    REQUIRE(parent->matrix.elements == std::array<float, 16>{
                                                 1, 0, 0, 0,
                                                 0, 1, 0, 0,
                                                 0, 0, 1, 0,
                                                 0, 0, 0, 1});
 
-    REQUIRE(parent->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(parent->matrixWorld.elements == std::array<float, 16>{
                                                      1, 0, 0, 0,
                                                      0, 1, 0, 0,
                                                      0, 0, 1, 0,
                                                      0, 0, 0, 1});
 
-    REQUIRE(child->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(child->matrixWorld.elements == std::array<float, 16>{
                                                     1, 0, 0, 0,
                                                     0, 1, 0, 0,
                                                     0, 0, 1, 0,
@@ -246,7 +305,7 @@ TEST_CASE("updateMatrixWorld") {
 
     parent->updateMatrixWorld();
 
-    REQUIRE(child->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(child->matrixWorld.elements == std::array<float, 16>{
                                                     1, 0, 0, 0,
                                                     0, 1, 0, 0,
                                                     0, 0, 1, 0,
@@ -260,7 +319,7 @@ TEST_CASE("updateMatrixWorld") {
     parent->matrixAutoUpdate = true;
     parent->updateMatrixWorld();
 
-    REQUIRE(child->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(child->matrixWorld.elements == std::array<float, 16>{
                                                     1, 0, 0, 0,
                                                     0, 1, 0, 0,
                                                     0, 0, 1, 0,
@@ -280,7 +339,7 @@ TEST_CASE("updateMatrixWorld") {
 
     parent->updateMatrixWorld(true);
 
-    REQUIRE(parent->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(parent->matrixWorld.elements == std::array<float, 16>{
                                                      1, 0, 0, 0,
                                                      0, 1, 0, 0,
                                                      0, 0, 1, 0,
@@ -300,15 +359,15 @@ TEST_CASE("updateMatrixWorld") {
 
     child->updateMatrixWorld();
 
-    REQUIRE(parent->matrix->elements == std::array<float, 16>{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1});
+    REQUIRE(parent->matrix.elements == std::array<float, 16>{1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1});
 
-    REQUIRE(parent->matrixWorld->elements == std::array<float, 16>{
+    REQUIRE(parent->matrixWorld.elements == std::array<float, 16>{
                                                      1, 0, 0, 0,
                                                      0, 1, 0, 0,
                                                      0, 0, 1, 0,
                                                      0, 0, 0, 1});
 
-    REQUIRE(child->matrixWorld->elements == std::array<float, 16>{1, 0, 0, 0,
+    REQUIRE(child->matrixWorld.elements == std::array<float, 16>{1, 0, 0, 0,
                                                                   0, 1, 0, 0,
                                                                   0, 0, 1, 0,
                                                                   4, 5, 6, 1});
@@ -334,88 +393,188 @@ TEST_CASE("updateWorldMatrix") {
 
     object->updateWorldMatrix();
 
-    REQUIRE(parent->matrix->elements == m.elements);
+    REQUIRE(parent->matrix.elements == m.elements);
 
-    REQUIRE(parent->matrixWorld->elements == m.elements);
+    REQUIRE(parent->matrixWorld.elements == m.elements);
 
-    REQUIRE(object->matrix->elements == m.setPosition(object->position).elements);
+    REQUIRE(object->matrix.elements == m.setPosition(object->position).elements);
 
-    REQUIRE(object->matrixWorld->elements == m.setPosition(object->position).elements);
+    REQUIRE(object->matrixWorld.elements == m.setPosition(object->position).elements);
 
-    REQUIRE(child->matrix->elements == m.identity().elements);
+    REQUIRE(child->matrix.elements == m.identity().elements);
 
-    REQUIRE(child->matrixWorld->elements == m.elements);
+    REQUIRE(child->matrixWorld.elements == m.elements);
 
     // Update the world matrices of an object and its parents
 
-    object->matrix->identity();
-    object->matrixWorld->identity();
+    object->matrix.identity();
+    object->matrixWorld.identity();
 
     object->updateWorldMatrix(true, false);
 
-    REQUIRE(parent->matrix->elements == m.setPosition(parent->position).elements);
+    REQUIRE(parent->matrix.elements == m.setPosition(parent->position).elements);
 
-    REQUIRE(parent->matrixWorld->elements == m.setPosition(parent->position).elements);
+    REQUIRE(parent->matrixWorld.elements == m.setPosition(parent->position).elements);
 
-    REQUIRE(object->matrix->elements == m.setPosition(object->position).elements);
+    REQUIRE(object->matrix.elements == m.setPosition(object->position).elements);
 
-    REQUIRE(object->matrixWorld->elements == m.setPosition(v.copy(parent->position).add(object->position)).elements);
+    REQUIRE(object->matrixWorld.elements == m.setPosition(v.copy(parent->position).add(object->position)).elements);
 
-    REQUIRE(child->matrix->elements == m.identity().elements);
+    REQUIRE(child->matrix.elements == m.identity().elements);
 
-    REQUIRE(child->matrixWorld->elements == m.identity().elements);
+    REQUIRE(child->matrixWorld.elements == m.identity().elements);
 
     // Update the world matrices of an object and its children
 
-    parent->matrix->identity();
-    parent->matrixWorld->identity();
-    object->matrix->identity();
-    object->matrixWorld->identity();
+    parent->matrix.identity();
+    parent->matrixWorld.identity();
+    object->matrix.identity();
+    object->matrixWorld.identity();
 
     object->updateWorldMatrix(false, true);
 
-    REQUIRE(parent->matrix->elements == m.elements);
+    REQUIRE(parent->matrix.elements == m.elements);
 
-    REQUIRE(parent->matrixWorld->elements == m.elements);
+    REQUIRE(parent->matrixWorld.elements == m.elements);
 
-    REQUIRE(object->matrix->elements == m.setPosition(object->position).elements);
+    REQUIRE(object->matrix.elements == m.setPosition(object->position).elements);
 
-    REQUIRE(object->matrixWorld->elements == m.setPosition(object->position).elements);
+    REQUIRE(object->matrixWorld.elements == m.setPosition(object->position).elements);
 
-    REQUIRE(child->matrix->elements == m.setPosition(child->position).elements);
+    REQUIRE(child->matrix.elements == m.setPosition(child->position).elements);
 
-    REQUIRE(child->matrixWorld->elements == m.setPosition(v.copy(object->position).add(child->position)).elements);
+    REQUIRE(child->matrixWorld.elements == m.setPosition(v.copy(object->position).add(child->position)).elements);
 
     // Update the world matrices of an object and its parents and children
 
-    object->matrix->identity();
-    object->matrixWorld->identity();
-    child->matrix->identity();
-    child->matrixWorld->identity();
+    object->matrix.identity();
+    object->matrixWorld.identity();
+    child->matrix.identity();
+    child->matrixWorld.identity();
 
     object->updateWorldMatrix(true, true);
 
-    REQUIRE(parent->matrix->elements == m.setPosition(parent->position).elements);
+    REQUIRE(parent->matrix.elements == m.setPosition(parent->position).elements);
 
-    REQUIRE(parent->matrixWorld->elements == m.setPosition(parent->position).elements);
+    REQUIRE(parent->matrixWorld.elements == m.setPosition(parent->position).elements);
 
-    REQUIRE(object->matrix->elements == m.setPosition(object->position).elements);
+    REQUIRE(object->matrix.elements == m.setPosition(object->position).elements);
 
-    REQUIRE(object->matrixWorld->elements == m.setPosition(v.copy(parent->position).add(object->position)).elements);
+    REQUIRE(object->matrixWorld.elements == m.setPosition(v.copy(parent->position).add(object->position)).elements);
 
-    REQUIRE(child->matrix->elements == m.setPosition(child->position).elements);
+    REQUIRE(child->matrix.elements == m.setPosition(child->position).elements);
 
-    REQUIRE(child->matrixWorld->elements == m.setPosition(v.copy(parent->position).add(object->position).add(child->position)).elements);
+    REQUIRE(child->matrixWorld.elements == m.setPosition(v.copy(parent->position).add(object->position).add(child->position)).elements);
 
     // object->matrixAutoUpdate = false test
 
-    object->matrix->identity();
-    object->matrixWorld->identity();
+    object->matrix.identity();
+    object->matrixWorld.identity();
 
     object->matrixAutoUpdate = false;
     object->updateWorldMatrix(true, false);
 
-    REQUIRE(object->matrix->elements == m.identity().elements);
+    REQUIRE(object->matrix.elements == m.identity().elements);
+
+    REQUIRE(object->matrixWorld.elements == m.setPosition(parent->position).elements);
+}
+
+TEST_CASE("updateMatrixWorldIncremental") {
+
+    // two identical trees, one updated serially and one incrementally
+
+    auto serial = Object3D::create();
+    auto incremental = Object3D::create();
+
+    std::vector<Object3D*> serialNodes{serial.get()};
+    std::vector<Object3D*> incrementalNodes{incremental.get()};
+
+    for (int i = 0; i < 5000; i++) {
+
+        const auto parentIndex = math::randomInRange(0, static_cast<int>(serialNodes.size()) - 1);
+
+        auto a = Object3D::create();
+        auto b = Object3D::create();
+        serialNodes[parentIndex]->add(a);
+        incrementalNodes[parentIndex]->add(b);
+        serialNodes.emplace_back(a.get());
+        incrementalNodes.emplace_back(b.get());
+    }
+
+    for (int frame = 0; frame < 5; frame++) {
+
+        for (int i = 0; i < 500; i++) {
+
+            const auto index = math::randomInRange(0, static_cast<int>(serialNodes.size()) - 1);
+            const Vector3 position(math::random(), math::random(), math::random());
+            const float angle = math::random();
+
+            for (auto nodes : {&serialNodes, &incrementalNodes}) {
+                auto node = (*nodes)[index];
+                node->position.copy(position);
+                node->rotation.y = angle;
+                node->scale.x = 1 + angle;
+            }
+        }
+
+        serial->updateMatrixWorld();
+        incremental->updateMatrixWorldIncremental();
+
+        for (unsigned i = 0; i < serialNodes.size(); i++) {
+
+            REQUIRE(serialNodes[i]->matrixWorld.elements == incrementalNodes[i]->matrixWorld.elements);
+        }
+    }
+
+    // re-parenting must refresh the world matrix even if the local transform is unchanged
+
+    serialNodes[1]->position.set(10, 0, 0);
+    incrementalNodes[1]->position.set(10, 0, 0);
+    for (auto nodes : {&serialNodes, &incrementalNodes}) {
+
+        auto leaf = nodes->back();// the last node created has no children
+        for (auto child : leaf->parent->children) {
+            if (child.get() == leaf) {
+                (*nodes)[1]->add(child);
+                break;
+            }
+        }
+    }
+
+    serial->updateMatrixWorld();
+    incremental->updateMatrixWorldIncremental();
+
+    for (unsigned i = 0; i < serialNodes.size(); i++) {
+
+        REQUIRE(serialNodes[i]->matrixWorld.elements == incrementalNodes[i]->matrixWorld.elements);
+    }
+}
+
+TEST_CASE("updateMatrixWorldIncremental helpers follow their light") {
+
+    // large enough for the children to be updated in parallel batches, the helper before the light
+    auto root = Object3D::create();
+    auto light = PointLight::create();
+    auto helper = PointLightHelper::create(light, 1);
+    root->add(helper);
+
+    for (int i = 0; i < 3000; i++) {
+
+        root->add(Object3D::create());
+    }
+
+    auto group = Object3D::create();
+    group->position.set(0, 2, 0);
+    group->add(light);
+    root->add(group);
+
+    root->updateMatrixWorldIncremental();
+    root->updateMatrixWorldIncremental();
+
+    light->position.set(5, 0, 0);
+    root->updateMatrixWorldIncremental();
 
-    REQUIRE(object->matrixWorld->elements == m.setPosition(parent->position).elements);
+    REQUIRE(helper->matrixWorld.elements == light->matrixWorld.elements);
+    CHECK(helper->matrixWorld.elements[12] == Approx(5));
+    CHECK(helper->matrixWorld.elements[13] == Approx(2));
 }
@@ -0,0 +1,101 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/core/ResourceSlot.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/renderers/gl/GLProperties.hpp"
+
+#include <memory>
+
+using namespace threepp;
+
+TEST_CASE("Slots are unique while alive") {
+
+    ResourceSlot a(ResourceKind::Texture);
+    ResourceSlot b(ResourceKind::Texture);
+    ResourceSlot c(ResourceKind::Material);
+
+    CHECK(a.handle() != b.handle());
+    CHECK(a.handle().generation != 0);
+    CHECK(c.kind() == ResourceKind::Material);
+    CHECK(ResourceSlot::count(ResourceKind::Texture) >= 2);
+}
+
+TEST_CASE("Released slots are reused with a new generation") {
+
+    auto first = std::make_unique<ResourceSlot>(ResourceKind::Geometry);
+    const auto old = first->handle();
+    first.reset();
+
+    ResourceSlot second(ResourceKind::Geometry);
+    CHECK(second.index() == old.index);
+    CHECK(second.handle().generation != old.generation);
+}
+
+TEST_CASE("Copies acquire their own slot") {
+
+    ResourceSlot a(ResourceKind::RenderTarget);
+    ResourceSlot b(a);
+    CHECK(a.handle() != b.handle());
+    CHECK(b.kind() == a.kind());
+}
+
+TEST_CASE("Cloned resources get their own slot") {
+
+    auto material = MeshBasicMaterial::create();
+    auto materialClone = material->clone();
+    CHECK(materialClone->slot.handle() != material->slot.handle());
+
+    auto geometry = BoxGeometry::create();
+    auto geometryClone = geometry->clone();
+    CHECK(geometryClone->slot.handle() != geometry->slot.handle());
+}
+
+TEST_CASE("GLTypeProperties drops state of previous slot owners") {
+
+    struct Value {
+        int value = 0;
+    };
+
+    gl::GLTypeProperties<Value> properties;
+
+    auto first = std::make_unique<ResourceSlot>(ResourceKind::Material);
+    properties.get(*first)->value = 42;
+    CHECK(properties.get(*first)->value == 42);
+    first.reset();
+
+    ResourceSlot second(ResourceKind::Material);
+    CHECK(properties.get(second)->value == 0);
+
+    properties.get(second)->value = 7;
+    properties.remove(second);
+    CHECK(properties.get(second)->value == 0);
+}
+
+TEST_CASE("GLTypeProperties entries keep their address") {
+
+    struct Value {
+        int value = 0;
+    };
+
+    gl::GLTypeProperties<Value> properties;
+
+    ResourceSlot slot(ResourceKind::Texture);
+    auto entry = properties.get(slot);
+    entry->value = 1;
+
+    std::vector<std::unique_ptr<ResourceSlot>> others;
+    for (int i = 0; i < 1000; i++) {
+
+        others.emplace_back(std::make_unique<ResourceSlot>(ResourceKind::Texture));
+        properties.get(*others.back())->value = i;
+    }
+
+    CHECK(properties.get(slot) == entry);
+    CHECK(entry->value == 1);
+
+    int count = 0;
+    properties.forEach([&](Value&) { ++count; });
+    CHECK(count == 1001);
+}
@@ -0,0 +1,290 @@
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/core/Object3D.hpp"
+#include "threepp/core/TransformSystem.hpp"
+#include "threepp/helpers/PointLightHelper.hpp"
+#include "threepp/lights/PointLight.hpp"
+#include "threepp/math/MathUtils.hpp"
+
+#include <vector>
+
+using namespace threepp;
+
+namespace {
+
+    // tree of `count` objects below root with random transforms, branching of at most 4
+    std::vector<std::shared_ptr<Object3D>> createTree(Object3D& root, size_t count) {
+
+        std::vector<std::shared_ptr<Object3D>> nodes;
+        for (size_t i = 0; i < count; i++) {
+
+            auto node = Object3D::create();
+            node->position.set(math::randomInRange(-5.f, 5.f), math::randomInRange(-5.f, 5.f), math::randomInRange(-5.f, 5.f));
+            node->rotation.set(math::randomInRange(-2.f, 2.f), math::randomInRange(-2.f, 2.f), math::randomInRange(-2.f, 2.f));
+            node->scale.setScalar(math::randomInRange(0.5f, 2.f));
+
+            Object3D& parent = i == 0 ? root : *nodes[math::randomInRange(0, static_cast<int>(i - 1) / 4)];
+            parent.add(node);
+            nodes.emplace_back(node);
+        }
+
+        return nodes;
+    }
+
+    // all objects below root, depth first
+    void collect(const Object3D& root, std::vector<std::shared_ptr<Object3D>>& nodes) {
+
+        for (const auto& child : root.children) {
+
+            nodes.emplace_back(child);
+            collect(*child, nodes);
+        }
+    }
+
+    void checkClose(const Matrix4& actual, const Matrix4& expected) {
+
+        for (unsigned i = 0; i < 16; i++) {
+
+            REQUIRE(actual.elements[i] == Approx(expected.elements[i]).margin(1e-4));
+        }
+    }
+
+    // world matrices as computed by updateMatrixWorld
+    std::vector<Matrix4> expectedWorlds(Object3D& root, const std::vector<std::shared_ptr<Object3D>>& nodes) {
+
+        root.updateMatrixWorld(true);
+
+        std::vector<Matrix4> worlds;
+        for (const auto& node : nodes) worlds.emplace_back(node->matrixWorld);
+
+        return worlds;
+    }
+
+    void checkWorlds(const TransformSystem& transforms, const std::vector<std::shared_ptr<Object3D>>& nodes, const std::vector<Matrix4>& expected) {
+
+        for (size_t i = 0; i < nodes.size(); i++) {
+
+            checkClose(nodes[i]->matrixWorld, expected[i]);
+            checkClose(transforms.matrixWorld(transforms.handle(*nodes[i])), expected[i]);
+        }
+    }
+
+}// namespace
+
+TEST_CASE("matches updateMatrixWorld") {
+
+    Object3D root;
+    root.position.set(1, 2, 3);
+    auto nodes = createTree(root, 2000);
+
+    const auto expected = expectedWorlds(root, nodes);
+
+    for (const auto& node : nodes) node->matrixWorld.identity();
+
+    TransformSystem transforms(root);
+    transforms.update();
+
+    CHECK(transforms.size() == nodes.size() + 1);
+    CHECK(transforms.updatedCount() == nodes.size() + 1);
+    checkWorlds(transforms, nodes, expected);
+}
+
+TEST_CASE("parents come before their children") {
+
+    Object3D root;
+    createTree(root, 500);
+
+    TransformSystem transforms(root);
+
+    const auto& offsets = transforms.levelOffsets();
+    REQUIRE(offsets.front() == 0);
+    REQUIRE(offsets.back() == transforms.size());
+    CHECK(transforms.parent(0) == TransformSystem::invalidHandle);
+    CHECK(&transforms.object(0) == &root);
+
+    for (size_t level = 1; level + 1 < offsets.size(); level++) {
+
+        for (auto h = offsets[level]; h < offsets[level + 1]; h++) {
+
+            const auto parent = transforms.parent(h);
+            CHECK(parent >= offsets[level - 1]);
+            CHECK(parent < offsets[level]);
+            CHECK(transforms.object(h).parent == &transforms.object(parent));
+            CHECK(transforms.handle(transforms.object(h)) == h);
+        }
+    }
+}
+
+TEST_CASE("only changed transforms are recomputed") {
+
+    Object3D root;
+    auto nodes = createTree(root, 100);
+
+    TransformSystem transforms(root);
+    transforms.update();
+
+    transforms.update();
+    CHECK(transforms.updatedCount() == 0);
+
+    // a leaf, then the first child of root with everything below it
+    Object3D* leaf = nullptr;
+    for (const auto& node : nodes) {
+
+        if (node->children.empty()) leaf = node.get();
+    }
+    REQUIRE(leaf);
+
+    leaf->position.x += 1;
+    transforms.update();
+    CHECK(transforms.updatedCount() == 1);
+
+    size_t subtree = 0;
+    nodes.front()->traverse([&](Object3D&) { ++subtree; });
+
+    nodes.front()->rotation.y += 0.5f;
+    transforms.update();
+    CHECK(transforms.updatedCount() == subtree);
+
+    transforms.update(true);
+    CHECK(transforms.updatedCount() == transforms.size());
+
+    checkWorlds(transforms, nodes, expectedWorlds(root, nodes));
+}
+
+TEST_CASE("hierarchy changes are picked up") {
+
+    Object3D root;
+    auto nodes = createTree(root, 200);
+
+    TransformSystem transforms(root);
+    transforms.update();
+
+    SECTION("add") {
+
+        auto added = Object3D::create();
+        added->position.set(0, 1, 0);
+        nodes.back()->add(added);
+        nodes.emplace_back(added);
+    }
+
+    SECTION("remove") {
+
+        nodes[1]->removeFromParent();
+        REQUIRE(transforms.handle(*nodes[1]) != TransformSystem::invalidHandle);
+
+        transforms.update();
+        CHECK(transforms.handle(*nodes[1]) == TransformSystem::invalidHandle);
+    }
+
+    SECTION("reparent") {
+
+        // the last node is a leaf, moving it below root lifts it to the first level
+        root.add(nodes.back());
+    }
+
+    transforms.update();
+
+    nodes.clear();
+    collect(root, nodes);
+
+    size_t count = 0;
+    root.traverse([&](Object3D&) { ++count; });
+    CHECK(transforms.size() == count);
+
+    const auto actual = transforms.matrixWorlds();
+    const auto expected = expectedWorlds(root, nodes);
+    for (size_t i = 0; i < nodes.size(); i++) {
+
+        checkClose(actual[transforms.handle(*nodes[i])], expected[i]);
+    }
+}
+
+TEST_CASE("matrixAutoUpdate and matrixWorldNeedsUpdate") {
+
+    Object3D root;
+    auto nodes = createTree(root, 50);
+
+    TransformSystem transforms(root);
+    transforms.update();
+
+    auto& manual = *nodes.front();
+    manual.matrixAutoUpdate = false;
+    manual.matrix.makeTranslation(3, 0, 0);
+    manual.position.set(100, 100, 100);// ignored while matrixAutoUpdate is off
+
+    transforms.update();
+    CHECK(manual.matrixWorld.elements[12] == Approx(3));
+    CHECK(manual.position.x == 100);
+
+    manual.matrixWorldNeedsUpdate = true;
+    transforms.update();
+    CHECK(transforms.updatedCount() > 0);
+    CHECK(!manual.matrixWorldNeedsUpdate);
+
+    checkWorlds(transforms, nodes, expectedWorlds(root, nodes));
+}
+
+TEST_CASE("root with a parent") {
+
+    Object3D world;
+    world.position.set(0, 5, 0);
+
+    auto root = Object3D::create();
+    world.add(root);
+    auto nodes = createTree(*root, 50);
+
+    world.updateMatrixWorld(true);
+
+    TransformSystem transforms(*root);
+    transforms.update();
+    checkWorlds(transforms, nodes, expectedWorlds(world, nodes));
+
+    world.position.set(0, -5, 0);
+    world.updateMatrix();
+    world.matrixWorld.copy(world.matrix);
+
+    transforms.update();
+    CHECK(transforms.updatedCount() == transforms.size());
+    checkWorlds(transforms, nodes, expectedWorlds(world, nodes));
+}
+
+TEST_CASE("hooks run as in updateMatrixWorld") {
+
+    Object3D root;
+    auto camera = PerspectiveCamera::create();
+    camera->position.set(1, 2, 3);
+    camera->lookAt(0, 0, 0);
+    root.add(camera);
+
+    TransformSystem transforms(root);
+    transforms.update();
+
+    const auto expected = Matrix4().copy(camera->matrixWorld).invert();
+    checkClose(camera->matrixWorldInverse, expected);
+}
+
+TEST_CASE("helpers follow their light in the same update") {
+
+    Object3D root;
+    auto light = PointLight::create();
+    root.add(light);
+
+    auto helper = PointLightHelper::create(light, 1);
+    root.add(helper);
+
+    TransformSystem transforms(root);
+    transforms.update();
+
+    light->position.set(5, 0, 0);
+    transforms.update();
+
+    CHECK(helper->matrixWorld.elements[12] == Approx(5));
+    checkClose(transforms.matrixWorld(transforms.handle(*helper)), light->matrixWorld);
+
+    std::vector<std::shared_ptr<Object3D>> nodes;
+    collect(root, nodes);
+    checkWorlds(transforms, nodes, expectedWorlds(root, nodes));
+}
@@ -0,0 +1,168 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/loaders/OBJLoader.hpp"
+#include "threepp/objects/LineSegments.hpp"
+#include "threepp/objects/Mesh.hpp"
+
+#include <fstream>
+
+using namespace threepp;
+
+namespace {
+
+    void compareAttributes(BufferGeometry& expected, BufferGeometry& actual, const std::string& name) {
+
+        REQUIRE(expected.hasAttribute(name) == actual.hasAttribute(name));
+        if (!expected.hasAttribute(name)) return;
+
+        const auto& a = expected.getAttribute<float>(name)->array();
+        const auto& b = actual.getAttribute<float>(name)->array();
+
+        REQUIRE(a.size() == b.size());
+        for (unsigned i = 0; i < a.size(); i++) {
+            REQUIRE(a[i] == Approx(b[i]).margin(1e-6));
+        }
+    }
+
+}// namespace
+
+TEST_CASE("fastMode matches the default parser") {
+
+    const std::filesystem::path path = std::string(DATA_FOLDER) + "/models/obj/female02/female02.obj";
+
+    OBJLoader loader;
+    loader.useCache = false;
+
+    auto expected = loader.load(path, false);
+    REQUIRE(expected);
+
+    std::vector<float> progress;
+    loader.fastMode = true;
+    loader.onProgress = [&](float value) { progress.emplace_back(value); };
+
+    auto actual = loader.load(path, false);
+    REQUIRE(actual);
+
+    REQUIRE(expected->children.size() == actual->children.size());
+    for (unsigned i = 0; i < expected->children.size(); i++) {
+
+        auto expectedMesh = expected->children[i]->as<Mesh>();
+        auto actualMesh = actual->children[i]->as<Mesh>();
+
+        CHECK(expectedMesh->name == actualMesh->name);
+        CHECK(expectedMesh->materials().size() == actualMesh->materials().size());
+
+        auto expectedGeometry = expectedMesh->geometry();
+        auto actualGeometry = actualMesh->geometry();
+
+        compareAttributes(*expectedGeometry, *actualGeometry, "position");
+        compareAttributes(*expectedGeometry, *actualGeometry, "normal");
+        compareAttributes(*expectedGeometry, *actualGeometry, "uv");
+
+        const auto& expectedGroups = expectedGeometry->groups;
+        const auto& actualGroups = actualGeometry->groups;
+        REQUIRE(expectedGroups.size() == actualGroups.size());
+        for (unsigned j = 0; j < expectedGroups.size(); j++) {
+            CHECK(expectedGroups[j].start == actualGroups[j].start);
+            CHECK(expectedGroups[j].count == actualGroups[j].count);
+            CHECK(expectedGroups[j].materialIndex == actualGroups[j].materialIndex);
+        }
+    }
+
+    REQUIRE(!progress.empty());
+    CHECK(std::is_sorted(progress.begin(), progress.end()));
+    CHECK(progress.back() == 1.f);
+}
+
+TEST_CASE("fastMode polygons, negative indices and colors") {
+
+    const auto path = std::filesystem::temp_directory_path() / "threepp_objloader_test.obj";
+    {
+        std::ofstream out(path);
+        out << "# quad\r\n"
+            << "o quad\r\n"
+            << "v 0 0 0 1 0 0\r\n"
+            << "v 1 0 0 0 1 0\r\n"
+            << "v 1 1 0 0 0 1\r\n"
+            << "v 0 1 0 1 1 1\r\n"
+            << "vt 0 0\r\n"
+            << "  vt 1 0\r\n"
+            << "vt 1 1\r\n"
+            << "vt 0 1\r\n"
+            << "f -4/-4 -3/-3 -2/-2 -1/-1\r\n";
+    }
+
+    OBJLoader loader;
+    loader.useCache = false;
+    loader.fastMode = true;
+
+    auto group = loader.load(path, false);
+    std::filesystem::remove(path);
+
+    REQUIRE(group);
+    REQUIRE(group->children.size() == 1);
+
+    auto geometry = group->children.front()->as<Mesh>()->geometry();
+    CHECK(group->children.front()->name == "quad");
+    CHECK_FALSE(geometry->hasAttribute("normal"));
+
+    const auto& position = geometry->getAttribute<float>("position")->array();
+    const auto& uv = geometry->getAttribute<float>("uv")->array();
+    const auto& color = geometry->getAttribute<float>("color")->array();
+
+    CHECK(position == std::vector<float>{0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0});
+    CHECK(uv == std::vector<float>{0, 0, 1, 0, 1, 1, 0, 0, 1, 1, 0, 1});
+    CHECK(color == std::vector<float>{1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1});
+}
+
+TEST_CASE("fastMode rejects malformed lines") {
+
+    const auto path = std::filesystem::temp_directory_path() / "threepp_objloader_malformed.obj";
+    {
+        std::ofstream out(path);
+        out << "v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1 2 4\n";
+    }
+
+    OBJLoader loader;
+    loader.useCache = false;
+    loader.fastMode = true;
+
+    CHECK_THROWS_AS(loader.load(path, false), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("line elements") {
+
+    const auto path = std::filesystem::temp_directory_path() / "threepp_objloader_lines.obj";
+    {
+        std::ofstream out(path);
+        out << "o polyline\n"
+            << "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+            << "vt 0 0\nvt 1 0\nvt 1 1\n"
+            << "l 1/1 2/2 -1/-1\n";
+    }
+
+    OBJLoader loader;
+    loader.useCache = false;
+
+    for (const bool fastMode : {false, true}) {
+
+        loader.fastMode = fastMode;
+        auto group = loader.load(path, false);
+
+        REQUIRE(group);
+        REQUIRE(group->children.size() == 1);
+
+        auto lines = group->children.front()->as<LineSegments>();
+        REQUIRE(lines);
+        CHECK(lines->name == "polyline");
+
+        // the polyline is split into segments between consecutive vertices
+        auto geometry = lines->geometry();
+        CHECK(geometry->getAttribute<float>("position")->array() == std::vector<float>{0, 0, 0, 1, 0, 0, 1, 0, 0, 1, 1, 0});
+        CHECK(geometry->getAttribute<float>("uv")->array() == std::vector<float>{0, 0, 1, 0, 1, 0, 1, 1});
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,113 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/loaders/STLLoader.hpp"
+
+#include <fstream>
+
+using namespace threepp;
+
+namespace {
+
+    const std::filesystem::path binaryPath = std::string(DATA_FOLDER) + "/models/stl/pr2_head_pan.stl";
+
+}// namespace
+
+TEST_CASE("binary") {
+
+    std::ifstream in(binaryPath, std::ios::binary);
+    in.seekg(80);
+    uint32_t faces;
+    in.read(reinterpret_cast<char*>(&faces), sizeof(uint32_t));
+
+    STLLoader loader;
+    auto geometry = loader.load(binaryPath);
+    REQUIRE(geometry);
+
+    auto& position = geometry->getAttribute<float>("position")->array();
+    auto& normal = geometry->getAttribute<float>("normal")->array();
+
+    REQUIRE(position.size() == faces * 9);
+    REQUIRE(normal.size() == faces * 9);
+    CHECK_FALSE(geometry->hasIndex());
+
+    for (uint32_t face = 0; face < faces; face++) {
+
+        float record[12];
+        in.seekg(84 + face * 50);
+        in.read(reinterpret_cast<char*>(record), sizeof(record));
+
+        for (int i = 0; i < 3; i++) {
+            for (int c = 0; c < 3; c++) {
+                REQUIRE(normal[face * 9 + i * 3 + c] == record[c]);
+                REQUIRE(position[face * 9 + i * 3 + c] == record[3 + i * 3 + c]);
+            }
+        }
+    }
+}
+
+TEST_CASE("ascii") {
+
+    const auto path = std::filesystem::temp_directory_path() / "threepp_stlloader_test.stl";
+    {
+        std::ofstream out(path);
+        out << "solid my part\r\n"
+            << "  facet normal 0 0 1\r\n"
+            << "    outer loop\r\n"
+            << "      vertex 0 0 0\r\n"
+            << "      vertex 1 0 0\r\n"
+            << "      vertex 1 1 0\r\n"
+            << "    endloop\r\n"
+            << "  endfacet\r\n"
+            << "  facet normal 0 0 1\n"
+            << "    outer loop\n"
+            << "      vertex 0 0 0\n"
+            << "      vertex 1 1 0\n"
+            << "      vertex 0 1.0e0 0\n"
+            << "    endloop\n"
+            << "  endfacet\n"
+            << "endsolid my part\n";
+    }
+
+    STLLoader loader;
+    auto geometry = loader.load(path);
+    REQUIRE(geometry);
+
+    CHECK(geometry->getAttribute<float>("position")->array() == std::vector<float>{0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0, 1, 0});
+    CHECK(geometry->getAttribute<float>("normal")->array() == std::vector<float>{0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1, 0, 0, 1});
+
+    loader.weldVertices = true;
+    geometry = loader.load(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(geometry);
+    CHECK(geometry->getAttribute<float>("position")->count() == 4);
+    CHECK(geometry->getIndex()->array() == std::vector<unsigned int>{0, 1, 2, 0, 2, 3});
+}
+
+TEST_CASE("weldVertices preserves triangles") {
+
+    STLLoader loader;
+    auto expected = loader.load(binaryPath);
+
+    loader.weldVertices = true;
+    auto welded = loader.load(binaryPath);
+
+    REQUIRE(welded->hasIndex());
+
+    auto& index = welded->getIndex()->array();
+    auto& position = welded->getAttribute<float>("position")->array();
+    auto& normal = welded->getAttribute<float>("normal")->array();
+    auto& expectedPosition = expected->getAttribute<float>("position")->array();
+    auto& expectedNormal = expected->getAttribute<float>("normal")->array();
+
+    REQUIRE(index.size() * 3 == expectedPosition.size());
+    CHECK(position.size() < expectedPosition.size());
+
+    for (size_t i = 0; i < index.size(); i++) {
+        for (int c = 0; c < 3; c++) {
+            REQUIRE(position[index[i] * 3 + c] == expectedPosition[i * 3 + c]);
+            REQUIRE(normal[index[i] * 3 + c] == expectedNormal[i * 3 + c]);
+        }
+    }
+}
@@ -0,0 +1,326 @@
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/Matrix3.hpp"
+#include "threepp/math/Matrix4.hpp"
+#include "threepp/math/Quaternion.hpp"
+#include "threepp/math/SimdKernels.hpp"
+#include "threepp/math/Sphere.hpp"
+#include "threepp/math/Vector3.hpp"
+
+#include <cmath>
+#include <functional>
+#include <random>
+
+using namespace threepp;
+
+namespace {
+
+    // every set the build and CPU support, compared against Scalar
+    std::vector<simd::InstructionSet> supportedSets() {
+
+        std::vector<simd::InstructionSet> sets;
+        for (auto set : {simd::InstructionSet::SSE, simd::InstructionSet::AVX2, simd::InstructionSet::NEON}) {
+
+            simd::setInstructionSet(set);
+            if (simd::instructionSet() == set) sets.emplace_back(set);
+        }
+
+        simd::setInstructionSet(simd::detectInstructionSet());
+
+        return sets;
+    }
+
+    // runs f with the given set selected
+    template<class F>
+    auto with(simd::InstructionSet set, F&& f) {
+
+        simd::setInstructionSet(set);
+        auto result = f();
+        simd::setInstructionSet(simd::detectInstructionSet());
+
+        return result;
+    }
+
+    // every test case draws from its own generator with a fixed seed, so failures reproduce
+    std::mt19937 generator() {
+
+        return std::mt19937(42);
+    }
+
+    float randomInRange(std::mt19937& rng, float min, float max) {
+
+        return std::uniform_real_distribution<float>(min, max)(rng);
+    }
+
+    Matrix4 randomMatrix(std::mt19937& rng) {
+
+        Matrix4 m;
+        for (auto& e : m.elements) e = randomInRange(rng, -2.f, 2.f);
+
+        return m;
+    }
+
+    Matrix4 randomTransform(std::mt19937& rng) {
+
+        // one draw per statement, the order arguments are evaluated in differs between compilers
+        Vector3 position, scale;
+        position.x = randomInRange(rng, -5.f, 5.f);
+        position.y = randomInRange(rng, -5.f, 5.f);
+        position.z = randomInRange(rng, -5.f, 5.f);
+        const float angle = randomInRange(rng, 0.f, 6.f);
+        scale.x = randomInRange(rng, 0.5f, 2.f);
+        scale.y = randomInRange(rng, 0.5f, 2.f);
+        scale.z = randomInRange(rng, 0.5f, 2.f);
+
+        Matrix4 m;
+        m.compose(position, Quaternion().setFromAxisAngle(Vector3(1, 2, 3).normalize(), angle), scale);
+
+        return m;
+    }
+
+    // vectors stride floats apart, the components beyond x, y and z set to a marker that must survive
+    std::vector<float> randomArray(std::mt19937& rng, size_t count, size_t stride) {
+
+        std::vector<float> array(count * stride, 42.f);
+        for (size_t i = 0; i < count; i++) {
+
+            for (size_t c = 0; c < 3; c++) array[i * stride + c] = randomInRange(rng, -10.f, 10.f);
+        }
+
+        return array;
+    }
+
+    void checkClose(const float* actual, const float* expected, size_t size, float epsilon = 1e-4f) {
+
+        for (size_t i = 0; i < size; i++) {
+
+            if (std::isnan(expected[i])) {
+
+                CHECK(std::isnan(actual[i]));
+
+            } else {
+
+                REQUIRE(actual[i] == Approx(expected[i]).epsilon(epsilon).margin(epsilon));
+            }
+        }
+    }
+
+}// namespace
+
+TEST_CASE("instruction set selection") {
+
+    const auto detected = simd::detectInstructionSet();
+    CHECK(simd::instructionSet() == detected);
+
+    simd::setInstructionSet(simd::InstructionSet::Scalar);
+    CHECK(simd::instructionSet() == simd::InstructionSet::Scalar);
+
+    simd::setInstructionSet(detected);
+    CHECK(simd::instructionSet() == detected);
+
+    CHECK(std::string(simd::name(detected)).size() > 0);
+}
+
+TEST_CASE("matrix kernels match scalar") {
+
+    auto rng = generator();
+
+    for (auto set : supportedSets()) {
+
+        DYNAMIC_SECTION(simd::name(set)) {
+
+            for (int i = 0; i < 100; i++) {
+
+                const auto a = randomMatrix(rng);
+                const auto b = randomMatrix(rng);
+
+                const auto multiply = [&] { return Matrix4().multiplyMatrices(a, b); };
+                const auto expected = with(simd::InstructionSet::Scalar, multiply);
+                const auto actual = with(set, multiply);
+                checkClose(actual.elements.data(), expected.elements.data(), 16);
+
+                // in place, aliasing either operand
+                auto inPlace = a;
+                with(set, [&] { return inPlace.multiply(b); });
+                checkClose(inPlace.elements.data(), expected.elements.data(), 16);
+
+                const auto transform = randomTransform(rng);
+                const auto invert = [&] { return Matrix4().copy(transform).invert(); };
+                const auto expectedInverse = with(simd::InstructionSet::Scalar, invert);
+                const auto inverse = with(set, invert);
+                checkClose(inverse.elements.data(), expectedInverse.elements.data(), 16);
+
+                const auto identity = Matrix4().multiplyMatrices(transform, inverse);
+                checkClose(identity.elements.data(), Matrix4().elements.data(), 16);
+            }
+
+            // singular matrices invert to zeros
+            Matrix4 singular;
+            singular.makeScale(1, 0, 1);
+            with(set, [&] { return singular.invert(); });
+            for (auto e : singular.elements) CHECK(e == 0);
+        }
+    }
+}
+
+TEST_CASE("array kernels match scalar") {
+
+    auto rng = generator();
+
+    const auto transform = randomTransform(rng);
+
+    // points well in front of the camera, near w = 0 the divide magnifies rounding differences
+    Matrix4 projection;
+    projection.makePerspective(-1, 1, 1, -1, 0.1f, 200);
+    projection.multiply(Matrix4().makeTranslation(0, 0, -100)).multiply(transform);
+
+    const auto normalMatrix = Matrix3().getNormalMatrix(transform);
+
+    using Kernel = std::function<void(float*, size_t, size_t)>;
+    const std::vector<std::pair<std::string, Kernel>> kernels{
+            {"applyMatrix4", [&](float* a, size_t n, size_t s) { simd::applyMatrix4(a, n, s, projection.elements.data()); }},
+            {"applyMatrix3", [&](float* a, size_t n, size_t s) { simd::applyMatrix3(a, n, s, normalMatrix.elements.data()); }},
+            {"applyNormalMatrix", [&](float* a, size_t n, size_t s) { simd::applyNormalMatrix(a, n, s, normalMatrix.elements.data()); }},
+            {"transformDirection", [&](float* a, size_t n, size_t s) { simd::transformDirection(a, n, s, transform.elements.data()); }},
+            {"normalize", [&](float* a, size_t n, size_t s) { simd::normalize(a, n, s); }}};
+
+    for (auto set : supportedSets()) {
+
+        // counts around the lane widths exercise the scalar tails
+        for (size_t count : {0, 1, 3, 4, 7, 8, 9, 17, 1001}) {
+
+            for (size_t stride : {3, 4, 5}) {
+
+                const auto source = randomArray(rng, count, stride);
+
+                for (const auto& [name, kernel] : kernels) {
+
+                    INFO(simd::name(set) << " " << name << " count=" << count << " stride=" << stride);
+
+                    auto expected = source;
+                    with(simd::InstructionSet::Scalar, [&] { kernel(expected.data(), count, stride); return 0; });
+
+                    auto actual = source;
+                    with(set, [&] { kernel(actual.data(), count, stride); return 0; });
+
+                    checkClose(actual.data(), expected.data(), actual.size());
+                }
+
+                INFO(simd::name(set) << " computeBounds count=" << count << " stride=" << stride);
+
+                float expectedMin[3], expectedMax[3], min[3], max[3];
+                with(simd::InstructionSet::Scalar, [&] { simd::computeBounds(source.data(), count, stride, expectedMin, expectedMax); return 0; });
+                with(set, [&] { simd::computeBounds(source.data(), count, stride, min, max); return 0; });
+
+                for (int c = 0; c < 3; c++) {
+
+                    CHECK(min[c] == expectedMin[c]);
+                    CHECK(max[c] == expectedMax[c]);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("array kernels match Vector3") {
+
+    auto rng = generator();
+
+    const auto transform = randomTransform(rng);
+    const auto source = randomArray(rng, 37, 3);
+
+    auto array = source;
+    simd::applyMatrix4(array.data(), 37, 3, transform.elements.data());
+
+    for (size_t i = 0; i < 37; i++) {
+
+        Vector3 v;
+        v.fromArray(source, i * 3).applyMatrix4(transform);
+
+        CHECK(array[i * 3] == Approx(v.x).margin(1e-4));
+        CHECK(array[i * 3 + 1] == Approx(v.y).margin(1e-4));
+        CHECK(array[i * 3 + 2] == Approx(v.z).margin(1e-4));
+    }
+}
+
+TEST_CASE("bounds skip NaN and zero vectors normalize as Vector3 does") {
+
+    auto rng = generator();
+
+    for (auto set : supportedSets()) {
+
+        INFO(simd::name(set));
+
+        std::vector<float> array = randomArray(rng, 16, 3);
+        array[4] = NAN;
+        array[30] = NAN;
+
+        float expectedMin[3], expectedMax[3], min[3], max[3];
+        with(simd::InstructionSet::Scalar, [&] { simd::computeBounds(array.data(), 16, 3, expectedMin, expectedMax); return 0; });
+        with(set, [&] { simd::computeBounds(array.data(), 16, 3, min, max); return 0; });
+
+        for (int c = 0; c < 3; c++) {
+
+            CHECK(!std::isnan(min[c]));
+            CHECK(min[c] == expectedMin[c]);
+            CHECK(max[c] == expectedMax[c]);
+        }
+
+        std::vector<float> zeros(8 * 3, 0.f);
+        with(set, [&] { simd::normalize(zeros.data(), 8, 3); return 0; });
+
+        Vector3 zero;
+        zero.normalize();
+        CHECK(std::isnan(zeros[0]) == std::isnan(zero.x));
+    }
+}
+
+TEST_CASE("plane distances match Frustum::intersectsSphere") {
+
+    auto rng = generator();
+
+    Matrix4 projection;
+    projection.makePerspective(-1, 1, 1, -1, 0.1f, 20);
+
+    Frustum frustum;
+    frustum.setFromProjectionMatrix(projection);
+
+    float planes[6][4];
+    for (size_t p = 0; p < 6; p++) {
+
+        const auto& plane = frustum.planes()[p];
+        planes[p][0] = plane.normal.x, planes[p][1] = plane.normal.y, planes[p][2] = plane.normal.z, planes[p][3] = plane.constant;
+    }
+
+    // spheres as center and radius, the radius at least 0.5 so rounding does not flip a sphere touching a plane
+    std::vector<float> source = randomArray(rng, 1001, 4);
+    for (size_t i = 0; i < 1001; i++) {
+
+        source[i * 4 + 2] -= 10;
+        source[i * 4 + 3] = 0.5f + static_cast<float>(i % 7) * 0.25f;
+    }
+
+    for (auto set : {simd::InstructionSet::Scalar, simd::InstructionSet::SSE, simd::InstructionSet::AVX2, simd::InstructionSet::NEON}) {
+
+        INFO(simd::name(set));
+
+        // counts around the lane widths exercise the scalar tails
+        for (size_t count : {0, 1, 7, 9, 1001}) {
+
+            auto array = source;
+            with(set, [&] { simd::planeDistances(array.data(), count, planes[0], 6); return 0; });
+
+            for (size_t i = 0; i < count; i++) {
+
+                const Sphere sphere({source[i * 4], source[i * 4 + 1], source[i * 4 + 2]}, source[i * 4 + 3]);
+                const bool intersects = frustum.intersectsSphere(sphere);
+
+                if (std::abs(array[i * 4 + 3]) > 1e-4f) CHECK((array[i * 4 + 3] >= 0) == intersects);
+                CHECK(array[i * 4] == source[i * 4]);
+            }
+        }
+    }
+}
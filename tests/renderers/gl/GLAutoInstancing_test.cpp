@@ -0,0 +1,150 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/renderers/gl/GLAutoInstancing.hpp"
+
+#include <deque>
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    // meshes and their render items, as pushed to a render list
+    struct Items {
+
+        std::vector<std::shared_ptr<Mesh>> meshes;
+        std::deque<RenderItem> items;
+        std::vector<RenderItem*> list;
+
+        Mesh& add(const std::shared_ptr<BufferGeometry>& geometry, const std::shared_ptr<Material>& material, float x) {
+
+            auto mesh = Mesh::create(geometry, material);
+            mesh->position.x = x;
+            mesh->updateMatrixWorld();
+            meshes.emplace_back(mesh);
+
+            auto& item = items.emplace_back();
+            item.object = mesh.get();
+            item.geometry = geometry.get();
+            item.material = material.get();
+            list.emplace_back(&item);
+
+            return *mesh;
+        }
+    };
+
+    float instanceX(const InstancedMesh& mesh, size_t index) {
+
+        Matrix4 matrix;
+        mesh.getMatrixAt(index, matrix);
+
+        return matrix.elements[12];
+    }
+
+}// namespace
+
+TEST_CASE("batches draws sharing geometry and material") {
+
+    auto geometry = BoxGeometry::create();
+    auto other = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+
+    Items items;
+    items.add(geometry, material, 1);
+    items.add(other, material, 2);
+    items.add(geometry, material, 3);
+    items.add(geometry, material, 4);
+
+    GLAutoInstancing instancing;
+    const auto& result = instancing.batch(items.list, 2, 0, 0);
+
+    // the batch takes the place of its first draw
+    REQUIRE(result.size() == 2);
+    CHECK(result[1] == items.list[1]);
+
+    const auto batch = result[0];
+    REQUIRE(instancing.meshes(0).size() == 1);
+
+    auto& mesh = *instancing.meshes(0).front();
+    CHECK(batch->object == &mesh);
+    CHECK(mesh.geometry() == geometry.get());
+    CHECK(mesh.material() == material.get());
+
+    REQUIRE(mesh.count == 3);
+    CHECK(instanceX(mesh, 0) == 1);
+    CHECK(instanceX(mesh, 1) == 3);
+    CHECK(instanceX(mesh, 2) == 4);
+
+    // below the threshold draws stay single, grouped by key within the run
+    const auto& unbatched = instancing.batch(items.list, 4, 0, 1);
+    const std::vector<RenderItem*> expected{items.list[0], items.list[2], items.list[3], items.list[1]};
+    CHECK(unbatched == expected);
+    CHECK(instancing.meshes(0).empty());
+
+    instancing.dispose();
+}
+
+TEST_CASE("keys separate shadow flags and render order") {
+
+    auto geometry = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+
+    Items items;
+    items.add(geometry, material, 1);
+    items.add(geometry, material, 2);
+    items.add(geometry, material, 3).receiveShadow = true;
+    items.add(geometry, material, 4).receiveShadow = true;
+    items.add(geometry, material, 5).castShadow = true;
+    items.items[4].renderOrder = 1;
+
+    GLAutoInstancing instancing;
+    const auto& result = instancing.batch(items.list, 2, 0, 0);
+
+    REQUIRE(result.size() == 3);
+    CHECK(result[2] == items.list[4]);
+
+    const auto& meshes = instancing.meshes(0);
+    REQUIRE(meshes.size() == 2);
+    CHECK(!meshes[0]->receiveShadow);
+    CHECK(meshes[1]->receiveShadow);
+    CHECK(instanceX(*meshes[1], 0) == 3);
+
+    instancing.dispose();
+}
+
+TEST_CASE("nested batches keep the outer result") {
+
+    auto geometry = BoxGeometry::create();
+    auto material = MeshBasicMaterial::create();
+
+    Items outer;
+    outer.add(geometry, material, 1);
+    outer.add(geometry, material, 2);
+
+    Items inner;
+    inner.add(geometry, material, 10);
+    inner.add(geometry, material, 20);
+    inner.add(geometry, material, 30);
+
+    GLAutoInstancing instancing;
+    const auto& outerResult = instancing.batch(outer.list, 2, 0, 0);
+    const auto outerMesh = instancing.meshes(0).front();
+
+    const auto& innerResult = instancing.batch(inner.list, 2, 1, 0);
+    const auto innerMesh = instancing.meshes(1).front();
+
+    CHECK(&outerResult != &innerResult);
+    CHECK(innerMesh != outerMesh);
+
+    REQUIRE(outerResult.size() == 1);
+    CHECK(outerResult.front()->object == outerMesh);
+    CHECK(outerMesh->count == 2);
+    CHECK(instanceX(*outerMesh, 1) == 2);
+    CHECK(innerMesh->count == 3);
+
+    instancing.dispose();
+}
@@ -0,0 +1,213 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/cameras/PerspectiveCamera.hpp"
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/math/Frustum.hpp"
+#include "threepp/math/MathUtils.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/renderers/gl/GLInstanceCulling.hpp"
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    Frustum cameraFrustum(PerspectiveCamera& camera) {
+
+        camera.updateMatrixWorld();
+
+        Matrix4 projScreenMatrix;
+        projScreenMatrix.multiplyMatrices(camera.projectionMatrix, camera.matrixWorldInverse);
+
+        Frustum frustum;
+        frustum.setFromProjectionMatrix(projScreenMatrix);
+
+        return frustum;
+    }
+
+    Vector3 instancePosition(const InstancedMesh& mesh, size_t index) {
+
+        Matrix4 matrix;
+        mesh.getMatrixAt(index, matrix);
+
+        Vector3 position;
+        return position.setFromMatrixPosition(matrix);
+    }
+
+}// namespace
+
+TEST_CASE("cull instances outside the frustum") {
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 100);
+    const auto frustum = cameraFrustum(*camera);
+
+    auto mesh = InstancedMesh::create(BoxGeometry::create(), MeshBasicMaterial::create(), 4);
+    mesh->perInstanceFrustumCulled = true;
+    mesh->updateMatrixWorld();
+
+    Matrix4 matrix;
+    mesh->setMatrixAt(0, matrix.makeTranslation(0, 0, -10)); // in front
+    mesh->setMatrixAt(1, matrix.makeTranslation(0, 0, 10));  // behind
+    mesh->setMatrixAt(2, matrix.makeTranslation(0, 0, -200));// beyond far
+    mesh->setMatrixAt(3, matrix.makeTranslation(2, 0, -5));   // in front
+
+    mesh->setColorAt(0, Color::red);
+    mesh->setColorAt(3, Color::blue);
+
+    GLInstanceCulling culling;
+    const auto& proxies = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 0);
+
+    REQUIRE(proxies.size() == 1);
+
+    const auto proxy = proxies.front();
+    REQUIRE(proxy->count == 2);
+    CHECK(proxy->geometry() == mesh->geometry());
+    CHECK(proxy->material() == mesh->material());
+
+    // visible instances keep their order
+    CHECK(instancePosition(*proxy, 0).equals(Vector3(0, 0, -10)));
+    CHECK(instancePosition(*proxy, 1).equals(Vector3(2, 0, -5)));
+
+    REQUIRE(proxy->instanceColor);
+    Color color;
+    proxy->getColorAt(1, color);
+    CHECK(color.equals(Color(Color::blue)));
+
+    // the transform of the mesh moves the far instance into view and the others behind the camera
+    mesh->position.z = 150;
+    mesh->updateMatrixWorld();
+
+    const auto& moved = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 1);
+    REQUIRE(moved.size() == 1);
+    CHECK(moved.front()->count == 1);
+    CHECK(instancePosition(*moved.front(), 0).equals(Vector3(0, 0, -200)));
+}
+
+TEST_CASE("nested cull keeps the outer proxies") {
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 100);
+    const auto frustum = cameraFrustum(*camera);
+
+    auto mesh = InstancedMesh::create(BoxGeometry::create(), MeshBasicMaterial::create(), 3);
+    mesh->perInstanceFrustumCulled = true;
+    mesh->updateMatrixWorld();
+
+    Matrix4 matrix;
+    mesh->setMatrixAt(0, matrix.makeTranslation(0, 0, -10));
+    mesh->setMatrixAt(1, matrix.makeTranslation(0, 0, 10));
+    mesh->setMatrixAt(2, matrix.makeTranslation(1, 0, -20));
+
+    GLInstanceCulling culling;
+    const auto& outer = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 0);
+    REQUIRE(outer.size() == 1);
+
+    const auto outerProxy = outer.front();
+    REQUIRE(outerProxy->count == 2);
+
+    // a nested render, e.g. a reflection, culls the same mesh from a camera looking the other way
+    auto mirrored = PerspectiveCamera::create(60, 1, 0.1f, 100);
+    mirrored->rotation.y = math::PI;
+    const auto& inner = culling.cull(*mesh, cameraFrustum(*mirrored), mirrored->position, mirrored->zoom, 1, 0);
+
+    REQUIRE(inner.size() == 1);
+    CHECK(inner.front() != outerProxy);
+    CHECK(inner.front()->count == 1);
+    CHECK(instancePosition(*inner.front(), 0).equals(Vector3(0, 0, 10)));
+
+    REQUIRE(outer.size() == 1);
+    CHECK(outer.front() == outerProxy);
+    CHECK(outerProxy->count == 2);
+    CHECK(instancePosition(*outerProxy, 0).equals(Vector3(0, 0, -10)));
+    CHECK(instancePosition(*outerProxy, 1).equals(Vector3(1, 0, -20)));
+}
+
+TEST_CASE("instance levels") {
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 1000);
+    const auto frustum = cameraFrustum(*camera);
+
+    auto near = BoxGeometry::create();
+    auto far = BoxGeometry::create(1, 1, 1);
+
+    auto mesh = InstancedMesh::create(near, MeshBasicMaterial::create(), 10);
+    mesh->addLevel(far, 50);
+    mesh->updateMatrixWorld();
+
+    REQUIRE(mesh->levels().size() == 1);
+
+    Matrix4 matrix;
+    for (int i = 0; i < 10; i++) {
+
+        mesh->setMatrixAt(i, matrix.makeTranslation(0, 0, -20.f * static_cast<float>(i + 1)));
+    }
+
+    GLInstanceCulling culling;
+    const auto& proxies = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 0);
+
+    REQUIRE(proxies.size() == 2);
+    CHECK(proxies[0]->geometry() == near.get());
+    CHECK(proxies[0]->count == 2);
+    CHECK(proxies[1]->geometry() == far.get());
+    CHECK(proxies[1]->count == 8);
+
+    // without per instance culling, instances behind the camera are kept
+    mesh->count = 4;
+    mesh->setMatrixAt(0, matrix.makeTranslation(0, 0, 20));
+
+    const auto& levels = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 1);
+    REQUIRE(levels.size() == 2);
+    CHECK(levels[0]->count == 2);
+    CHECK(levels[1]->count == 2);
+}
+
+TEST_CASE("cull many instances") {
+
+    auto camera = PerspectiveCamera::create(90, 1, 0.1f, 100);
+    const auto frustum = cameraFrustum(*camera);
+
+    const int count = 100000;
+    auto mesh = InstancedMesh::create(BoxGeometry::create(0.1f, 0.1f, 0.1f), MeshBasicMaterial::create(), count);
+    mesh->perInstanceFrustumCulled = true;
+    mesh->updateMatrixWorld();
+
+    // every other instance behind the camera
+    Matrix4 matrix;
+    for (int i = 0; i < count; i++) {
+
+        mesh->setMatrixAt(i, matrix.makeTranslation(0, 0, i % 2 == 0 ? -10.f : 10.f));
+    }
+
+    GLInstanceCulling culling;
+    const auto& proxies = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 0);
+
+    REQUIRE(proxies.size() == 1);
+    CHECK(proxies.front()->count == count / 2);
+    CHECK(instancePosition(*proxies.front(), count / 2 - 1).equals(Vector3(0, 0, -10)));
+}
+
+TEST_CASE("more levels than a signed byte holds") {
+
+    auto camera = PerspectiveCamera::create(60, 1, 0.1f, 1000);
+    const auto frustum = cameraFrustum(*camera);
+
+    auto mesh = InstancedMesh::create(BoxGeometry::create(), MeshBasicMaterial::create(), 2);
+    for (int i = 1; i <= 200; i++) {
+
+        mesh->addLevel(BoxGeometry::create(), static_cast<float>(i));
+    }
+    mesh->perInstanceFrustumCulled = true;
+    mesh->updateMatrixWorld();
+
+    Matrix4 matrix;
+    mesh->setMatrixAt(0, matrix.makeTranslation(0, 0, -150.5f));
+    mesh->setMatrixAt(1, matrix.makeTranslation(0, 0, 150.5f));// behind
+
+    GLInstanceCulling culling;
+    const auto& proxies = culling.cull(*mesh, frustum, camera->position, camera->zoom, 0, 0);
+
+    REQUIRE(proxies.size() == 1);
+    CHECK(proxies.front()->geometry() == mesh->levels()[149].geometry.get());
+    CHECK(proxies.front()->count == 1);
+}
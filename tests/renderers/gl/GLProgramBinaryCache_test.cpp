@@ -0,0 +1,135 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/renderers/gl/GLProgramBinaryCache.hpp"
+
+#include <fstream>
+
+using namespace threepp::gl;
+
+namespace {
+
+    struct TempDirectory {
+
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "threepp_program_binary_cache_test";
+
+        TempDirectory() {
+            std::filesystem::remove_all(path);
+        }
+
+        ~TempDirectory() {
+            std::filesystem::remove_all(path);
+        }
+    };
+
+    std::vector<char> readFile(const std::filesystem::path& path) {
+
+        std::ifstream in(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    }
+
+    void writeFile(const std::filesystem::path& path, const std::vector<char>& data) {
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    GLProgramBinaryCache::Entry makeEntry() {
+
+        GLProgramBinaryCache::Entry entry;
+        entry.format = 0x8741;
+        for (int i = 0; i < 100; i++) entry.binary.emplace_back(static_cast<char>(i * 7));
+
+        return entry;
+    }
+
+}// namespace
+
+TEST_CASE("key derivation") {
+
+    const auto key = GLProgramBinaryCache::composeKey("driver", "cache", "vertex", "fragment");
+
+    // every part changes the key, and parts do not run into each other
+    CHECK(key != GLProgramBinaryCache::composeKey("other driver", "cache", "vertex", "fragment"));
+    CHECK(key != GLProgramBinaryCache::composeKey("driver", "other cache", "vertex", "fragment"));
+    CHECK(key != GLProgramBinaryCache::composeKey("driver", "cache", "other vertex", "fragment"));
+    CHECK(key != GLProgramBinaryCache::composeKey("driver", "cache", "vertex", "other fragment"));
+    CHECK(GLProgramBinaryCache::composeKey("driver", "cachev", "ertex", "fragment") != key);
+
+    const std::filesystem::path directory("cache");
+    const auto path = GLProgramBinaryCache::entryPath(directory, key);
+
+    CHECK(path.parent_path() == directory);
+    CHECK(path.extension() == ".bin");
+    CHECK(path == GLProgramBinaryCache::entryPath(directory, GLProgramBinaryCache::composeKey("driver", "cache", "vertex", "fragment")));
+    CHECK(path != GLProgramBinaryCache::entryPath(directory, GLProgramBinaryCache::composeKey("driver", "cache", "vertex", "other fragment")));
+}
+
+TEST_CASE("entries") {
+
+    TempDirectory directory;
+
+    const auto key = GLProgramBinaryCache::composeKey("driver", "cache", "vertex", "fragment");
+    const auto entry = makeEntry();
+
+    CHECK(!GLProgramBinaryCache::readEntry(directory.path, key));
+
+    REQUIRE(GLProgramBinaryCache::writeEntry(directory.path, key, entry));
+
+    const auto path = GLProgramBinaryCache::entryPath(directory.path, key);
+    auto file = readFile(path);
+
+    SECTION("round trip") {
+
+        const auto read = GLProgramBinaryCache::readEntry(directory.path, key);
+        REQUIRE(read);
+        CHECK(read->format == entry.format);
+        CHECK(read->binary == entry.binary);
+    }
+
+    SECTION("written for another key") {
+
+        // the entry of key found under the file name of other, as after a collision of the file name hashes
+        const auto other = GLProgramBinaryCache::composeKey("other driver", "cache", "vertex", "fragment");
+        writeFile(GLProgramBinaryCache::entryPath(directory.path, other), file);
+
+        CHECK(!GLProgramBinaryCache::readEntry(directory.path, other));
+    }
+
+    SECTION("magic") {
+
+        file[0] ^= 1;
+        writeFile(path, file);
+
+        CHECK(!GLProgramBinaryCache::readEntry(directory.path, key));
+    }
+
+    SECTION("version") {
+
+        file[4] ^= 1;
+        writeFile(path, file);
+
+        CHECK(!GLProgramBinaryCache::readEntry(directory.path, key));
+    }
+
+    SECTION("truncated") {
+
+        file.resize(file.size() - 1);
+        writeFile(path, file);
+        CHECK(!GLProgramBinaryCache::readEntry(directory.path, key));
+
+        file.resize(10);
+        writeFile(path, file);
+        CHECK(!GLProgramBinaryCache::readEntry(directory.path, key));
+    }
+
+    SECTION("corrupt length") {
+
+        // the length is the last field of the header, right before the binary
+        const auto lengthOffset = file.size() - entry.binary.size() - 4;
+        file[lengthOffset + 3] = static_cast<char>(0x7f);
+        writeFile(path, file);
+
+        CHECK(!GLProgramBinaryCache::readEntry(directory.path, key));
+    }
+}
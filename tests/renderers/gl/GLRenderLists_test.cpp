@@ -9,6 +9,8 @@
 #include "threepp/renderers/gl/GLProperties.hpp"
 #include "threepp/renderers/gl/GLRenderLists.hpp"
 
+#include <tuple>
+
 using namespace threepp;
 using namespace threepp::gl;
 
@@ -87,16 +89,16 @@ TEST_CASE("push") {
     auto proD = std::make_shared<GLProgram>();
     BufferGeometry geoD;
 
-    auto materialProperties = properties.materialProperties.get(matA.uuid());
+    auto materialProperties = properties.materialProperties.get(matA.slot);
     materialProperties->program = proA;
 
-    materialProperties = properties.materialProperties.get(matB.uuid());
+    materialProperties = properties.materialProperties.get(matB.slot);
     materialProperties->program = proB;
 
-    materialProperties = properties.materialProperties.get(matC.uuid());
+    materialProperties = properties.materialProperties.get(matC.slot);
     materialProperties->program = proC;
 
-    materialProperties = properties.materialProperties.get(matD.uuid());
+    materialProperties = properties.materialProperties.get(matD.slot);
     materialProperties->program = proD;
 
     // A
@@ -172,21 +174,119 @@ TEST_CASE("push") {
     }
 }
 
-//struct DummyItem {
-//    Object3D o;
-//    BufferGeometry g;
-//    DummyMaterial m;
-//    unsigned int groupOrder = 0;
-//    float z = 0;
-//
-//    DummyItem(int id) {
-//        o.id = id;
-//    }
-//};
-//
-//TEST_CASE("sort") {
-//
-//    GLProperties properties;
-//    GLRenderList list(properties);
-//
-//}
+struct DummyItem {
+
+    Object3D o;
+    BufferGeometry g;
+    DummyMaterial m;
+
+    explicit DummyItem(unsigned int id, bool transparent = false) {
+        o.id = id;
+        m.transparent = transparent;
+    }
+};
+
+TEST_CASE("sort") {
+
+    GLProperties properties;
+    GLRenderList list(properties);
+
+    auto proA = std::make_shared<GLProgram>();
+    auto proB = std::make_shared<GLProgram>();
+
+    std::vector<std::unique_ptr<DummyItem>> items;
+    for (unsigned int i = 0; i < 6; i++) {
+        items.emplace_back(std::make_unique<DummyItem>(i, i >= 4));
+    }
+
+    properties.materialProperties.get(items[0]->m.slot)->program = proB;
+    properties.materialProperties.get(items[1]->m.slot)->program = proA;
+    properties.materialProperties.get(items[2]->m.slot)->program = proA;
+    properties.materialProperties.get(items[3]->m.slot)->program = proA;
+
+    items[3]->o.renderOrder = 1;
+
+    list.push(&items[0]->o, &items[0]->g, &items[0]->m, 0, 0.1f, std::nullopt);
+    list.push(&items[1]->o, &items[1]->g, &items[1]->m, 0, 0.9f, std::nullopt);
+    list.push(&items[1]->o, &items[1]->g, &items[1]->m, 0, 0.2f, std::nullopt);
+    list.push(&items[3]->o, &items[3]->g, &items[3]->m, 0, -0.5f, std::nullopt);
+    list.push(&items[2]->o, &items[2]->g, &items[2]->m, 0, 0.5f, std::nullopt);
+    list.push(&items[4]->o, &items[4]->g, &items[4]->m, 0, 0.3f, std::nullopt);
+    list.push(&items[5]->o, &items[5]->g, &items[5]->m, 0, 0.7f, std::nullopt);
+    list.push(&items[4]->o, &items[4]->g, &items[4]->m, 1, 0.9f, std::nullopt);
+
+    list.finish();
+    list.sort();
+
+    REQUIRE(list.opaque.size() == 5);
+    // renderOrder first, then program, material and depth
+    CHECK(list.opaque[0]->object == &items[1]->o);
+    CHECK(list.opaque[0]->z == Approx(0.2f));
+    CHECK(list.opaque[1]->object == &items[1]->o);
+    CHECK(list.opaque[1]->z == Approx(0.9f));
+    CHECK(list.opaque[2]->object == &items[2]->o);
+    CHECK(list.opaque[3]->object == &items[0]->o);
+    CHECK(list.opaque[4]->object == &items[3]->o);
+
+    REQUIRE(list.transparent.size() == 3);
+    // groupOrder first, then back to front
+    CHECK(list.transparent[0]->object == &items[5]->o);
+    CHECK(list.transparent[1]->object == &items[4]->o);
+    CHECK(list.transparent[1]->groupOrder == 0);
+    CHECK(list.transparent[2]->object == &items[4]->o);
+    CHECK(list.transparent[2]->groupOrder == 1);
+}
+
+TEST_CASE("sort large list") {
+
+    GLProperties properties;
+    GLRenderList list(properties);
+
+    std::vector<std::shared_ptr<GLProgram>> programs(4);
+    for (auto& program : programs) program = std::make_shared<GLProgram>();
+
+    std::vector<std::unique_ptr<DummyItem>> items;
+    for (unsigned int i = 0; i < 1000; i++) {
+
+        auto& item = items.emplace_back(std::make_unique<DummyItem>(i, i % 3 == 0));
+        item->o.renderOrder = (i * 7) % 3;
+        properties.materialProperties.get(item->m.slot)->program = programs[(i * 13) % programs.size()];
+    }
+
+    for (int frame = 0; frame < 2; frame++) {
+
+        list.init();
+        for (unsigned int i = 0; i < items.size(); i++) {
+
+            auto& item = items[i];
+            const auto z = static_cast<float>((i * 7919) % 1000) / 500.f - 1.f;
+            list.push(&item->o, &item->g, &item->m, i % 2, z, std::nullopt);
+        }
+        list.finish();
+        list.sort();
+
+        REQUIRE(list.opaque.size() + list.transparent.size() == items.size());
+
+        for (size_t i = 1; i < list.opaque.size(); i++) {
+
+            auto a = list.opaque[i - 1];
+            auto b = list.opaque[i];
+            REQUIRE(!b->material->transparent);
+
+            const auto keyA = std::make_tuple(a->groupOrder, a->renderOrder, a->program->id, a->material->slot.index(), a->geometry->slot.index(), a->z);
+            const auto keyB = std::make_tuple(b->groupOrder, b->renderOrder, b->program->id, b->material->slot.index(), b->geometry->slot.index(), b->z);
+            REQUIRE(keyA <= keyB);
+        }
+
+        for (size_t i = 1; i < list.transparent.size(); i++) {
+
+            auto a = list.transparent[i - 1];
+            auto b = list.transparent[i];
+            REQUIRE(b->material->transparent);
+
+            const auto keyA = std::make_tuple(a->groupOrder, a->renderOrder, -a->z);
+            const auto keyB = std::make_tuple(b->groupOrder, b->renderOrder, -b->z);
+            REQUIRE(keyA <= keyB);
+        }
+    }
+}
@@ -0,0 +1,236 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/InstancedMesh.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/renderers/gl/GLShadowCasters.hpp"
+#include "threepp/scenes/Scene.hpp"
+
+using namespace threepp;
+using namespace threepp::gl;
+
+namespace {
+
+    std::shared_ptr<Mesh> addCaster(Object3D& parent, float x) {
+
+        auto mesh = Mesh::create(BoxGeometry::create(), MeshBasicMaterial::create());
+        mesh->castShadow = true;
+        mesh->position.x = x;
+        parent.add(mesh);
+
+        return mesh;
+    }
+
+    // gathers and classifies the casters of scene as one shadow render would
+    size_t update(GLShadowCasters& casters, Scene& scene) {
+
+        scene.updateMatrixWorld();
+        casters.gather(scene, Layers(), false);
+
+        return casters.updateStates(scene);
+    }
+
+    // updates until the epoch settles, moving casters back into the static set
+    size_t settle(GLShadowCasters& casters, Scene& scene) {
+
+        for (unsigned i = 0; i < GLShadowCasters::staticAfterFrames; i++) update(casters, scene);
+
+        return update(casters, scene);
+    }
+
+    bool isStatic(const GLShadowCasters& casters, const Object3D& object) {
+
+        for (const auto& caster : casters.casters) {
+
+            if (caster.object == &object) return caster.isStatic;
+        }
+
+        FAIL("not a caster");
+        return false;
+    }
+
+}// namespace
+
+TEST_CASE("gather") {
+
+    auto scene = Scene::create();
+    auto caster = addCaster(*scene, 0);
+    auto child = addCaster(*caster, 1);
+
+    auto receiver = Mesh::create(BoxGeometry::create(), MeshBasicMaterial::create());
+    receiver->receiveShadow = true;
+    scene->add(receiver);
+
+    auto hidden = addCaster(*scene, 2);
+    hidden->visible = false;
+    addCaster(*hidden, 3);
+
+    auto otherLayer = addCaster(*scene, 4);
+    otherLayer->layers.set(2);
+
+    scene->updateMatrixWorld();
+
+    GLShadowCasters casters;
+    casters.gather(*scene, Layers(), false);
+
+    REQUIRE(casters.casters.size() == 2);
+    CHECK(casters.casters[0].object == caster.get());
+    CHECK(casters.casters[1].object == child.get());
+
+    // world space bounds
+    CHECK(casters.casters[1].sphere.center.x == Approx(1));
+
+    // receivers only cast into VSM shadow maps
+    casters.gather(*scene, Layers(), true);
+    CHECK(casters.casters.size() == 3);
+}
+
+TEST_CASE("static and dynamic split") {
+
+    auto scene = Scene::create();
+    auto still = addCaster(*scene, 0);
+    auto moving = addCaster(*scene, 1);
+
+    GLShadowCasters casters;
+    const auto first = update(casters, *scene);
+    CHECK(isStatic(casters, *still));
+    CHECK(isStatic(casters, *moving));
+
+    moving->position.y += 1;
+    const auto moved = update(casters, *scene);
+    CHECK(moved != first);
+    CHECK(isStatic(casters, *still));
+    CHECK(!isStatic(casters, *moving));
+
+    std::vector<ShadowDraw> draws, staticDraws;
+    casters.addDraws(0, true, draws, staticDraws);
+    casters.addDraws(1, true, draws, staticDraws);
+    REQUIRE(draws.size() == 1);
+    REQUIRE(staticDraws.size() == 1);
+    CHECK(casters.casters[draws.front().caster].object == moving.get());
+    CHECK(casters.casters[staticDraws.front().caster].object == still.get());
+
+    // without a cached layer everything is drawn as dynamic
+    draws.clear(), staticDraws.clear();
+    casters.addDraws(0, false, draws, staticDraws);
+    CHECK(draws.size() == 1);
+    CHECK(staticDraws.empty());
+
+    // moving while dynamic leaves the static set alone
+    moving->position.y += 1;
+    CHECK(update(casters, *scene) == moved);
+
+    // back into the static set once it stays put
+    const auto settled = settle(casters, *scene);
+    CHECK(settled != moved);
+    CHECK(isStatic(casters, *moving));
+    CHECK(update(casters, *scene) == settled);
+}
+
+TEST_CASE("invalidation") {
+
+    auto scene = Scene::create();
+    auto caster = addCaster(*scene, 0);
+
+    GLShadowCasters casters;
+    auto epoch = update(casters, *scene);
+    REQUIRE(update(casters, *scene) == epoch);
+
+    const auto changes = [&] {
+        const auto next = settle(casters, *scene);
+        const bool changed = next != epoch;
+        epoch = next;
+        return changed;
+    };
+
+    SECTION("material swap") {
+
+        caster->setMaterial(MeshBasicMaterial::create());
+        CHECK(changes());
+    }
+
+    SECTION("material visibility") {
+
+        caster->material()->visible = false;
+        CHECK(changes());
+
+        // invisible materials have no draws
+        std::vector<ShadowDraw> draws, staticDraws;
+        casters.addDraws(0, true, draws, staticDraws);
+        CHECK(draws.empty());
+        CHECK(staticDraws.empty());
+
+        caster->material()->visible = true;
+        CHECK(changes());
+    }
+
+    SECTION("material version") {
+
+        caster->material()->needsUpdate();
+        CHECK(changes());
+    }
+
+    SECTION("geometry") {
+
+        caster->setGeometry(BoxGeometry::create(2, 2, 2));
+        CHECK(changes());
+    }
+
+    SECTION("draw range") {
+
+        caster->geometry()->setDrawRange(0, 6);
+        CHECK(changes());
+
+        caster->geometry()->setDrawRange(6, 6);
+        CHECK(changes());
+    }
+
+    SECTION("instance count") {
+
+        auto instanced = InstancedMesh::create(BoxGeometry::create(), MeshBasicMaterial::create(), 4);
+        instanced->castShadow = true;
+        scene->add(instanced);
+        CHECK(changes());
+
+        instanced->count = 2;
+        CHECK(changes());
+    }
+
+    SECTION("added and removed") {
+
+        auto added = addCaster(*scene, 5);
+        CHECK(changes());
+
+        added->removeFromParent();
+        CHECK(changes());
+    }
+
+    SECTION("nothing") {
+
+        CHECK(!changes());
+    }
+}
+
+TEST_CASE("scenes keep their own states") {
+
+    auto a = Scene::create();
+    addCaster(*a, 0);
+
+    auto b = Scene::create();
+    addCaster(*b, 1);
+    addCaster(*b, 2);
+
+    GLShadowCasters casters;
+    const auto epochA = update(casters, *a);
+    const auto epochB = update(casters, *b);
+    CHECK(epochA != epochB);
+
+    // alternating between them every frame keeps both sets cached
+    for (int i = 0; i < 3; i++) {
+
+        CHECK(update(casters, *a) == epochA);
+        CHECK(update(casters, *b) == epochB);
+    }
+}
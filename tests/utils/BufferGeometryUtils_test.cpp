@@ -0,0 +1,187 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/utils/BufferGeometryUtils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace threepp;
+
+namespace {
+
+    // triangles as sorted vertex positions, independent of index order and winding start
+    // the triangles of count indices from start, all when count is negative
+    std::vector<std::array<float, 9>> triangleSoup(BufferGeometry& geometry, int start = 0, int count = -1) {
+
+        const auto index = geometry.getIndex();
+        const auto position = geometry.getAttribute("position");
+        if (count < 0) count = index ? index->count() : position->count();
+
+        std::vector<std::array<float, 9>> triangles;
+        for (int t = 0; t < count / 3; t++) {
+
+            std::array<std::array<float, 3>, 3> corners{};
+            for (int k = 0; k < 3; k++) {
+
+                const auto v = index ? index->getX(start + t * 3 + k) : start + t * 3 + k;
+                for (int c = 0; c < 3; c++) corners[k][c] = position->getComponent(v, c);
+            }
+
+            std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end()), corners.end());
+
+            std::array<float, 9> triangle{};
+            for (int k = 0; k < 9; k++) triangle[k] = corners[k / 3][k % 3];
+            triangles.push_back(triangle);
+        }
+
+        std::sort(triangles.begin(), triangles.end());
+
+        return triangles;
+    }
+
+    void shuffleTriangles(BufferGeometry& geometry) {
+
+        auto& indices = geometry.getIndex()->array();
+
+        std::vector<std::array<unsigned int, 3>> triangles(indices.size() / 3);
+        for (size_t t = 0; t < triangles.size(); t++) {
+
+            triangles[t] = {indices[t * 3], indices[t * 3 + 1], indices[t * 3 + 2]};
+        }
+
+        std::shuffle(triangles.begin(), triangles.end(), std::mt19937(42));
+
+        for (size_t t = 0; t < triangles.size(); t++) {
+
+            std::copy(triangles[t].begin(), triangles[t].end(), indices.begin() + t * 3);
+        }
+    }
+
+}// namespace
+
+TEST_CASE("mergeVertices") {
+
+    auto box = BoxGeometry::create()->toNonIndexed();
+    REQUIRE(box->getAttribute("position")->count() == 36);
+
+    auto welded = mergeVertices(*box);
+    REQUIRE(welded);
+    CHECK(welded->hasIndex());
+    CHECK(welded->getIndex()->count() == 36);
+    // normals and uvs keep the faces apart
+    CHECK(welded->getAttribute("position")->count() == 24);
+    CHECK(triangleSoup(*welded) == triangleSoup(*box));
+
+    box->deleteAttribute("normal");
+    box->deleteAttribute("uv");
+
+    // positions within tolerance are welded
+    auto& array = box->getAttribute<float>("position")->array();
+    for (size_t i = 0; i < array.size(); i += 2) array[i] += 1e-6f;
+
+    welded = mergeVertices(*box, 1e-3f);
+    CHECK(welded->getAttribute("position")->count() == 8);
+
+    welded = mergeVertices(*box, 0);
+    CHECK(welded->getAttribute("position")->count() > 8);
+}
+
+TEST_CASE("optimizeVertexCache") {
+
+    auto sphere = SphereGeometry::create(1, 64, 32);
+    shuffleTriangles(*sphere);
+
+    const auto before = computeACMR(*sphere);
+    const auto triangles = triangleSoup(*sphere);
+
+    optimizeVertexCache(*sphere);
+
+    CHECK(computeACMR(*sphere) < before * 0.5f);
+    CHECK(computeACMR(*sphere) < 1.f);
+    CHECK(triangleSoup(*sphere) == triangles);
+}
+
+TEST_CASE("optimizeOverdraw") {
+
+    auto sphere = SphereGeometry::create(1, 64, 32);
+    optimizeVertexCache(*sphere);
+
+    const auto acmr = computeACMR(*sphere);
+    const auto triangles = triangleSoup(*sphere);
+
+    optimizeOverdraw(*sphere, 1.05f);
+
+    CHECK(triangleSoup(*sphere) == triangles);
+    CHECK(computeACMR(*sphere) < acmr * 1.25f);
+}
+
+TEST_CASE("overlapping groups keep their triangles") {
+
+    auto sphere = SphereGeometry::create(1, 256, 160);
+    shuffleTriangles(*sphere);
+
+    const auto indexCount = sphere->getIndex()->count();
+    const int half = indexCount / 6 * 3;
+
+    // the second group covers the second half of the first and the rest of the index
+    sphere->addGroup(0, half + half / 3 * 3, 0);
+    sphere->addGroup(half, indexCount - half, 1);
+
+    const auto triangles = triangleSoup(*sphere);
+
+    std::vector<std::vector<std::array<float, 9>>> groupTriangles;
+    for (const auto& group : sphere->groups) {
+
+        groupTriangles.push_back(triangleSoup(*sphere, group.start, group.count));
+    }
+
+    const auto acmr = computeACMR(*sphere);
+
+    optimizeVertexCache(*sphere);
+    optimizeOverdraw(*sphere);
+
+    CHECK(triangleSoup(*sphere) == triangles);
+    CHECK(computeACMR(*sphere) < acmr);
+
+    // no triangle moved to another group, which would change its material
+    for (size_t i = 0; i < sphere->groups.size(); i++) {
+
+        const auto& group = sphere->groups[i];
+        CHECK(triangleSoup(*sphere, group.start, group.count) == groupTriangles[i]);
+    }
+}
+
+TEST_CASE("optimizeVertexFetch") {
+
+    auto geometry = BufferGeometry::create();
+    geometry->setAttribute("position", FloatBufferAttribute::create(std::vector<float>{0, 0, 0, 1, 0, 0, 9, 9, 9, 0, 1, 0, 1, 1, 0}, 3));
+    geometry->setIndex(std::vector<unsigned int>{4, 3, 1, 3, 0, 1});
+
+    const auto triangles = triangleSoup(*geometry);
+
+    optimizeVertexFetch(*geometry);
+
+    // the unreferenced vertex is dropped and vertices appear in first use order
+    CHECK(geometry->getAttribute("position")->count() == 4);
+    CHECK(geometry->getIndex()->array() == std::vector<unsigned int>{0, 1, 2, 1, 3, 2});
+    CHECK(triangleSoup(*geometry) == triangles);
+}
+
+TEST_CASE("optimizeGeometry large soup") {
+
+    // large enough to be welded in shards and reordered in parallel chunks
+    auto sphere = SphereGeometry::create(1, 256, 160);
+    auto soup = sphere->toNonIndexed();
+    const auto triangles = triangleSoup(*soup);
+
+    auto optimized = optimizeGeometry(*soup);
+    REQUIRE(optimized);
+
+    CHECK(optimized->getAttribute("position")->count() <= sphere->getAttribute("position")->count());
+    CHECK(computeACMR(*optimized) < 1.f);
+    CHECK(triangleSoup(*optimized) == triangles);
+}
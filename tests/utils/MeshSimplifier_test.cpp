@@ -0,0 +1,178 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/geometries/BoxGeometry.hpp"
+#include "threepp/geometries/PlaneGeometry.hpp"
+#include "threepp/geometries/SphereGeometry.hpp"
+#include "threepp/materials/MeshBasicMaterial.hpp"
+#include "threepp/objects/LOD.hpp"
+#include "threepp/objects/Mesh.hpp"
+#include "threepp/utils/MeshSimplifier.hpp"
+
+#include <cmath>
+
+using namespace threepp;
+
+namespace {
+
+    size_t triangleCount(const BufferGeometry& geometry) {
+
+        return geometry.hasIndex() ? geometry.getIndex()->count() / 3 : geometry.getAttribute("position")->count() / 3;
+    }
+
+    // largest distance of a vertex from the unit sphere
+    float sphereDeviation(const BufferGeometry& geometry) {
+
+        const auto position = geometry.getAttribute("position");
+
+        Vector3 v;
+        float deviation = 0;
+        for (int i = 0; i < position->count(); i++) {
+
+            position->setFromBufferAttribute(v, i);
+            deviation = std::max(deviation, std::abs(v.length() - 1));
+        }
+
+        return deviation;
+    }
+
+}// namespace
+
+TEST_CASE("simplify sphere") {
+
+    auto sphere = SphereGeometry::create(1, 64, 48);
+    const auto triangles = triangleCount(*sphere);
+
+    SimplifyOptions options;
+    options.targetRatio = 0.25f;
+    options.targetError = 0.05f;
+
+    float error = -1;
+    auto simplified = simplifyGeometry(*sphere, options, &error);
+    REQUIRE(simplified);
+
+    CHECK(triangleCount(*simplified) <= triangles / 4);
+    CHECK(triangleCount(*simplified) > triangles / 8);
+    CHECK(simplified->getAttribute("position")->count() < sphere->getAttribute("position")->count() / 2);
+    CHECK(simplified->hasAttribute("normal"));
+    CHECK(simplified->hasAttribute("uv"));
+
+    CHECK(error >= 0);
+    CHECK(error <= options.targetError);
+    CHECK(sphereDeviation(*simplified) < 1e-5f);
+}
+
+TEST_CASE("simplify respects target error") {
+
+    auto sphere = SphereGeometry::create(1, 32, 24);
+
+    SimplifyOptions options;
+    options.targetRatio = 0;
+    options.targetError = 1e-3f;
+
+    float error = -1;
+    auto simplified = simplifyGeometry(*sphere, options, &error);
+    REQUIRE(simplified);
+
+    // a curved surface cannot lose many triangles within such a small error
+    CHECK(triangleCount(*simplified) > triangleCount(*sphere) / 2);
+    CHECK(error <= options.targetError);
+}
+
+TEST_CASE("simplify triangle soup") {
+
+    auto soup = SphereGeometry::create(1, 32, 24)->toNonIndexed();
+
+    SimplifyOptions options;
+    options.targetRatio = 0.5f;
+    options.targetError = 0.05f;
+
+    auto simplified = simplifyGeometry(*soup, options);
+    REQUIRE(simplified);
+
+    CHECK(simplified->hasIndex());
+    CHECK(triangleCount(*simplified) <= triangleCount(*soup) / 2);
+}
+
+TEST_CASE("simplify plane and lock border") {
+
+    auto plane = PlaneGeometry::create(1, 1, 16, 16);
+
+    SimplifyOptions options;
+    options.targetRatio = 0;
+    options.targetError = 1e-4f;
+    options.attributeWeight = 0;
+
+    // a flat surface collapses to a handful of triangles without any error
+    auto simplified = simplifyGeometry(*plane, options);
+    REQUIRE(simplified);
+    CHECK(triangleCount(*simplified) <= 8);
+
+    options.lockBorder = true;
+    auto locked = simplifyGeometry(*plane, options);
+    REQUIRE(locked);
+
+    const auto position = locked->getAttribute("position");
+
+    int outline = 0;
+    for (int i = 0; i < position->count(); i++) {
+
+        if (std::abs(position->getComponent(i, 0)) == 0.5f || std::abs(position->getComponent(i, 1)) == 0.5f) outline++;
+    }
+
+    // the 64 outline vertices stay, the interior goes except for the few the outline fans around
+    CHECK(outline == 64);
+    CHECK(position->count() <= 68);
+    CHECK(triangleCount(*locked) < triangleCount(*plane) / 4);
+}
+
+TEST_CASE("simplify keeps groups") {
+
+    auto box = BoxGeometry::create(1, 1, 1, 8, 8, 8);
+
+    SimplifyOptions options;
+    options.targetRatio = 0;
+    options.targetError = 1e-4f;
+
+    auto simplified = simplifyGeometry(*box, options);
+    REQUIRE(simplified);
+
+    REQUIRE(simplified->groups.size() == box->groups.size());
+    for (size_t i = 0; i < box->groups.size(); i++) {
+
+        CHECK(simplified->groups[i].materialIndex == box->groups[i].materialIndex);
+        CHECK(simplified->groups[i].count > 0);
+        CHECK(simplified->groups[i].count < box->groups[i].count);
+    }
+
+    simplified->computeBoundingBox();
+    CHECK(simplified->boundingBox->min().equals(Vector3(-0.5f, -0.5f, -0.5f)));
+    CHECK(simplified->boundingBox->max().equals(Vector3(0.5f, 0.5f, 0.5f)));
+}
+
+TEST_CASE("generateLOD") {
+
+    auto mesh = Mesh::create(SphereGeometry::create(1, 64, 48), MeshBasicMaterial::create());
+    mesh->position.set(1, 2, 3);
+
+    SimplifyOptions options;
+    options.targetError = 0.05f;
+
+    auto lod = generateLOD(*mesh, {10, 20, 40}, options);
+
+    REQUIRE(lod->children.size() == 4);
+    CHECK(lod->position.equals(Vector3(1, 2, 3)));
+
+    size_t previous = std::numeric_limits<size_t>::max();
+    for (auto child : lod->children) {
+
+        auto level = child->as<Mesh>();
+        REQUIRE(level);
+        CHECK(level->position.equals(Vector3()));
+        CHECK(level->material() == mesh->material());
+
+        const auto triangles = triangleCount(*level->geometry());
+        CHECK(triangles < previous);
+        previous = triangles;
+    }
+}
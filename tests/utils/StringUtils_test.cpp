@@ -83,3 +83,55 @@ TEST_CASE("trim") {
         REQUIRE(trim == std::string{str.begin() + 4, str.end() - 4});
     }
 }
+
+TEST_CASE("parseFloat") {
+
+    const auto parse = [](const std::string& str, float& value) {
+        auto it = str.data();
+        return utils::parseFloat(it, str.data() + str.size(), value);
+    };
+
+    float value;
+    for (const std::string str : {"0", "1", "-1", "3.14159", "-0.000123", ".5", "1.", "+2.5", "1e3", "1.5E-4", "-2.75e+2", "123456789.123456789", "0.1234567890123456789012345"}) {
+        REQUIRE(parse(str, value));
+        CHECK(value == std::stof(str));
+    }
+
+    CHECK_FALSE(parse("", value));
+    CHECK_FALSE(parse("-", value));
+    CHECK_FALSE(parse(".", value));
+    CHECK_FALSE(parse("abc", value));
+
+    const std::string line{"  1.5 -2 3e1x"};
+    auto it = line.data();
+    const auto end = line.data() + line.size();
+
+    float x, y, z;
+    REQUIRE(utils::parseFloat(it, end, x));
+    REQUIRE(utils::parseFloat(it, end, y));
+    REQUIRE(utils::parseFloat(it, end, z));
+    CHECK(x == 1.5f);
+    CHECK(y == -2.f);
+    CHECK(z == 30.f);
+    CHECK(*it == 'x');
+}
+
+TEST_CASE("parseInt") {
+
+    const std::string line{"12/-3//7"};
+    auto it = line.data();
+    const auto end = line.data() + line.size();
+
+    int value;
+    REQUIRE(utils::parseInt(it, end, value));
+    CHECK(value == 12);
+    CHECK(*it++ == '/');
+    REQUIRE(utils::parseInt(it, end, value));
+    CHECK(value == -3);
+    CHECK(*it++ == '/');
+    CHECK_FALSE(utils::parseInt(it, end, value));
+    CHECK(*it++ == '/');
+    REQUIRE(utils::parseInt(it, end, value));
+    CHECK(value == 7);
+    CHECK(it == end);
+}
@@ -0,0 +1,122 @@
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include "threepp/utils/ThreadPool.hpp"
+
+#include <chrono>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+using namespace threepp::utils;
+
+TEST_CASE("submit returns future") {
+
+    ThreadPool pool(4);
+
+    auto f1 = pool.submit([] { return 42; });
+    auto f2 = pool.submit([] { return std::string("threepp"); });
+
+    CHECK(f1.get() == 42);
+    CHECK(f2.get() == "threepp");
+
+    auto f3 = pool.submit([]() -> int { throw std::runtime_error("error"); });
+    CHECK_THROWS_AS(f3.get(), std::runtime_error);
+}
+
+TEST_CASE("wait") {
+
+    ThreadPool pool(4);
+
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; i++) {
+        pool.submit([&] { ++counter; });
+    }
+    pool.wait();
+
+    CHECK(counter == 1000);
+}
+
+TEST_CASE("parallel_for covers range exactly once") {
+
+    ThreadPool pool(4);
+
+    std::vector<int> visits(10007);
+    parallel_for(pool, size_t(0), visits.size(), size_t(64), [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; i++) visits[i]++;
+    });
+
+    CHECK(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+}
+
+TEST_CASE("nested parallel_for") {
+
+    ThreadPool pool(3);
+
+    std::atomic<int> counter{0};
+    parallel_for(pool, 0, 64, 1, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            parallel_for(pool, 0, 100, 10, [&](int b, int e) {
+                counter += e - b;
+            });
+        }
+    });
+
+    CHECK(counter == 6400);
+}
+
+TEST_CASE("parallel_reduce") {
+
+    ThreadPool pool(4);
+
+    std::vector<long> values(100000);
+    std::iota(values.begin(), values.end(), 0);
+
+    const auto sum = parallel_reduce(
+            pool, size_t(0), values.size(), size_t(1000), 0L,
+            [&](size_t begin, size_t end) { return std::accumulate(values.begin() + begin, values.begin() + end, 0L); },
+            [](long a, long b) { return a + b; });
+
+    CHECK(sum == std::accumulate(values.begin(), values.end(), 0L));
+}
+
+TEST_CASE("TaskGroup propagates exceptions") {
+
+    ThreadPool pool(2);
+
+    TaskGroup group(pool);
+    group.run([] {});
+    group.run([] { throw std::logic_error("error"); });
+
+    CHECK_THROWS_AS(group.wait(), std::logic_error);
+}
+
+TEST_CASE("tasks waiting concurrently") {
+
+    ThreadPool pool(2);
+
+    for (int run = 0; run < 50; run++) {
+
+        std::atomic<int> started{0};
+        std::atomic<int> counter{0};
+
+        const auto task = [&] {
+            // both tasks are inside wait() at the same time
+            ++started;
+            while (started < 2) std::this_thread::yield();
+
+            for (int i = 0; i < 10; i++) {
+                pool.post([&] { ++counter; });
+            }
+            pool.wait();
+        };
+
+        auto f1 = pool.submit(task);
+        auto f2 = pool.submit(task);
+
+        REQUIRE(f1.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        REQUIRE(f2.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        CHECK(counter == 20);
+    }
+}